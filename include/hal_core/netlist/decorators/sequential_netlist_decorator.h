@@ -0,0 +1,95 @@
+// MIT License
+//
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+#include "hal_core/netlist/event_system/event_handler.h"
+#include "hal_core/netlist/netlist.h"
+#include "hal_core/utilities/result.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace hal
+{
+    class NETLIST_API SequentialNetlistDecorator
+    {
+    public:
+        /**
+         * Construct new SequentialNetlistDecorator object and compute for every flip-flop of the netlist its sequential successors and predecessors, i.e., the flip-flops that are reached through combinational logic only.<br>
+         * The index is invalidated through gate and net events of the netlist and only the affected flip-flops are updated on the next query, i.e., changes made while events are disabled are not tracked until `rebuild` is called.
+         * 
+         * @param[in] netlist - The netlist to operate on.
+         */
+        SequentialNetlistDecorator(const Netlist& netlist);
+
+        ~SequentialNetlistDecorator();
+
+        SequentialNetlistDecorator(const SequentialNetlistDecorator&) = delete;
+        SequentialNetlistDecorator& operator=(const SequentialNetlistDecorator&) = delete;
+
+        /**
+         * Discard the index and compute the sequential successors and predecessors of all flip-flops again.
+         */
+        void rebuild();
+
+        /**
+         * Update the sequential successors and predecessors of all flip-flops affected by netlist changes since the last update.<br>
+         * This is done implicitly by every query, but must be called explicitly before querying the decorator from multiple threads.
+         */
+        void update();
+
+        /**
+         * Get all sequential successors or predecessors of a flip-flop, i.e., the flip-flops that are reached by traversing combinational logic starting at its output or input nets.<br>
+         * The result may include the provided flip-flop itself and is ordered by gate ID.
+         * Matches `netlist_utils::get_next_sequential_gates` without the need to traverse the netlist.
+         * 
+         * @param[in] gate - The flip-flop.
+         * @param[in] get_successors - If true, sequential successors are returned, otherwise sequential predecessors are returned.
+         * @returns All sequential successors or predecessors of the flip-flop on success, an error otherwise.
+         */
+        Result<std::vector<Gate*>> get_next_sequential_gates(const Gate* gate, bool get_successors);
+
+    private:
+        const Netlist& m_netlist;
+        std::string m_callback_name;
+
+        std::vector<Gate*> m_flip_flops;
+        std::unordered_map<const Gate*, u32> m_flip_flop_indices;
+        std::vector<std::vector<Gate*>> m_successors;
+        std::vector<std::vector<Gate*>> m_predecessors;
+
+        // changes since the last update
+        bool m_rebuild_required = false;
+        std::unordered_set<u32> m_changed_nets;
+        std::unordered_set<u32> m_changed_gates;
+
+        void handle_gate_event(GateEvent::event e, Gate* gate);
+        void handle_net_event(NetEvent::event e, Net* net, u32 associated_data);
+        std::vector<u32> find_affected_flip_flops() const;
+        std::vector<std::vector<Gate*>> compute_successors(const std::vector<u32>& flip_flop_indices) const;
+    };
+}    // namespace hal
@@ -0,0 +1,134 @@
+// MIT License
+//
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+#include "hal_core/netlist/event_system/event_handler.h"
+#include "hal_core/netlist/netlist.h"
+#include "hal_core/utilities/result.h"
+
+#include <unordered_map>
+
+namespace hal
+{
+    class NETLIST_API SpatialNetlistDecorator
+    {
+    public:
+        /**
+         * Construct new SpatialNetlistDecorator object and index the locations of all placed gates of the netlist in a uniform grid.<br>
+         * The index is kept up to date by listening to gate events of the netlist, i.e., gates that are created, removed, or moved while gate events are disabled are not tracked until `rebuild` is called.
+         * 
+         * @param[in] netlist - The netlist to operate on.
+         * @param[in] cell_size - The side length of a grid cell. If set to 0, the size is chosen such that a cell holds only a few gates on average.
+         */
+        SpatialNetlistDecorator(const Netlist& netlist, u32 cell_size = 0);
+
+        ~SpatialNetlistDecorator();
+
+        SpatialNetlistDecorator(const SpatialNetlistDecorator&) = delete;
+        SpatialNetlistDecorator& operator=(const SpatialNetlistDecorator&) = delete;
+
+        /**
+         * Discard the index and index the locations of all placed gates of the netlist again.
+         * 
+         * @param[in] cell_size - The side length of a grid cell. If set to 0, the size is chosen such that a cell holds only a few gates on average.
+         */
+        void rebuild(u32 cell_size = 0);
+
+        /**
+         * Get the side length of a grid cell of the index.
+         * 
+         * @returns The side length of a grid cell.
+         */
+        u32 get_cell_size() const;
+
+        /**
+         * Get the number of indexed gates, i.e., of gates that have a location assigned.
+         * 
+         * @returns The number of indexed gates.
+         */
+        u32 get_num_placed_gates() const;
+
+        /**
+         * Get all placed gates within the given rectangle, bounds included.<br>
+         * The gates are returned in no particular order.
+         * 
+         * @param[in] min_x - The minimum x-coordinate of the rectangle.
+         * @param[in] min_y - The minimum y-coordinate of the rectangle.
+         * @param[in] max_x - The maximum x-coordinate of the rectangle.
+         * @param[in] max_y - The maximum y-coordinate of the rectangle.
+         * @returns The gates within the rectangle.
+         */
+        std::vector<Gate*> get_gates_in_area(i32 min_x, i32 min_y, i32 max_x, i32 max_y) const;
+
+        /**
+         * Get the `k` placed gates closest to the given location in terms of Euclidean distance.<br>
+         * The gates are ordered by increasing distance, gates with equal distance are ordered by ID.
+         * 
+         * @param[in] x - The x-coordinate of the location.
+         * @param[in] y - The y-coordinate of the location.
+         * @param[in] k - The maximum number of gates to return.
+         * @returns The `k` closest gates.
+         */
+        std::vector<Gate*> get_nearest_gates(i32 x, i32 y, u32 k) const;
+
+        /**
+         * Get the `k` placed gates closest to the given gate in terms of Euclidean distance, excluding the gate itself.<br>
+         * The gates are ordered by increasing distance, gates with equal distance are ordered by ID.
+         * 
+         * @param[in] gate - The gate.
+         * @param[in] k - The maximum number of gates to return.
+         * @returns The `k` closest gates on success, an error otherwise.
+         */
+        Result<std::vector<Gate*>> get_nearest_gates(const Gate* gate, u32 k) const;
+
+    private:
+        struct IndexedGate
+        {
+            Gate* gate;
+            i32 x;
+            i32 y;
+        };
+
+        const Netlist& m_netlist;
+        std::string m_callback_name;
+
+        u32 m_cell_size = 1;
+        std::unordered_map<u64, std::vector<IndexedGate>> m_cells;
+        std::unordered_map<const Gate*, std::pair<i32, i32>> m_locations;
+
+        // bounds of all cells that have ever been occupied
+        i64 m_min_cell_x = 0;
+        i64 m_min_cell_y = 0;
+        i64 m_max_cell_x = -1;
+        i64 m_max_cell_y = -1;
+
+        void insert_gate(Gate* gate);
+        void erase_gate(const Gate* gate);
+        void handle_gate_event(GateEvent::event e, Gate* gate);
+        std::vector<Gate*> find_nearest_gates(i32 x, i32 y, u32 k, const Gate* excluded_gate) const;
+    };
+}    // namespace hal
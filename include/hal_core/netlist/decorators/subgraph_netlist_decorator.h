@@ -133,6 +133,42 @@ namespace hal
          */
         Result<BooleanFunction> get_subgraph_function(const Module* subgraph_module, const Net* subgraph_output) const;
 
+        /**
+         * Get the combined Boolean functions of a subgraph of combinational gates starting at the sources of each of the provided subgraph output nets.
+         * The variables of the resulting Boolean functions are created from the subgraph input nets using `BooleanFunctionNetDecorator::get_boolean_variable`.
+         * The function of every gate within the cones of the outputs is built only once and gates that do not depend on each other are processed concurrently.
+         * The results match those of `get_subgraph_function` for each individual output net.
+         * 
+         * @param[in] subgraph_gates - The gates making up the subgraph to consider.
+         * @param[in] subgraph_outputs - The subgraph output nets for which to generate the Boolean functions.
+         * @return The combined Boolean functions of the subgraph in the order of the output nets on success, an error otherwise.
+         */
+        Result<std::vector<BooleanFunction>> get_subgraph_functions(const std::vector<const Gate*>& subgraph_gates, const std::vector<const Net*>& subgraph_outputs) const;
+
+        /**
+         * Get the combined Boolean functions of a subgraph of combinational gates starting at the sources of each of the provided subgraph output nets.
+         * The variables of the resulting Boolean functions are created from the subgraph input nets using `BooleanFunctionNetDecorator::get_boolean_variable`.
+         * The function of every gate within the cones of the outputs is built only once and gates that do not depend on each other are processed concurrently.
+         * The results match those of `get_subgraph_function` for each individual output net.
+         * 
+         * @param[in] subgraph_gates - The gates making up the subgraph to consider.
+         * @param[in] subgraph_outputs - The subgraph output nets for which to generate the Boolean functions.
+         * @return The combined Boolean functions of the subgraph in the order of the output nets on success, an error otherwise.
+         */
+        Result<std::vector<BooleanFunction>> get_subgraph_functions(const std::vector<Gate*>& subgraph_gates, const std::vector<const Net*>& subgraph_outputs) const;
+
+        /**
+         * Get the combined Boolean functions of a subgraph of combinational gates starting at the sources of each of the provided subgraph output nets.
+         * The variables of the resulting Boolean functions are created from the subgraph input nets using `BooleanFunctionNetDecorator::get_boolean_variable`.
+         * The function of every gate within the cones of the outputs is built only once and gates that do not depend on each other are processed concurrently.
+         * The results match those of `get_subgraph_function` for each individual output net.
+         * 
+         * @param[in] subgraph_module - The module making up the subgraph to consider.
+         * @param[in] subgraph_outputs - The subgraph output nets for which to generate the Boolean functions.
+         * @return The combined Boolean functions of the subgraph in the order of the output nets on success, an error otherwise.
+         */
+        Result<std::vector<BooleanFunction>> get_subgraph_functions(const Module* subgraph_module, const std::vector<const Net*>& subgraph_outputs) const;
+
         /**
          * Get the inputs of the combined Boolean function of a subgraph of combinational gates starting at the source of the provided subgraph output net.
          * This does not actually build the boolean function but only determines the inputs the subgraph function would have, which is a lot faster.
@@ -0,0 +1,83 @@
+// MIT License
+//
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+#include "hal_core/utilities/result.h"
+
+#include <filesystem>
+#include <memory>
+
+namespace hal
+{
+    class GateLibrary;
+
+    /**
+     * The gate library cache stores parsed gate libraries in a versioned binary format next to the library file, so that they can be restored without parsing the library again.
+     * A cache file is only used if its format version and the HAL version that created it match and the content hash of the library file is unchanged.
+     * If the directory of the library is not writable, the cache is stored within the user share directory instead.
+     *
+     * @ingroup gate_lib
+     */
+    namespace gate_library_cache
+    {
+        /**
+         * The version of the binary cache format, increment on any change to the format.<br>
+         * Changes to the gate library parsers are covered by the HAL version that is stored alongside.
+         */
+        constexpr u32 CACHE_FORMAT_VERSION = 2;
+
+        /**
+         * The file extension of gate library cache files.
+         */
+        constexpr const char* CACHE_FILE_EXTENSION = ".glcache";
+
+        /**
+         * Check whether a file is a gate library cache file.
+         *
+         * @param[in] file_path - The file path.
+         * @returns True if the file is a cache file, false otherwise.
+         */
+        NETLIST_API bool is_cache_file(const std::filesystem::path& file_path);
+
+        /**
+         * Restore a gate library from its cache.
+         *
+         * @param[in] file_path - The path to the gate library file (not the cache file).
+         * @returns The gate library on success, an error if there is no valid cache for the gate library file.
+         */
+        NETLIST_API Result<std::unique_ptr<GateLibrary>> load(const std::filesystem::path& file_path);
+
+        /**
+         * Store a gate library within the cache of its gate library file.
+         *
+         * @param[in] gate_lib - The gate library as returned by the gate library parser.
+         * @param[in] file_path - The path to the gate library file (not the cache file).
+         * @returns Ok() on success, an error otherwise.
+         */
+        NETLIST_API Result<std::monostate> save(const GateLibrary* gate_lib, const std::filesystem::path& file_path);
+    }    // namespace gate_library_cache
+}    // namespace hal
@@ -28,6 +28,8 @@
 #include "hal_core/defines.h"
 
 #include <filesystem>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace hal
@@ -105,5 +107,14 @@ namespace hal
          */
         NETLIST_API std::vector<GateLibrary*> get_gate_libraries();
 
+        /**
+         * Get all loaded gate libraries that contain at least one of the given gate types, ordered by the number of contained gate types in descending order.
+         * Gate type names are compared case-insensitively using an index that is maintained while loading gate libraries.
+         *
+         * @param[in] gate_types - The names of the gate types.
+         * @returns A vector of pairs of gate libraries and the number of given gate types they contain.
+         */
+        NETLIST_API std::vector<std::pair<GateLibrary*, u32>> get_gate_libraries_by_gate_types(const std::set<std::string>& gate_types);
+
     }    // namespace gate_library_manager
 }    // namespace hal
@@ -30,12 +30,50 @@
 #include "hal_core/utilities/result.h"
 
 #include <filesystem>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace hal
 {
     /* forward declaration*/
     class GateLibrary;
 
+    /**
+     * Summary of the differences between a netlist and its updated version, see NetlistParser::update.
+     * Modules are identified by their names.
+     *
+     * @ingroup netlist_parser
+     */
+    struct NetlistUpdateReport
+    {
+        /**
+         * Modules whose definition, including the definitions of all their submodules, is unchanged.
+         */
+        std::vector<std::string> unchanged_modules;
+
+        /**
+         * Modules that exist in both versions but whose definition or the definition of one of their submodules has changed.
+         * Parsers that cannot tell report all modules existing in both versions as changed.
+         */
+        std::vector<std::string> changed_modules;
+
+        /**
+         * Modules that only exist in the updated version.
+         */
+        std::vector<std::string> added_modules;
+
+        /**
+         * Modules that only exist in the previous version.
+         */
+        std::vector<std::string> removed_modules;
+
+        /**
+         * Whether the entire netlist has been instantiated from scratch instead of being updated incrementally.
+         */
+        bool full_rebuild = false;
+    };
+
     /**
      * @ingroup netlist_parser
      */
@@ -55,12 +93,36 @@ namespace hal
 
         /**
          * Instantiate the parsed netlist using the specified gate library.
+         * Implementations must leave the intermediate format untouched, as this function may be called concurrently for different gate libraries once parsing has finished.
          *
          * @param[in] gate_library - The gate library.
          * @returns A pointer to the resulting netlist.
          */
         virtual Result<std::unique_ptr<Netlist>> instantiate(const GateLibrary* gate_library) = 0;
 
+        /**
+         * Get the types of all instances within the parsed netlist that do not refer to modules defined within the netlist itself, i.e., the gate types required for instantiation.
+         * Used to select a suitable gate library without instantiating the netlist.
+         * An empty set indicates that the parser does not provide this information.
+         *
+         * @returns The set of required gate type names.
+         */
+        virtual std::set<std::string> get_required_gate_types() const
+        {
+            return {};
+        }
+
+        /**
+         * Update a netlist to the parsed version of its netlist file, e.g., after an engineering change order.
+         * The gate library of the given netlist is used for instantiation.
+         * Parsers that are able to do so reuse all unchanged parts of the netlist and only rebuild the changed ones, the default implementation instantiates the entire netlist from scratch.
+         * Either way, the result is equivalent to a freshly instantiated netlist apart from the IDs of the netlist elements.
+         *
+         * @param[in] netlist - The netlist to update, it is consumed by the update.
+         * @returns The updated netlist and a report on the differences to the previous version.
+         */
+        virtual Result<std::pair<std::unique_ptr<Netlist>, NetlistUpdateReport>> update(std::unique_ptr<Netlist> netlist);
+
         /**
          * Parse and instantiate a netlist using the specified gate library.
          *
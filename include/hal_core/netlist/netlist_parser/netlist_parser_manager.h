@@ -97,6 +97,16 @@ namespace hal
          */
         std::vector<std::unique_ptr<Netlist>> parse_all(const std::filesystem::path& file_name);
 
+        /**
+         * Update a netlist to a new version of its HDL file, reusing unchanged parts of the netlist where the parser supports it.
+         * The gate library of the given netlist is used.
+         *
+         * @param[in] netlist - The netlist to update, it is consumed by the update.
+         * @param[in] file_name - The new version of the HDL file.
+         * @returns The updated netlist and a report on the differences to the previous version, or an error.
+         */
+        NETLIST_API Result<std::pair<std::unique_ptr<Netlist>, NetlistUpdateReport>> update(std::unique_ptr<Netlist> netlist, const std::filesystem::path& file_name);
+
         /**
          * Checks whether there is a parser registered for file extension
          * @param file_name - The input file
@@ -134,6 +134,7 @@ namespace hal
          * The use of the this cached version is recommended in case of extensive usage to improve performance. 
          * The cache will be filled by this function and should initially be provided empty.
          * Different caches for different values of get_successors shall be used.
+         * For repeated queries on flip-flops, `SequentialNetlistDecorator` provides an index that is kept up to date on netlist changes.
          *
          * @param[in] gate - The initial gate.
          * @param[in] get_successors - If true, sequential successors are returned, otherwise sequential predecessors are returned.
@@ -35,6 +35,8 @@
 #include "hal_core/netlist/decorators/boolean_function_net_decorator.h"
 #include "hal_core/netlist/decorators/subgraph_netlist_decorator.h"
 #include "hal_core/netlist/decorators/netlist_modification_decorator.h"
+#include "hal_core/netlist/decorators/sequential_netlist_decorator.h"
+#include "hal_core/netlist/decorators/spatial_netlist_decorator.h"
 #include "hal_core/netlist/gate.h"
 #include "hal_core/netlist/gate_library/enums/async_set_reset_behavior.h"
 #include "hal_core/netlist/gate_library/gate_library.h"
@@ -319,6 +321,20 @@ namespace hal
      */
     void netlist_modification_decorator_init(py::module& m);
 
+    /**
+     * Initializes Python bindings for the HAL spatial netlist decorator in a python module.
+     *
+     * @param[in] m - the python module
+     */
+    void spatial_netlist_decorator_init(py::module& m);
+
+    /**
+     * Initializes Python bindings for the HAL sequential netlist decorator in a python module.
+     *
+     * @param[in] m - the python module
+     */
+    void sequential_netlist_decorator_init(py::module& m);
+
     /**
      * Initializes Python bindings for the HAL LogManager in a python module.
      *
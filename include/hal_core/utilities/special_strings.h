@@ -25,7 +25,11 @@
 
 #pragma once
 
+#include "hal_core/utilities/utils.h"
+
+#include <cctype>
 #include <string>
+#include <string_view>
 
 namespace hal
 {
@@ -51,7 +55,7 @@ namespace hal
             }
             else
             {
-                return S(str.data());
+                return S(str.data(), str.size());
             }
         }
 
@@ -141,23 +145,45 @@ namespace hal
         };
 
         using CaseInsensitiveString = std::basic_string<char, CaseInsensitiveCharTraits>;
+
+        using CaseInsensitiveStringView = std::basic_string_view<char, CaseInsensitiveCharTraits>;
     }    // namespace core_strings
 }    // namespace hal
 
 namespace std
 {
+    template<>
+    struct hash<hal::core_strings::CaseInsensitiveStringView>
+    {
+        /**
+         * Hashes the given string, strings that only differ in case yield the same hash value.
+         * 
+         * @param[in] s - The string to hash.
+         * @returns The hash value.
+         */
+        std::size_t operator()(const hal::core_strings::CaseInsensitiveStringView& s) const
+        {
+            u64 hash = hal::utils::FNV1A_OFFSET_BASIS;
+            for (char c : s)
+            {
+                hash = hal::utils::fnv1a_hash(hash, (u8)toupper(c));
+            }
+            return hash;
+        }
+    };
+
     template<>
     struct hash<hal::core_strings::CaseInsensitiveString>
     {
         /**
-         * Hashes the given string.
+         * Hashes the given string, strings that only differ in case yield the same hash value.
          * 
          * @param[in] s - The string to hash.
          * @returns The hash value.
          */
         std::size_t operator()(const hal::core_strings::CaseInsensitiveString& s) const
         {
-            return std::hash<std::string>{}(std::string(s.data()));
+            return std::hash<hal::core_strings::CaseInsensitiveStringView>{}(s);
         }
     };
 
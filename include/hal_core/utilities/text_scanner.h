@@ -0,0 +1,149 @@
+// MIT License
+// 
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+
+#include <array>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hal
+{
+    /**
+     * A read-only text file that is memory-mapped where supported and read into memory otherwise.<br>
+     * The text remains valid until the file is closed or the object is destroyed, so tokens may reference it directly.
+     * 
+     * @ingroup utilities
+     */
+    class CORE_API MappedTextFile
+    {
+    public:
+        MappedTextFile() = default;
+        ~MappedTextFile();
+
+        MappedTextFile(const MappedTextFile&) = delete;
+        MappedTextFile& operator=(const MappedTextFile&) = delete;
+
+        /**
+         * Open a file and make its content available as text.<br>
+         * A previously opened file is closed first.
+         *
+         * @param[in] path - The path to the file.
+         * @returns True on success, false otherwise.
+         */
+        bool open(const std::filesystem::path& path);
+
+        /**
+         * Release the text of the file.
+         */
+        void close();
+
+        /**
+         * Get the text of the file.
+         *
+         * @returns A view on the entire file content.
+         */
+        std::string_view get_text() const;
+
+    private:
+        const char* m_data = nullptr;
+        size_t m_size      = 0;
+        bool m_mapped      = false;
+        std::string m_buffer;
+    };
+
+    /**
+     * A set of characters that can be searched for in a text.<br>
+     * The search processes 16 characters at a time if SSE2 is available.
+     * 
+     * @ingroup utilities
+     */
+    class CORE_API CharacterSet
+    {
+    public:
+        /**
+         * Construct a character set.
+         *
+         * @param[in] characters - The characters of the set.
+         * @param[in] include_whitespace - Set to true to add all whitespace characters to the set.
+         */
+        CharacterSet(const std::string& characters, bool include_whitespace = false);
+
+        /**
+         * Check whether the set contains a character.
+         *
+         * @param[in] c - The character.
+         * @returns True if the character is contained in the set, false otherwise.
+         */
+        bool contains(char c) const
+        {
+            return m_table[static_cast<u8>(c)];
+        }
+
+        /**
+         * Find the first character within a range of text that is contained in the set.
+         *
+         * @param[in] begin - The start of the text.
+         * @param[in] end - The end of the text.
+         * @returns A pointer to the first matching character or 'end' if there is none.
+         */
+        const char* find_first(const char* begin, const char* end) const;
+
+    private:
+        std::array<bool, 256> m_table;
+        std::vector<char> m_characters;
+    };
+
+    /**
+     * Stable storage for strings that do not exist in a text buffer, e.g., tokens assembled from several parts.<br>
+     * Views on stored strings remain valid until the arena is cleared or destroyed.
+     * 
+     * @ingroup utilities
+     */
+    class CORE_API StringArena
+    {
+    public:
+        /**
+         * Store a string.
+         *
+         * @param[in] s - The string to store.
+         * @returns A view on the stored string.
+         */
+        std::string_view store(std::string&& s);
+
+        /**
+         * Release all stored strings.
+         */
+        void clear();
+
+    private:
+        std::deque<std::string> m_strings;
+    };
+}    // namespace hal
@@ -29,6 +29,8 @@
 
 #include <algorithm>
 #include <map>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace hal
@@ -117,7 +119,27 @@ namespace hal
     };
 
     /**
-     * A token stream comprises a sequence of tokens that may, for example, have been read from a file.
+     * Maps the string type of a token to a string type owning its characters.
+     * Views are mapped to the corresponding string type, all other types are kept.
+     * 
+     * @ingroup utilities
+     */
+    template<typename T>
+    struct TokenOwningString
+    {
+        using type = T;
+    };
+
+    template<typename CharT, typename Traits>
+    struct TokenOwningString<std::basic_string_view<CharT, Traits>>
+    {
+        using type = std::basic_string<CharT, Traits>;
+    };
+
+    /**
+     * A token stream comprises a sequence of tokens that may, for example, have been read from a file.<br>
+     * Besides owning strings, tokens may hold std::string_view instances referencing a buffer that outlives the stream.
+     * Such view-based streams copy only the views, while messages and joined tokens are returned as owning strings.
      * 
      * @ingroup utilities
      */
@@ -125,6 +147,11 @@ namespace hal
     class NETLIST_API TokenStream
     {
     public:
+        /**
+         * The string type owning its characters, used for messages and joined tokens.
+         */
+        using owning_string_t = typename TokenOwningString<T>::type;
+
         /**
          * The exception that is raised on any kind of error that occurs while working on the tokens of the stream.
          */
@@ -133,7 +160,7 @@ namespace hal
             /**
              * The message that is displayed to the user.
              */
-            T message;
+            owning_string_t message;
 
             /**
              * The affected line number.
@@ -174,6 +201,22 @@ namespace hal
             : TokenStream(increase_level_tokens, decrease_level_tokens)
         {
             m_data = init;
+            own_data();
+        }
+
+        /**
+         * Construct a token stream by taking over a vector of tokens.<br>
+         * The increase-level and decrease-level tokens are used for level-aware iteration. If active, all operations are only executed on tokens on level 0.
+         *
+         * @param[in] init - The vector of tokens.
+         * @param[in] decrease_level_tokens - A vector of tokens that mark the start of a new level, i.e., increase the level.
+         * @param[in] increase_level_tokens - A vector of tokens that mark the end of a level, i.e., decrease the level.
+         */
+        TokenStream(std::vector<Token<T>>&& init, const std::vector<T>& increase_level_tokens = {"("}, const std::vector<T>& decrease_level_tokens = {")"})
+            : TokenStream(increase_level_tokens, decrease_level_tokens)
+        {
+            m_data = std::move(init);
+            own_data();
         }
 
         /**
@@ -184,9 +227,21 @@ namespace hal
         TokenStream(const TokenStream<T>& other)
         {
             m_pos                   = other.m_pos;
-            m_data                  = other.m_data;
+            m_data                  = std::vector<Token<T>>(other.m_tokens, other.m_tokens + other.m_size);
             m_increase_level_tokens = other.m_increase_level_tokens;
             m_decrease_level_tokens = other.m_decrease_level_tokens;
+            own_data();
+        }
+
+        /**
+         * Construct a token stream by taking over another one (i.e., move constructor).<br>
+         * A sub-stream remains a sub-stream of the same tokens.
+         *
+         * @param[in] other - The token stream to take over.
+         */
+        TokenStream(TokenStream<T>&& other) noexcept
+        {
+            *this = std::move(other);
         }
 
         /**
@@ -197,13 +252,61 @@ namespace hal
          */
         TokenStream<T>& operator=(const TokenStream<T>& other)
         {
-            m_pos                   = other.m_pos;
-            m_data                  = other.m_data;
-            m_increase_level_tokens = other.m_increase_level_tokens;
-            m_decrease_level_tokens = other.m_decrease_level_tokens;
+            if (this != &other)
+            {
+                m_pos                   = other.m_pos;
+                m_data                  = std::vector<Token<T>>(other.m_tokens, other.m_tokens + other.m_size);
+                m_increase_level_tokens = other.m_increase_level_tokens;
+                m_decrease_level_tokens = other.m_decrease_level_tokens;
+                own_data();
+            }
             return *this;
         }
 
+        /**
+         * Assign a token stream by taking over another one.<br>
+         * A sub-stream remains a sub-stream of the same tokens.
+         *
+         * @param[in] other - The token stream.
+         * @returns A reference to the token stream.
+         */
+        TokenStream<T>& operator=(TokenStream<T>&& other) noexcept
+        {
+            if (this != &other)
+            {
+                // the buffer of a moved vector is taken over, hence the token pointer stays valid
+                m_pos                   = other.m_pos;
+                m_data                  = std::move(other.m_data);
+                m_tokens                = other.m_tokens;
+                m_size                  = other.m_size;
+                m_increase_level_tokens = std::move(other.m_increase_level_tokens);
+                m_decrease_level_tokens = std::move(other.m_decrease_level_tokens);
+                other.m_data.clear();
+                other.own_data();
+                other.m_pos = 0;
+            }
+            return *this;
+        }
+
+        /**
+         * Get a stream of the tokens in the absolute range [begin, end) of this stream without copying them.<br>
+         * The sub-stream refers to the tokens of this stream, hence this stream must outlive the sub-stream and its tokens must not be modified meanwhile.<br>
+         * Copying a sub-stream copies its tokens.
+         *
+         * @param[in] begin - The absolute position of the first token of the sub-stream.
+         * @param[in] end - The absolute position behind the last token of the sub-stream.
+         * @returns The sub-stream.
+         */
+        TokenStream<T> sub_stream(u32 begin, u32 end)
+        {
+            TokenStream<T> res(m_increase_level_tokens, m_decrease_level_tokens);
+            begin        = std::min(begin, m_size);
+            end          = std::min(std::max(begin, end), m_size);
+            res.m_tokens = m_tokens + begin;
+            res.m_size   = end - begin;
+            return res;
+        }
+
         /**
          * Consume the next token(s) in the stream.<br>
          * Advances the stream by the given number and returns the last consumed token.
@@ -233,7 +336,7 @@ namespace hal
             {
                 if (throw_on_error)
                 {
-                    throw TokenStreamException({"expected Token '" + expected + "' but reached the end of the stream", get_current_line_number()});
+                    throw TokenStreamException({"expected Token '" + owning_string_t(expected) + "' but reached the end of the stream", get_current_line_number()});
                 }
                 return false;
             }
@@ -242,7 +345,7 @@ namespace hal
             {
                 if (throw_on_error)
                 {
-                    throw TokenStreamException({"expected Token '" + expected + "' but got '" + at(m_pos).string + "'", get_current_line_number()});
+                    throw TokenStreamException({"expected Token '" + owning_string_t(expected) + "' but got '" + owning_string_t(at(m_pos).string) + "'", get_current_line_number()});
                 }
                 return false;
             }
@@ -268,7 +371,7 @@ namespace hal
             auto found = find_next(expected, end, level_aware);
             if (found > size() && throw_on_error)
             {
-                throw TokenStreamException({"expected Token '" + expected + "' not found", get_current_line_number()});
+                throw TokenStreamException({"expected Token '" + owning_string_t(expected) + "' not found", get_current_line_number()});
             }
             m_pos = std::min(size(), found);
             return at(m_pos - 1);
@@ -310,12 +413,12 @@ namespace hal
             auto found = find_next(expected, end, level_aware);
             if (found > size() && throw_on_error)
             {
-                throw TokenStreamException({"expected Token '" + expected + "' not found", get_current_line_number()});
+                throw TokenStreamException({"expected Token '" + owning_string_t(expected) + "' not found", get_current_line_number()});
             }
             auto end_pos = std::min(size(), found);
             TokenStream res(m_increase_level_tokens, m_decrease_level_tokens);
-            res.m_data.reserve(res.m_data.size() + (end_pos - m_pos));
-            res.m_data.insert(res.m_data.begin(), m_data.begin() + m_pos, m_data.begin() + end_pos);
+            res.m_data.assign(m_tokens + m_pos, m_tokens + end_pos);
+            res.own_data();
             m_pos = end_pos;
             return res;
         }
@@ -335,23 +438,23 @@ namespace hal
          * @param[in] throw_on_error - If true, throws an TokenStreamException instead of returning false on error.
          * @returns The joined token.
          */
-        Token<T> join_until(const T& match, const T& joiner, u32 end = END_OF_STREAM, bool level_aware = true, bool throw_on_error = false)
+        Token<owning_string_t> join_until(const T& match, const T& joiner, u32 end = END_OF_STREAM, bool level_aware = true, bool throw_on_error = false)
         {
             u32 start_line = get_current_line_number();
             auto found     = find_next(match, end, level_aware);
             if (found > size() && throw_on_error)
             {
-                throw TokenStreamException({"match Token '" + match + "' not found", start_line});
+                throw TokenStreamException({"match Token '" + owning_string_t(match) + "' not found", start_line});
             }
             auto end_pos = std::min(size(), found);
-            T result;
+            owning_string_t result;
             while (m_pos < end_pos && remaining() > 0)
             {
                 if (!result.empty())
                 {
                     result += joiner;
                 }
-                result += consume();
+                result += consume().string;
             }
             return {start_line, result};
         }
@@ -364,17 +467,17 @@ namespace hal
          * @param[in] joiner - The string used to join consumed tokens.
          * @returns The joined token.
          */
-        Token<T> join(const T& joiner)
+        Token<owning_string_t> join(const T& joiner)
         {
             u32 start_line = get_current_line_number();
-            T result;
+            owning_string_t result;
             while (remaining() > 0)
             {
                 if (!result.empty())
                 {
                     result += joiner;
                 }
-                result += consume();
+                result += consume().string;
             }
             return {start_line, result};
         }
@@ -414,11 +517,11 @@ namespace hal
          */
         Token<T>& at(u32 position)
         {
-            if (position >= m_data.size())
+            if (position >= m_size)
             {
                 throw TokenStreamException({"reached the end of the stream", get_current_line_number()});
             }
-            return m_data[position];
+            return m_tokens[position];
         }
 
         /**
@@ -426,11 +529,11 @@ namespace hal
          */
         const Token<T>& at(u32 position) const
         {
-            if (position >= m_data.size())
+            if (position >= m_size)
             {
                 throw TokenStreamException({"reached the end of the stream", get_current_line_number()});
             }
-            return m_data[position];
+            return m_tokens[position];
         }
 
         /**
@@ -473,7 +576,7 @@ namespace hal
          */
         u32 size() const
         {
-            return m_data.size();
+            return m_size;
         }
 
         /**
@@ -519,18 +622,31 @@ namespace hal
     private:
         std::vector<T> m_increase_level_tokens;
         std::vector<T> m_decrease_level_tokens;
+
+        // the tokens owned by the stream, empty for sub-streams
         std::vector<Token<T>> m_data;
+
+        // the tokens of the stream, i.e., the owned tokens or a range of the tokens of another stream for sub-streams
+        Token<T>* m_tokens = nullptr;
+        u32 m_size         = 0;
+
         u32 m_pos;
 
+        void own_data()
+        {
+            m_tokens = m_data.data();
+            m_size   = m_data.size();
+        }
+
         u32 get_current_line_number() const
         {
-            if (m_pos < m_data.size())
+            if (m_pos < m_size)
             {
-                return m_data[m_pos].number;
+                return m_tokens[m_pos].number;
             }
-            else if (!m_data.empty())
+            else if (m_size > 0)
             {
-                return m_data.back().number;
+                return m_tokens[m_size - 1].number;
             }
             return END_OF_STREAM;
         }
@@ -32,10 +32,12 @@
 #include "hal_core/defines.h"
 #include "hal_core/utilities/result.h"
 
+#include <atomic>
 #include <functional>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -530,6 +532,15 @@ namespace hal
          */
         CORE_API bool folder_exists_and_is_accessible(const std::filesystem::path& path);
 
+        /**
+         * Get a path next to the given file that no other process or thread uses as temporary file at the same time.<br>
+         * Writing to this path and renaming it to the given file afterwards replaces the file atomically.
+         *
+         * @param[in] path - The file that is going to be replaced.
+         * @returns The temporary path.
+         */
+        CORE_API std::filesystem::path get_unique_temp_path(const std::filesystem::path& path);
+
         /**
          * Locate an executable in the given path environment.
          *
@@ -763,5 +774,99 @@ namespace hal
          * @returns OK and an integer on success, an ERROR otherwise.
          */
         CORE_API Result<u32> wrapped_stoul(const std::string& s);
+
+        /**
+         * Get the number of threads that process the given number of work items in parallel.<br>
+         * This is the requested number of threads, or the number of available cores if none is requested, limited to the number of work items but at least one.
+         *
+         * @param[in] count - The number of work items.
+         * @param[in] num_threads - The requested number of threads, `0` to use all available cores.
+         * @returns The number of threads.
+         */
+        CORE_API u32 get_num_parallel_threads(u32 count, u32 num_threads = 0);
+
+        /**
+         * Calls a function for all indices in [0, count) in parallel and additionally passes the index of the calling thread in [0, get_num_parallel_threads(count, num_threads)), e.g., to access buffers owned by that thread.<br>
+         * Indices are handed out one at a time, hence the work per index may vary greatly.
+         *
+         * @param[in] count - The number of indices.
+         * @param[in] num_threads - The requested number of threads, `0` to use all available cores.
+         * @param[in] func - The function called as `func(thread_index, index)`.
+         */
+        template<typename F>
+        void parallel_for_with_thread_index(u32 count, u32 num_threads, const F& func)
+        {
+            num_threads = get_num_parallel_threads(count, num_threads);
+
+            std::atomic<u32> next(0);
+            auto worker = [&next, &func, count](u32 thread_index) {
+                for (u32 i = next++; i < count; i = next++)
+                {
+                    func(thread_index, i);
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (u32 t = 1; t < num_threads; t++)
+            {
+                threads.emplace_back(worker, t);
+            }
+
+            worker(0);
+
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+        }
+
+        /**
+         * Calls a function for all indices in [0, count) in parallel.<br>
+         * Indices are handed out one at a time, hence the work per index may vary greatly.
+         *
+         * @param[in] count - The number of indices.
+         * @param[in] func - The function called as `func(index)`.
+         * @param[in] num_threads - The requested number of threads, `0` to use all available cores.
+         */
+        template<typename F>
+        void parallel_for(u32 count, const F& func, u32 num_threads = 0)
+        {
+            parallel_for_with_thread_index(count, num_threads, [&func](u32, u32 i) { func(i); });
+        }
+
+        /**
+         * The 64-bit FNV-1a hash of empty data, i.e., the initial value when hashing data.
+         */
+        constexpr u64 FNV1A_OFFSET_BASIS = 0xcbf29ce484222325ull;
+
+        /**
+         * Extends a 64-bit FNV-1a hash by a single byte.
+         *
+         * @param[in] hash - The hash of the preceding data.
+         * @param[in] byte - The byte.
+         * @returns The extended hash.
+         */
+        constexpr u64 fnv1a_hash(u64 hash, u8 byte)
+        {
+            return (hash ^ byte) * 0x100000001b3ull;
+        }
+
+        /**
+         * Extends a 64-bit FNV-1a hash by the given data.
+         *
+         * @param[in] hash - The hash of the preceding data.
+         * @param[in] data - The data.
+         * @param[in] size - The size of the data in bytes.
+         * @returns The extended hash.
+         */
+        inline u64 fnv1a_hash(u64 hash, const void* data, size_t size)
+        {
+            const u8* bytes = static_cast<const u8*>(data);
+            for (size_t i = 0; i < size; i++)
+            {
+                hash = fnv1a_hash(hash, bytes[i]);
+            }
+            return hash;
+        }
     }    // namespace utils
 }    // namespace hal
@@ -0,0 +1,171 @@
+// MIT License
+//
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+#include "hal_core/utilities/result.h"
+
+#include <igraph/igraph.h>
+#include <map>
+#include <set>
+
+namespace hal
+{
+    /* forward declaration */
+    class Gate;
+    class Module;
+    class Netlist;
+
+    /**
+     * A directed graph of the gates of a netlist stored in compressed sparse row (CSR) format.
+     * Each gate is a vertex and each connection from a source of a net to one of its destinations is an edge.
+     * Vertices are numbered consecutively by gate ID starting at 0, so per-vertex data can be stored in plain vectors.
+     *
+     * The graph is a snapshot of the netlist that is built once and can then be shared by any number of algorithms.
+     * It is not updated when the netlist changes.
+     */
+    class PLUGIN_API NetlistGraph
+    {
+    public:
+        /**
+         * Create a graph from the gates of a netlist.
+         * The graph can be restricted to the combinational gates of the netlist and to the gates of a module including all of its submodules.
+         * Edges are only created between gates that are both part of the graph.
+         *
+         * @param[in] netlist - The netlist to operate on.
+         * @param[in] combinational_only - Set `true` to only consider combinational gates, `false` to consider all gates. Defaults to `false`.
+         * @param[in] module - The module to restrict the graph to or `nullptr` to consider the entire netlist. Defaults to `nullptr`.
+         * @returns The graph on success, an error otherwise.
+         */
+        static Result<std::unique_ptr<NetlistGraph>> from_netlist(Netlist* netlist, bool combinational_only = false, const Module* module = nullptr);
+
+        /**
+         * Get the netlist the graph has been created from.
+         *
+         * @returns The netlist.
+         */
+        Netlist* get_netlist() const;
+
+        /**
+         * Get the number of vertices of the graph.
+         *
+         * @returns The number of vertices.
+         */
+        u32 get_num_vertices() const;
+
+        /**
+         * Get the number of edges of the graph.
+         *
+         * @returns The number of edges.
+         */
+        u32 get_num_edges() const;
+
+        /**
+         * Get the gates of the graph indexed by their vertex.
+         *
+         * @returns A vector mapping each vertex to its gate.
+         */
+        const std::vector<Gate*>& get_gates() const;
+
+        /**
+         * Get the gate of a vertex.
+         *
+         * @param[in] vertex - The vertex.
+         * @returns The gate on success, an error otherwise.
+         */
+        Result<Gate*> get_gate(u32 vertex) const;
+
+        /**
+         * Get the vertex of a gate.
+         *
+         * @param[in] gate - The gate.
+         * @returns The vertex on success, an error if the gate is not part of the graph.
+         */
+        Result<u32> get_vertex(const Gate* gate) const;
+
+        /**
+         * Get the offsets of the outgoing edges of all vertices.
+         * The targets of the outgoing edges of vertex `v` are stored at the positions `[offsets[v], offsets[v + 1])` of the vector returned by `get_out_edges`.
+         *
+         * @returns A vector of `get_num_vertices() + 1` offsets.
+         */
+        const std::vector<u32>& get_out_offsets() const;
+
+        /**
+         * Get the targets of the outgoing edges of all vertices ordered by their source vertex.
+         *
+         * @returns A vector of `get_num_edges()` target vertices.
+         */
+        const std::vector<u32>& get_out_edges() const;
+
+        /**
+         * Get the offsets of the incoming edges of all vertices.
+         * The sources of the incoming edges of vertex `v` are stored at the positions `[offsets[v], offsets[v + 1])` of the vector returned by `get_in_edges`.
+         *
+         * @returns A vector of `get_num_vertices() + 1` offsets.
+         */
+        const std::vector<u32>& get_in_offsets() const;
+
+        /**
+         * Get the sources of the incoming edges of all vertices ordered by their target vertex.
+         *
+         * @returns A vector of `get_num_edges()` source vertices.
+         */
+        const std::vector<u32>& get_in_edges() const;
+
+        /**
+         * Create an igraph graph with the same vertices and edges.
+         * The igraph graph has to be destroyed by the caller using `igraph_destroy`.
+         *
+         * @param[out] graph - The uninitialized igraph graph.
+         * @param[in] directed - Set `true` to create a directed graph, `false` to create an undirected one. Defaults to `true`.
+         * @returns Ok on success, an error otherwise.
+         */
+        Result<std::monostate> to_igraph(igraph_t* graph, bool directed = true) const;
+
+        /**
+         * Group the gates of the graph by the membership vector computed by an igraph algorithm on the graph created by `to_igraph`.
+         *
+         * @param[in] membership - The membership vector with one entry per vertex.
+         * @returns A map from membership ID to the set of gates that have the membership.
+         */
+        std::map<int, std::set<Gate*>> get_memberships(const igraph_vector_t* membership) const;
+
+    private:
+        NetlistGraph(Netlist* netlist);
+
+        Netlist* m_netlist;
+
+        // vertex to gate and gate ID to vertex
+        std::vector<Gate*> m_gates;
+        std::vector<u32> m_gate_id_to_vertex;
+
+        std::vector<u32> m_out_offsets;
+        std::vector<u32> m_out_edges;
+        std::vector<u32> m_in_offsets;
+        std::vector<u32> m_in_edges;
+    };
+}    // namespace hal
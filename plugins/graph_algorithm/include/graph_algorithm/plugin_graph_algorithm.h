@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include "graph_algorithm/netlist_graph.h"
 #include "hal_core/plugin_system/plugin_interface_base.h"
 
 #include <igraph/igraph.h>
@@ -34,6 +35,7 @@ namespace hal
     /* forward declaration */
     class Netlist;
     class Gate;
+    class Module;
     class Net;
 
     class PLUGIN_API GraphAlgorithmPlugin : public BasePluginInterface
@@ -75,6 +77,15 @@ namespace hal
          */
         std::map<int, std::set<Gate*>> get_communities(Netlist* const netlist);
 
+        /**
+         * Get a map of community IDs to communities of a netlist graph. Each community is represented by a set of gates.<br>
+         * In contrast to the netlist variant, leaves are not removed from the netlist beforehand.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @returns A map from community IDs to communities.
+         */
+        std::map<int, std::set<Gate*>> get_communities(const NetlistGraph* graph);
+
         /**
          * Get a map of community IDs to communities running the spinglass clustering algorithm. Each community is represented by a set of gates.
          *
@@ -84,6 +95,15 @@ namespace hal
          */
         std::map<int, std::set<Gate*>> get_communities_spinglass(Netlist* const netlist, u32 const spins);
 
+        /**
+         * Get a map of community IDs to communities of a netlist graph running the spinglass clustering algorithm. Each community is represented by a set of gates.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @param[in] spins - The number of spins.
+         * @returns A map from community IDs to communities.
+         */
+        std::map<int, std::set<Gate*>> get_communities_spinglass(const NetlistGraph* graph, u32 const spins);
+
         /**
          * Get a map of community IDs to communities running the fast greedy clustering algorithm from igraph. Each community is represented by a set of gates.
          *
@@ -92,6 +112,68 @@ namespace hal
          */
         std::map<int, std::set<Gate*>> get_communities_fast_greedy(Netlist* const netlist);
 
+        /**
+         * Get a map of community IDs to communities of a netlist graph running the fast greedy clustering algorithm from igraph. Each community is represented by a set of gates.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @returns A map from community IDs to communities.
+         */
+        std::map<int, std::set<Gate*>> get_communities_fast_greedy(const NetlistGraph* graph);
+
+        /**
+         * Get a map of community IDs to communities running a parallel implementation of the Louvain clustering algorithm. Each community is represented by a set of gates.<br>
+         * The netlist is treated as an undirected graph in which every connection between two gates has a weight of 1.
+         *
+         * @param[in] netlist - The netlist to operate on.
+         * @param[in] seed - The seed that determines the order in which vertices are moved between communities.
+         * @param[in] max_passes - The maximum number of passes, or 0 to run until no vertex changes its community anymore.
+         * @param[in] time_limit - The time in seconds after which the current communities are returned, or 0 for no limit.
+         * @returns A map from community IDs to communities.
+         */
+        std::map<int, std::set<Gate*>> get_communities_louvain(Netlist* netlist, u32 seed = 0, u32 max_passes = 0, double time_limit = 0.0);
+
+        /**
+         * Get a map of community IDs to communities of a netlist graph running a parallel implementation of the Louvain clustering algorithm. Each community is represented by a set of gates.<br>
+         * The algorithm is described in more detail at get_community_ids_louvain.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @param[in] edge_weights - The weight of every edge of the graph, or an empty vector to weight all edges equally.
+         * @param[in] seed - The seed that determines the order in which vertices are moved between communities.
+         * @param[in] max_passes - The maximum number of passes, or 0 to run until no vertex changes its community anymore.
+         * @param[in] time_limit - The time in seconds after which the current communities are returned, or 0 for no limit.
+         * @returns A map from community IDs to communities.
+         */
+        std::map<int, std::set<Gate*>>
+            get_communities_louvain(const NetlistGraph* graph, const std::vector<double>& edge_weights = {}, u32 seed = 0, u32 max_passes = 0, double time_limit = 0.0);
+
+        /**
+         * Get the community of every vertex of a netlist graph running a parallel implementation of the Louvain clustering algorithm.<br>
+         * The graph is treated as undirected, the weights of edges in both directions between two vertices add up.
+         * Every pass first moves vertices to the neighboring community that increases the modularity the most and then merges each community into a single vertex.
+         * The vertices are moved in batches determined by the seed, so the result only depends on the seed and not on the number of threads.<br>
+         * When the pass or time limit is reached, the communities found so far are returned.
+         * The communities are numbered consecutively in the order of their smallest vertex.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @param[in] edge_weights - The non-negative weight of every edge of the graph in the order of the outgoing edges, or an empty vector to weight all edges equally.
+         * @param[in] seed - The seed that determines the order in which vertices are moved between communities.
+         * @param[in] max_passes - The maximum number of passes, or 0 to run until no vertex changes its community anymore.
+         * @param[in] time_limit - The time in seconds after which the current communities are returned, or 0 for no limit.
+         * @returns A vector holding the community ID of each vertex on success, an error otherwise.
+         */
+        Result<std::vector<u32>>
+            get_community_ids_louvain(const NetlistGraph* graph, const std::vector<double>& edge_weights = {}, u32 seed = 0, u32 max_passes = 0, double time_limit = 0.0);
+
+        /**
+         * Create a module named 'community_<ID>' for every non-empty community found by any of the clustering functions.
+         *
+         * @param[in] netlist - The netlist the gates of the communities belong to.
+         * @param[in] communities - A map from community IDs to communities.
+         * @param[in] parent - The parent module of the new modules, or a 'nullptr' to use the top module.
+         * @returns A map from community IDs to the created modules on success, an error otherwise.
+         */
+        Result<std::map<int, Module*>> create_community_modules(Netlist* netlist, const std::map<int, std::set<Gate*>>& communities, Module* parent = nullptr);
+
         /**
          * Get a vector of strongly connected components (SCC) with each SSC being represented by a vector of gates.
          *
@@ -100,6 +182,55 @@ namespace hal
          */
         std::vector<std::vector<Gate*>> get_strongly_connected_components(Netlist* netlist);
 
+        /**
+         * Get a vector of strongly connected components (SCC) of a netlist graph with each SSC being represented by a vector of gates.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @returns A vector of SCCs.
+         */
+        std::vector<std::vector<Gate*>> get_strongly_connected_components(const NetlistGraph* graph);
+
+        /**
+         * Get the strongly connected component (SCC) of every vertex of a netlist graph.
+         * The components are numbered consecutively in the order of their smallest vertex.
+         * Combinational loops are the components with more than one vertex of a graph that only contains combinational gates.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @returns A vector holding the component ID of each vertex on success, an error otherwise.
+         */
+        Result<std::vector<u32>> get_strongly_connected_component_ids(const NetlistGraph* graph);
+
+        /*
+        *      levelization functions
+        */
+
+        /**
+         * Get the vertices of an acyclic netlist graph in topological order, i.e., every vertex is placed after all of its predecessors.
+         * The vertices are ordered by their logic level first and by vertex second.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @returns A vector of all vertices in topological order on success, an error if the graph contains a cycle.
+         */
+        Result<std::vector<u32>> get_topological_order(const NetlistGraph* graph);
+
+        /**
+         * Get the logic level of every vertex of an acyclic netlist graph, i.e., the length of the longest path from any vertex without predecessors to the vertex.<br>
+         * Flip-flops usually close cycles, hence the graph is typically created from the combinational gates only.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @returns A vector holding the logic level of each vertex on success, an error if the graph contains a cycle.
+         */
+        Result<std::vector<u32>> get_logic_levels(const NetlistGraph* graph);
+
+        /**
+         * Get the logic depth of every vertex of an acyclic netlist graph, i.e., the length of the longest path from the vertex to any vertex without successors.<br>
+         * The longest path through a vertex has a length of its logic level plus its logic depth.
+         *
+         * @param[in] graph - The netlist graph to operate on.
+         * @returns A vector holding the logic depth of each vertex on success, an error if the graph contains a cycle.
+         */
+        Result<std::vector<u32>> get_logic_depths(const NetlistGraph* graph);
+
         /**
          * Get a graph cut for a specific gate and depth. Further, a set of gates can be specified that limit the graph cut, i.e., flip-flops and memory cells.<br>
          * The graph cut is returned as a vector of sets of gates with the vector's index representing the distance of each set to the starting point.
@@ -120,7 +251,8 @@ namespace hal
         /**
          * Generates an directed graph based on the current netlist. Each gate is transformed to a node while each
          * net is transformed to an edge. The function returns the mapping from igraph node ids to HAL gates. Note
-         * that for each global input and output dummy nodes are generated in the igraph representation.
+         * that for each global input and output dummy nodes are generated in the igraph representation.<br>
+         * The graph is rebuilt on every call, use a NetlistGraph to build it once for several algorithms instead.
          *
          * @param[in] netlist - The netlist to operate on.
          * @param[in] igraph - igraph object
@@ -13,6 +13,7 @@
 
 #include "hal_core/defines.h"
 #include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/module.h"
 #include "hal_core/netlist/net.h"
 #include "hal_core/netlist/netlist.h"
 #include "hal_core/utilities/log.h"
@@ -37,6 +38,98 @@ namespace hal
         py::module m("graph_algorithm", "hal GraphAlgorithmPlugin python bindings");
 #endif    // ifdef PYBIND11_MODULE
 
+        py::class_<NetlistGraph> py_netlist_graph(m, "NetlistGraph", R"(
+            A directed graph of the gates of a netlist stored in compressed sparse row (CSR) format.
+            Each gate is a vertex and each connection from a source of a net to one of its destinations is an edge.
+            Vertices are numbered consecutively by gate ID starting at 0.
+            The graph is a snapshot of the netlist that is built once and can then be shared by any number of algorithms.
+        )");
+
+        py_netlist_graph.def_static(
+            "from_netlist",
+            [](Netlist* netlist, bool combinational_only, const Module* module) -> std::unique_ptr<NetlistGraph> {
+                auto res = NetlistGraph::from_netlist(netlist, combinational_only, module);
+                if (res.is_ok())
+                {
+                    return res.get();
+                }
+                else
+                {
+                    log_error("python_context", "error encountered while creating netlist graph:\n{}", res.get_error().get());
+                    return nullptr;
+                }
+            },
+            py::arg("netlist"),
+            py::arg("combinational_only") = false,
+            py::arg("module")             = nullptr,
+            R"(
+            Create a graph from the gates of a netlist.
+            The graph can be restricted to the combinational gates of the netlist and to the gates of a module including all of its submodules.
+            Edges are only created between gates that are both part of the graph.
+
+            :param hal_py.Netlist netlist: The netlist to operate on.
+            :param bool combinational_only: Set True to only consider combinational gates, False to consider all gates.
+            :param hal_py.Module module: The module to restrict the graph to or None to consider the entire netlist.
+            :returns: The graph on success, None otherwise.
+            :rtype: graph_algorithm.NetlistGraph or None
+        )");
+
+        py_netlist_graph.def_property_readonly("num_vertices", &NetlistGraph::get_num_vertices, R"(
+            The number of vertices of the graph.
+
+            :type: int
+        )");
+
+        py_netlist_graph.def("get_num_vertices", &NetlistGraph::get_num_vertices, R"(
+            Get the number of vertices of the graph.
+
+            :returns: The number of vertices.
+            :rtype: int
+        )");
+
+        py_netlist_graph.def_property_readonly("num_edges", &NetlistGraph::get_num_edges, R"(
+            The number of edges of the graph.
+
+            :type: int
+        )");
+
+        py_netlist_graph.def("get_num_edges", &NetlistGraph::get_num_edges, R"(
+            Get the number of edges of the graph.
+
+            :returns: The number of edges.
+            :rtype: int
+        )");
+
+        py_netlist_graph.def("get_gates", &NetlistGraph::get_gates, R"(
+            Get the gates of the graph indexed by their vertex.
+
+            :returns: A list mapping each vertex to its gate.
+            :rtype: list[hal_py.Gate]
+        )");
+
+        py_netlist_graph.def(
+            "get_vertex",
+            [](const NetlistGraph& self, const Gate* gate) -> std::optional<u32> {
+                auto res = self.get_vertex(gate);
+                if (res.is_ok())
+                {
+                    return res.get();
+                }
+                else
+                {
+                    log_error("python_context", "error encountered while getting vertex:\n{}", res.get_error().get());
+                    return std::nullopt;
+                }
+            },
+            py::arg("gate"),
+            R"(
+            Get the vertex of a gate.
+
+            :param hal_py.Gate gate: The gate.
+            :returns: The vertex on success, None otherwise.
+            :rtype: int or None
+        )");
+
         py::class_<GraphAlgorithmPlugin, RawPtrWrapper<GraphAlgorithmPlugin>, BasePluginInterface>(m, "GraphAlgorithmPlugin")
             .def_property_readonly("name", &GraphAlgorithmPlugin::get_name, R"(
                 The name of the plugin.
@@ -60,14 +153,22 @@ namespace hal
                 :returns: Plugin version.
                 :rtype: str
                 )")
-            .def("get_communities", &GraphAlgorithmPlugin::get_communities, py::arg("netlist"), R"(
+            .def("get_communities", py::overload_cast<Netlist*>(&GraphAlgorithmPlugin::get_communities), py::arg("netlist"), R"(
                 Get a dict of community IDs to communities. Each community is represented by a set of gates.
 
                 :param hal_py.Netlist netlist: The netlist to operate on.
                 :returns: A dict from community IDs to communities.
                 :rtype: dict[int,set[hal_py.get_gate()]]
                 )")
-            .def("get_communities_spinglass", &GraphAlgorithmPlugin::get_communities_spinglass, py::arg("netlist"), py::arg("spins"), R"(
+            .def("get_communities", py::overload_cast<const NetlistGraph*>(&GraphAlgorithmPlugin::get_communities), py::arg("graph"), R"(
+                Get a dict of community IDs to communities of a netlist graph. Each community is represented by a set of gates.
+                In contrast to the netlist variant, leaves are not removed from the netlist beforehand.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :returns: A dict from community IDs to communities.
+                :rtype: dict[int,set[hal_py.get_gate()]]
+                )")
+            .def("get_communities_spinglass", py::overload_cast<Netlist*, u32>(&GraphAlgorithmPlugin::get_communities_spinglass), py::arg("netlist"), py::arg("spins"), R"(
                 Get a dict of community IDs to communities running the spinglass clustering algorithm. Each community is represented by a set of gates.
 
                 :param hal_py.Netlist netlist: The netlist to operate on.
@@ -75,13 +176,125 @@ namespace hal
                 :returns: A dict from community IDs to communities.
                 :rtype: dict[int,set[hal_py.get_gate()]]
                 )")
-            .def("get_communities_fast_greedy", &GraphAlgorithmPlugin::get_communities_fast_greedy, py::arg("netlist"), R"(
+            .def("get_communities_spinglass", py::overload_cast<const NetlistGraph*, u32>(&GraphAlgorithmPlugin::get_communities_spinglass), py::arg("graph"), py::arg("spins"), R"(
+                Get a dict of community IDs to communities of a netlist graph running the spinglass clustering algorithm. Each community is represented by a set of gates.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :param int spins: The number of spins.
+                :returns: A dict from community IDs to communities.
+                :rtype: dict[int,set[hal_py.get_gate()]]
+                )")
+            .def("get_communities_fast_greedy", py::overload_cast<Netlist*>(&GraphAlgorithmPlugin::get_communities_fast_greedy), py::arg("netlist"), R"(
                 Get a dict of community IDs to communities running the fast greedy clustering algorithm from igraph. Each community is represented by a set of gates.
 
                 :param hal_py.Netlist netlist: The netlist to operate on.
                 :returns: A dict from community IDs to communities.
                 :rtype: dict[set[hal_py.get_gate()]]
                 )")
+            .def("get_communities_fast_greedy", py::overload_cast<const NetlistGraph*>(&GraphAlgorithmPlugin::get_communities_fast_greedy), py::arg("graph"), R"(
+                Get a dict of community IDs to communities of a netlist graph running the fast greedy clustering algorithm from igraph. Each community is represented by a set of gates.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :returns: A dict from community IDs to communities.
+                :rtype: dict[set[hal_py.get_gate()]]
+                )")
+            .def("get_communities_louvain",
+                 py::overload_cast<Netlist*, u32, u32, double>(&GraphAlgorithmPlugin::get_communities_louvain),
+                 py::arg("netlist"),
+                 py::arg("seed")       = 0,
+                 py::arg("max_passes") = 0,
+                 py::arg("time_limit") = 0.0,
+                 R"(
+                Get a dict of community IDs to communities running a parallel implementation of the Louvain clustering algorithm. Each community is represented by a set of gates.
+                The netlist is treated as an undirected graph in which every connection between two gates has a weight of 1.
+
+                :param hal_py.Netlist netlist: The netlist to operate on.
+                :param int seed: The seed that determines the order in which vertices are moved between communities.
+                :param int max_passes: The maximum number of passes, or 0 to run until no vertex changes its community anymore.
+                :param float time_limit: The time in seconds after which the current communities are returned, or 0 for no limit.
+                :returns: A dict from community IDs to communities.
+                :rtype: dict[int,set[hal_py.get_gate()]]
+                )")
+            .def("get_communities_louvain",
+                 py::overload_cast<const NetlistGraph*, const std::vector<double>&, u32, u32, double>(&GraphAlgorithmPlugin::get_communities_louvain),
+                 py::arg("graph"),
+                 py::arg("edge_weights") = std::vector<double>(),
+                 py::arg("seed")         = 0,
+                 py::arg("max_passes")   = 0,
+                 py::arg("time_limit")   = 0.0,
+                 R"(
+                Get a dict of community IDs to communities of a netlist graph running a parallel implementation of the Louvain clustering algorithm. Each community is represented by a set of gates.
+                The algorithm is described in more detail at get_community_ids_louvain.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :param list[float] edge_weights: The weight of every edge of the graph, or an empty list to weight all edges equally.
+                :param int seed: The seed that determines the order in which vertices are moved between communities.
+                :param int max_passes: The maximum number of passes, or 0 to run until no vertex changes its community anymore.
+                :param float time_limit: The time in seconds after which the current communities are returned, or 0 for no limit.
+                :returns: A dict from community IDs to communities.
+                :rtype: dict[int,set[hal_py.get_gate()]]
+                )")
+            .def(
+                "get_community_ids_louvain",
+                [](GraphAlgorithmPlugin& self, const NetlistGraph* graph, const std::vector<double>& edge_weights, u32 seed, u32 max_passes, double time_limit) -> std::optional<std::vector<u32>> {
+                    auto res = self.get_community_ids_louvain(graph, edge_weights, seed, max_passes, time_limit);
+                    if (res.is_ok())
+                    {
+                        return res.get();
+                    }
+                    else
+                    {
+                        log_error("python_context", "error encountered while getting Louvain communities:\n{}", res.get_error().get());
+                        return std::nullopt;
+                    }
+                },
+                py::arg("graph"),
+                py::arg("edge_weights") = std::vector<double>(),
+                py::arg("seed")         = 0,
+                py::arg("max_passes")   = 0,
+                py::arg("time_limit")   = 0.0,
+                R"(
+                Get the community of every vertex of a netlist graph running a parallel implementation of the Louvain clustering algorithm.
+                The graph is treated as undirected, the weights of edges in both directions between two vertices add up.
+                Every pass first moves vertices to the neighboring community that increases the modularity the most and then merges each community into a single vertex.
+                The vertices are moved in batches determined by the seed, so the result only depends on the seed and not on the number of threads.
+                When the pass or time limit is reached, the communities found so far are returned.
+                The communities are numbered consecutively in the order of their smallest vertex.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :param list[float] edge_weights: The non-negative weight of every edge of the graph in the order of the outgoing edges, or an empty list to weight all edges equally.
+                :param int seed: The seed that determines the order in which vertices are moved between communities.
+                :param int max_passes: The maximum number of passes, or 0 to run until no vertex changes its community anymore.
+                :param float time_limit: The time in seconds after which the current communities are returned, or 0 for no limit.
+                :returns: A list holding the community ID of each vertex on success, None otherwise.
+                :rtype: list[int] or None
+                )")
+            .def(
+                "create_community_modules",
+                [](GraphAlgorithmPlugin& self, Netlist* netlist, const std::map<int, std::set<Gate*>>& communities, Module* parent) -> std::optional<std::map<int, Module*>> {
+                    auto res = self.create_community_modules(netlist, communities, parent);
+                    if (res.is_ok())
+                    {
+                        return res.get();
+                    }
+                    else
+                    {
+                        log_error("python_context", "error encountered while creating community modules:\n{}", res.get_error().get());
+                        return std::nullopt;
+                    }
+                },
+                py::arg("netlist"),
+                py::arg("communities"),
+                py::arg("parent") = nullptr,
+                R"(
+                Create a module named 'community_<ID>' for every non-empty community found by any of the clustering functions.
+
+                :param hal_py.Netlist netlist: The netlist the gates of the communities belong to.
+                :param dict[int,set[hal_py.Gate]] communities: A dict from community IDs to communities.
+                :param hal_py.Module parent: The parent module of the new modules, or None to use the top module.
+                :returns: A dict from community IDs to the created modules on success, None otherwise.
+                :rtype: dict[int,hal_py.Module] or None
+                )")
             /*
             .def("get_communities_multilevel", &GraphAlgorithmPlugin::get_communities_multilevel, py::arg("netlist"), R"(
                 Get a dict of community IDs to communities running the multilevel clustering algorithm from igraph. Each community is represented by a set of gates.
@@ -90,13 +303,113 @@ namespace hal
                 :returns: A dict from community IDs to communities.
                 :rtype: dict[int,set[hal_py.get_gate()]]
                 )") */
-            .def("get_strongly_connected_components", &GraphAlgorithmPlugin::get_strongly_connected_components, py::arg("netlist"), R"(
+            .def("get_strongly_connected_components", py::overload_cast<Netlist*>(&GraphAlgorithmPlugin::get_strongly_connected_components), py::arg("netlist"), R"(
                 Get a list of strongly connected components (SCC) with each SSC being represented by a list of gates.
 
                 :param hal_py.Netlist netlist: The netlist to operate on.
                 :returns: A list of SCCs.
                 :rtype: list[list[hal_py.get_gate()]]
                 )")
+            .def("get_strongly_connected_components", py::overload_cast<const NetlistGraph*>(&GraphAlgorithmPlugin::get_strongly_connected_components), py::arg("graph"), R"(
+                Get a list of strongly connected components (SCC) of a netlist graph with each SSC being represented by a list of gates.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :returns: A list of SCCs.
+                :rtype: list[list[hal_py.get_gate()]]
+                )")
+            .def(
+                "get_strongly_connected_component_ids",
+                [](GraphAlgorithmPlugin& self, const NetlistGraph* graph) -> std::optional<std::vector<u32>> {
+                    auto res = self.get_strongly_connected_component_ids(graph);
+                    if (res.is_ok())
+                    {
+                        return res.get();
+                    }
+                    else
+                    {
+                        log_error("python_context", "error encountered while getting strongly connected component IDs:\n{}", res.get_error().get());
+                        return std::nullopt;
+                    }
+                },
+                py::arg("graph"),
+                R"(
+                Get the strongly connected component (SCC) of every vertex of a netlist graph.
+                The components are numbered consecutively in the order of their smallest vertex.
+                Combinational loops are the components with more than one vertex of a graph that only contains combinational gates.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :returns: A list holding the component ID of each vertex on success, None otherwise.
+                :rtype: list[int] or None
+                )")
+            .def(
+                "get_topological_order",
+                [](GraphAlgorithmPlugin& self, const NetlistGraph* graph) -> std::optional<std::vector<u32>> {
+                    auto res = self.get_topological_order(graph);
+                    if (res.is_ok())
+                    {
+                        return res.get();
+                    }
+                    else
+                    {
+                        log_error("python_context", "error encountered while getting topological order:\n{}", res.get_error().get());
+                        return std::nullopt;
+                    }
+                },
+                py::arg("graph"),
+                R"(
+                Get the vertices of an acyclic netlist graph in topological order, i.e., every vertex is placed after all of its predecessors.
+                The vertices are ordered by their logic level first and by vertex second.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :returns: A list of all vertices in topological order on success, None if the graph contains a cycle.
+                :rtype: list[int] or None
+                )")
+            .def(
+                "get_logic_levels",
+                [](GraphAlgorithmPlugin& self, const NetlistGraph* graph) -> std::optional<std::vector<u32>> {
+                    auto res = self.get_logic_levels(graph);
+                    if (res.is_ok())
+                    {
+                        return res.get();
+                    }
+                    else
+                    {
+                        log_error("python_context", "error encountered while getting logic levels:\n{}", res.get_error().get());
+                        return std::nullopt;
+                    }
+                },
+                py::arg("graph"),
+                R"(
+                Get the logic level of every vertex of an acyclic netlist graph, i.e., the length of the longest path from any vertex without predecessors to the vertex.
+                Flip-flops usually close cycles, hence the graph is typically created from the combinational gates only.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :returns: A list holding the logic level of each vertex on success, None if the graph contains a cycle.
+                :rtype: list[int] or None
+                )")
+            .def(
+                "get_logic_depths",
+                [](GraphAlgorithmPlugin& self, const NetlistGraph* graph) -> std::optional<std::vector<u32>> {
+                    auto res = self.get_logic_depths(graph);
+                    if (res.is_ok())
+                    {
+                        return res.get();
+                    }
+                    else
+                    {
+                        log_error("python_context", "error encountered while getting logic depths:\n{}", res.get_error().get());
+                        return std::nullopt;
+                    }
+                },
+                py::arg("graph"),
+                R"(
+                Get the logic depth of every vertex of an acyclic netlist graph, i.e., the length of the longest path from the vertex to any vertex without successors.
+                The longest path through a vertex has a length of its logic level plus its logic depth.
+
+                :param graph_algorithm.NetlistGraph graph: The netlist graph to operate on.
+                :returns: A list holding the logic depth of each vertex on success, None if the graph contains a cycle.
+                :rtype: list[int] or None
+                )")
             .def("get_graph_cut",
                  &GraphAlgorithmPlugin::get_graph_cut,
                  py::arg("netlist"),
@@ -17,9 +17,36 @@ namespace hal
             log_error(this->get_name(), "{}", "parameter 'nl' is nullptr");
             return std::map<int, std::set<Gate*>>();
         }
+
+        std::unique_ptr<NetlistGraph> graph;
+        if (auto res = NetlistGraph::from_netlist(nl); res.is_error())
+        {
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::map<int, std::set<Gate*>>();
+        }
+        else
+        {
+            graph = res.get();
+        }
+
+        return get_communities_fast_greedy(graph.get());
+    }
+
+    std::map<int, std::set<Gate*>> GraphAlgorithmPlugin::get_communities_fast_greedy(const NetlistGraph* nl_graph)
+    {
+        if (nl_graph == nullptr)
+        {
+            log_error(this->get_name(), "{}", "parameter 'graph' is nullptr");
+            return std::map<int, std::set<Gate*>>();
+        }
+
         // get igraph
         igraph_t graph;
-        std::map<int, Gate*> vertex_to_gate = get_igraph_directed(nl, &graph);
+        if (auto res = nl_graph->to_igraph(&graph); res.is_error())
+        {
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::map<int, std::set<Gate*>>();
+        }
 
         igraph_vector_t membership, modularity;
         igraph_matrix_t merges;
@@ -37,12 +64,7 @@ namespace hal
                                     &membership);
 
         // map back to HAL structures
-        std::map<int, std::set<Gate*>> community_sets;
-        for (int i = 0; i < igraph_vector_size(&membership); i++)
-        {
-            community_sets[(int)VECTOR(membership)[i]].insert(vertex_to_gate[i]);
-        }
-        //igraph_vector_destroy(&membership);
+        std::map<int, std::set<Gate*>> community_sets = nl_graph->get_memberships(&membership);
 
         igraph_destroy(&graph);
         igraph_vector_destroy(&membership);
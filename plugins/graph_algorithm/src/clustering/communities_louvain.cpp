@@ -0,0 +1,601 @@
+#include "graph_algorithm/plugin_graph_algorithm.h"
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/module.h"
+#include "hal_core/netlist/netlist.h"
+#include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric>
+
+namespace hal
+{
+    namespace
+    {
+        // number of vertices handed to a thread at once
+        const u32 chunk_size = 4096;
+
+        // the vertices of a sweep are split into this many batches, all vertices of a batch choose their new community at the same time
+        const u32 num_batches = 16;
+
+        // maximum number of sweeps over all vertices within a single pass
+        const u32 max_sweeps = 32;
+
+        const u32 no_entry = std::numeric_limits<u32>::max();
+
+        u32 hash(u32 seed, u32 value)
+        {
+            u64 x = ((u64)seed << 32) | value;
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            x *= 0xc4ceb9fe1a85ec53ULL;
+            x ^= x >> 33;
+            return (u32)x;
+        }
+
+        /**
+         * An undirected weighted graph in CSR format. Every edge is stored for both of its vertices, self-loops are stored separately.
+         */
+        struct WeightedGraph
+        {
+            std::vector<u32> offsets;
+            std::vector<u32> neighbors;
+            std::vector<double> weights;
+            std::vector<double> self_weights;
+        };
+
+        /**
+         * Sums up the weights of the edges from a vertex or community to each neighboring community.
+         * Every thread keeps its own accumulator, so the lookup table never has to be cleared completely.
+         */
+        class NeighborWeights
+        {
+        public:
+            void add(u32 community, double weight)
+            {
+                if (m_positions.size() <= community)
+                {
+                    m_positions.resize(community + 1, no_entry);
+                }
+
+                u32& pos = m_positions[community];
+                if (pos == no_entry)
+                {
+                    pos = m_communities.size();
+                    m_communities.push_back(community);
+                    m_weights.push_back(0.0);
+                }
+                m_weights[pos] += weight;
+            }
+
+            double get(u32 community) const
+            {
+                return (community < m_positions.size() && m_positions[community] != no_entry) ? m_weights[m_positions[community]] : 0.0;
+            }
+
+            const std::vector<u32>& get_communities() const
+            {
+                return m_communities;
+            }
+
+            const std::vector<double>& get_weights() const
+            {
+                return m_weights;
+            }
+
+            void clear()
+            {
+                for (u32 community : m_communities)
+                {
+                    m_positions[community] = no_entry;
+                }
+                m_communities.clear();
+                m_weights.clear();
+            }
+
+        private:
+            std::vector<u32> m_positions;
+            std::vector<u32> m_communities;
+            std::vector<double> m_weights;
+        };
+
+        /**
+         * Calls a function for every index in [0, count) in parallel, every thread owns an accumulator that is passed to the function.
+         */
+        template<typename F>
+        void parallel_for_with_weights(u32 count, std::vector<NeighborWeights>& accumulators, const F& func)
+        {
+            const u32 num_chunks = (count + chunk_size - 1) / chunk_size;
+            utils::parallel_for_with_thread_index(num_chunks, accumulators.size(), [&](u32 t, u32 c) {
+                const u32 end = std::min(count, (c + 1) * chunk_size);
+                for (u32 i = c * chunk_size; i < end; i++)
+                {
+                    func(i, accumulators[t]);
+                }
+            });
+        }
+
+        /**
+         * Creates the undirected graph of a netlist graph, the weights of edges in both directions between two vertices add up.
+         */
+        WeightedGraph make_undirected(const NetlistGraph* graph, const std::vector<double>& edge_weights)
+        {
+            const u32 num_vertices              = graph->get_num_vertices();
+            const std::vector<u32>& out_offsets = graph->get_out_offsets();
+            const std::vector<u32>& out_edges   = graph->get_out_edges();
+            const std::vector<u32>& in_offsets  = graph->get_in_offsets();
+
+            auto get_weight = [&edge_weights](u32 e) { return edge_weights.empty() ? 1.0 : edge_weights[e]; };
+
+            // every vertex lists its outgoing edges first and its incoming edges second, self-loops are part of both and are left out
+            WeightedGraph res;
+            res.self_weights.assign(num_vertices, 0.0);
+            std::vector<u32> num_self_loops(num_vertices, 0);
+            utils::parallel_for((num_vertices + chunk_size - 1) / chunk_size, [&](u32 c) {
+                const u32 end = std::min(num_vertices, (c + 1) * chunk_size);
+                for (u32 v = c * chunk_size; v < end; v++)
+                {
+                    for (u32 e = out_offsets[v]; e < out_offsets[v + 1]; e++)
+                    {
+                        if (out_edges[e] == v)
+                        {
+                            res.self_weights[v] += get_weight(e);
+                            num_self_loops[v]++;
+                        }
+                    }
+                }
+            });
+
+            res.offsets.assign(num_vertices + 1, 0);
+            for (u32 v = 0; v < num_vertices; v++)
+            {
+                res.offsets[v + 1] = res.offsets[v] + (out_offsets[v + 1] - out_offsets[v]) + (in_offsets[v + 1] - in_offsets[v]) - 2 * num_self_loops[v];
+            }
+
+            res.neighbors.resize(res.offsets[num_vertices]);
+            res.weights.resize(res.offsets[num_vertices]);
+            std::vector<u32> in_positions(num_vertices);
+            utils::parallel_for((num_vertices + chunk_size - 1) / chunk_size, [&](u32 c) {
+                const u32 end = std::min(num_vertices, (c + 1) * chunk_size);
+                for (u32 v = c * chunk_size; v < end; v++)
+                {
+                    u32 pos = res.offsets[v];
+                    for (u32 e = out_offsets[v]; e < out_offsets[v + 1]; e++)
+                    {
+                        if (out_edges[e] != v)
+                        {
+                            res.neighbors[pos] = out_edges[e];
+                            res.weights[pos]   = get_weight(e);
+                            pos++;
+                        }
+                    }
+                    in_positions[v] = pos;
+                }
+            });
+
+            for (u32 v = 0; v < num_vertices; v++)
+            {
+                for (u32 e = out_offsets[v]; e < out_offsets[v + 1]; e++)
+                {
+                    if (const u32 w = out_edges[e]; w != v)
+                    {
+                        res.neighbors[in_positions[w]] = v;
+                        res.weights[in_positions[w]]   = get_weight(e);
+                        in_positions[w]++;
+                    }
+                }
+            }
+
+            return res;
+        }
+
+        /**
+         * Moves vertices to the neighboring community that increases the modularity the most until hardly any vertex moves anymore or the time is up.
+         * All vertices of a batch choose their new community based on the communities before the batch, the moves that still increase the modularity are then applied in order.
+         * Hence, the result does not depend on the number of threads.
+         *
+         * Returns whether any vertex has been moved, the community of each vertex is written to 'community'.
+         */
+        template<typename F>
+        bool move_vertices(const WeightedGraph& graph, u32 seed, std::vector<NeighborWeights>& accumulators, std::vector<u32>& community, const F& out_of_time)
+        {
+            const u32 num_vertices = graph.self_weights.size();
+
+            std::vector<double> degrees(num_vertices);
+            utils::parallel_for((num_vertices + chunk_size - 1) / chunk_size, [&](u32 c) {
+                const u32 end = std::min(num_vertices, (c + 1) * chunk_size);
+                for (u32 v = c * chunk_size; v < end; v++)
+                {
+                    degrees[v] = 2 * graph.self_weights[v];
+                    for (u32 e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+                    {
+                        degrees[v] += graph.weights[e];
+                    }
+                }
+            });
+
+            const double total_degree = std::accumulate(degrees.begin(), degrees.end(), 0.0);
+
+            community.resize(num_vertices);
+            std::iota(community.begin(), community.end(), 0);
+            if (total_degree <= 0.0)
+            {
+                return false;
+            }
+
+            std::vector<double> community_degrees = degrees;
+
+            std::vector<std::vector<u32>> batches(num_batches);
+            for (u32 v = 0; v < num_vertices; v++)
+            {
+                batches[hash(seed, v) % num_batches].push_back(v);
+            }
+
+            // the gain of moving a vertex from its own community (without the vertex) to a community it is connected to with the given weight, up to a constant factor
+            auto get_gain = [&](u32 v, u32 target, double weight) {
+                const double target_degree = community_degrees[target] - (target == community[v] ? degrees[v] : 0.0);
+                return weight - degrees[v] * target_degree / total_degree;
+            };
+
+            auto choose_community = [&](u32 v, NeighborWeights& neighbor_weights) {
+                for (u32 e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+                {
+                    neighbor_weights.add(community[graph.neighbors[e]], graph.weights[e]);
+                }
+
+                const u32 own    = community[v];
+                u32 best         = own;
+                double best_gain = get_gain(v, own, neighbor_weights.get(own));
+                for (u32 i = 0; i < neighbor_weights.get_communities().size(); i++)
+                {
+                    const u32 target = neighbor_weights.get_communities()[i];
+                    if (target == own)
+                    {
+                        continue;
+                    }
+
+                    if (const double gain = get_gain(v, target, neighbor_weights.get_weights()[i]); gain > best_gain || (gain == best_gain && best != own && target < best))
+                    {
+                        best      = target;
+                        best_gain = gain;
+                    }
+                }
+
+                neighbor_weights.clear();
+                return best;
+            };
+
+            auto is_improvement = [&](u32 v, u32 target) {
+                double own_weight    = 0.0;
+                double target_weight = 0.0;
+                for (u32 e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+                {
+                    if (const u32 neighbor_community = community[graph.neighbors[e]]; neighbor_community == community[v])
+                    {
+                        own_weight += graph.weights[e];
+                    }
+                    else if (neighbor_community == target)
+                    {
+                        target_weight += graph.weights[e];
+                    }
+                }
+                return get_gain(v, target, target_weight) > get_gain(v, community[v], own_weight);
+            };
+
+            // a vertex only has to be looked at again once the community of one of its neighbors has changed
+            std::vector<u8> active(num_vertices, 1);
+
+            bool any_moved = false;
+            std::vector<u32> candidates;
+            std::vector<u32> targets;
+            for (u32 sweep = 0; sweep < max_sweeps; sweep++)
+            {
+                u32 num_moved = 0;
+                for (const std::vector<u32>& batch : batches)
+                {
+                    candidates.clear();
+                    for (u32 v : batch)
+                    {
+                        if (active[v])
+                        {
+                            candidates.push_back(v);
+                            active[v] = 0;
+                        }
+                    }
+
+                    targets.resize(candidates.size());
+                    parallel_for_with_weights(candidates.size(), accumulators, [&](u32 i, NeighborWeights& neighbor_weights) { targets[i] = choose_community(candidates[i], neighbor_weights); });
+
+                    for (u32 i = 0; i < candidates.size(); i++)
+                    {
+                        const u32 v = candidates[i];
+                        if (targets[i] == community[v])
+                        {
+                            continue;
+                        }
+
+                        // the target was chosen based on the communities before the batch, neighbors that moved in the meantime may have made it a bad choice
+                        if (!is_improvement(v, targets[i]))
+                        {
+                            active[v] = 1;
+                            continue;
+                        }
+
+                        community_degrees[community[v]] -= degrees[v];
+                        community_degrees[targets[i]] += degrees[v];
+                        community[v] = targets[i];
+                        num_moved++;
+
+                        for (u32 e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+                        {
+                            active[graph.neighbors[e]] = 1;
+                        }
+                    }
+
+                    if (out_of_time())
+                    {
+                        return any_moved || num_moved > 0;
+                    }
+                }
+
+                any_moved |= (num_moved > 0);
+
+                // the last few moves hardly change the modularity, the next pass continues on the merged graph anyway
+                if (num_moved == 0 || (u64)num_moved * 1000 < num_vertices)
+                {
+                    break;
+                }
+            }
+
+            return any_moved;
+        }
+
+        /**
+         * Renumbers the communities consecutively in the order of their smallest vertex and returns the number of communities.
+         */
+        u32 renumber(std::vector<u32>& community)
+        {
+            std::vector<u32> new_ids(community.size(), no_entry);
+            u32 next_id = 0;
+            for (u32& id : community)
+            {
+                if (new_ids[id] == no_entry)
+                {
+                    new_ids[id] = next_id++;
+                }
+                id = new_ids[id];
+            }
+            return next_id;
+        }
+
+        /**
+         * Merges every community into a single vertex, the communities have to be numbered consecutively.
+         * Edges within a community turn into a self-loop of the new vertex.
+         */
+        WeightedGraph aggregate(const WeightedGraph& graph, const std::vector<u32>& community, u32 num_communities, std::vector<NeighborWeights>& accumulators)
+        {
+            const u32 num_vertices = graph.self_weights.size();
+
+            std::vector<u32> member_offsets(num_communities + 1, 0);
+            for (u32 id : community)
+            {
+                member_offsets[id + 1]++;
+            }
+            std::partial_sum(member_offsets.begin(), member_offsets.end(), member_offsets.begin());
+
+            std::vector<u32> members(num_vertices);
+            std::vector<u32> member_positions(member_offsets.begin(), member_offsets.end() - 1);
+            for (u32 v = 0; v < num_vertices; v++)
+            {
+                members[member_positions[community[v]]++] = v;
+            }
+
+            // collect the neighbors of every community first and copy them into place once all sizes are known
+            WeightedGraph res;
+            res.self_weights.assign(num_communities, 0.0);
+            std::vector<std::vector<u32>> community_neighbors(num_communities);
+            std::vector<std::vector<double>> community_weights(num_communities);
+            parallel_for_with_weights(num_communities, accumulators, [&](u32 c, NeighborWeights& neighbor_weights) {
+                double internal_weight = 0.0;
+                for (u32 i = member_offsets[c]; i < member_offsets[c + 1]; i++)
+                {
+                    const u32 v = members[i];
+                    res.self_weights[c] += graph.self_weights[v];
+                    for (u32 e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+                    {
+                        if (const u32 target = community[graph.neighbors[e]]; target == c)
+                        {
+                            internal_weight += graph.weights[e];
+                        }
+                        else
+                        {
+                            neighbor_weights.add(target, graph.weights[e]);
+                        }
+                    }
+                }
+
+                // every internal edge has been seen from both of its vertices
+                res.self_weights[c] += internal_weight / 2;
+                community_neighbors[c] = neighbor_weights.get_communities();
+                community_weights[c]   = neighbor_weights.get_weights();
+                neighbor_weights.clear();
+            });
+
+            res.offsets.assign(num_communities + 1, 0);
+            for (u32 c = 0; c < num_communities; c++)
+            {
+                res.offsets[c + 1] = res.offsets[c] + community_neighbors[c].size();
+            }
+
+            res.neighbors.resize(res.offsets[num_communities]);
+            res.weights.resize(res.offsets[num_communities]);
+            utils::parallel_for((num_communities + chunk_size - 1) / chunk_size, [&](u32 chunk) {
+                const u32 end = std::min(num_communities, (chunk + 1) * chunk_size);
+                for (u32 c = chunk * chunk_size; c < end; c++)
+                {
+                    std::copy(community_neighbors[c].begin(), community_neighbors[c].end(), res.neighbors.begin() + res.offsets[c]);
+                    std::copy(community_weights[c].begin(), community_weights[c].end(), res.weights.begin() + res.offsets[c]);
+                    std::vector<u32>().swap(community_neighbors[c]);
+                    std::vector<double>().swap(community_weights[c]);
+                }
+            });
+
+            return res;
+        }
+    }    // namespace
+
+    std::map<int, std::set<Gate*>> GraphAlgorithmPlugin::get_communities_louvain(Netlist* nl, u32 seed, u32 max_passes, double time_limit)
+    {
+        if (nl == nullptr)
+        {
+            log_error(this->get_name(), "{}", "parameter 'nl' is nullptr");
+            return std::map<int, std::set<Gate*>>();
+        }
+
+        std::unique_ptr<NetlistGraph> graph;
+        if (auto res = NetlistGraph::from_netlist(nl); res.is_error())
+        {
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::map<int, std::set<Gate*>>();
+        }
+        else
+        {
+            graph = res.get();
+        }
+
+        return get_communities_louvain(graph.get(), {}, seed, max_passes, time_limit);
+    }
+
+    std::map<int, std::set<Gate*>> GraphAlgorithmPlugin::get_communities_louvain(const NetlistGraph* nl_graph, const std::vector<double>& edge_weights, u32 seed, u32 max_passes, double time_limit)
+    {
+        std::vector<u32> community_ids;
+        if (auto res = get_community_ids_louvain(nl_graph, edge_weights, seed, max_passes, time_limit); res.is_error())
+        {
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::map<int, std::set<Gate*>>();
+        }
+        else
+        {
+            community_ids = res.get();
+        }
+
+        std::map<int, std::set<Gate*>> community_sets;
+        for (u32 v = 0; v < community_ids.size(); v++)
+        {
+            community_sets[community_ids[v]].insert(nl_graph->get_gates()[v]);
+        }
+
+        return community_sets;
+    }
+
+    Result<std::vector<u32>> GraphAlgorithmPlugin::get_community_ids_louvain(const NetlistGraph* graph, const std::vector<double>& edge_weights, u32 seed, u32 max_passes, double time_limit)
+    {
+        if (graph == nullptr)
+        {
+            return ERR("could not get Louvain communities: graph is a 'nullptr'");
+        }
+
+        if (!edge_weights.empty() && edge_weights.size() != graph->get_num_edges())
+        {
+            return ERR("could not get Louvain communities: " + std::to_string(edge_weights.size()) + " edge weights were given for a graph with " + std::to_string(graph->get_num_edges())
+                       + " edges");
+        }
+
+        if (const auto it = std::find_if(edge_weights.begin(), edge_weights.end(), [](double weight) { return !(weight >= 0.0); }); it != edge_weights.end())
+        {
+            return ERR("could not get Louvain communities: weight of edge " + std::to_string(it - edge_weights.begin()) + " is negative or not a number");
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        auto out_of_time = [start, time_limit]() { return time_limit > 0.0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= time_limit; };
+
+        std::vector<NeighborWeights> accumulators(utils::get_num_parallel_threads(graph->get_num_vertices()));
+
+        // every vertex of the current graph stands for the vertices of the original graph that are assigned to it
+        WeightedGraph current = make_undirected(graph, edge_weights);
+        std::vector<u32> membership(graph->get_num_vertices());
+        std::iota(membership.begin(), membership.end(), 0);
+
+        std::vector<u32> community;
+        for (u32 pass = 0; max_passes == 0 || pass < max_passes; pass++)
+        {
+            if (!move_vertices(current, hash(seed, pass), accumulators, community, out_of_time))
+            {
+                break;
+            }
+
+            const u32 num_communities = renumber(community);
+            utils::parallel_for((membership.size() + chunk_size - 1) / chunk_size, [&](u32 c) {
+                const u32 end = std::min((u32)membership.size(), (c + 1) * chunk_size);
+                for (u32 v = c * chunk_size; v < end; v++)
+                {
+                    membership[v] = community[membership[v]];
+                }
+            });
+
+            if (out_of_time())
+            {
+                break;
+            }
+
+            current = aggregate(current, community, num_communities, accumulators);
+        }
+
+        // the renumbering of the last pass ordered the communities by their smallest vertex in the merged graph, not in the original one
+        renumber(membership);
+
+        return OK(membership);
+    }
+
+    Result<std::map<int, Module*>> GraphAlgorithmPlugin::create_community_modules(Netlist* netlist, const std::map<int, std::set<Gate*>>& communities, Module* parent)
+    {
+        if (netlist == nullptr)
+        {
+            return ERR("could not create community modules: netlist is a 'nullptr'");
+        }
+
+        if (parent == nullptr)
+        {
+            parent = netlist->get_top_module();
+        }
+        else if (parent->get_netlist() != netlist)
+        {
+            return ERR("could not create community modules in netlist with ID " + std::to_string(netlist->get_id()) + ": parent module '" + parent->get_name() + "' with ID "
+                       + std::to_string(parent->get_id()) + " belongs to a different netlist");
+        }
+
+        for (const auto& [id, gates] : communities)
+        {
+            for (const Gate* gate : gates)
+            {
+                if (gate == nullptr || gate->get_netlist() != netlist)
+                {
+                    return ERR("could not create community modules in netlist with ID " + std::to_string(netlist->get_id()) + ": community " + std::to_string(id)
+                               + " contains a gate that does not belong to the netlist");
+                }
+            }
+        }
+
+        std::map<int, Module*> modules;
+        for (const auto& [id, gates] : communities)
+        {
+            if (gates.empty())
+            {
+                continue;
+            }
+
+            Module* module = netlist->create_module("community_" + std::to_string(id), parent, std::vector<Gate*>(gates.begin(), gates.end()));
+            if (module == nullptr)
+            {
+                return ERR("could not create community modules in netlist with ID " + std::to_string(netlist->get_id()) + ": failed to create module for community "
+                           + std::to_string(id));
+            }
+            modules[id] = module;
+        }
+
+        return OK(modules);
+    }
+}    // namespace hal
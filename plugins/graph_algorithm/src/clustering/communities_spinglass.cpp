@@ -20,11 +20,36 @@ namespace hal
 
         log_info("graph_algorithm", "netlist has {} gates and {} nets", nl->get_gates().size(), nl->get_nets().size());
 
+        std::unique_ptr<NetlistGraph> graph;
+        if (auto res = NetlistGraph::from_netlist(nl); res.is_error())
+        {
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::map<int, std::set<Gate*>>();
+        }
+        else
+        {
+            graph = res.get();
+        }
+
+        return get_communities_spinglass(graph.get(), spins);
+    }
+
+    std::map<int, std::set<Gate*>> GraphAlgorithmPlugin::get_communities_spinglass(const NetlistGraph* nl_graph, u32 const spins)
+    {
+        if (nl_graph == nullptr)
+        {
+            log_error(this->get_name(), "{}", "parameter 'graph' is nullptr");
+            return std::map<int, std::set<Gate*>>();
+        }
+
         // get igraph
         igraph_t graph;
-        std::map<int, Gate*> vertex_to_gate = get_igraph_directed(nl, &graph);
+        if (auto res = nl_graph->to_igraph(&graph); res.is_error())
+        {
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::map<int, std::set<Gate*>>();
+        }
 
-        
         igraph_real_t modularity, temperature;
         igraph_vector_t membership, csize;
 
@@ -57,7 +82,7 @@ namespace hal
         }
 
         // map back to HAL structures
-        auto community_sets = get_memberships_for_hal(&graph, membership, vertex_to_gate);
+        auto community_sets = nl_graph->get_memberships(&membership);
 
         igraph_destroy(&graph);
         igraph_vector_destroy(&membership);
@@ -41,60 +41,35 @@ namespace hal
             }
         } while (deleted_leave);
 
-        /* map netlist to igraph IDs for both directions */
-        std::map<int, int> nl_igraph_id_match, igraph_nl_id_match;
-        u32 id_count = 0;
-        for (const auto& single_gate : nl->get_gates())
+        std::unique_ptr<NetlistGraph> graph;
+        if (auto res = NetlistGraph::from_netlist(nl); res.is_error())
         {
-            nl_igraph_id_match[single_gate->get_id()] = id_count;
-            igraph_nl_id_match[id_count]              = single_gate->get_id();
-            id_count++;
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::map<int, std::set<Gate*>>();
         }
-
-        /* count amount of nets, with all destinations of all nets */
-        u32 edge_counter = 0;
-        for (auto net : nl->get_nets())
+        else
         {
-            assert(net->get_sources().size() == 1);
-            if (net->get_sources().front()->get_gate() == nullptr)
-                continue;
-
-            for (const auto& successor : net->get_destinations())
-            {
-                if (successor->get_gate() == nullptr)
-                    continue;
-                edge_counter += 2;
-            }
+            graph = res.get();
         }
 
-        /* transform all nets to igraph_real_t */
-        igraph_real_t* edges     = new igraph_real_t[edge_counter];
-        u32 edge_vertice_counter = 0;
-        for (auto net : nl->get_nets())
-        {
-            assert(net->get_sources().size() == 1);
-            Gate* predecessor = net->get_sources().front()->get_gate();
-            if (predecessor == nullptr)
-                continue;
-            u32 predecessor_id = nl_igraph_id_match[predecessor->get_id()];
+        return get_communities(graph.get());
+    }
 
-            for (const auto& successor : net->get_destinations())
-            {
-                if (successor->get_gate() == nullptr)
-                    continue;
-                auto successor_id             = nl_igraph_id_match[successor->get_gate()->get_id()];
-                edges[edge_vertice_counter++] = (igraph_real_t)predecessor_id;
-                edges[edge_vertice_counter++] = (igraph_real_t)successor_id;
-            }
+    std::map<int, std::set<Gate*>> GraphAlgorithmPlugin::get_communities(const NetlistGraph* nl_graph)
+    {
+        if (nl_graph == nullptr)
+        {
+            log_error(this->get_name(), "{}", "parameter 'graph' is nullptr");
+            return std::map<int, std::set<Gate*>>();
         }
 
-        /* create and add edges to the graph */
+        /* create an undirected graph with one edge per connection between two gates */
         igraph_t graph;
-        igraph_vector_t netlist_edges;
-        igraph_vector_init_copy(&netlist_edges, edges, edge_counter);
-        delete[] edges;
-        igraph_create(&graph, &netlist_edges, nl->get_gates().size(), IGRAPH_UNDIRECTED);
-        igraph_vector_destroy(&netlist_edges);
+        if (auto res = nl_graph->to_igraph(&graph, false); res.is_error())
+        {
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::map<int, std::set<Gate*>>();
+        }
 
         /* remove double edges */
         igraph_simplify(&graph, true, false, 0);
@@ -111,11 +86,7 @@ namespace hal
         igraph_destroy(&graph);
 
         /* group gates by community membership */
-        std::map<int, std::set<Gate*>> community_sets;
-        for (int i = 0; i < igraph_vector_size(&membership); i++)
-        {
-            community_sets[(int)VECTOR(membership)[i]].insert(nl->get_gate_by_id(igraph_nl_id_match[i]));
-        }
+        std::map<int, std::set<Gate*>> community_sets = nl_graph->get_memberships(&membership);
         igraph_vector_destroy(&membership);
 
         return community_sets;
@@ -0,0 +1,139 @@
+#include "graph_algorithm/plugin_graph_algorithm.h"
+#include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace hal
+{
+    namespace
+    {
+        // number of vertices handed to a thread at once
+        const u32 chunk_size = 4096;
+
+        /**
+         * Computes the length of the longest path from any vertex without incoming edges to every vertex, following the edges given by the offsets and targets.
+         * The vertices are processed level by level (Kahn's algorithm), all vertices of a level are handled in parallel.
+         * Vertices on or behind a cycle are never reached, hence the number of vertices that have been assigned a level is returned.
+         */
+        u32 compute_levels(const std::vector<u32>& offsets, const std::vector<u32>& targets, const std::vector<u32>& reverse_offsets, std::vector<u32>& levels)
+        {
+            const u32 num_vertices = offsets.size() - 1;
+            const u32 num_chunks   = (num_vertices + chunk_size - 1) / chunk_size;
+
+            std::vector<std::atomic<u32>> remaining_inputs(num_vertices);
+            std::vector<std::vector<u32>> chunks(num_chunks);
+            utils::parallel_for(num_chunks, [&](u32 c) {
+                const u32 end = std::min(num_vertices, (c + 1) * chunk_size);
+                for (u32 v = c * chunk_size; v < end; v++)
+                {
+                    remaining_inputs[v] = reverse_offsets[v + 1] - reverse_offsets[v];
+                    if (remaining_inputs[v] == 0)
+                    {
+                        chunks[c].push_back(v);
+                    }
+                }
+            });
+
+            levels.assign(num_vertices, 0);
+
+            u32 num_assigned = 0;
+            for (u32 level = 0; std::any_of(chunks.begin(), chunks.end(), [](const auto& chunk) { return !chunk.empty(); }); level++)
+            {
+                std::vector<u32> frontier;
+                for (auto& chunk : chunks)
+                {
+                    frontier.insert(frontier.end(), chunk.begin(), chunk.end());
+                    chunk.clear();
+                }
+                num_assigned += frontier.size();
+
+                // a vertex joins the next level once its last input has been processed
+                chunks.resize((frontier.size() + chunk_size - 1) / chunk_size);
+                utils::parallel_for(chunks.size(), [&](u32 c) {
+                    const u32 end = std::min((u32)frontier.size(), (c + 1) * chunk_size);
+                    for (u32 i = c * chunk_size; i < end; i++)
+                    {
+                        const u32 v = frontier[i];
+                        levels[v]   = level;
+                        for (u32 e = offsets[v]; e < offsets[v + 1]; e++)
+                        {
+                            if (--remaining_inputs[targets[e]] == 0)
+                            {
+                                chunks[c].push_back(targets[e]);
+                            }
+                        }
+                    }
+                });
+            }
+
+            return num_assigned;
+        }
+
+        Result<std::vector<u32>> get_levels(const NetlistGraph* graph, bool backwards, const std::string& name)
+        {
+            if (graph == nullptr)
+            {
+                return ERR("could not get " + name + ": graph is a 'nullptr'");
+            }
+
+            std::vector<u32> levels;
+            const u32 num_assigned = backwards ? compute_levels(graph->get_in_offsets(), graph->get_in_edges(), graph->get_out_offsets(), levels)
+                                               : compute_levels(graph->get_out_offsets(), graph->get_out_edges(), graph->get_in_offsets(), levels);
+            if (num_assigned != graph->get_num_vertices())
+            {
+                return ERR("could not get " + name + ": " + std::to_string(graph->get_num_vertices() - num_assigned) + " of " + std::to_string(graph->get_num_vertices())
+                           + " vertices are part of or depend on a cycle");
+            }
+
+            return OK(levels);
+        }
+    }    // namespace
+
+    Result<std::vector<u32>> GraphAlgorithmPlugin::get_topological_order(const NetlistGraph* graph)
+    {
+        std::vector<u32> levels;
+        if (auto res = get_levels(graph, false, "topological order"); res.is_error())
+        {
+            return ERR(res.get_error());
+        }
+        else
+        {
+            levels = res.get();
+        }
+
+        // sort the vertices by level using counting sort, vertices of the same level stay ordered by vertex
+        std::vector<u32> level_offsets;
+        for (u32 level : levels)
+        {
+            if (level + 1 >= level_offsets.size())
+            {
+                level_offsets.resize(level + 2, 0);
+            }
+            level_offsets[level + 1]++;
+        }
+        for (u32 level = 1; level < level_offsets.size(); level++)
+        {
+            level_offsets[level] += level_offsets[level - 1];
+        }
+
+        std::vector<u32> order(levels.size());
+        for (u32 v = 0; v < levels.size(); v++)
+        {
+            order[level_offsets[levels[v]]++] = v;
+        }
+
+        return OK(order);
+    }
+
+    Result<std::vector<u32>> GraphAlgorithmPlugin::get_logic_levels(const NetlistGraph* graph)
+    {
+        return get_levels(graph, false, "logic levels");
+    }
+
+    Result<std::vector<u32>> GraphAlgorithmPlugin::get_logic_depths(const NetlistGraph* graph)
+    {
+        return get_levels(graph, true, "logic depths");
+    }
+}    // namespace hal
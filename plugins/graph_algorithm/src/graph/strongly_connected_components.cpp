@@ -4,12 +4,228 @@
 #include "hal_core/netlist/netlist.h"
 #include "hal_core/plugin_system/plugin_manager.h"
 #include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
 
-#include <igraph/igraph.h>
-#include <stdio.h>
+#include <atomic>
+#include <limits>
 
 namespace hal
 {
+    namespace
+    {
+        // number of vertices handed to a thread at once
+        const u32 chunk_size = 4096;
+
+        const u32 no_component = std::numeric_limits<u32>::max();
+
+        /**
+         * Calls a function for every vertex of a frontier in parallel and collects the vertices it adds to the next frontier.
+         */
+        template<typename F>
+        std::vector<u32> expand_frontier(const std::vector<u32>& frontier, const F& visit)
+        {
+            const u32 num_chunks = (frontier.size() + chunk_size - 1) / chunk_size;
+            std::vector<std::vector<u32>> next_chunks(num_chunks);
+            utils::parallel_for(num_chunks, [&frontier, &visit, &next_chunks](u32 c) {
+                const u32 end = std::min((u32)frontier.size(), (c + 1) * chunk_size);
+                for (u32 i = c * chunk_size; i < end; i++)
+                {
+                    visit(frontier[i], next_chunks[c]);
+                }
+            });
+
+            std::vector<u32> next;
+            for (const auto& chunk : next_chunks)
+            {
+                next.insert(next.end(), chunk.begin(), chunk.end());
+            }
+            return next;
+        }
+
+        /**
+         * Computes the strongly connected components of a netlist graph, every vertex is labeled with a vertex of its component.
+         *
+         * Most vertices of a netlist are not part of any cycle, so vertices without incoming or outgoing edges are removed first until none are left.
+         * The largest remaining component, which typically contains the sequential feedback of the design, is then found by a forward and a backward search from a pivot vertex.
+         * Both steps run in parallel, the few vertices that are left are handled by Tarjan's algorithm.
+         */
+        std::vector<u32> find_components(const NetlistGraph* graph)
+        {
+            const u32 num_vertices             = graph->get_num_vertices();
+            const std::vector<u32>& out_offsets = graph->get_out_offsets();
+            const std::vector<u32>& out_edges   = graph->get_out_edges();
+            const std::vector<u32>& in_offsets  = graph->get_in_offsets();
+            const std::vector<u32>& in_edges    = graph->get_in_edges();
+
+            std::vector<u32> component(num_vertices, no_component);
+            std::vector<std::atomic<u8>> removed(num_vertices);
+            std::vector<std::atomic<u32>> in_degrees(num_vertices);
+            std::vector<std::atomic<u32>> out_degrees(num_vertices);
+
+            // trim vertices that cannot be part of a cycle, each of them is a component of its own
+            std::vector<std::vector<u32>> start_chunks((num_vertices + chunk_size - 1) / chunk_size);
+            utils::parallel_for(start_chunks.size(), [&](u32 c) {
+                const u32 end = std::min(num_vertices, (c + 1) * chunk_size);
+                for (u32 v = c * chunk_size; v < end; v++)
+                {
+                    in_degrees[v]  = in_offsets[v + 1] - in_offsets[v];
+                    out_degrees[v] = out_offsets[v + 1] - out_offsets[v];
+                    removed[v]     = (in_degrees[v] == 0 || out_degrees[v] == 0) ? 1 : 0;
+                    if (removed[v])
+                    {
+                        start_chunks[c].push_back(v);
+                    }
+                }
+            });
+
+            std::vector<u32> frontier;
+            for (const auto& chunk : start_chunks)
+            {
+                frontier.insert(frontier.end(), chunk.begin(), chunk.end());
+            }
+
+            while (!frontier.empty())
+            {
+                frontier = expand_frontier(frontier, [&](u32 v, std::vector<u32>& next) {
+                    component[v] = v;
+                    for (u32 e = out_offsets[v]; e < out_offsets[v + 1]; e++)
+                    {
+                        const u32 w = out_edges[e];
+                        if (--in_degrees[w] == 0 && removed[w].exchange(1) == 0)
+                        {
+                            next.push_back(w);
+                        }
+                    }
+                    for (u32 e = in_offsets[v]; e < in_offsets[v + 1]; e++)
+                    {
+                        const u32 u = in_edges[e];
+                        if (--out_degrees[u] == 0 && removed[u].exchange(1) == 0)
+                        {
+                            next.push_back(u);
+                        }
+                    }
+                });
+            }
+
+            // choose the remaining vertex with the most remaining paths through it as pivot
+            u32 pivot      = no_component;
+            u64 best_score = 0;
+            for (u32 v = 0; v < num_vertices; v++)
+            {
+                if (!removed[v] && (pivot == no_component || (u64)in_degrees[v] * out_degrees[v] > best_score))
+                {
+                    pivot      = v;
+                    best_score = (u64)in_degrees[v] * out_degrees[v];
+                }
+            }
+
+            if (pivot != no_component)
+            {
+                // bit 0 marks vertices reachable from the pivot, bit 1 vertices of that set that reach the pivot
+                std::vector<std::atomic<u8>> marks(num_vertices);
+                for (auto& mark : marks)
+                {
+                    mark.store(0, std::memory_order_relaxed);
+                }
+
+                marks[pivot] = 3;
+                frontier     = {pivot};
+                while (!frontier.empty())
+                {
+                    frontier = expand_frontier(frontier, [&](u32 v, std::vector<u32>& next) {
+                        for (u32 e = out_offsets[v]; e < out_offsets[v + 1]; e++)
+                        {
+                            const u32 w = out_edges[e];
+                            if (!removed[w] && (marks[w].fetch_or(1) & 1) == 0)
+                            {
+                                next.push_back(w);
+                            }
+                        }
+                    });
+                }
+
+                frontier = {pivot};
+                while (!frontier.empty())
+                {
+                    frontier = expand_frontier(frontier, [&](u32 v, std::vector<u32>& next) {
+                        component[v] = pivot;
+                        for (u32 e = in_offsets[v]; e < in_offsets[v + 1]; e++)
+                        {
+                            const u32 u = in_edges[e];
+                            if ((marks[u].load() & 1) != 0 && (marks[u].fetch_or(2) & 2) == 0)
+                            {
+                                next.push_back(u);
+                            }
+                        }
+                    });
+                }
+            }
+
+            // Tarjan's algorithm on all vertices that are still unassigned
+            std::vector<u32> index(num_vertices, no_component);
+            std::vector<u32> low_link(num_vertices, 0);
+            std::vector<u32> scc_stack;
+            std::vector<std::pair<u32, u32>> call_stack;
+            u32 next_index = 0;
+            for (u32 root = 0; root < num_vertices; root++)
+            {
+                if (component[root] != no_component || index[root] != no_component)
+                {
+                    continue;
+                }
+
+                index[root] = low_link[root] = next_index++;
+                scc_stack.push_back(root);
+                call_stack.emplace_back(root, out_offsets[root]);
+                while (!call_stack.empty())
+                {
+                    auto& [v, e] = call_stack.back();
+                    if (e < out_offsets[v + 1])
+                    {
+                        const u32 w = out_edges[e++];
+                        if (component[w] != no_component && index[w] == no_component)
+                        {
+                            // already assigned by trimming or the forward-backward search
+                            continue;
+                        }
+                        else if (index[w] == no_component)
+                        {
+                            index[w] = low_link[w] = next_index++;
+                            scc_stack.push_back(w);
+                            call_stack.emplace_back(w, out_offsets[w]);
+                        }
+                        else if (component[w] == no_component)
+                        {
+                            low_link[v] = std::min(low_link[v], index[w]);
+                        }
+                        continue;
+                    }
+
+                    const u32 finished = v;
+                    call_stack.pop_back();
+                    if (!call_stack.empty())
+                    {
+                        const u32 parent   = call_stack.back().first;
+                        low_link[parent] = std::min(low_link[parent], low_link[finished]);
+                    }
+
+                    if (low_link[finished] == index[finished])
+                    {
+                        u32 w;
+                        do
+                        {
+                            w = scc_stack.back();
+                            scc_stack.pop_back();
+                            component[w] = finished;
+                        } while (w != finished);
+                    }
+                }
+            }
+
+            return component;
+        }
+    }    // namespace
+
     std::vector<std::vector<Gate*>> GraphAlgorithmPlugin::get_strongly_connected_components(Netlist* nl)
     {
         if (nl == nullptr)
@@ -18,38 +234,72 @@ namespace hal
             return std::vector<std::vector<Gate*>>();
         }
 
-        // get igraph
-        igraph_t graph;
-        std::map<int, Gate*> vertex_to_gate = get_igraph_directed(nl, &graph);
+        std::unique_ptr<NetlistGraph> graph;
+        if (auto res = NetlistGraph::from_netlist(nl); res.is_error())
+        {
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::vector<std::vector<Gate*>>();
+        }
+        else
+        {
+            graph = res.get();
+        }
 
-        igraph_vector_t membership, csize;
-        igraph_integer_t number_of_clusters;
-        igraph_vector_init(&membership, 0);
-        igraph_vector_init(&csize, 0);
+        return get_strongly_connected_components(graph.get());
+    }
 
-        // run scc
-        igraph_clusters(&graph, &membership, &csize, &number_of_clusters, IGRAPH_STRONG);
+    std::vector<std::vector<Gate*>> GraphAlgorithmPlugin::get_strongly_connected_components(const NetlistGraph* nl_graph)
+    {
+        std::vector<u32> component_ids;
+        if (auto res = get_strongly_connected_component_ids(nl_graph); res.is_error())
+        {
+            log_error(this->get_name(), "{}", res.get_error().get());
+            return std::vector<std::vector<Gate*>>();
+        }
+        else
+        {
+            component_ids = res.get();
+        }
 
-        // map back to HAL structures
-        std::map<int, std::set<Gate*>> ssc_membership = get_memberships_for_hal(&graph, membership, vertex_to_gate);
+        // components are numbered by their smallest vertex, so the last vertex does not necessarily have the highest ID
+        u32 num_components = 0;
+        for (u32 id : component_ids)
+        {
+            num_components = std::max(num_components, id + 1);
+        }
 
-        // convert to set
-        std::vector<std::vector<Gate*>> sccs;
-        for (const auto& scc : ssc_membership)
+        std::vector<std::vector<Gate*>> sccs(num_components);
+        for (u32 v = 0; v < component_ids.size(); v++)
         {
-            std::vector<Gate*> scc_vector;
-            for (const auto& scc_gate : scc.second)
+            sccs[component_ids[v]].push_back(nl_graph->get_gates()[v]);
+        }
+
+        return sccs;
+    }
+
+    Result<std::vector<u32>> GraphAlgorithmPlugin::get_strongly_connected_component_ids(const NetlistGraph* graph)
+    {
+        if (graph == nullptr)
+        {
+            return ERR("could not get strongly connected components: graph is a 'nullptr'");
+        }
+
+        const std::vector<u32> component = find_components(graph);
+
+        // number the components in the order of their smallest vertex to get the same result regardless of the number of threads
+        std::vector<u32> representative_to_id(component.size(), no_component);
+        std::vector<u32> component_ids(component.size());
+        u32 next_id = 0;
+        for (u32 v = 0; v < component.size(); v++)
+        {
+            u32& id = representative_to_id[component[v]];
+            if (id == no_component)
             {
-                scc_vector.push_back(scc_gate);
+                id = next_id++;
             }
-            sccs.push_back(scc_vector);
+            component_ids[v] = id;
         }
 
-        // cleanup
-        igraph_destroy(&graph);
-        igraph_vector_destroy(&membership);
-        igraph_vector_destroy(&csize);
-
-        return sccs;
+        return OK(component_ids);
     }
 }    // namespace hal
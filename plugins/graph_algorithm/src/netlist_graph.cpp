@@ -0,0 +1,249 @@
+#include "graph_algorithm/netlist_graph.h"
+
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/module.h"
+#include "hal_core/netlist/net.h"
+#include "hal_core/netlist/netlist.h"
+#include "hal_core/utilities/utils.h"
+
+#include <limits>
+
+namespace hal
+{
+    namespace
+    {
+        // marks gate IDs that do not belong to a vertex
+        const u32 no_vertex = std::numeric_limits<u32>::max();
+    }    // namespace
+
+    NetlistGraph::NetlistGraph(Netlist* netlist) : m_netlist(netlist)
+    {
+    }
+
+    Result<std::unique_ptr<NetlistGraph>> NetlistGraph::from_netlist(Netlist* netlist, bool combinational_only, const Module* module)
+    {
+        if (netlist == nullptr)
+        {
+            return ERR("could not create netlist graph: netlist is a 'nullptr'");
+        }
+
+        if (module != nullptr && module->get_netlist() != netlist)
+        {
+            return ERR("could not create netlist graph for netlist with ID " + std::to_string(netlist->get_id()) + ": module '" + module->get_name() + "' with ID "
+                       + std::to_string(module->get_id()) + " belongs to a different netlist");
+        }
+
+        auto graph = std::unique_ptr<NetlistGraph>(new NetlistGraph(netlist));
+
+        std::vector<Gate*> candidates;
+        if (module != nullptr)
+        {
+            candidates = module->get_gates(nullptr, true);
+        }
+        else
+        {
+            candidates = netlist->get_gates();
+        }
+
+        // number the vertices by gate ID without sorting the gates
+        u32 max_gate_id = 0;
+        for (const Gate* gate : candidates)
+        {
+            max_gate_id = std::max(max_gate_id, gate->get_id());
+        }
+
+        std::vector<Gate*> gates_by_id(candidates.empty() ? 0 : max_gate_id + 1, nullptr);
+        for (Gate* gate : candidates)
+        {
+            if (!combinational_only || gate->get_type()->has_property(GateTypeProperty::combinational))
+            {
+                gates_by_id[gate->get_id()] = gate;
+            }
+        }
+
+        graph->m_gate_id_to_vertex.assign(gates_by_id.size(), no_vertex);
+        for (Gate* gate : gates_by_id)
+        {
+            if (gate != nullptr)
+            {
+                graph->m_gate_id_to_vertex[gate->get_id()] = graph->m_gates.size();
+                graph->m_gates.push_back(gate);
+            }
+        }
+
+        const u32 num_vertices = graph->m_gates.size();
+
+        auto get_target_vertex = [&graph](const Endpoint* ep) {
+            const u32 id = ep->get_gate()->get_id();
+            return id < graph->m_gate_id_to_vertex.size() ? graph->m_gate_id_to_vertex[id] : no_vertex;
+        };
+
+        // count the outgoing edges of all vertices first to allocate the edges at once
+        std::vector<u32> out_degrees(num_vertices, 0);
+        utils::parallel_for(num_vertices, [&graph, &out_degrees, &get_target_vertex](u32 v) {
+            for (const Net* net : graph->m_gates[v]->get_fan_out_nets())
+            {
+                for (const Endpoint* ep : net->get_destinations())
+                {
+                    if (get_target_vertex(ep) != no_vertex)
+                    {
+                        out_degrees[v]++;
+                    }
+                }
+            }
+        });
+
+        graph->m_out_offsets.assign(num_vertices + 1, 0);
+        for (u32 v = 0; v < num_vertices; v++)
+        {
+            graph->m_out_offsets[v + 1] = graph->m_out_offsets[v] + out_degrees[v];
+        }
+
+        graph->m_out_edges.resize(graph->m_out_offsets[num_vertices]);
+        utils::parallel_for(num_vertices, [&graph, &get_target_vertex](u32 v) {
+            u32 pos = graph->m_out_offsets[v];
+            for (const Net* net : graph->m_gates[v]->get_fan_out_nets())
+            {
+                for (const Endpoint* ep : net->get_destinations())
+                {
+                    if (const u32 target = get_target_vertex(ep); target != no_vertex)
+                    {
+                        graph->m_out_edges[pos++] = target;
+                    }
+                }
+            }
+        });
+
+        // transpose the outgoing edges, sources end up ordered by vertex
+        graph->m_in_offsets.assign(num_vertices + 1, 0);
+        for (u32 target : graph->m_out_edges)
+        {
+            graph->m_in_offsets[target + 1]++;
+        }
+        for (u32 v = 0; v < num_vertices; v++)
+        {
+            graph->m_in_offsets[v + 1] += graph->m_in_offsets[v];
+        }
+
+        graph->m_in_edges.resize(graph->m_out_edges.size());
+        std::vector<u32> in_positions(graph->m_in_offsets.begin(), graph->m_in_offsets.end() - 1);
+        for (u32 v = 0; v < num_vertices; v++)
+        {
+            for (u32 e = graph->m_out_offsets[v]; e < graph->m_out_offsets[v + 1]; e++)
+            {
+                graph->m_in_edges[in_positions[graph->m_out_edges[e]]++] = v;
+            }
+        }
+
+        return OK(std::move(graph));
+    }
+
+    Netlist* NetlistGraph::get_netlist() const
+    {
+        return m_netlist;
+    }
+
+    u32 NetlistGraph::get_num_vertices() const
+    {
+        return m_gates.size();
+    }
+
+    u32 NetlistGraph::get_num_edges() const
+    {
+        return m_out_edges.size();
+    }
+
+    const std::vector<Gate*>& NetlistGraph::get_gates() const
+    {
+        return m_gates;
+    }
+
+    Result<Gate*> NetlistGraph::get_gate(u32 vertex) const
+    {
+        if (vertex >= m_gates.size())
+        {
+            return ERR("could not get gate of vertex " + std::to_string(vertex) + ": graph only has " + std::to_string(m_gates.size()) + " vertices");
+        }
+
+        return OK(m_gates[vertex]);
+    }
+
+    Result<u32> NetlistGraph::get_vertex(const Gate* gate) const
+    {
+        if (gate == nullptr)
+        {
+            return ERR("could not get vertex of gate: gate is a 'nullptr'");
+        }
+
+        if (gate->get_id() >= m_gate_id_to_vertex.size() || m_gate_id_to_vertex[gate->get_id()] == no_vertex || m_gates[m_gate_id_to_vertex[gate->get_id()]] != gate)
+        {
+            return ERR("could not get vertex of gate '" + gate->get_name() + "' with ID " + std::to_string(gate->get_id()) + ": gate is not part of the graph");
+        }
+
+        return OK(m_gate_id_to_vertex[gate->get_id()]);
+    }
+
+    const std::vector<u32>& NetlistGraph::get_out_offsets() const
+    {
+        return m_out_offsets;
+    }
+
+    const std::vector<u32>& NetlistGraph::get_out_edges() const
+    {
+        return m_out_edges;
+    }
+
+    const std::vector<u32>& NetlistGraph::get_in_offsets() const
+    {
+        return m_in_offsets;
+    }
+
+    const std::vector<u32>& NetlistGraph::get_in_edges() const
+    {
+        return m_in_edges;
+    }
+
+    Result<std::monostate> NetlistGraph::to_igraph(igraph_t* graph, bool directed) const
+    {
+        if (graph == nullptr)
+        {
+            return ERR("could not create igraph graph: graph is a 'nullptr'");
+        }
+
+        igraph_vector_t edges;
+        if (igraph_vector_init(&edges, 2 * (long)m_out_edges.size()) != IGRAPH_SUCCESS)
+        {
+            return ERR("could not create igraph graph: unable to allocate " + std::to_string(m_out_edges.size()) + " edges");
+        }
+
+        u64 pos = 0;
+        for (u32 v = 0; v < m_gates.size(); v++)
+        {
+            for (u32 e = m_out_offsets[v]; e < m_out_offsets[v + 1]; e++)
+            {
+                VECTOR(edges)[pos++] = v;
+                VECTOR(edges)[pos++] = m_out_edges[e];
+            }
+        }
+
+        const int res = igraph_create(graph, &edges, m_gates.size(), directed ? IGRAPH_DIRECTED : IGRAPH_UNDIRECTED);
+        igraph_vector_destroy(&edges);
+        if (res != IGRAPH_SUCCESS)
+        {
+            return ERR("could not create igraph graph: igraph returned error code " + std::to_string(res));
+        }
+
+        return OK({});
+    }
+
+    std::map<int, std::set<Gate*>> NetlistGraph::get_memberships(const igraph_vector_t* membership) const
+    {
+        std::map<int, std::set<Gate*>> community_sets;
+        const u32 num_entries = std::min((u32)igraph_vector_size(membership), (u32)m_gates.size());
+        for (u32 v = 0; v < num_entries; v++)
+        {
+            community_sets[(int)VECTOR(*membership)[v]].insert(m_gates[v]);
+        }
+        return community_sets;
+    }
+}    // namespace hal
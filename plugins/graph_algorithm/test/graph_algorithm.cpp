@@ -0,0 +1,316 @@
+#include "graph_algorithm/netlist_graph.h"
+#include "graph_algorithm/plugin_graph_algorithm.h"
+
+#include "netlist_test_utils.h"
+#include "gate_library_test_utils.h"
+
+#include <set>
+
+namespace hal {
+
+    class GraphAlgorithmTest : public ::testing::Test {
+    protected:
+        virtual void SetUp()
+        {
+            NO_COUT_BLOCK;
+            test_utils::init_log_channels();
+        }
+
+        virtual void TearDown()
+        {
+        }
+
+        /**
+         * Creates a netlist holding a cycle through a flip-flop, a combinational cycle, and a gate that is not part of any cycle.
+         * In order of their IDs the gates are: ff, a, b, c, d, e, f, g.
+         *
+         *      ff -> a -> b -> c -> d -> ff
+         *            a ------> c
+         *            a -> e
+         *      f <-> g
+         */
+        std::unique_ptr<Netlist> create_cyclic_netlist()
+        {
+            std::unique_ptr<Netlist> nl = test_utils::create_empty_netlist();
+            const GateLibrary* gl = nl->get_gate_library();
+
+            Gate* ff = nl->create_gate(gl->get_gate_type_by_name("DFF"), "ff");
+            Gate* a  = nl->create_gate(gl->get_gate_type_by_name("AND2"), "a");
+            Gate* b  = nl->create_gate(gl->get_gate_type_by_name("AND2"), "b");
+            Gate* c  = nl->create_gate(gl->get_gate_type_by_name("AND2"), "c");
+            Gate* d  = nl->create_gate(gl->get_gate_type_by_name("AND2"), "d");
+            Gate* e  = nl->create_gate(gl->get_gate_type_by_name("AND2"), "e");
+            Gate* f  = nl->create_gate(gl->get_gate_type_by_name("AND2"), "f");
+            Gate* g  = nl->create_gate(gl->get_gate_type_by_name("AND2"), "g");
+
+            test_utils::connect(nl.get(), ff, "Q", a, "I0");
+            test_utils::connect(nl.get(), a, "O", b, "I0");
+            test_utils::connect(nl.get(), a, "O", c, "I0");
+            test_utils::connect(nl.get(), a, "O", e, "I0");
+            test_utils::connect(nl.get(), b, "O", c, "I1");
+            test_utils::connect(nl.get(), c, "O", d, "I0");
+            test_utils::connect(nl.get(), d, "O", ff, "D");
+            test_utils::connect(nl.get(), f, "O", g, "I0");
+            test_utils::connect(nl.get(), g, "O", f, "I0");
+
+            nl->create_module("core", nl->get_top_module(), {a, b, c, d, e});
+
+            return nl;
+        }
+
+        /**
+         * Creates a netlist of two clusters of 8 gates each that are connected by a single net.
+         * Within a cluster, gate i drives gates i + 1 and i + 2 (modulo 8).
+         */
+        std::unique_ptr<Netlist> create_clustered_netlist()
+        {
+            std::unique_ptr<Netlist> nl = test_utils::create_empty_netlist();
+            const GateLibrary* gl = nl->get_gate_library();
+
+            std::vector<Gate*> gates;
+            for (u32 i = 0; i < 16; i++)
+            {
+                // the first gate of the second cluster takes the connection between both clusters as third input
+                GateType* type = (i == 8) ? gl->get_gate_type_by_name("AND3") : gl->get_gate_type_by_name("AND2");
+                gates.push_back(nl->create_gate(type, "g" + std::to_string(i)));
+            }
+
+            for (u32 i = 0; i < 16; i++)
+            {
+                u32 base = (i / 8) * 8;
+                test_utils::connect(nl.get(), gates.at(i), "O", gates.at(base + (i + 1) % 8), "I0");
+                test_utils::connect(nl.get(), gates.at(i), "O", gates.at(base + (i + 2) % 8), "I1");
+            }
+            test_utils::connect(nl.get(), gates.at(0), "O", gates.at(8), "I2");
+
+            return nl;
+        }
+
+        /**
+         * Creates a netlist of a single ring of 64 buffers, which has no obvious community structure.
+         */
+        std::unique_ptr<Netlist> create_ring_netlist()
+        {
+            std::unique_ptr<Netlist> nl = test_utils::create_empty_netlist();
+            const GateLibrary* gl = nl->get_gate_library();
+
+            std::vector<Gate*> gates;
+            for (u32 i = 0; i < 64; i++)
+            {
+                gates.push_back(nl->create_gate(gl->get_gate_type_by_name("BUF"), "g" + std::to_string(i)));
+            }
+
+            for (u32 i = 0; i < 64; i++)
+            {
+                test_utils::connect(nl.get(), gates.at(i), "O", gates.at((i + 1) % 64), "I");
+            }
+
+            return nl;
+        }
+
+        /**
+         * Checks whether every community of the fine partition is fully contained within a single community of the coarse partition.
+         */
+        bool is_coarsening(const std::vector<u32>& fine, const std::vector<u32>& coarse)
+        {
+            std::map<u32, u32> fine_to_coarse;
+            for (u32 v = 0; v < fine.size(); v++)
+            {
+                if (const auto [it, inserted] = fine_to_coarse.insert({fine.at(v), coarse.at(v)}); !inserted && it->second != coarse.at(v))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        u32 count_communities(const std::vector<u32>& communities)
+        {
+            return std::set<u32>(communities.begin(), communities.end()).size();
+        }
+    };
+
+    /**
+     * Testing the computation of strongly connected components on a netlist graph with and without sequential gates.
+     *
+     * Functions: get_strongly_connected_component_ids
+     */
+    TEST_F(GraphAlgorithmTest, check_strongly_connected_component_ids)
+    {
+        TEST_START
+        {
+            std::unique_ptr<Netlist> nl = create_cyclic_netlist();
+            ASSERT_NE(nl, nullptr);
+            GraphAlgorithmPlugin plugin;
+
+            {
+                // all gates, the flip-flop closes the cycle through a, b, c, and d
+                auto graph_res = NetlistGraph::from_netlist(nl.get());
+                ASSERT_TRUE(graph_res.is_ok());
+                std::unique_ptr<NetlistGraph> graph = graph_res.get();
+                ASSERT_EQ(graph->get_num_vertices(), 8);
+
+                auto res = plugin.get_strongly_connected_component_ids(graph.get());
+                ASSERT_TRUE(res.is_ok());
+                EXPECT_EQ(res.get(), std::vector<u32>({0, 0, 0, 0, 0, 1, 2, 2}));
+            }
+            {
+                // combinational gates only, only f and g remain in a common component
+                auto graph_res = NetlistGraph::from_netlist(nl.get(), true);
+                ASSERT_TRUE(graph_res.is_ok());
+                std::unique_ptr<NetlistGraph> graph = graph_res.get();
+                ASSERT_EQ(graph->get_num_vertices(), 7);
+
+                auto res = plugin.get_strongly_connected_component_ids(graph.get());
+                ASSERT_TRUE(res.is_ok());
+                EXPECT_EQ(res.get(), std::vector<u32>({0, 1, 2, 3, 4, 5, 5}));
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing the computation of logic levels and depths, which requires an acyclic netlist graph.
+     *
+     * Functions: get_logic_levels, get_logic_depths, get_topological_order
+     */
+    TEST_F(GraphAlgorithmTest, check_logic_levels)
+    {
+        TEST_START
+        {
+            std::unique_ptr<Netlist> nl = create_cyclic_netlist();
+            ASSERT_NE(nl, nullptr);
+            GraphAlgorithmPlugin plugin;
+
+            {
+                // the combinational cycle of f and g remains
+                auto graph_res = NetlistGraph::from_netlist(nl.get(), true);
+                ASSERT_TRUE(graph_res.is_ok());
+                std::unique_ptr<NetlistGraph> graph = graph_res.get();
+
+                EXPECT_TRUE(plugin.get_logic_levels(graph.get()).is_error());
+                EXPECT_TRUE(plugin.get_logic_depths(graph.get()).is_error());
+                EXPECT_TRUE(plugin.get_topological_order(graph.get()).is_error());
+            }
+            {
+                // restricted to gates a to e
+                Module* core = nl->get_modules([](const Module* m) { return m->get_name() == "core"; }).front();
+                auto graph_res = NetlistGraph::from_netlist(nl.get(), true, core);
+                ASSERT_TRUE(graph_res.is_ok());
+                std::unique_ptr<NetlistGraph> graph = graph_res.get();
+                ASSERT_EQ(graph->get_num_vertices(), 5);
+
+                auto levels = plugin.get_logic_levels(graph.get());
+                ASSERT_TRUE(levels.is_ok());
+                EXPECT_EQ(levels.get(), std::vector<u32>({0, 1, 2, 3, 1}));
+
+                auto depths = plugin.get_logic_depths(graph.get());
+                ASSERT_TRUE(depths.is_ok());
+                EXPECT_EQ(depths.get(), std::vector<u32>({3, 2, 1, 0, 0}));
+
+                auto order = plugin.get_topological_order(graph.get());
+                ASSERT_TRUE(order.is_ok());
+                EXPECT_EQ(order.get(), std::vector<u32>({0, 1, 4, 2, 3}));
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing the Louvain community detection on a netlist graph with two clearly separated clusters.
+     *
+     * Functions: get_community_ids_louvain
+     */
+    TEST_F(GraphAlgorithmTest, check_community_ids_louvain)
+    {
+        TEST_START
+        {
+            std::unique_ptr<Netlist> nl = create_clustered_netlist();
+            ASSERT_NE(nl, nullptr);
+            GraphAlgorithmPlugin plugin;
+
+            auto graph_res = NetlistGraph::from_netlist(nl.get());
+            ASSERT_TRUE(graph_res.is_ok());
+            std::unique_ptr<NetlistGraph> graph = graph_res.get();
+
+            const std::vector<u32> expected = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1};
+            for (u32 seed : {0, 1, 42})
+            {
+                auto res = plugin.get_community_ids_louvain(graph.get(), {}, seed);
+                ASSERT_TRUE(res.is_ok());
+                EXPECT_EQ(res.get(), expected);
+
+                // the same seed always yields the same partition
+                auto again = plugin.get_community_ids_louvain(graph.get(), {}, seed);
+                ASSERT_TRUE(again.is_ok());
+                EXPECT_EQ(again.get(), res.get());
+            }
+
+            {
+                // the bridge is weighted heavier than all other edges combined, hence its endpoints end up in a common community
+                std::vector<double> weights(graph->get_num_edges(), 1.0);
+                const u32 src = graph->get_vertex(nl->get_gate_by_id(1)).get();
+                const u32 dst = graph->get_vertex(nl->get_gate_by_id(9)).get();
+                const std::vector<u32>& out_offsets = graph->get_out_offsets();
+                const std::vector<u32>& out_edges   = graph->get_out_edges();
+                for (u32 e = out_offsets.at(src); e < out_offsets.at(src + 1); e++)
+                {
+                    if (out_edges.at(e) == dst)
+                    {
+                        weights.at(e) = 1000.0;
+                    }
+                }
+
+                auto res = plugin.get_community_ids_louvain(graph.get(), weights);
+                ASSERT_TRUE(res.is_ok());
+                EXPECT_EQ(res.get().at(src), res.get().at(dst));
+            }
+            {
+                // wrong number of edge weights
+                EXPECT_TRUE(plugin.get_community_ids_louvain(graph.get(), {1.0, 2.0}).is_error());
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing that the Louvain community detection stops after the given number of passes.
+     * Every pass only merges communities of the previous pass, so fewer passes yield a finer partition.
+     *
+     * Functions: get_community_ids_louvain
+     */
+    TEST_F(GraphAlgorithmTest, check_community_ids_louvain_max_passes)
+    {
+        TEST_START
+        {
+            std::unique_ptr<Netlist> nl = create_ring_netlist();
+            ASSERT_NE(nl, nullptr);
+            GraphAlgorithmPlugin plugin;
+
+            auto graph_res = NetlistGraph::from_netlist(nl.get());
+            ASSERT_TRUE(graph_res.is_ok());
+            std::unique_ptr<NetlistGraph> graph = graph_res.get();
+
+            auto unlimited = plugin.get_community_ids_louvain(graph.get(), {}, 0, 0);
+            ASSERT_TRUE(unlimited.is_ok());
+
+            auto single = plugin.get_community_ids_louvain(graph.get(), {}, 0, 1);
+            ASSERT_TRUE(single.is_ok());
+            EXPECT_GT(count_communities(single.get()), count_communities(unlimited.get()));
+
+            std::vector<u32> previous = single.get();
+            for (u32 max_passes = 2; max_passes <= 8; max_passes++)
+            {
+                auto res = plugin.get_community_ids_louvain(graph.get(), {}, 0, max_passes);
+                ASSERT_TRUE(res.is_ok());
+                EXPECT_TRUE(is_coarsening(previous, res.get()));
+                EXPECT_TRUE(is_coarsening(res.get(), unlimited.get()));
+                previous = res.get();
+            }
+
+            // the ring has converged long before
+            EXPECT_EQ(previous, unlimited.get());
+        }
+        TEST_END
+    }
+}    // namespace hal
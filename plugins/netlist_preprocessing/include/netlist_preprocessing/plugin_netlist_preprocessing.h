@@ -141,6 +141,8 @@ namespace hal
         /**
          * Parses a design exchange format file and extracts the coordinated of a placed design for each component/gate.
          * The extracted coordinates get annotated to the gates.
+         * If the die area extends into negative coordinates, all coordinates are shifted such that the die area starts at zero.
+         * Components that remain at negative coordinates are skipped with a warning, since such gates would count as not placed.
          * 
          * @param[in] nl - The netlist to operate on.
          * @param[in] def_file - Path to the def file.
@@ -12,10 +12,12 @@
 #include "hal_core/netlist/net.h"
 #include "hal_core/netlist/netlist_utils.h"
 #include "hal_core/utilities/result.h"
-#include "hal_core/utilities/token_stream.h"
+#include "hal_core/utilities/text_scanner.h"
+#include "hal_core/utilities/utils.h"
 
 #include "rapidjson/document.h"
 
+#include <charconv>
 #include <fstream>
 #include <queue>
 #include <regex>
@@ -1275,192 +1277,376 @@ namespace hal
         return OK(counter);
     }
 
-    namespace {
-        struct ComponentData {
-            std::string name;
-            std::string type;
-            u64 x;
-            u64 y;
-        };
+    namespace
+    {
+        // size of the pieces of the COMPONENTS section that are parsed concurrently
+        const size_t def_chunk_size = 1 << 20;
 
-        TokenStream<std::string> tokenize(std::stringstream& ss)
+        bool is_def_whitespace(char c)
         {
-            const std::string delimiters = " ;-";
-            std::string current_token;
-            u32 line_number = 0;
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
 
-            std::string line;
-            bool escaped    = false;
+        bool is_def_delimiter(char c)
+        {
+            return c == ';' || c == '(' || c == ')';
+        }
+
+        /**
+         * Get the next token of a DEF file and advance the position behind it.
+         * Tokens are separated by whitespace, ';', '(', and ')' form tokens of their own even without surrounding whitespace.
+         * Returns an empty view at the end of the text.
+         */
+        std::string_view next_def_token(const char*& pos, const char* end)
+        {
+            while (pos < end && is_def_whitespace(*pos))
+            {
+                pos++;
+            }
 
-            std::vector<Token<std::string>> parsed_tokens;
-            while (std::getline(ss, line))
+            const char* begin = pos;
+            if (pos < end && is_def_delimiter(*pos))
             {
-                line_number++;
+                pos++;
+                return std::string_view(begin, 1);
+            }
 
-                for (char c : line)
+            while (pos < end && !is_def_whitespace(*pos) && !is_def_delimiter(*pos))
+            {
+                // a backslash escapes the next character, which may also be a whitespace
+                if (*pos == '\\' && pos + 1 < end)
                 {
-                    // deal with escaping and strings
-                    if (c == '\\')
-                    {
-                        escaped = true;
-                        continue;
-                    }
-                    else if (escaped && std::isspace(c))
-                    {
-                        escaped = false;
-                        continue;
-                    }
+                    pos++;
+                }
+                pos++;
+            }
 
-                    if (((!std::isspace(c) && delimiters.find(c) == std::string::npos) || escaped))
-                    {
-                        current_token += c;
-                    }
-                    else
-                    {
-                        if (!current_token.empty())
-                        {
-                            parsed_tokens.emplace_back(line_number, current_token);
-                            current_token.clear();
-                        }
+            return std::string_view(begin, pos - begin);
+        }
 
-                        if (!std::isspace(c))
-                        {
-                            parsed_tokens.emplace_back(line_number, std::string(1, c));
-                        }
-                    }
+        std::string unescape_def_name(std::string_view name)
+        {
+            std::string res;
+            res.reserve(name.size());
+            for (size_t i = 0; i < name.size(); i++)
+            {
+                if (name[i] == '\\' && i + 1 < name.size())
+                {
+                    i++;
                 }
+                res += name[i];
+            }
+            return res;
+        }
 
-                if (!current_token.empty())
+        u32 get_def_line_number(std::string_view text, const char* pos)
+        {
+            return std::count(text.data(), pos, '\n') + 1;
+        }
+
+        Result<i32> parse_def_coordinate(std::string_view token)
+        {
+            i64 value           = 0;
+            const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+            if (ec != std::errc() || ptr != token.data() + token.size() || value < std::numeric_limits<i32>::min() || value > std::numeric_limits<i32>::max())
+            {
+                return ERR("invalid coordinate '" + std::string(token) + "'");
+            }
+            return OK((i32)value);
+        }
+
+        /**
+         * Parse the points of a 'DIEAREA ( <x> <y> ) ( <x> <y> ) ... ;' statement, 'pos' points behind the 'DIEAREA' keyword.
+         * Returns the lower left corner of the bounding box of all points.
+         */
+        Result<std::pair<i32, i32>> parse_def_die_area_origin(const char*& pos, const char* end)
+        {
+            std::optional<std::pair<i32, i32>> origin;
+            for (std::string_view token = next_def_token(pos, end); token != ";"; token = next_def_token(pos, end))
+            {
+                const std::string_view x_str = next_def_token(pos, end);
+                const std::string_view y_str = next_def_token(pos, end);
+                const std::string_view close = next_def_token(pos, end);
+
+                const auto x_res = parse_def_coordinate(x_str);
+                const auto y_res = parse_def_coordinate(y_str);
+                if (token != "(" || close != ")" || x_res.is_error() || y_res.is_error())
                 {
-                    parsed_tokens.emplace_back(line_number, current_token);
-                    current_token.clear();
+                    return ERR("invalid point in DIEAREA statement");
+                }
+
+                if (!origin.has_value())
+                {
+                    origin = std::make_pair(x_res.get(), y_res.get());
+                }
+                else
+                {
+                    origin->first  = std::min(origin->first, x_res.get());
+                    origin->second = std::min(origin->second, y_res.get());
                 }
             }
 
-            return TokenStream(parsed_tokens, {}, {});
+            if (!origin.has_value())
+            {
+                return ERR("DIEAREA statement without points");
+            }
+            return OK(origin.value());
         }
-    
-        Result<std::unordered_map<std::string, ComponentData>> parse_tokens(TokenStream<std::string>& ts)
+
+        struct ComponentChunk
         {
-            ts.consume_until("COMPONENTS");
-            ts.consume("COMPONENTS");
-            const auto component_count_str = ts.consume().string;
-            ts.consume(";");
+            // placed gates in the order of the file
+            std::vector<std::pair<Gate*, std::pair<i32, i32>>> placements;
+            u32 component_count = 0;
+            u32 unknown_count   = 0;
+            std::optional<Error> error;
+        };
 
-            u32 component_count;
-            if (const auto res = utils::wrapped_stoul(component_count_str); res.is_ok())
-            {   
-                component_count = res.get();
-            }
-            else
+        /**
+         * Parse the component statements within a piece of the COMPONENTS section.
+         * Statements look like '- <name> <type> [+ <attribute> ...] ;', the location is given by a '+ PLACED', '+ FIXED', or '+ COVER' attribute.
+         */
+        void parse_component_chunk(std::string_view text, const char* begin, const char* end, const std::unordered_map<std::string_view, Gate*>& name_to_gate, ComponentChunk& chunk)
+        {
+            const char* pos = begin;
+            while (true)
             {
-                return ERR_APPEND(res.get_error(), "could not parse tokens: failed to read component count from token" + component_count_str);
-            }
-
-            std::cout << "Component count: " << component_count << std::endl;
-
-            std::unordered_map<std::string, ComponentData> component_data;
-            for (u32 c_idx = 0; c_idx < component_count; c_idx++)
-            {
-                // parse a line
-                ComponentData new_data_entry;
-                ts.consume("-");
-                new_data_entry.name = ts.consume().string;
-                new_data_entry.type = ts.consume().string;
-                ts.consume("+");
-                ts.consume("SOURCE");
-                ts.consume("DIST");
-                ts.consume("TIMING");
-                ts.consume("+");
-                ts.consume("PLACED");
-                ts.consume("FIXED");
-                ts.consume("(");
-                
-                if (const auto res = utils::wrapped_stoull(ts.consume().string); res.is_ok())
+                std::string_view token = next_def_token(pos, end);
+                if (token.empty())
                 {
-                    new_data_entry.x = res.get();
+                    return;
                 }
-                else
+
+                const char* statement_begin = token.data();
+
+                if (token != "-")
                 {
-                    return ERR_APPEND(res.get_error(), "could not parse tokens: failed to read x coordinate from token");
+                    chunk.error = Error(__FILE__, __LINE__, "expected '-' but got '" + std::string(token) + "' (line " + std::to_string(get_def_line_number(text, statement_begin)) + ")");
+                    return;
                 }
 
-                if (const auto res = utils::wrapped_stoull(ts.consume().string); res.is_ok())
+                const std::string_view name = next_def_token(pos, end);
+                const std::string_view type = next_def_token(pos, end);
+                if (name.empty() || type.empty())
                 {
-                    new_data_entry.y = res.get();
+                    chunk.error = Error(__FILE__, __LINE__, "incomplete component statement (line " + std::to_string(get_def_line_number(text, statement_begin)) + ")");
+                    return;
                 }
-                else
+
+                std::optional<std::pair<i32, i32>> location;
+                for (token = next_def_token(pos, end); token != ";"; token = next_def_token(pos, end))
                 {
-                    return ERR_APPEND(res.get_error(), "could not parse tokens: failed to read y coordinate from token");
+                    if (token.empty())
+                    {
+                        chunk.error = Error(__FILE__, __LINE__, "missing ';' at the end of component '" + std::string(name) + "' (line " + std::to_string(get_def_line_number(text, statement_begin)) + ")");
+                        return;
+                    }
+
+                    if (token == "PLACED" || token == "FIXED" || token == "COVER")
+                    {
+                        const std::string_view open  = next_def_token(pos, end);
+                        const std::string_view x_str = next_def_token(pos, end);
+                        const std::string_view y_str = next_def_token(pos, end);
+                        const std::string_view close = next_def_token(pos, end);
+
+                        const auto x_res = parse_def_coordinate(x_str);
+                        const auto y_res = parse_def_coordinate(y_str);
+                        if (open != "(" || close != ")" || x_res.is_error() || y_res.is_error())
+                        {
+                            chunk.error =
+                                Error(__FILE__, __LINE__, "invalid location of component '" + std::string(name) + "' (line " + std::to_string(get_def_line_number(text, statement_begin)) + ")");
+                            return;
+                        }
+
+                        location = std::make_pair(x_res.get(), y_res.get());
+                    }
                 }
 
-                ts.consume(")");
+                chunk.component_count++;
 
-                ts.consume_current_line();
+                if (!location.has_value())
+                {
+                    continue;
+                }
 
-                component_data.insert({new_data_entry.name, new_data_entry});
+                const auto gate_it = (name.find('\\') == std::string_view::npos) ? name_to_gate.find(name) : name_to_gate.find(unescape_def_name(name));
+                if (gate_it != name_to_gate.end())
+                {
+                    chunk.placements.emplace_back(gate_it->second, location.value());
+                }
+                else
+                {
+                    chunk.unknown_count++;
+                }
             }
-
-            return OK(component_data);
         }
-    }
+    }    // namespace
 
     Result<std::monostate> NetlistPreprocessingPlugin::parse_def_file(Netlist* nl, const std::filesystem::path& def_file)
     {
-        std::stringstream ss;
-        std::ifstream ifs;
-        ifs.open(def_file.string(), std::ifstream::in);
-        if (!ifs.is_open())
+        MappedTextFile file;
+        if (!file.open(def_file))
         {
             return ERR("could not parse DEF (Design Exchange Format) file '" + def_file.string() + "' : unable to open file");
         }
-        ss << ifs.rdbuf();
-        ifs.close();
 
-        auto ts = tokenize(ss);
+        const std::string_view text = file.get_text();
+        const char* const text_end  = text.data() + text.size();
 
-        std::unordered_map<std::string, ComponentData> component_data;
-        // parse tokens
-        try
+        // skip to the COMPONENTS section, the die area in front of it determines the coordinate origin
+        const char* pos = text.data();
+        std::pair<i32, i32> die_origin = {0, 0};
+        for (std::string_view token = next_def_token(pos, text_end); token != "COMPONENTS"; token = next_def_token(pos, text_end))
         {
-            if (auto res = parse_tokens(ts); res.is_error())
+            if (token.empty())
             {
-                return ERR_APPEND(res.get_error(), "could not parse Design Exchange Format file '" + def_file.string() + "': unable to parse tokens");
+                return ERR("could not parse Design Exchange Format file '" + def_file.string() + "': no COMPONENTS section found");
             }
-            else
+
+            if (token == "DIEAREA")
             {
-                component_data = res.get();
+                const char* statement_begin = token.data();
+                if (const auto res = parse_def_die_area_origin(pos, text_end); res.is_ok())
+                {
+                    die_origin = res.get();
+                }
+                else
+                {
+                    return ERR_APPEND(res.get_error(),
+                                      "could not parse Design Exchange Format file '" + def_file.string() + "': unable to parse die area (line "
+                                          + std::to_string(get_def_line_number(text, statement_begin)) + ")");
+                }
             }
         }
-        catch (TokenStream<std::string>::TokenStreamException& e)
+
+        // gates with negative coordinates count as not placed, so a die area extending into negative coordinates is shifted to start at zero
+        const i64 shift_x = std::max<i64>(0, -(i64)die_origin.first);
+        const i64 shift_y = std::max<i64>(0, -(i64)die_origin.second);
+
+        const std::string_view component_count_str = next_def_token(pos, text_end);
+        u32 component_count;
+        if (const auto res = utils::wrapped_stoul(std::string(component_count_str)); res.is_ok())
+        {
+            component_count = res.get();
+        }
+        else
         {
-            if (e.line_number != (u32)-1)
+            return ERR_APPEND(res.get_error(), "could not parse Design Exchange Format file '" + def_file.string() + "': failed to read component count from token " + std::string(component_count_str));
+        }
+
+        if (next_def_token(pos, text_end) != ";")
+        {
+            return ERR("could not parse Design Exchange Format file '" + def_file.string() + "': expected ';' after component count (line " + std::to_string(get_def_line_number(text, pos)) + ")");
+        }
+
+        const char* section_end = pos;
+        for (const char* token_begin = pos;; token_begin = section_end)
+        {
+            const std::string_view token = next_def_token(section_end, text_end);
+            if (token.empty())
             {
-                return ERR("could not parse Design Exchange Format file '" + def_file.string() + "': " + e.message + " (line " + std::to_string(e.line_number) + ")");
+                return ERR("could not parse Design Exchange Format file '" + def_file.string() + "': missing 'END COMPONENTS'");
             }
-            else
+
+            // statements start with a '-', so 'END' can only occur at the end of the section or within a statement
+            if (token == "END")
+            {
+                const char* after_end = section_end;
+                if (next_def_token(after_end, text_end) == "COMPONENTS")
+                {
+                    section_end = token_begin;
+                    break;
+                }
+            }
+        }
+
+        // split the section into chunks at statement boundaries, i.e., behind a ';' that is followed by a '-'
+        std::vector<const char*> chunk_bounds = {pos};
+        while (section_end - chunk_bounds.back() > (std::ptrdiff_t)def_chunk_size)
+        {
+            const char* split = chunk_bounds.back() + def_chunk_size;
+            while (split < section_end)
+            {
+                split = std::find(split, section_end, ';');
+                if (split == section_end)
+                {
+                    break;
+                }
+
+                const char* next = split + 1;
+                while (next < section_end && is_def_whitespace(*next))
+                {
+                    next++;
+                }
+
+                if (*(split - 1) != '\\' && next < section_end && *next == '-')
+                {
+                    split = next;
+                    break;
+                }
+                split = next;
+            }
+
+            if (split >= section_end)
             {
-                return ERR("could not parse Design Exchange Format file '" + def_file.string() + "': " + e.message);
+                break;
             }
+            chunk_bounds.push_back(split);
         }
+        chunk_bounds.push_back(section_end);
 
-        std::unordered_map<std::string, Gate*> name_to_gate;
-        for (auto g : nl->get_gates())
+        std::unordered_map<std::string_view, Gate*> name_to_gate;
+        name_to_gate.reserve(nl->get_gates().size());
+        for (Gate* g : nl->get_gates())
         {
             name_to_gate.insert({g->get_name(), g});
         }
 
-        u32 counter = 0;
-        for (const auto& [gate_name, data] : component_data)
+        std::vector<ComponentChunk> chunks(chunk_bounds.size() - 1);
+        utils::parallel_for(chunks.size(), [&text, &chunk_bounds, &name_to_gate, &chunks](u32 idx) { parse_component_chunk(text, chunk_bounds.at(idx), chunk_bounds.at(idx + 1), name_to_gate, chunks.at(idx)); });
+
+        u32 parsed_components = 0;
+        u32 unknown_gates     = 0;
+        u32 outside_gates     = 0;
+        u32 counter           = 0;
+        for (const auto& chunk : chunks)
         {
-            if (const auto& g_it = name_to_gate.find(gate_name); g_it != name_to_gate.end())
+            if (chunk.error.has_value())
             {
-                // TODO figure out whereever we are saving coordinates now...
-                g_it->second->set_location_x(data.x);
-                g_it->second->set_location_y(data.y);
+                return ERR_APPEND(chunk.error.value(), "could not parse Design Exchange Format file '" + def_file.string() + "': unable to parse component");
+            }
 
+            for (const auto& [gate, location] : chunk.placements)
+            {
+                const i64 x = location.first + shift_x;
+                const i64 y = location.second + shift_y;
+                if (x < 0 || y < 0 || x > std::numeric_limits<i32>::max() || y > std::numeric_limits<i32>::max())
+                {
+                    outside_gates++;
+                    continue;
+                }
+
+                gate->set_location(std::make_pair((i32)x, (i32)y));
                 counter++;
             }
+
+            parsed_components += chunk.component_count;
+            unknown_gates += chunk.unknown_count;
+        }
+
+        if (parsed_components != component_count)
+        {
+            log_warning("netlist_preprocessing", "DEF file '{}' declares {} components but contains {}.", def_file.string(), component_count, parsed_components);
+        }
+
+        if (unknown_gates > 0)
+        {
+            log_warning("netlist_preprocessing", "{} placed components of DEF file '{}' do not correspond to any gate in the netlist.", unknown_gates, def_file.string());
+        }
+
+        if (outside_gates > 0)
+        {
+            log_warning("netlist_preprocessing", "skipped {} components of DEF file '{}' located at negative coordinates outside of the die area.", outside_gates, def_file.string());
         }
 
         log_info("netlist_preprocessing", "reconstructed coordinates for {} / {} ({:.2}) gates", counter, nl->get_gates().size(), (double)counter / (double)nl->get_gates().size());
@@ -308,4 +308,122 @@ namespace hal {
         }
         TEST_END
     }
+
+    /**
+     * Test the annotation of gate locations from the COMPONENTS section of a DEF file.
+     *
+     * Functions: parse_def_file
+     */
+    TEST_F(NetlistPreprocessingTest, check_parse_def_file)
+    {
+        TEST_START
+        {
+            std::unique_ptr<Netlist> nl = test_utils::create_empty_netlist();
+            ASSERT_NE(nl, nullptr);
+            GateType* buf = nl->get_gate_library()->get_gate_type_by_name("BUF");
+            ASSERT_NE(buf, nullptr);
+
+            Gate* g0 = nl->create_gate(buf, "g0");
+            Gate* g1 = nl->create_gate(buf, "g1");
+            Gate* g2 = nl->create_gate(buf, "g[2]");
+            Gate* g3 = nl->create_gate(buf, "g3");
+            Gate* g4 = nl->create_gate(buf, "g(4)");
+            Gate* g5 = nl->create_gate(buf, "g5");
+
+            {
+                // escaped names, PLACED/FIXED/COVER locations, and delimiters without surrounding whitespace
+                // the die area extends into negative coordinates, so all coordinates are shifted by (200, 10)
+                std::filesystem::path def_file = test_utils::create_sandbox_file("components.def",
+                                                                                 "VERSION 5.8 ;\n"
+                                                                                 "DESIGN top ;\n"
+                                                                                 "UNITS DISTANCE MICRONS 1000 ;\n"
+                                                                                 "DIEAREA ( -200 0 ) ( 100000 -10 ) ( 100000 100000 ) ;\n"
+                                                                                 "COMPONENTS 7 ;\n"
+                                                                                 "- g0 BUF + PLACED ( 10 20 ) N ;\n"
+                                                                                 "- g1 BUF + SOURCE DIST + FIXED ( -100 50 ) FS ;\n"
+                                                                                 "- g\\[2\\] BUF\n"
+                                                                                 "  + COVER ( 0 -7 ) N ;\n"
+                                                                                 "- g3 BUF + PLACED (30 40) N;\n"
+                                                                                 "- g\\(4\\) BUF + PLACED ( 1 2 ) S\n;\n"
+                                                                                 "- unknown BUF + PLACED ( 5 6 ) N ;\n"
+                                                                                 "- g5 BUF + UNPLACED ;\n"
+                                                                                 "END COMPONENTS\n"
+                                                                                 "END DESIGN\n");
+
+                auto res = NetlistPreprocessingPlugin::parse_def_file(nl.get(), def_file);
+                ASSERT_TRUE(res.is_ok());
+
+                EXPECT_EQ(g0->get_location(), std::make_pair(210, 30));
+                EXPECT_EQ(g1->get_location(), std::make_pair(100, 60));
+                EXPECT_EQ(g2->get_location(), std::make_pair(200, 3));
+                EXPECT_EQ(g3->get_location(), std::make_pair(230, 50));
+                EXPECT_EQ(g4->get_location(), std::make_pair(201, 12));
+                EXPECT_TRUE(g2->has_location());
+                EXPECT_FALSE(g5->has_location());
+            }
+            {
+                // without a die area coordinates are kept, components at negative coordinates are skipped
+                Gate* h0 = nl->create_gate(buf, "h0");
+                Gate* h1 = nl->create_gate(buf, "h1");
+                Gate* h2 = nl->create_gate(buf, "h2");
+                std::filesystem::path def_file = test_utils::create_sandbox_file("negative.def",
+                                                                                 "COMPONENTS 3 ;\n"
+                                                                                 "- h0 BUF + PLACED ( 10 20 ) N ;\n"
+                                                                                 "- h1 BUF + PLACED ( -100 50 ) N ;\n"
+                                                                                 "- h2 BUF + PLACED ( 0 -7 ) N ;\n"
+                                                                                 "END COMPONENTS\n");
+
+                auto res = NetlistPreprocessingPlugin::parse_def_file(nl.get(), def_file);
+                ASSERT_TRUE(res.is_ok());
+
+                EXPECT_EQ(h0->get_location(), std::make_pair(10, 20));
+                EXPECT_FALSE(h1->has_location());
+                EXPECT_FALSE(h2->has_location());
+            }
+            {
+                // component outside of the shifted die area
+                Gate* k0 = nl->create_gate(buf, "k0");
+                std::filesystem::path def_file = test_utils::create_sandbox_file("outside.def",
+                                                                                 "DIEAREA ( -50 -50 ) ( 50 50 ) ;\n"
+                                                                                 "COMPONENTS 1 ;\n"
+                                                                                 "- k0 BUF + PLACED ( -60 0 ) N ;\n"
+                                                                                 "END COMPONENTS\n");
+
+                auto res = NetlistPreprocessingPlugin::parse_def_file(nl.get(), def_file);
+                ASSERT_TRUE(res.is_ok());
+                EXPECT_FALSE(k0->has_location());
+            }
+            {
+                // malformed die area
+                std::filesystem::path def_file = test_utils::create_sandbox_file("invalid_die_area.def",
+                                                                                 "DIEAREA ( 0 0 ( 10 10 ) ;\n"
+                                                                                 "COMPONENTS 1 ;\n"
+                                                                                 "- g0 BUF + PLACED ( 10 20 ) N ;\n"
+                                                                                 "END COMPONENTS\n");
+                EXPECT_TRUE(NetlistPreprocessingPlugin::parse_def_file(nl.get(), def_file).is_error());
+            }
+            {
+                // missing ';' at the end of a component
+                std::filesystem::path def_file = test_utils::create_sandbox_file("missing_semicolon.def",
+                                                                                 "COMPONENTS 1 ;\n"
+                                                                                 "- g0 BUF + PLACED ( 10 20 ) N\n"
+                                                                                 "END COMPONENTS\n");
+                EXPECT_TRUE(NetlistPreprocessingPlugin::parse_def_file(nl.get(), def_file).is_error());
+            }
+            {
+                // invalid coordinate
+                std::filesystem::path def_file = test_utils::create_sandbox_file("invalid_coordinate.def",
+                                                                                 "COMPONENTS 1 ;\n"
+                                                                                 "- g0 BUF + PLACED ( 10 abc ) N ;\n"
+                                                                                 "END COMPONENTS\n");
+                EXPECT_TRUE(NetlistPreprocessingPlugin::parse_def_file(nl.get(), def_file).is_error());
+            }
+            {
+                // no COMPONENTS section
+                std::filesystem::path def_file = test_utils::create_sandbox_file("no_components.def", "VERSION 5.8 ;\nEND DESIGN\n");
+                EXPECT_TRUE(NetlistPreprocessingPlugin::parse_def_file(nl.get(), def_file).is_error());
+            }
+        }
+        TEST_END
+    }
 } // namespace hal
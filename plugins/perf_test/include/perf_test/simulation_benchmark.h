@@ -0,0 +1,154 @@
+// MIT License
+// 
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+    class GateLibrary;
+    class Netlist;
+    class NetlistSimulatorController;
+    class PerfTestPlugin;
+
+    /**
+     * Benchmark harness for simulation engines. Every design is simulated by every selected engine
+     * using identical pseudo random stimulus. Results of all engines are compared against the first
+     * engine which succeeded, thus a benchmark run fails if any engine diverges.
+     */
+    class SimulationBenchmark
+    {
+    public:
+        struct Result
+        {
+            std::string design;
+            std::string engine;
+            u32 gates                = 0;
+            u64 cycles               = 0;
+            bool success             = false;
+            bool matches_reference   = false;
+            double wall_time         = 0;    // seconds from run_simulation() until results are loaded
+            u64 events               = 0;
+            double events_per_second = 0;
+            u64 peak_rss             = 0;    // kB, maximum of this process and child processes
+            u64 output_size          = 0;    // bytes in simulation working directory
+        };
+
+        /**
+         * Constructor.
+         *
+         * @param[in] parent - Plugin instance used to compare waveforms.
+         * @param[in] cycles - Number of clock cycles to simulate per design.
+         * @param[in] clock_period - Clock period in picoseconds.
+         * @param[in] seed - Seed for stimulus generator.
+         */
+        SimulationBenchmark(PerfTestPlugin* parent, u64 cycles = 1000, u64 clock_period = 10000, u32 seed = 1);
+        ~SimulationBenchmark();
+
+        /**
+         * Add design owned by caller.
+         *
+         * @param[in] name - Design name used in report.
+         * @param[in] nl - The netlist.
+         */
+        void add_design(const std::string& name, Netlist* nl);
+
+        /**
+         * Load design from file, e.g. one of the examples shipped with HAL.
+         *
+         * @param[in] netlist_file - HAL project or netlist file.
+         * @param[in] gate_library_file - Gate library, may be empty for HAL projects.
+         * @returns True on success, false otherwise.
+         */
+        bool add_design_file(const std::filesystem::path& netlist_file, const std::filesystem::path& gate_library_file = std::filesystem::path());
+
+        /**
+         * Generate ring of 'depth' register stages, each 'width' flip-flops wide. Stages are connected by two input
+         * combinational gates mixing neighbouring bits. The gate types are taken from the given library.
+         *
+         * @param[in] gl - The gate library.
+         * @param[in] width - Number of flip-flops per stage.
+         * @param[in] depth - Number of stages.
+         * @returns True on success, false if library lacks suitable gate types.
+         */
+        bool add_synthetic_design(const GateLibrary* gl, u32 width, u32 depth);
+
+        /**
+         * Select engines by name. All registered engines are used if none are selected.
+         *
+         * @param[in] engines - Engine names.
+         */
+        void set_engines(const std::vector<std::string>& engines);
+
+        /**
+         * Run all engines on all designs.
+         *
+         * @returns True if all engines succeeded and results match, false otherwise.
+         */
+        bool run();
+
+        /**
+         * Write results as JSON file.
+         *
+         * @param[in] filename - Output file.
+         * @returns True on success, false otherwise.
+         */
+        bool write_json(const std::filesystem::path& filename) const;
+
+        /**
+         * Get results of last run.
+         *
+         * @returns Vector with one entry per design and engine.
+         */
+        const std::vector<Result>& get_results() const
+        {
+            return m_results;
+        }
+
+    private:
+        struct Design
+        {
+            std::string name;
+            Netlist* netlist;
+            std::unique_ptr<Netlist> owned;
+        };
+
+        bool simulate(const Design& design, const std::string& engine_name, std::unique_ptr<NetlistSimulatorController>& ctrl, Result& result) const;
+
+        PerfTestPlugin* m_parent;
+        u64 m_cycles;
+        u64 m_clock_period;
+        u32 m_seed;
+        std::vector<Design> m_designs;
+        std::vector<std::string> m_engines;
+        std::vector<Result> m_results;
+    };
+}    // namespace hal
@@ -0,0 +1,794 @@
+#include "perf_test/plugin_perf_test.h"
+
+#include "graph_algorithm/netlist_graph.h"
+#include "graph_algorithm/plugin_graph_algorithm.h"
+#include "hal_core/netlist/decorators/spatial_netlist_decorator.h"
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/gate_library/gate_library.h"
+#include "hal_core/netlist/gate_library/gate_library_manager.h"
+#include "hal_core/netlist/module.h"
+#include "hal_core/netlist/net.h"
+#include "hal_core/netlist/netlist.h"
+#include "hal_core/netlist/netlist_factory.h"
+#include "hal_core/netlist/netlist_parser/netlist_parser_manager.h"
+#include "hal_core/netlist/netlist_writer/netlist_writer_manager.h"
+#include "hal_core/netlist/persistent/netlist_serializer.h"
+#include "hal_core/plugin_system/plugin_manager.h"
+#include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
+#include "netlist_simulator_controller/netlist_simulator_controller.h"
+#include "netlist_simulator_controller/plugin_netlist_simulator_controller.h"
+#include "netlist_simulator_controller/simulation_engine.h"
+#include "netlist_simulator_controller/simulation_input.h"
+#include "netlist_simulator_controller/wave_data.h"
+#include "perf_test/simulation_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <thread>
+
+namespace hal
+{
+    extern std::unique_ptr<BasePluginInterface> create_plugin_instance()
+    {
+        return std::make_unique<PerfTestPlugin>();
+    }
+
+    PerfTestPlugin::PerfTestPlugin()
+    {
+        m_extensions.push_back(new CliExtensionsPerfTest(this));
+    }
+
+    std::string PerfTestPlugin::get_name() const
+    {
+        return std::string("perf_test");
+    }
+
+    std::string PerfTestPlugin::get_version() const
+    {
+        return std::string("0.1");
+    }
+
+    void PerfTestPlugin::initialize()
+    {
+    }
+
+    ProgramOptions CliExtensionsPerfTest::get_cli_options() const
+    {
+        ProgramOptions description;
+
+        description.add("--perf_test", "executes the plugin perf_test");
+        description.add("--base_path", "set base path of HAL install", {""});
+        description.add("--benchmark", "run all simulation engines on benchmark designs and write results to JSON file", {""});
+        description.add("--benchmark_designs", "comma separated list of design files, default: examples in HAL install", {""});
+        description.add("--benchmark_synthetic", "comma separated list of synthetic design sizes <width>x<depth>, e.g. 64x16,256x64", {""});
+        description.add("--benchmark_cycles", "number of clock cycles to simulate per design (default 1000)", {""});
+        description.add("--benchmark_engines", "comma separated list of engines, default: all registered engines", {""});
+        description.add("--benchmark_writer", "write the netlist repeatedly to the given file (e.g., out.v) and report the writer throughput in MB/s", {""});
+        description.add("--benchmark_writer_runs", "number of times the netlist is written (default 5)", {""});
+        description.add("--benchmark_spatial_index", "place the given number of gates randomly and report the time of area queries on the spatial index vs. a linear scan", {""});
+        description.add("--benchmark_spatial_index_queries", "number of area and nearest gate queries (default 1000)", {""});
+        description.add("--benchmark_graph_algorithm", "create a netlist with the given number of gates and report the time of all graph_algorithm functions", {""});
+        description.add("--benchmark_graph_algorithm_module_gates", "number of gates in the module used for module-restricted graphs, spinglass clustering and community modules (default 1000)", {""});
+
+        return description;
+    }
+
+    bool PerfTestPlugin::cmp_sim_data(NetlistSimulatorController* reference_simulation_ctrl, NetlistSimulatorController* simulation_ctrl, int tolerance)
+    {
+        bool no_errors                     = true;
+        WaveDataList* reference_simulation = reference_simulation_ctrl->get_waves();
+        WaveDataList* engine_simulation    = simulation_ctrl->get_waves();
+        log_info("perf_test", "comparing outputs, reference has {} and engine simulation {} nets...", reference_simulation->size(), engine_simulation->size());
+
+        auto signal_to_string = [](int v) -> std::string {
+            if (v >= 0)
+                return std::to_string(v);
+            return "X";
+        };
+
+        // get all reference simulation net ids
+        std::set<u32> reference_simulation_nets;
+        for (auto it : *reference_simulation)
+        {
+            reference_simulation_nets.insert(it->id());
+        }
+
+        // get all  simulation net ids
+        std::set<u32> engine_simulation_nets;
+        for (auto it : *engine_simulation)
+        {
+            engine_simulation_nets.insert(it->id());
+        }
+
+        // identify mismatches
+        std::set<u32> unmatching_nets;
+        for (auto it_ref : *reference_simulation)
+        {
+            int iwave_sim = engine_simulation->waveIndexByNetId(it_ref->id());
+            if (iwave_sim < 0)
+            {
+                no_errors = false;
+                log_error("perf_test", "net '{}' (ID {}) in reference, but not in simulated output.", it_ref->name().toStdString(), it_ref->id());
+            }
+            else if (!it_ref->isEqual(*engine_simulation->at(iwave_sim), tolerance))
+            {
+                no_errors = false;
+                unmatching_nets.insert(it_ref->id());
+            }
+        }
+
+        if (!unmatching_nets.empty())
+        {
+            log_error("perf_test", "found {} unmatching nets.", unmatching_nets.size());
+        }
+
+        u64 earliest_mismatch = -1;
+        std::vector<u32> earliest_mismatch_nets;
+        auto update_mismatch = [&](u64 time, u32 net) {
+            if (time < earliest_mismatch)
+            {
+                earliest_mismatch      = time;
+                earliest_mismatch_nets = {net};
+            }
+            else if (time == earliest_mismatch)
+            {
+                earliest_mismatch_nets.push_back(net);
+            }
+        };
+
+        // print the events of both simulations side by side, differing events are marked with an arrow
+        for (auto net_id : unmatching_nets)
+        {
+            const WaveData* wave_data_a                = reference_simulation->at(reference_simulation->waveIndexByNetId(net_id));
+            const WaveData* wave_data_b                = engine_simulation->at(engine_simulation->waveIndexByNetId(net_id));
+            std::vector<std::pair<u64, int>> events_a = wave_data_a->get_events();
+            std::vector<std::pair<u64, int>> events_b = wave_data_b->get_events();
+
+            u32 width = 0;
+            if (!events_a.empty() && !events_b.empty())
+            {
+                width = std::to_string(std::max(events_a.back().first, events_b.back().first)).size();
+            }
+
+            auto event_to_string = [&signal_to_string, width](const std::pair<u64, int>& event) { return fmt::format("{} @ {:>{}}ns", signal_to_string(event.second), event.first, width); };
+            const std::string no_event(width + 6, ' ');
+
+            log_info("perf_test", "difference in net '{}' (ID {}):", wave_data_a->name().toStdString(), net_id);
+            log_info("perf_test", "{:<{}} | engine:", "reference:", width + 6);
+
+            for (u32 i = 0, j = 0; i < events_a.size() || j < events_b.size();)
+            {
+                if (i < events_a.size() && j < events_b.size() && std::abs((long long)events_a[i].first - (long long)events_b[j].first) < tolerance)
+                {
+                    if (events_a[i].second == events_b[j].second)
+                    {
+                        log_info("perf_test", "{} | {}", event_to_string(events_a[i]), event_to_string(events_b[j]));
+                    }
+                    else
+                    {
+                        update_mismatch(events_a[i].first, net_id);
+                        log_info("perf_test", "{} | {}  <--", event_to_string(events_a[i]), event_to_string(events_b[j]));
+                    }
+                    i++;
+                    j++;
+                }
+                else if (j >= events_b.size() || (i < events_a.size() && events_a[i].first < events_b[j].first))
+                {
+                    update_mismatch(events_a[i].first, net_id);
+                    log_info("perf_test", "{} |", event_to_string(events_a[i]));
+                    i++;
+                }
+                else
+                {
+                    update_mismatch(events_b[j].first, net_id);
+                    log_info("perf_test", "{} | {}", no_event, event_to_string(events_b[j]));
+                    j++;
+                }
+            }
+        }
+
+        if (!earliest_mismatch_nets.empty())
+        {
+            log_error("perf_test", "earliest mismatch at {}ns in net(s) {}.", earliest_mismatch, utils::join(", ", earliest_mismatch_nets));
+        }
+
+        if (reference_simulation->size() != engine_simulation->size())
+        {
+            log_warning("perf_test", "number of nets differs between reference ({}) and engine simulation ({}).", reference_simulation->size(), engine_simulation->size());
+            if (reference_simulation->size() > engine_simulation->size())
+            {
+                no_errors = false;
+                std::vector<u32> mismatch;
+                std::set_difference(reference_simulation_nets.begin(), reference_simulation_nets.end(), engine_simulation_nets.begin(), engine_simulation_nets.end(), std::back_inserter(mismatch));
+                for (auto x : mismatch)
+                {
+                    int iwave = reference_simulation->waveIndexByNetId(x);
+                    log_warning("perf_test", "  only in reference: {} {}", x, iwave < 0 ? "" : reference_simulation->at(iwave)->name().toStdString());
+                }
+            }
+            else
+            {
+                std::vector<u32> mismatch;
+                std::set_difference(engine_simulation_nets.begin(), engine_simulation_nets.end(), reference_simulation_nets.begin(), reference_simulation_nets.end(), std::back_inserter(mismatch));
+                for (auto x : mismatch)
+                {
+                    int iwave = engine_simulation->waveIndexByNetId(x);
+                    std::string wave_name(iwave < 0 ? "" : engine_simulation->at(iwave)->name().toStdString());
+
+                    // constant nets '0' and '1' are added artificially by some engines
+                    if (!wave_name.empty() && wave_name != "'0'" && wave_name != "'1'")
+                    {
+                        no_errors = false;
+                    }
+                    log_warning("perf_test", "  only in engine simulation: {} {}", x, wave_name);
+                }
+            }
+        }
+
+        if (no_errors)
+        {
+            log_info("perf_test", "simulation correct.");
+        }
+        else
+        {
+            log_error("perf_test", "simulation incorrect.");
+        }
+
+        return no_errors;
+    }
+
+    bool PerfTestPlugin::run_benchmark(Netlist* nl, ProgramArguments& args)
+    {
+        u64 cycles = 1000;
+        if (args.is_option_set("--benchmark_cycles"))
+        {
+            cycles = std::stoull(args.get_parameter("--benchmark_cycles"));
+        }
+
+        SimulationBenchmark benchmark(this, cycles);
+
+        if (args.is_option_set("--benchmark_engines"))
+        {
+            benchmark.set_engines(utils::split(args.get_parameter("--benchmark_engines"), ','));
+        }
+
+        if (args.is_option_set("--benchmark_designs"))
+        {
+            for (const std::string& design_file : utils::split(args.get_parameter("--benchmark_designs"), ','))
+            {
+                if (!benchmark.add_design_file(design_file))
+                    return false;
+            }
+        }
+        else if (args.is_option_set("--base_path"))
+        {
+            // HAL projects shipped as examples
+            std::filesystem::path examples = std::filesystem::path(args.get_parameter("--base_path")) / "examples";
+            std::vector<std::filesystem::path> design_files;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(examples, ec))
+            {
+                if (entry.path().extension() == ".hal")
+                    design_files.push_back(entry.path());
+            }
+            std::sort(design_files.begin(), design_files.end());
+            for (const std::filesystem::path& design_file : design_files)
+            {
+                benchmark.add_design_file(design_file);
+            }
+        }
+
+        if (nl)
+        {
+            benchmark.add_design(nl->get_design_name().empty() ? "netlist" : nl->get_design_name(), nl);
+        }
+
+        if (args.is_option_set("--benchmark_synthetic"))
+        {
+            if (!nl)
+            {
+                log_error("perf_test", "synthetic designs require a netlist to take the gate library from.");
+                return false;
+            }
+            for (const std::string& size : utils::split(args.get_parameter("--benchmark_synthetic"), ','))
+            {
+                std::vector<std::string> dims = utils::split(size, 'x');
+                if (dims.size() != 2 || !benchmark.add_synthetic_design(nl->get_gate_library(), std::stoul(dims.at(0)), std::stoul(dims.at(1))))
+                {
+                    log_error("perf_test", "cannot generate synthetic design '{}'.", size);
+                    return false;
+                }
+            }
+        }
+
+        bool retval = benchmark.run();
+        if (!benchmark.write_json(args.get_parameter("--benchmark")))
+        {
+            log_error("perf_test", "cannot write benchmark results to '{}'.", args.get_parameter("--benchmark"));
+            return false;
+        }
+        return retval;
+    }
+
+    bool PerfTestPlugin::run_writer_benchmark(Netlist* nl, ProgramArguments& args)
+    {
+        if (!nl)
+        {
+            log_error("perf_test", "writer benchmark requires a netlist.");
+            return false;
+        }
+
+        u32 runs = 5;
+        if (args.is_option_set("--benchmark_writer_runs"))
+        {
+            runs = std::max(1u, (u32)std::stoul(args.get_parameter("--benchmark_writer_runs")));
+        }
+
+        const std::filesystem::path file_path = args.get_parameter("--benchmark_writer");
+
+        double best_time  = 0;
+        double total_time = 0;
+        for (u32 run = 0; run < runs; run++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (!netlist_writer_manager::write(nl, file_path))
+            {
+                log_error("perf_test", "cannot write netlist to '{}'.", file_path.string());
+                return false;
+            }
+            const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            total_time += time;
+            if (run == 0 || time < best_time)
+            {
+                best_time = time;
+            }
+        }
+
+        std::error_code ec;
+        const double megabytes = std::filesystem::file_size(file_path, ec) / 1e6;
+        if (ec)
+        {
+            log_error("perf_test", "cannot determine size of '{}'.", file_path.string());
+            return false;
+        }
+
+        log_info("perf_test",
+                 "writer benchmark '{}': {:.2f} MB, best {:.3f} s ({:.1f} MB/s), mean {:.3f} s ({:.1f} MB/s) over {} runs",
+                 file_path.string(),
+                 megabytes,
+                 best_time,
+                 megabytes / best_time,
+                 total_time / runs,
+                 megabytes * runs / total_time,
+                 runs);
+        return true;
+    }
+
+    bool PerfTestPlugin::run_spatial_index_benchmark(Netlist* nl, ProgramArguments& args)
+    {
+        if (!nl || nl->get_gate_library()->get_gate_types().empty())
+        {
+            log_error("perf_test", "spatial index benchmark requires a netlist to take the gate library from.");
+            return false;
+        }
+
+        const u32 num_gates = (u32)std::stoul(args.get_parameter("--benchmark_spatial_index"));
+
+        u32 num_queries = 1000;
+        if (args.is_option_set("--benchmark_spatial_index_queries"))
+        {
+            num_queries = std::max(1u, (u32)std::stoul(args.get_parameter("--benchmark_spatial_index_queries")));
+        }
+
+        // place the gates on a square die with one gate per four sites on average
+        std::unique_ptr<Netlist> synthetic = netlist_factory::create_netlist(nl->get_gate_library());
+        GateType* gate_type                = nl->get_gate_library()->get_gate_types().begin()->second;
+        const i32 die_size                 = std::max(1, (i32)std::sqrt(4.0 * num_gates));
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<i32> coordinate(0, die_size - 1);
+        for (u32 i = 0; i < num_gates; i++)
+        {
+            synthetic->create_gate(gate_type, "G_" + std::to_string(i), coordinate(rng), coordinate(rng));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        SpatialNetlistDecorator index(*synthetic);
+        const double build_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // boxes of 20x20 sites, i.e., about 100 gates per query
+        std::vector<std::pair<i32, i32>> corners;
+        for (u32 i = 0; i < num_queries; i++)
+        {
+            corners.emplace_back(coordinate(rng), coordinate(rng));
+        }
+
+        u64 index_hits = 0;
+        start          = std::chrono::steady_clock::now();
+        for (const auto& [x, y] : corners)
+        {
+            index_hits += index.get_gates_in_area(x, y, x + 19, y + 19).size();
+        }
+        const double index_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (const auto& [x, y] : corners)
+        {
+            (void)index.get_nearest_gates(x, y, 10);
+        }
+        const double nearest_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // the linear scan is slow, hence only a few of the queries are repeated for comparison
+        const u32 num_scans = std::min(num_queries, 10u);
+        u64 scan_hits       = 0;
+        u64 index_scan_hits = 0;
+        start               = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < num_scans; i++)
+        {
+            const auto [x, y] = corners.at(i);
+            for (const Gate* gate : synthetic->get_gates())
+            {
+                if (gate->get_location_x() >= x && gate->get_location_x() <= x + 19 && gate->get_location_y() >= y && gate->get_location_y() <= y + 19)
+                {
+                    scan_hits++;
+                }
+            }
+            index_scan_hits += index.get_gates_in_area(x, y, x + 19, y + 19).size();
+        }
+        const double scan_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (scan_hits != index_scan_hits)
+        {
+            log_error("perf_test", "spatial index returned {} gates but linear scan found {} gates.", index_scan_hits, scan_hits);
+            return false;
+        }
+
+        log_info("perf_test",
+                 "spatial index benchmark with {} gates: build {:.3f} s (cell size {}), area query {:.2f} us ({:.1f} gates on average), nearest 10 gates {:.2f} us, linear scan {:.2f} us",
+                 num_gates,
+                 build_time,
+                 index.get_cell_size(),
+                 index_time * 1e6 / num_queries,
+                 (double)index_hits / num_queries,
+                 nearest_time * 1e6 / num_queries,
+                 scan_time * 1e6 / num_scans);
+        return true;
+    }
+
+    bool PerfTestPlugin::run_graph_algorithm_benchmark(Netlist* nl, ProgramArguments& args)
+    {
+        if (!nl)
+        {
+            log_error("perf_test", "graph algorithm benchmark requires a netlist to take the gate library from.");
+            return false;
+        }
+
+        auto plugin = plugin_manager::get_plugin_instance<GraphAlgorithmPlugin>("graph_algorithm");
+        if (!plugin)
+        {
+            log_error("perf_test", "graph algorithm benchmark requires the graph_algorithm plugin.");
+            return false;
+        }
+
+        const u32 num_gates = (u32)std::stoul(args.get_parameter("--benchmark_graph_algorithm"));
+
+        u32 num_module_gates = 1000;
+        if (args.is_option_set("--benchmark_graph_algorithm_module_gates"))
+        {
+            num_module_gates = (u32)std::stoul(args.get_parameter("--benchmark_graph_algorithm_module_gates"));
+        }
+        num_module_gates = std::max(1u, std::min(num_module_gates, num_gates));
+
+        // pick the combinational gate type with the fewest inputs (but at least two) and any flip-flop type, ties are broken by name
+        GateType* comb_type = nullptr;
+        GateType* ff_type   = nullptr;
+        for (const auto& [name, type] : nl->get_gate_library()->get_gate_types())
+        {
+            if (type->get_output_pins().empty())
+            {
+                continue;
+            }
+
+            const u32 num_inputs = type->get_input_pins().size();
+            if (type->has_property(GateTypeProperty::combinational) && num_inputs >= 2
+                && (!comb_type || num_inputs < comb_type->get_input_pins().size() || (num_inputs == comb_type->get_input_pins().size() && name < comb_type->get_name())))
+            {
+                comb_type = type;
+            }
+            else if (type->has_property(GateTypeProperty::ff) && num_inputs >= 1 && (!ff_type || name < ff_type->get_name()))
+            {
+                ff_type = type;
+            }
+        }
+
+        if (!comb_type)
+        {
+            log_error("perf_test", "graph algorithm benchmark requires a combinational gate type with at least two inputs in gate library '{}'.", nl->get_gate_library()->get_name());
+            return false;
+        }
+
+        // every gate drives the next one, so consecutive gates are connected, and a random gate close by, which creates loops
+        std::unique_ptr<Netlist> synthetic = netlist_factory::create_netlist(nl->get_gate_library());
+        std::vector<Gate*> gates;
+        gates.reserve(num_gates);
+        for (u32 i = 0; i < num_gates; i++)
+        {
+            gates.push_back(synthetic->create_gate((ff_type && i % 10 == 9) ? ff_type : comb_type, "G_" + std::to_string(i)));
+        }
+
+        const i64 window = 64;
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<i64> offset(-window, window);
+        for (u32 i = 0; i < num_gates; i++)
+        {
+            Net* net = synthetic->create_net("N_" + std::to_string(i));
+            net->add_source(gates.at(i), gates.at(i)->get_type()->get_output_pins().front());
+            if (i + 1 < num_gates)
+            {
+                net->add_destination(gates.at(i + 1), gates.at(i + 1)->get_type()->get_input_pins().front());
+            }
+
+            const i64 j = std::min(std::max((i64)i + offset(rng), (i64)0), (i64)num_gates - 1);
+            if (const auto& pins = gates.at(j)->get_type()->get_input_pins(); pins.size() > 1 && gates.at(j)->get_fan_in_net(pins.at(1)) == nullptr)
+            {
+                net->add_destination(gates.at(j), pins.at(1));
+            }
+        }
+
+        Module* module = synthetic->create_module("benchmark_module", synthetic->get_top_module(), std::vector<Gate*>(gates.begin(), gates.begin() + num_module_gates));
+
+        auto measure = [](const auto& func) {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        log_info("perf_test", "graph algorithm benchmark with {} gates and {} nets:", synthetic->get_gates().size(), synthetic->get_nets().size());
+
+        // the legacy conversion that used to run on every call of an algorithm
+        igraph_t legacy_graph;
+        const double legacy_time = measure([&]() { plugin->get_igraph_directed(synthetic.get(), &legacy_graph); });
+        igraph_destroy(&legacy_graph);
+        log_info("perf_test", "  get_igraph_directed: {:.3f} s", legacy_time);
+
+        std::unique_ptr<NetlistGraph> graph;
+        std::unique_ptr<NetlistGraph> comb_graph;
+        std::unique_ptr<NetlistGraph> module_graph;
+        const double graph_time        = measure([&]() { graph = NetlistGraph::from_netlist(synthetic.get()).get(); });
+        const double comb_graph_time   = measure([&]() { comb_graph = NetlistGraph::from_netlist(synthetic.get(), true).get(); });
+        const double module_graph_time = measure([&]() { module_graph = NetlistGraph::from_netlist(synthetic.get(), false, module).get(); });
+        log_info("perf_test", "  NetlistGraph::from_netlist: {:.3f} s ({} vertices, {} edges)", graph_time, graph->get_num_vertices(), graph->get_num_edges());
+        log_info("perf_test", "  NetlistGraph::from_netlist (combinational only): {:.3f} s ({} vertices)", comb_graph_time, comb_graph->get_num_vertices());
+        log_info("perf_test", "  NetlistGraph::from_netlist (module): {:.3f} s ({} vertices)", module_graph_time, module_graph->get_num_vertices());
+
+        igraph_t converted_graph;
+        const double to_igraph_time = measure([&]() { (void)graph->to_igraph(&converted_graph); });
+        igraph_destroy(&converted_graph);
+        log_info("perf_test", "  NetlistGraph::to_igraph: {:.3f} s", to_igraph_time);
+
+        std::vector<std::vector<Gate*>> sccs;
+        std::map<int, std::set<Gate*>> communities;
+        double time = measure([&]() { sccs = plugin->get_strongly_connected_components(graph.get()); });
+        log_info("perf_test", "  get_strongly_connected_components: {:.3f} s ({} components)", time, sccs.size());
+
+        time = measure([&]() { sccs = plugin->get_strongly_connected_components(comb_graph.get()); });
+        log_info("perf_test", "  get_strongly_connected_components (combinational only): {:.3f} s ({} components)", time, sccs.size());
+
+        Result<std::vector<u32>> vertex_values = ERR("not computed");
+        time = measure([&]() { vertex_values = plugin->get_strongly_connected_component_ids(graph.get()); });
+        log_info("perf_test", "  get_strongly_connected_component_ids: {:.3f} s", time);
+
+        // the random connections may close combinational loops, in which case the levelization fails after the same amount of work
+        time = measure([&]() { vertex_values = plugin->get_topological_order(comb_graph.get()); });
+        log_info("perf_test", "  get_topological_order (combinational only): {:.3f} s{}", time, vertex_values.is_ok() ? "" : " (graph is cyclic)");
+
+        time = measure([&]() { vertex_values = plugin->get_logic_levels(comb_graph.get()); });
+        log_info("perf_test", "  get_logic_levels (combinational only): {:.3f} s{}", time, vertex_values.is_ok() ? "" : " (graph is cyclic)");
+
+        time = measure([&]() { vertex_values = plugin->get_logic_depths(comb_graph.get()); });
+        log_info("perf_test", "  get_logic_depths (combinational only): {:.3f} s{}", time, vertex_values.is_ok() ? "" : " (graph is cyclic)");
+
+        time = measure([&]() { communities = plugin->get_communities_fast_greedy(graph.get()); });
+        log_info("perf_test", "  get_communities_fast_greedy: {:.3f} s ({} communities)", time, communities.size());
+
+        time = measure([&]() { communities = plugin->get_communities(graph.get()); });
+        log_info("perf_test", "  get_communities: {:.3f} s ({} communities)", time, communities.size());
+
+        time = measure([&]() { communities = plugin->get_communities_louvain(graph.get()); });
+        log_info("perf_test", "  get_communities_louvain: {:.3f} s ({} communities)", time, communities.size());
+
+        // spinglass clustering does not scale to large graphs, hence it is run on the module only
+        time = measure([&]() { communities = plugin->get_communities_spinglass(module_graph.get(), 25); });
+        log_info("perf_test", "  get_communities_spinglass (module): {:.3f} s ({} communities)", time, communities.size());
+
+        time = measure([&]() { communities = plugin->get_communities_louvain(module_graph.get()); });
+        Result<std::map<int, Module*>> community_modules = ERR("not computed");
+        time += measure([&]() { community_modules = plugin->create_community_modules(synthetic.get(), communities, module); });
+        log_info("perf_test", "  get_communities_louvain + create_community_modules (module): {:.3f} s ({} modules)", time, community_modules.is_ok() ? community_modules.get().size() : 0);
+
+        std::vector<std::set<Gate*>> cut;
+        time = measure([&]() { cut = plugin->get_graph_cut(synthetic.get(), gates.back(), 10); });
+        log_info("perf_test", "  get_graph_cut (depth 10): {:.3f} s ({} levels)", time, cut.size());
+
+        // the netlist variants build the graph on every call, get_communities removes leaves from the netlist and thus runs last
+        time = measure([&]() { sccs = plugin->get_strongly_connected_components(synthetic.get()); });
+        log_info("perf_test", "  get_strongly_connected_components (netlist): {:.3f} s ({} components)", time, sccs.size());
+
+        time = measure([&]() { communities = plugin->get_communities_fast_greedy(synthetic.get()); });
+        log_info("perf_test", "  get_communities_fast_greedy (netlist): {:.3f} s ({} communities)", time, communities.size());
+
+        graph.reset();
+        comb_graph.reset();
+        module_graph.reset();
+        time = measure([&]() { communities = plugin->get_communities(synthetic.get()); });
+        log_info("perf_test", "  get_communities (netlist): {:.3f} s ({} communities)", time, communities.size());
+
+        return true;
+    }
+
+    bool CliExtensionsPerfTest::handle_cli_call(Netlist* nl, ProgramArguments& args)
+    {
+        if (args.is_option_set("--benchmark_graph_algorithm"))
+        {
+            return mParent->run_graph_algorithm_benchmark(nl, args);
+        }
+
+        if (args.is_option_set("--benchmark_spatial_index"))
+        {
+            return mParent->run_spatial_index_benchmark(nl, args);
+        }
+
+        if (args.is_option_set("--benchmark_writer"))
+        {
+            return mParent->run_writer_benchmark(nl, args);
+        }
+
+        if (args.is_option_set("--benchmark"))
+        {
+            return mParent->run_benchmark(nl, args);
+        }
+
+        if (!args.is_option_set("--base_path"))
+        {
+            log_error("perf_test", "base_path parameter not set");
+            return false;
+        }
+        std::string base_path = args.get_parameter("--base_path");
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorControllerPlugin>("netlist_simulator_controller");
+
+        auto sim_ctrl_verilator = plugin->create_simulator_controller("tocipher_simulator");
+        auto verilator_engine   = sim_ctrl_verilator->create_simulation_engine("verilator");
+
+        auto sim_ctrl_reference = plugin->create_simulator_controller("tocipher_reference");
+
+        if (nl->get_gate_library() == nullptr)
+        {
+            log_error("perf_test", "netlist has no gate library");
+            return false;
+        }
+
+        std::string path_vcd = base_path + "/bin/hal_plugins/test-files/toycipher/dump.vcd";
+        if (!utils::file_exists(path_vcd))
+        {
+            log_error("perf_test", "reference VCD file '{}' not found", path_vcd);
+            return false;
+        }
+
+        sim_ctrl_reference->add_gates(nl->get_gates());
+        sim_ctrl_reference->initialize();
+        sim_ctrl_reference->import_vcd(path_vcd, NetlistSimulatorController::FilterInputFlag::CompleteNetlist);
+
+        // prepare simulation
+        sim_ctrl_verilator->add_gates(nl->get_gates());
+        sim_ctrl_verilator->initialize();
+
+        // retrieve nets
+        auto clk = *(nl->get_nets([](auto net) { return net->get_name() == "CLK"; }).begin());
+        sim_ctrl_verilator->add_clock_period(clk, 10000);
+
+        std::set<const Net*> key_set, plaintext_set;
+        auto start = *(nl->get_nets([](auto net) { return net->get_name() == "START"; }).begin());
+
+        for (int i = 0; i < 16; i++)
+        {
+            std::string name = "KEY_" + std::to_string(i);
+            key_set.insert(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            std::string name = "PLAINTEXT_" + std::to_string(i);
+            plaintext_set.insert(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        // set GND and VCC
+        Net* GND = *(nl->get_nets([](auto net) { return net->is_gnd_net(); }).begin());
+        if (GND != nullptr)
+        {
+            sim_ctrl_verilator->set_input(GND, BooleanFunction::Value::ZERO);
+        }
+
+        Net* VCC = *(nl->get_nets([](auto net) { return net->is_vcc_net(); }).begin());
+        if (VCC != nullptr)
+        {
+            sim_ctrl_verilator->set_input(VCC, BooleanFunction::Value::ONE);
+        }
+
+        // testbench of the toycipher, times in ps
+        {
+            for (auto net : plaintext_set)    //PLAINTEXT <= (OTHERS => '0');
+                sim_ctrl_verilator->set_input(net, BooleanFunction::Value::ZERO);
+
+            for (auto net : key_set)    //KEY <= (OTHERS => '0');
+                sim_ctrl_verilator->set_input(net, BooleanFunction::Value::ZERO);
+
+            sim_ctrl_verilator->set_input(start, BooleanFunction::Value::ZERO);    //START <= '0';
+            sim_ctrl_verilator->simulate(10 * 1000);                               //WAIT FOR 10 NS;
+
+            sim_ctrl_verilator->set_input(start, BooleanFunction::Value::ONE);    //START <= '1';
+            sim_ctrl_verilator->simulate(10 * 1000);                              //WAIT FOR 10 NS;
+
+            sim_ctrl_verilator->set_input(start, BooleanFunction::Value::ZERO);    //START <= '0';
+            sim_ctrl_verilator->simulate(100 * 1000);                              //WAIT FOR 100 NS;
+
+            for (auto net : plaintext_set)    //PLAINTEXT <= (OTHERS => '1');
+                sim_ctrl_verilator->set_input(net, BooleanFunction::Value::ONE);
+
+            for (auto net : key_set)    //KEY <= (OTHERS => '1');
+                sim_ctrl_verilator->set_input(net, BooleanFunction::Value::ONE);
+
+            sim_ctrl_verilator->set_input(start, BooleanFunction::Value::ZERO);    //START <= '0';
+            sim_ctrl_verilator->simulate(10 * 1000);                               //WAIT FOR 10 NS;
+
+            sim_ctrl_verilator->set_input(start, BooleanFunction::Value::ONE);    //START <= '1';
+            sim_ctrl_verilator->simulate(10 * 1000);                              //WAIT FOR 10 NS;
+
+            sim_ctrl_verilator->set_input(start, BooleanFunction::Value::ZERO);    //START <= '0';
+            sim_ctrl_verilator->simulate(100 * 1000);                              //WAIT FOR 100 NS;
+
+            for (auto net : plaintext_set)    //PLAINTEXT <= (OTHERS => '0');
+                sim_ctrl_verilator->set_input(net, BooleanFunction::Value::ZERO);
+
+            for (auto net : key_set)    //KEY <= (OTHERS => '0');
+                sim_ctrl_verilator->set_input(net, BooleanFunction::Value::ZERO);
+
+            sim_ctrl_verilator->set_input(start, BooleanFunction::Value::ZERO);    //START <= '0';
+            sim_ctrl_verilator->simulate(10 * 1000);                               //WAIT FOR 10 NS;
+
+            sim_ctrl_verilator->set_input(start, BooleanFunction::Value::ONE);    //START <= '1';
+            sim_ctrl_verilator->simulate(10 * 1000);                              //WAIT FOR 10 NS;
+
+            sim_ctrl_verilator->set_input(start, BooleanFunction::Value::ZERO);    //START <= '0';
+            sim_ctrl_verilator->simulate(25 * 1000);                               //WAIT FOR 25 NS;
+
+            sim_ctrl_verilator->initialize();
+            sim_ctrl_verilator->run_simulation();
+
+            while (verilator_engine->get_state() == SimulationEngine::State::Running)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            }
+        }
+
+        if (verilator_engine->get_state() == SimulationEngine::State::Failed)
+        {
+            log_error("perf_test", "simulation engine '{}' failed", verilator_engine->name());
+            return false;
+        }
+
+        sim_ctrl_verilator->get_results();
+
+        // load the waveforms of all nets into memory for comparison
+        for (Net* n : nl->get_nets())
+        {
+            sim_ctrl_verilator->get_waveform_by_net(n);
+            sim_ctrl_reference->get_waveform_by_net(n);
+        }
+
+        return mParent->cmp_sim_data(sim_ctrl_reference.get(), sim_ctrl_verilator.get());
+    }
+}    // namespace hal
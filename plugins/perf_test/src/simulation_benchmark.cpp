@@ -0,0 +1,412 @@
+#include "perf_test/simulation_benchmark.h"
+
+#include "hal_core/netlist/endpoint.h"
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/gate_library/gate_library.h"
+#include "hal_core/netlist/gate_library/gate_type.h"
+#include "hal_core/netlist/net.h"
+#include "hal_core/netlist/netlist.h"
+#include "hal_core/netlist/netlist_factory.h"
+#include "hal_core/plugin_system/plugin_manager.h"
+#include "hal_core/utilities/json_write_document.h"
+#include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
+#include "netlist_simulator_controller/netlist_simulator_controller.h"
+#include "netlist_simulator_controller/plugin_netlist_simulator_controller.h"
+#include "netlist_simulator_controller/simulation_engine.h"
+#include "netlist_simulator_controller/wave_data.h"
+#include "perf_test/plugin_perf_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <random>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace hal
+{
+    namespace
+    {
+        u64 peak_rss_kb()
+        {
+#ifdef _WIN32
+            return 0;
+#else
+            struct rusage self, children;
+            getrusage(RUSAGE_SELF, &self);
+            getrusage(RUSAGE_CHILDREN, &children);
+            u64 retval = std::max(self.ru_maxrss, children.ru_maxrss);
+#ifdef __APPLE__
+            retval /= 1024;    // reported in bytes
+#endif
+            return retval;
+#endif
+        }
+
+        u64 directory_size(const std::filesystem::path& dir)
+        {
+            u64 retval = 0;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(dir, ec))
+            {
+                if (entry.is_regular_file(ec))
+                {
+                    retval += entry.file_size(ec);
+                }
+            }
+            return retval;
+        }
+
+        bool is_clock_net(const Net* net)
+        {
+            for (const Endpoint* ep : net->get_destinations())
+            {
+                if (ep->get_pin()->get_type() == PinType::clock)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // sorted by name to get same design on every run
+        std::vector<GateType*> sorted_gate_types(const GateLibrary* gl, const std::function<bool(const GateType*)>& filter)
+        {
+            std::map<std::string, GateType*> sorted;
+            for (const auto& [name, gt] : gl->get_gate_types(filter))
+            {
+                sorted[name] = gt;
+            }
+            std::vector<GateType*> retval;
+            for (const auto& [name, gt] : sorted)
+            {
+                retval.push_back(gt);
+            }
+            return retval;
+        }
+    }    // namespace
+
+    SimulationBenchmark::SimulationBenchmark(PerfTestPlugin* parent, u64 cycles, u64 clock_period, u32 seed)
+        : m_parent(parent), m_cycles(cycles), m_clock_period(clock_period), m_seed(seed)
+    {
+    }
+
+    SimulationBenchmark::~SimulationBenchmark()
+    {
+    }
+
+    void SimulationBenchmark::add_design(const std::string& name, Netlist* nl)
+    {
+        m_designs.push_back({name, nl, nullptr});
+    }
+
+    bool SimulationBenchmark::add_design_file(const std::filesystem::path& netlist_file, const std::filesystem::path& gate_library_file)
+    {
+        std::unique_ptr<Netlist> nl = netlist_factory::load_netlist(netlist_file, gate_library_file);
+        if (!nl)
+        {
+            log_error("perf_test", "cannot load benchmark design '{}'.", netlist_file.string());
+            return false;
+        }
+        Netlist* raw = nl.get();
+        m_designs.push_back({netlist_file.stem().string(), raw, std::move(nl)});
+        return true;
+    }
+
+    bool SimulationBenchmark::add_synthetic_design(const GateLibrary* gl, u32 width, u32 depth)
+    {
+        if (!gl || width < 2 || !depth)
+        {
+            return false;
+        }
+
+        // flip-flop with clock and data input only, no set/reset/enable left floating
+        GateType* ff_type = nullptr;
+        for (GateType* gt : sorted_gate_types(gl, [](const GateType* gt) { return gt->has_property(GateTypeProperty::ff); }))
+        {
+            std::vector<GatePin*> inputs = gt->get_input_pins();
+            if (inputs.size() != 2)
+                continue;
+            bool has_clock = std::any_of(inputs.begin(), inputs.end(), [](const GatePin* p) { return p->get_type() == PinType::clock; });
+            bool has_data  = std::any_of(inputs.begin(), inputs.end(), [](const GatePin* p) { return p->get_type() == PinType::data; });
+            bool has_state = !gt->get_pins([](const GatePin* p) { return p->get_direction() == PinDirection::output && p->get_type() == PinType::state; }).empty();
+            if (has_clock && has_data && has_state)
+            {
+                ff_type = gt;
+                break;
+            }
+        }
+
+        // two input gate, prefer XOR which keeps toggle activity high
+        GateType* comb_type = nullptr;
+        for (GateType* gt : sorted_gate_types(gl, [](const GateType* gt) {
+                 return gt->has_property(GateTypeProperty::combinational) && !gt->has_property(GateTypeProperty::c_lut) && gt->get_input_pins().size() == 2
+                        && gt->get_output_pins().size() == 1;
+             }))
+        {
+            if (!comb_type || utils::to_upper(gt->get_name()).find("XOR") != std::string::npos)
+            {
+                comb_type = gt;
+            }
+            if (utils::to_upper(comb_type->get_name()).find("XOR") != std::string::npos)
+            {
+                break;
+            }
+        }
+
+        if (!ff_type || !comb_type)
+        {
+            log_warning("perf_test", "gate library '{}' lacks flip-flop or two input gate, cannot generate synthetic design.", gl->get_name());
+            return false;
+        }
+
+        GatePin* ff_clk = nullptr;
+        GatePin* ff_d   = nullptr;
+        for (GatePin* p : ff_type->get_input_pins())
+        {
+            if (p->get_type() == PinType::clock)
+                ff_clk = p;
+            else
+                ff_d = p;
+        }
+        GatePin* ff_q     = ff_type->get_pins([](const GatePin* p) { return p->get_direction() == PinDirection::output && p->get_type() == PinType::state; }).front();
+        GatePin* comb_a   = comb_type->get_input_pins().at(0);
+        GatePin* comb_b   = comb_type->get_input_pins().at(1);
+        GatePin* comb_out = comb_type->get_output_pins().at(0);
+
+        std::unique_ptr<Netlist> nl = netlist_factory::create_netlist(gl);
+        std::string name = "synthetic_" + std::to_string(width) + "x" + std::to_string(depth);
+        nl->set_design_name(name);
+
+        Net* clk = nl->create_net("CLK");
+        clk->mark_global_input_net();
+
+        // q[s][i] is output of flip-flop i in stage s
+        std::vector<std::vector<Net*>> q(depth, std::vector<Net*>(width));
+        std::vector<std::vector<Gate*>> ffs(depth, std::vector<Gate*>(width));
+        for (u32 s = 0; s < depth; s++)
+        {
+            for (u32 i = 0; i < width; i++)
+            {
+                std::string suffix = std::to_string(s) + "_" + std::to_string(i);
+                ffs[s][i]          = nl->create_gate(ff_type, "FF_" + suffix);
+                clk->add_destination(ffs[s][i], ff_clk);
+                q[s][i] = nl->create_net("Q_" + suffix);
+                q[s][i]->add_source(ffs[s][i], ff_q);
+            }
+        }
+
+        // stage s is fed by stage s-1, stage 0 by primary inputs and last stage (ring)
+        for (u32 s = 0; s < depth; s++)
+        {
+            const std::vector<Net*>& prev = q[(s + depth - 1) % depth];
+            for (u32 i = 0; i < width; i++)
+            {
+                std::string suffix = std::to_string(s) + "_" + std::to_string(i);
+                Gate* comb         = nl->create_gate(comb_type, "MIX_" + suffix);
+                Net* d             = nl->create_net("D_" + suffix);
+                d->add_source(comb, comb_out);
+                d->add_destination(ffs[s][i], ff_d);
+                if (s == 0)
+                {
+                    Net* in = nl->create_net("IN_" + std::to_string(i));
+                    in->mark_global_input_net();
+                    in->add_destination(comb, comb_a);
+                }
+                else
+                {
+                    prev[i]->add_destination(comb, comb_a);
+                }
+                prev[(i + 1) % width]->add_destination(comb, comb_b);
+            }
+        }
+
+        for (Net* out : q.back())
+        {
+            out->mark_global_output_net();
+        }
+
+        Netlist* raw = nl.get();
+        m_designs.push_back({name, raw, std::move(nl)});
+        return true;
+    }
+
+    void SimulationBenchmark::set_engines(const std::vector<std::string>& engines)
+    {
+        m_engines = engines;
+    }
+
+    bool SimulationBenchmark::simulate(const Design& design, const std::string& engine_name, std::unique_ptr<NetlistSimulatorController>& ctrl, Result& result) const
+    {
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorControllerPlugin>("netlist_simulator_controller");
+        if (!plugin)
+        {
+            log_error("perf_test", "plugin 'netlist_simulator_controller' not loaded.");
+            return false;
+        }
+
+        ctrl                     = plugin->create_simulator_controller("benchmark_" + design.name + "_" + engine_name);
+        SimulationEngine* engine = ctrl->create_simulation_engine(engine_name);
+        if (!engine)
+        {
+            log_error("perf_test", "cannot create simulation engine '{}'.", engine_name);
+            return false;
+        }
+
+        ctrl->add_gates(design.netlist->get_gates());
+        ctrl->initialize();
+
+        // same stimulus for every engine
+        std::mt19937 rng(m_seed);
+        std::vector<const Net*> data_inputs;
+        bool has_clock = false;
+        std::vector<const Net*> inputs(ctrl->get_input_nets().begin(), ctrl->get_input_nets().end());
+        std::sort(inputs.begin(), inputs.end(), [](const Net* a, const Net* b) { return a->get_id() < b->get_id(); });
+        for (const Net* net : inputs)
+        {
+            if (net->is_gnd_net())
+                ctrl->set_input(net, BooleanFunction::Value::ZERO);
+            else if (net->is_vcc_net())
+                ctrl->set_input(net, BooleanFunction::Value::ONE);
+            else if (is_clock_net(net))
+            {
+                ctrl->add_clock_period(net, m_clock_period);
+                has_clock = true;
+            }
+            else
+                data_inputs.push_back(net);
+        }
+        if (!has_clock)
+        {
+            ctrl->set_no_clock_used();
+        }
+
+        for (u64 cycle = 0; cycle < m_cycles; cycle++)
+        {
+            for (const Net* net : data_inputs)
+            {
+                ctrl->set_input(net, (rng() & 1) ? BooleanFunction::Value::ONE : BooleanFunction::Value::ZERO);
+            }
+            ctrl->simulate(m_clock_period);
+        }
+        ctrl->initialize();
+
+        auto t_start = std::chrono::steady_clock::now();
+        ctrl->run_simulation();
+        while (engine->get_state() == SimulationEngine::State::Running)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (engine->get_state() == SimulationEngine::State::Failed || !ctrl->get_results())
+        {
+            log_error("perf_test", "engine '{}' failed on design '{}'.", engine_name, design.name);
+            return false;
+        }
+        for (Net* net : design.netlist->get_nets())
+        {
+            ctrl->get_waveform_by_net(net);
+        }
+        result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+        for (const WaveData* wd : *ctrl->get_waves())
+        {
+            result.events += std::max<u64>(wd->fileSize(), wd->data().size());
+        }
+        result.events_per_second = result.wall_time > 0 ? result.events / result.wall_time : 0;
+        result.peak_rss          = peak_rss_kb();
+        result.output_size       = directory_size(ctrl->get_working_directory());
+        result.success           = true;
+        return true;
+    }
+
+    bool SimulationBenchmark::run()
+    {
+        m_results.clear();
+        std::vector<std::string> engines = m_engines.empty() ? SimulationEngineFactories::instance()->factoryNames() : m_engines;
+        if (engines.empty())
+        {
+            log_error("perf_test", "no simulation engine registered.");
+            return false;
+        }
+
+        bool retval = true;
+        for (const Design& design : m_designs)
+        {
+            std::unique_ptr<NetlistSimulatorController> reference;
+            for (const std::string& engine_name : engines)
+            {
+                log_info("perf_test", "benchmark design '{}' with engine '{}' ...", design.name, engine_name);
+                Result result;
+                result.design = design.name;
+                result.engine = engine_name;
+                result.gates  = design.netlist->get_gates().size();
+                result.cycles = m_cycles;
+
+                std::unique_ptr<NetlistSimulatorController> ctrl;
+                if (!simulate(design, engine_name, ctrl, result))
+                {
+                    retval = false;
+                }
+                else if (!reference)
+                {
+                    // first engine succeeding serves as reference
+                    result.matches_reference = true;
+                    reference                = std::move(ctrl);
+                }
+                else
+                {
+                    result.matches_reference = m_parent->cmp_sim_data(reference.get(), ctrl.get());
+                    if (!result.matches_reference)
+                    {
+                        log_error("perf_test", "engine '{}' diverges from reference on design '{}'.", engine_name, design.name);
+                        retval = false;
+                    }
+                }
+
+                log_info("perf_test",
+                         "  {:.3f} s, {} events, {:.0f} events/s, peak RSS {} kB, output {} bytes",
+                         result.wall_time,
+                         result.events,
+                         result.events_per_second,
+                         result.peak_rss,
+                         result.output_size);
+                m_results.push_back(result);
+            }
+        }
+        return retval;
+    }
+
+    bool SimulationBenchmark::write_json(const std::filesystem::path& filename) const
+    {
+        JsonWriteDocument doc;
+        doc["cycles"]       = (uint64_t)m_cycles;
+        doc["clock_period"] = (uint64_t)m_clock_period;
+        doc["seed"]         = (int)m_seed;
+
+        JsonWriteArray& res_arr = doc.add_array("results");
+        for (const Result& result : m_results)
+        {
+            JsonWriteObject& res_obj       = res_arr.add_object();
+            res_obj["design"]              = result.design;
+            res_obj["engine"]              = result.engine;
+            res_obj["gates"]               = (int)result.gates;
+            res_obj["cycles"]              = (uint64_t)result.cycles;
+            res_obj["success"]             = result.success ? 1 : 0;
+            res_obj["matches_reference"]   = result.matches_reference ? 1 : 0;
+            res_obj["wall_time"]           = result.wall_time;
+            res_obj["events"]              = (uint64_t)result.events;
+            res_obj["events_per_second"]   = result.events_per_second;
+            res_obj["peak_rss_kb"]         = (uint64_t)result.peak_rss;
+            res_obj["output_size"]         = (uint64_t)result.output_size;
+            res_obj.close();
+        }
+        res_arr.close();
+
+        return doc.serialize(filename.string());
+    }
+}    // namespace hal
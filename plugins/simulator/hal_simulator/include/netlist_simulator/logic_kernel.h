@@ -0,0 +1,166 @@
+// MIT License
+// 
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+#include "hal_core/netlist/boolean_function.h"
+
+#include <vector>
+
+namespace hal
+{
+    /**
+     * Four-valued logic word in dual-rail encoding holding 64 independent signal lanes.
+     * A lane is known if its bit in 'known' is set, 'value' then holds the logic level.
+     * Unknown lanes with a set 'value' bit represent Z, all other unknown lanes represent X.
+     */
+    struct LogicWord
+    {
+        u64 value = 0;
+        u64 known = 0;
+
+        static LogicWord from_value(BooleanFunction::Value v);
+        BooleanFunction::Value lane(u32 index = 0) const;
+    };
+
+    namespace logic_kernel
+    {
+        /**
+         * Lane-wise NOT. X and Z are kept unchanged, matching BooleanFunction evaluation.
+         */
+        inline LogicWord op_not(const LogicWord& a)
+        {
+            return LogicWord{a.value ^ a.known, a.known};
+        }
+
+        /**
+         * Lane-wise AND. A known 0 on either input dominates unless pessimistic X-propagation is requested.
+         */
+        inline LogicWord op_and(const LogicWord& a, const LogicWord& b, bool x_pessimism)
+        {
+            u64 known = a.known & b.known;
+            if (!x_pessimism)
+            {
+                known |= (a.known & ~a.value) | (b.known & ~b.value);
+            }
+            return LogicWord{a.value & b.value & a.known & b.known, known};
+        }
+
+        /**
+         * Lane-wise OR. A known 1 on either input dominates unless pessimistic X-propagation is requested.
+         */
+        inline LogicWord op_or(const LogicWord& a, const LogicWord& b, bool x_pessimism)
+        {
+            u64 known = a.known & b.known;
+            u64 value = (a.known & a.value) | (b.known & b.value);
+            if (!x_pessimism)
+            {
+                known |= value;
+            }
+            return LogicWord{value & known, known};
+        }
+
+        /**
+         * Lane-wise XOR. Any unknown input yields X.
+         */
+        inline LogicWord op_xor(const LogicWord& a, const LogicWord& b)
+        {
+            u64 known = a.known & b.known;
+            return LogicWord{(a.value ^ b.value) & known, known};
+        }
+
+        /**
+         * Lane-wise multiplexer selecting 'a' if 's' is 1 and 'b' if 's' is 0, including X and Z. An unknown select yields X.
+         */
+        inline LogicWord op_mux(const LogicWord& s, const LogicWord& a, const LogicWord& b)
+        {
+            u64 sel_one  = s.known & s.value;
+            u64 sel_zero = s.known & ~s.value;
+            u64 known    = (sel_one & a.known) | (sel_zero & b.known);
+            return LogicWord{(sel_one & a.value) | (sel_zero & b.value), known};
+        }
+    }    // namespace logic_kernel
+
+    /**
+     * A single-bit Boolean function compiled into a flat sequence of dual-rail logic operations.
+     * Compilation only succeeds for functions built from AND, OR, NOT, XOR, ITE, 1-bit constants and 1-bit variables,
+     * callers are expected to fall back to BooleanFunction::evaluate otherwise.
+     */
+    class LogicKernel
+    {
+    public:
+        LogicKernel() = default;
+
+        /**
+         * Compile a Boolean function.
+         *
+         * @param[in] function - The Boolean function to compile.
+         * @param[in] variables - The variable names in the order in which their values are passed to evaluate().
+         * @param[in] x_pessimism - Set to true to propagate X through controlling values as well.
+         * @returns True on success, false if the function contains unsupported operations or unknown variables.
+         */
+        bool compile(const BooleanFunction& function, const std::vector<std::string>& variables, bool x_pessimism = false);
+
+        /**
+         * Check whether the kernel holds a compiled function.
+         *
+         * @returns True if compile() succeeded.
+         */
+        bool is_valid() const;
+
+        /**
+         * Evaluate the kernel.
+         *
+         * @param[in] inputs - Pointers to the current values of the variables, ordered as passed to compile().
+         * @returns The resulting value.
+         */
+        BooleanFunction::Value evaluate(const std::vector<const BooleanFunction::Value*>& inputs) const;
+
+    private:
+        enum class OpCode : u8
+        {
+            Load,
+            Const,
+            Not,
+            And,
+            Or,
+            Xor,
+            Mux
+        };
+
+        struct Instruction
+        {
+            OpCode op;
+            u32 operand;
+        };
+
+        std::vector<Instruction> m_program;
+        std::vector<LogicWord> m_constants;
+        u32 m_stack_size  = 0;
+        bool m_x_pessimism = false;
+        bool m_valid       = false;
+    };
+}    // namespace hal
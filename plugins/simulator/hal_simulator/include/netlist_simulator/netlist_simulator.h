@@ -29,6 +29,7 @@
 #include "hal_core/netlist/gate_library/enums/async_set_reset_behavior.h"
 #include "hal_core/netlist/gate_library/gate_type.h"
 #include "hal_core/netlist/net.h"
+#include "netlist_simulator/logic_kernel.h"
 #include "netlist_simulator/simulation.h"
 #include "netlist_simulator_controller/simulation_engine.h"
 
@@ -136,6 +137,55 @@ namespace hal
          */
         const Simulation& get_simulation_state() const;
 
+        /**
+         * Create a compact binary checkpoint of the full simulator state.
+         * The checkpoint comprises the current value of every net, the content and pending clocked ports of all RAM gates, and all pending events.
+         * The event history recorded prior to the checkpoint is not included.
+         * Initializes the simulation if 'initialize' has not yet been called.
+         *
+         * @returns The serialized checkpoint.
+         */
+        std::vector<u8> create_checkpoint();
+
+        /**
+         * Restore the simulator state from a checkpoint created by 'create_checkpoint'.
+         * The simulator must operate on the same netlist and simulation set as the simulator that created the checkpoint.
+         * Any previously recorded events are discarded.
+         *
+         * @param[in] checkpoint - The serialized checkpoint.
+         * @returns True on success, false otherwise.
+         */
+        bool restore_checkpoint(const std::vector<u8>& checkpoint);
+
+        /**
+         * Write a checkpoint of the full simulator state to a file.
+         *
+         * @param[in] path - The path to the checkpoint file.
+         * @returns True on success, false otherwise.
+         */
+        bool save_checkpoint(const std::filesystem::path& path);
+
+        /**
+         * Restore the simulator state from a checkpoint file written by 'save_checkpoint'.
+         *
+         * @param[in] path - The path to the checkpoint file.
+         * @returns True on success, false otherwise.
+         */
+        bool load_checkpoint(const std::filesystem::path& path);
+
+        /**
+         * Fork the current simulator state into a number of independent continuations that are executed in parallel threads.
+         * Every continuation operates on its own simulator instance that is restored from a common checkpoint of this simulator.
+         * The state of this simulator is not altered.
+         * The continuation receives its simulator instance as well as its index and must not keep a reference to the simulator beyond its execution.
+         *
+         * @param[in] count - The number of continuations.
+         * @param[in] continuation - The function executing a single continuation.
+         * @param[in] num_threads - The maximum number of threads to use, 0 to use the number of hardware threads.
+         * @returns True if all continuations were started successfully, false otherwise.
+         */
+        bool fork_continuations(u32 count, const std::function<void(NetlistSimulator*, u32)>& continuation, u32 num_threads = 0);
+
         /**
          * Set the iteration timeout, i.e., the maximum number of events processed for a single point in time.
          * Useful to abort in case of infinite loops.
@@ -194,8 +244,10 @@ namespace hal
             std::vector<GatePin*> m_output_pins;
             std::vector<const Net*> m_output_nets;
             std::unordered_map<const Net*, BooleanFunction> m_functions;
+            std::vector<LogicKernel> m_kernels;
+            std::vector<const BooleanFunction::Value*> m_kernel_inputs;
 
-            SimulationGateCombinational(const Gate* gate);
+            SimulationGateCombinational(const Gate* gate, bool x_pessimism);
 
             bool simulate(const Simulation& simulation, const WaveEvent& event, std::map<std::pair<const Net*, u64>, BooleanFunction::Value>& new_events) override;
         };
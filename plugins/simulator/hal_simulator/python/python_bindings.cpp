@@ -165,6 +165,55 @@ namespace hal
                 :rtype: libnetlist_simulator.Simulation
             )")
 
+            .def(
+                "create_checkpoint",
+                [](NetlistSimulator& self) {
+                    std::vector<u8> checkpoint = self.create_checkpoint();
+                    return py::bytes(reinterpret_cast<const char*>(checkpoint.data()), checkpoint.size());
+                },
+                R"(
+                Create a compact binary checkpoint of the full simulator state.
+                The checkpoint comprises the current value of every net, the content and pending clocked ports of all RAM gates, and all pending events.
+                The event history recorded prior to the checkpoint is not included.
+                Initializes the simulation if 'initialize' has not yet been called.
+
+                :returns: The serialized checkpoint.
+                :rtype: bytes
+            )")
+
+            .def(
+                "restore_checkpoint",
+                [](NetlistSimulator& self, const py::bytes& checkpoint) {
+                    std::string data = checkpoint;
+                    return self.restore_checkpoint(std::vector<u8>(data.begin(), data.end()));
+                },
+                py::arg("checkpoint"),
+                R"(
+                Restore the simulator state from a checkpoint created by 'create_checkpoint'.
+                The simulator must operate on the same netlist and simulation set as the simulator that created the checkpoint.
+                Any previously recorded events are discarded.
+
+                :param bytes checkpoint: The serialized checkpoint.
+                :returns: True on success, False otherwise.
+                :rtype: bool
+            )")
+
+            .def("save_checkpoint", &NetlistSimulator::save_checkpoint, py::arg("path"), R"(
+                Write a checkpoint of the full simulator state to a file.
+
+                :param pathlib.Path path: The path to the checkpoint file.
+                :returns: True on success, False otherwise.
+                :rtype: bool
+            )")
+
+            .def("load_checkpoint", &NetlistSimulator::load_checkpoint, py::arg("path"), R"(
+                Restore the simulator state from a checkpoint file written by 'save_checkpoint'.
+
+                :param pathlib.Path path: The path to the checkpoint file.
+                :returns: True on success, False otherwise.
+                :rtype: bool
+            )")
+
             .def("set_iteration_timeout", &NetlistSimulator::set_iteration_timeout, py::arg("iterations"), R"(
                 Set the iteration timeout, i.e., the maximum number of events processed for a single point in time.
                 Useful to abort in case of infinite loops.
@@ -0,0 +1,164 @@
+#include "netlist_simulator/logic_kernel.h"
+
+#include <algorithm>
+#include <array>
+
+namespace hal
+{
+    namespace
+    {
+        // deeper functions are left to BooleanFunction::evaluate, gate library functions stay far below
+        const u32 MAX_STACK_SIZE = 64;
+    }
+
+    LogicWord LogicWord::from_value(BooleanFunction::Value v)
+    {
+        switch (v)
+        {
+            case BooleanFunction::Value::ZERO:
+                return LogicWord{0, ~0ull};
+            case BooleanFunction::Value::ONE:
+                return LogicWord{~0ull, ~0ull};
+            case BooleanFunction::Value::Z:
+                return LogicWord{~0ull, 0};
+            default:
+                return LogicWord{0, 0};
+        }
+    }
+
+    BooleanFunction::Value LogicWord::lane(u32 index) const
+    {
+        u64 mask = 1ull << index;
+        if (known & mask)
+        {
+            return (value & mask) ? BooleanFunction::Value::ONE : BooleanFunction::Value::ZERO;
+        }
+        return (value & mask) ? BooleanFunction::Value::Z : BooleanFunction::Value::X;
+    }
+
+    bool LogicKernel::compile(const BooleanFunction& function, const std::vector<std::string>& variables, bool x_pessimism)
+    {
+        m_program.clear();
+        m_constants.clear();
+        m_stack_size  = 0;
+        m_x_pessimism = x_pessimism;
+        m_valid       = false;
+
+        if (function.is_empty() || function.size() != 1)
+        {
+            return false;
+        }
+
+        u32 depth = 0;
+        for (const BooleanFunction::Node& node : function.get_nodes())
+        {
+            if (node.size != 1)
+            {
+                return false;
+            }
+
+            switch (node.type)
+            {
+                case BooleanFunction::NodeType::Variable: {
+                    auto it = std::find(variables.begin(), variables.end(), node.variable);
+                    if (it == variables.end())
+                    {
+                        return false;
+                    }
+                    m_program.push_back({OpCode::Load, (u32)std::distance(variables.begin(), it)});
+                    break;
+                }
+                case BooleanFunction::NodeType::Constant:
+                    m_program.push_back({OpCode::Const, (u32)m_constants.size()});
+                    m_constants.push_back(LogicWord::from_value(node.constant.front()));
+                    break;
+                case BooleanFunction::NodeType::Not:
+                    m_program.push_back({OpCode::Not, 0});
+                    break;
+                case BooleanFunction::NodeType::And:
+                    m_program.push_back({OpCode::And, 0});
+                    break;
+                case BooleanFunction::NodeType::Or:
+                    m_program.push_back({OpCode::Or, 0});
+                    break;
+                case BooleanFunction::NodeType::Xor:
+                    m_program.push_back({OpCode::Xor, 0});
+                    break;
+                case BooleanFunction::NodeType::Ite:
+                    m_program.push_back({OpCode::Mux, 0});
+                    break;
+                default:
+                    m_program.clear();
+                    m_constants.clear();
+                    return false;
+            }
+
+            // track stack usage: leaves push one entry, every operation replaces its operands by a single result
+            u32 arity = node.get_arity();
+            if (depth < arity)
+            {
+                m_program.clear();
+                m_constants.clear();
+                return false;
+            }
+            depth = depth - arity + 1;
+            m_stack_size = std::max(m_stack_size, depth);
+        }
+
+        if (depth != 1 || m_stack_size > MAX_STACK_SIZE)
+        {
+            m_program.clear();
+            m_constants.clear();
+            m_stack_size = 0;
+            return false;
+        }
+
+        m_valid = true;
+        return true;
+    }
+
+    bool LogicKernel::is_valid() const
+    {
+        return m_valid;
+    }
+
+    BooleanFunction::Value LogicKernel::evaluate(const std::vector<const BooleanFunction::Value*>& inputs) const
+    {
+        std::array<LogicWord, MAX_STACK_SIZE> stack;
+        u32 top = 0;
+
+        for (const Instruction& ins : m_program)
+        {
+            switch (ins.op)
+            {
+                case OpCode::Load:
+                    stack[top++] = LogicWord::from_value(*inputs[ins.operand]);
+                    break;
+                case OpCode::Const:
+                    stack[top++] = m_constants[ins.operand];
+                    break;
+                case OpCode::Not:
+                    stack[top - 1] = logic_kernel::op_not(stack[top - 1]);
+                    break;
+                case OpCode::And:
+                    --top;
+                    stack[top - 1] = logic_kernel::op_and(stack[top - 1], stack[top], m_x_pessimism);
+                    break;
+                case OpCode::Or:
+                    --top;
+                    stack[top - 1] = logic_kernel::op_or(stack[top - 1], stack[top], m_x_pessimism);
+                    break;
+                case OpCode::Xor:
+                    --top;
+                    stack[top - 1] = logic_kernel::op_xor(stack[top - 1], stack[top]);
+                    break;
+                case OpCode::Mux:
+                    top -= 2;
+                    stack[top - 1] = logic_kernel::op_mux(stack[top - 1], stack[top], stack[top + 1]);
+                    break;
+            }
+        }
+
+        return stack[0].lane(0);
+    }
+}    // namespace hal
@@ -255,6 +255,7 @@ namespace hal
         std::unordered_map<const Gate*, SimulationGate*> sim_gates_map;
         std::unordered_set<const Net*> all_nets;
         std::map<const Net*, BooleanFunction::Value> init_events;
+        const bool x_pessimism = (get_engine_property("x_pessimism") == "true");
 
         // precompute everything that is gate-related
         for (const Gate* gate : mSimulationInput->get_gates())
@@ -293,7 +294,7 @@ namespace hal
             }
             else if (gate->get_type()->has_property(GateTypeProperty::combinational))
             {
-                std::unique_ptr<SimulationGateCombinational> sim_gate_owner = std::make_unique<SimulationGateCombinational>(gate);
+                std::unique_ptr<SimulationGateCombinational> sim_gate_owner = std::make_unique<SimulationGateCombinational>(gate, x_pessimism);
                 SimulationGateCombinational* sim_gate                       = sim_gate_owner.get();
                 sim_gate_base                                               = sim_gate;
                 m_sim_gates.push_back(std::move(sim_gate_owner));
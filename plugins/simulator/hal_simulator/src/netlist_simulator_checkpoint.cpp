@@ -0,0 +1,419 @@
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/net.h"
+#include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
+#include "netlist_simulator/netlist_simulator.h"
+#include "netlist_simulator_controller/simulation_input.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace hal
+{
+    namespace
+    {
+        // binary layout (little endian, all integers fixed width):
+        //   header     : magic[8] version:u32 current_time:u64 id_counter:u64
+        //   net values : count:u32 { net_id:u32 time:u64 id:u64 value:i8 }
+        //   RAM gates  : count:u32 { gate_id:u32 num_words:u32 words:u64[] num_read:u32 read:u32[] num_write:u32 write:u32[] }
+        //   events     : count:u32 { net_id:u32 time:u64 id:u64 value:i8 }
+        const char checkpoint_magic[8] = {'H', 'A', 'L', 'S', 'I', 'M', 'C', 'P'};
+        const u32 checkpoint_version   = 1;
+
+        class CheckpointWriter
+        {
+        public:
+            std::vector<u8> m_buffer;
+
+            template<typename T>
+            void write(T value)
+            {
+                const u8* ptr = reinterpret_cast<const u8*>(&value);
+                m_buffer.insert(m_buffer.end(), ptr, ptr + sizeof(T));
+            }
+
+            void write_event(const WaveEvent& event)
+            {
+                write<u32>(event.affected_net->get_id());
+                write<u64>(event.time);
+                write<u64>(event.id);
+                write<i8>(static_cast<i8>(event.new_value));
+            }
+        };
+
+        class CheckpointReader
+        {
+        public:
+            CheckpointReader(const std::vector<u8>& buffer) : m_buffer(buffer)
+            {
+            }
+
+            template<typename T>
+            bool read(T& value)
+            {
+                if (m_pos + sizeof(T) > m_buffer.size())
+                {
+                    return false;
+                }
+                std::memcpy(&value, m_buffer.data() + m_pos, sizeof(T));
+                m_pos += sizeof(T);
+                return true;
+            }
+
+            bool read_event(const std::unordered_map<u32, const Net*>& nets, WaveEvent& event)
+            {
+                u32 net_id;
+                i8 value;
+                if (!read(net_id) || !read(event.time) || !read(event.id) || !read(value))
+                {
+                    return false;
+                }
+                if (value < BooleanFunction::Value::Z || value > BooleanFunction::Value::ONE)
+                {
+                    log_error("hal_simulator", "checkpoint contains invalid signal value {} for net with ID {}.", (int)value, net_id);
+                    return false;
+                }
+                auto it = nets.find(net_id);
+                if (it == nets.end())
+                {
+                    log_error("hal_simulator", "checkpoint references net with ID {} which is not part of the simulation.", net_id);
+                    return false;
+                }
+                event.affected_net = it->second;
+                event.new_value    = static_cast<BooleanFunction::Value>(value);
+                return true;
+            }
+
+            void skip(size_t num_bytes)
+            {
+                m_pos = std::min(m_pos + num_bytes, m_buffer.size());
+            }
+
+            bool at_end() const
+            {
+                return m_pos == m_buffer.size();
+            }
+
+        private:
+            const std::vector<u8>& m_buffer;
+            size_t m_pos = 0;
+        };
+    }    // namespace
+
+    std::vector<u8> NetlistSimulator::create_checkpoint()
+    {
+        if (!m_is_initialized)
+        {
+            initialize();
+        }
+
+        CheckpointWriter writer;
+        writer.m_buffer.insert(writer.m_buffer.end(), std::begin(checkpoint_magic), std::end(checkpoint_magic));
+        writer.write<u32>(checkpoint_version);
+        writer.write<u64>(m_current_time);
+        writer.write<u64>(m_id_counter);
+
+        // net values, i.e., the most recent event of every net
+        writer.write<u32>(m_simulation.m_events.size());
+        for (const auto& [net, events] : m_simulation.m_events)
+        {
+            writer.write_event(events.back());
+        }
+
+        // flip-flop state is fully determined by the values of its output nets, only RAM content needs to be stored
+        std::vector<const SimulationGateRAM*> rams;
+        for (const auto& sim_gate : m_sim_gates)
+        {
+            if (const SimulationGateRAM* ram = dynamic_cast<const SimulationGateRAM*>(sim_gate.get()); ram != nullptr)
+            {
+                rams.push_back(ram);
+            }
+        }
+
+        writer.write<u32>(rams.size());
+        for (const SimulationGateRAM* ram : rams)
+        {
+            writer.write<u32>(ram->m_gate->get_id());
+            writer.write<u32>(ram->m_data.size());
+            for (u64 word : ram->m_data)
+            {
+                writer.write<u64>(word);
+            }
+            writer.write<u32>(ram->m_clocked_read_ports.size());
+            for (size_t index : ram->m_clocked_read_ports)
+            {
+                writer.write<u32>(index);
+            }
+            writer.write<u32>(ram->m_clocked_write_ports.size());
+            for (size_t index : ram->m_clocked_write_ports)
+            {
+                writer.write<u32>(index);
+            }
+        }
+
+        // pending events
+        writer.write<u32>(m_event_queue.size());
+        for (const WaveEvent& event : m_event_queue)
+        {
+            writer.write_event(event);
+        }
+
+        return std::move(writer.m_buffer);
+    }
+
+    bool NetlistSimulator::restore_checkpoint(const std::vector<u8>& checkpoint)
+    {
+        if (checkpoint.size() < sizeof(checkpoint_magic) || std::memcmp(checkpoint.data(), checkpoint_magic, sizeof(checkpoint_magic)) != 0)
+        {
+            log_error("hal_simulator", "data is not a simulator checkpoint.");
+            return false;
+        }
+
+        if (!m_is_initialized)
+        {
+            initialize();
+            if (!m_is_initialized)
+            {
+                return false;
+            }
+        }
+
+        // collect all nets that may be referenced by the checkpoint
+        std::unordered_map<u32, const Net*> nets;
+        for (const Net* net : mSimulationInput->get_input_nets())
+        {
+            nets.emplace(net->get_id(), net);
+        }
+        std::unordered_map<u32, SimulationGate*> sim_gates;
+        for (SimulationGate* sim_gate : m_sim_gates_raw)
+        {
+            sim_gates.emplace(sim_gate->m_gate->get_id(), sim_gate);
+            for (const Net* net : sim_gate->m_gate->get_fan_out_nets())
+            {
+                nets.emplace(net->get_id(), net);
+            }
+        }
+
+        CheckpointReader reader(checkpoint);
+        reader.skip(sizeof(checkpoint_magic));
+
+        u32 version;
+        u64 current_time;
+        u64 id_counter;
+        if (!reader.read(version) || !reader.read(current_time) || !reader.read(id_counter))
+        {
+            log_error("hal_simulator", "simulator checkpoint is truncated.");
+            return false;
+        }
+        if (version != checkpoint_version)
+        {
+            log_error("hal_simulator", "unsupported simulator checkpoint version {}, expected version {}.", version, checkpoint_version);
+            return false;
+        }
+
+        // parse into temporary storage first so that a corrupt checkpoint leaves the simulator untouched
+        Simulation simulation;
+        u32 num_nets;
+        if (!reader.read(num_nets))
+        {
+            log_error("hal_simulator", "simulator checkpoint is truncated.");
+            return false;
+        }
+        for (u32 i = 0; i < num_nets; i++)
+        {
+            WaveEvent event;
+            if (!reader.read_event(nets, event))
+            {
+                log_error("hal_simulator", "could not read net values from simulator checkpoint.");
+                return false;
+            }
+            simulation.m_events[event.affected_net].push_back(event);
+        }
+
+        std::vector<std::tuple<SimulationGateRAM*, std::vector<u64>, std::vector<size_t>, std::vector<size_t>>> ram_states;
+        u32 num_rams;
+        if (!reader.read(num_rams))
+        {
+            log_error("hal_simulator", "simulator checkpoint is truncated.");
+            return false;
+        }
+        for (u32 i = 0; i < num_rams; i++)
+        {
+            u32 gate_id;
+            u32 num_words;
+            if (!reader.read(gate_id) || !reader.read(num_words))
+            {
+                log_error("hal_simulator", "could not read RAM state from simulator checkpoint.");
+                return false;
+            }
+
+            SimulationGateRAM* ram = nullptr;
+            if (auto it = sim_gates.find(gate_id); it != sim_gates.end())
+            {
+                ram = dynamic_cast<SimulationGateRAM*>(it->second);
+            }
+            if (ram == nullptr)
+            {
+                log_error("hal_simulator", "checkpoint references RAM gate with ID {} which is not part of the simulation.", gate_id);
+                return false;
+            }
+
+            std::vector<u64> data(num_words);
+            for (u64& word : data)
+            {
+                if (!reader.read(word))
+                {
+                    log_error("hal_simulator", "could not read RAM state from simulator checkpoint.");
+                    return false;
+                }
+            }
+
+            std::vector<size_t> clocked_ports[2];
+            for (std::vector<size_t>& ports : clocked_ports)
+            {
+                u32 num_ports;
+                if (!reader.read(num_ports))
+                {
+                    log_error("hal_simulator", "could not read RAM state from simulator checkpoint.");
+                    return false;
+                }
+                for (u32 j = 0; j < num_ports; j++)
+                {
+                    u32 index;
+                    if (!reader.read(index) || index >= ram->m_ports.size())
+                    {
+                        log_error("hal_simulator", "could not read RAM state from simulator checkpoint.");
+                        return false;
+                    }
+                    ports.push_back(index);
+                }
+            }
+
+            ram_states.emplace_back(ram, std::move(data), std::move(clocked_ports[0]), std::move(clocked_ports[1]));
+        }
+
+        std::vector<WaveEvent> event_queue;
+        u32 num_events;
+        if (!reader.read(num_events))
+        {
+            log_error("hal_simulator", "simulator checkpoint is truncated.");
+            return false;
+        }
+        event_queue.reserve(num_events);
+        for (u32 i = 0; i < num_events; i++)
+        {
+            WaveEvent event;
+            if (!reader.read_event(nets, event))
+            {
+                log_error("hal_simulator", "could not read pending events from simulator checkpoint.");
+                return false;
+            }
+            event_queue.push_back(event);
+        }
+
+        if (!reader.at_end())
+        {
+            log_error("hal_simulator", "simulator checkpoint contains trailing data.");
+            return false;
+        }
+
+        // apply state
+        m_current_time = current_time;
+        m_id_counter   = id_counter;
+        m_simulation   = std::move(simulation);
+        m_event_queue  = std::move(event_queue);
+
+        for (auto& [ram, data, read_ports, write_ports] : ram_states)
+        {
+            ram->m_data                = std::move(data);
+            ram->m_clocked_read_ports  = std::move(read_ports);
+            ram->m_clocked_write_ports = std::move(write_ports);
+        }
+
+        // gates cache their input values, rebuild them from the restored net values
+        for (SimulationGate* sim_gate : m_sim_gates_raw)
+        {
+            for (u32 i = 0; i < sim_gate->m_input_pins.size(); i++)
+            {
+                BooleanFunction::Value value = BooleanFunction::Value::X;
+                if (const Net* net = sim_gate->m_input_nets.at(i); net != nullptr)
+                {
+                    if (auto it = m_simulation.m_events.find(net); it != m_simulation.m_events.end())
+                    {
+                        value = it->second.back().new_value;
+                    }
+                }
+                sim_gate->m_input_values[sim_gate->m_input_pins.at(i)->get_name()] = value;
+            }
+        }
+
+        return true;
+    }
+
+    bool NetlistSimulator::save_checkpoint(const std::filesystem::path& path)
+    {
+        std::vector<u8> checkpoint = create_checkpoint();
+
+        std::ofstream ofs(path, std::ios::binary);
+        if (!ofs.is_open())
+        {
+            log_error("hal_simulator", "could not open file '{}' for writing.", path.string());
+            return false;
+        }
+        ofs.write(reinterpret_cast<const char*>(checkpoint.data()), checkpoint.size());
+        return ofs.good();
+    }
+
+    bool NetlistSimulator::load_checkpoint(const std::filesystem::path& path)
+    {
+        std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+        if (!ifs.is_open())
+        {
+            log_error("hal_simulator", "could not open file '{}' for reading.", path.string());
+            return false;
+        }
+
+        std::vector<u8> checkpoint(ifs.tellg());
+        ifs.seekg(0);
+        if (!ifs.read(reinterpret_cast<char*>(checkpoint.data()), checkpoint.size()))
+        {
+            log_error("hal_simulator", "could not read checkpoint file '{}'.", path.string());
+            return false;
+        }
+
+        return restore_checkpoint(checkpoint);
+    }
+
+    bool NetlistSimulator::fork_continuations(u32 count, const std::function<void(NetlistSimulator*, u32)>& continuation, u32 num_threads)
+    {
+        if (!continuation)
+        {
+            log_error("hal_simulator", "no continuation given.");
+            return false;
+        }
+
+        const std::vector<u8> checkpoint = create_checkpoint();
+
+        // every continuation works on a fresh simulator sharing the (read-only) simulation input
+        std::vector<std::unique_ptr<NetlistSimulator>> simulators;
+        for (u32 i = 0; i < count; i++)
+        {
+            std::unique_ptr<NetlistSimulator> sim(new NetlistSimulator(name()));
+            sim->mSimulationInput     = mSimulationInput;
+            sim->mWorkDir             = mWorkDir;
+            sim->mProperties          = mProperties;
+            sim->m_timeout_iterations = m_timeout_iterations;
+            if (!sim->restore_checkpoint(checkpoint))
+            {
+                log_error("hal_simulator", "could not restore checkpoint for continuation {}.", i);
+                return false;
+            }
+            simulators.push_back(std::move(sim));
+        }
+
+        utils::parallel_for(count, [&continuation, &simulators](u32 i) { continuation(simulators.at(i).get(), i); }, num_threads);
+
+        return true;
+    }
+}    // namespace hal
@@ -2,12 +2,20 @@
 
 namespace hal
 {
-    NetlistSimulator::SimulationGateCombinational::SimulationGateCombinational(const Gate* gate) : SimulationGate(gate)
+    NetlistSimulator::SimulationGateCombinational::SimulationGateCombinational(const Gate* gate, bool x_pessimism) : SimulationGate(gate)
     {
         std::unordered_map<std::string, BooleanFunction> functions = gate->get_boolean_functions();
 
         m_output_pins = gate->get_type()->get_output_pins();
 
+        // kernels read the input values in place, map nodes stay valid for the lifetime of the gate
+        std::vector<std::string> input_names;
+        for (const GatePin* pin : m_input_pins)
+        {
+            input_names.push_back(pin->get_name());
+            m_kernel_inputs.push_back(&m_input_values.at(pin->get_name()));
+        }
+
         for (const GatePin* pin : m_output_pins)
         {
             const Net* out_net = gate->get_fan_out_net(pin);
@@ -32,6 +40,8 @@ namespace hal
                     break;
                 }
             }
+            m_kernels.emplace_back();
+            m_kernels.back().compile(func, input_names, x_pessimism);
             m_functions.emplace(out_net, func);
         }
     }
@@ -43,9 +53,12 @@ namespace hal
         // compute delay, currently just a placeholder
         u64 delay = 0;
 
-        for (auto out_net : m_output_nets)
+        for (u32 i = 0; i < m_output_nets.size(); i++)
         {
-            BooleanFunction::Value result = m_functions[out_net].evaluate(m_input_values).get();
+            const Net* out_net = m_output_nets[i];
+
+            // functions using operations beyond the logic kernel are evaluated on the Boolean function directly
+            BooleanFunction::Value result = m_kernels[i].is_valid() ? m_kernels[i].evaluate(m_kernel_inputs) : m_functions[out_net].evaluate(m_input_values).get();
 
             new_events[std::make_pair(out_net, event.time + delay)] = result;
         }
@@ -0,0 +1,180 @@
+#include "netlist_simulator/logic_kernel.h"
+
+#include "netlist_test_utils.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hal
+{
+    class LogicKernelTest : public ::testing::Test
+    {
+    protected:
+        const std::vector<BooleanFunction::Value> all_values = {BooleanFunction::Value::ZERO, BooleanFunction::Value::ONE, BooleanFunction::Value::X, BooleanFunction::Value::Z};
+
+        virtual void SetUp()
+        {
+            NO_COUT_BLOCK;
+            test_utils::init_log_channels();
+        }
+
+        virtual void TearDown()
+        {
+        }
+
+        std::vector<BooleanFunction> create_functions()
+        {
+            std::vector<BooleanFunction> functions;
+            for (const std::string& expression : {"A", "!A", "A & B", "A | B", "A ^ B", "!(A & B)", "(A & B) | (!A & C)", "!(A ^ (B | C))", "(A | !B) & (C ^ A)", "A & !A", "A ^ A", "A & 0", "B | 1"})
+            {
+                functions.push_back(BooleanFunction::from_string(expression).get());
+            }
+            functions.push_back(BooleanFunction::Ite(BooleanFunction::Var("A"), BooleanFunction::Var("B"), BooleanFunction::Var("C"), 1).get());
+            functions.push_back(BooleanFunction::Ite(BooleanFunction::Var("A"), ~BooleanFunction::Var("B"), BooleanFunction::Var("B") & BooleanFunction::Var("C"), 1).get());
+            return functions;
+        }
+
+        /**
+         * Evaluate the kernel and the Boolean function on every assignment of 0, 1, X, and Z to the variables A, B, and C.
+         *
+         * @param[in] function - The Boolean function.
+         * @param[in] kernel - The kernel compiled from the function using variable order A, B, C.
+         * @param[in] check - Called with the kernel result and the Boolean function result for each assignment.
+         */
+        template<typename Check>
+        void for_all_inputs(const BooleanFunction& function, const LogicKernel& kernel, const Check& check)
+        {
+            std::vector<BooleanFunction::Value> values(3);
+            std::vector<const BooleanFunction::Value*> inputs = {&values[0], &values[1], &values[2]};
+            for (u32 i = 0; i < 64; i++)
+            {
+                values[0] = all_values[i & 3];
+                values[1] = all_values[(i >> 2) & 3];
+                values[2] = all_values[(i >> 4) & 3];
+                std::unordered_map<std::string, BooleanFunction::Value> assignment = {{"A", values[0]}, {"B", values[1]}, {"C", values[2]}};
+                auto expected = function.evaluate(assignment);
+                ASSERT_TRUE(expected.is_ok());
+                SCOPED_TRACE(function.to_string() + " with A=" + enum_to_string(values[0]) + " B=" + enum_to_string(values[1]) + " C=" + enum_to_string(values[2]));
+                check(kernel.evaluate(inputs), expected.get(), values);
+            }
+        }
+    };
+
+    /**
+     * Testing that kernels evaluate like BooleanFunction::evaluate, including X and Z inputs.
+     *
+     * Functions: compile, evaluate
+     */
+    TEST_F(LogicKernelTest, check_evaluate)
+    {
+        TEST_START
+        {
+            for (const BooleanFunction& function : create_functions())
+            {
+                LogicKernel kernel;
+                ASSERT_TRUE(kernel.compile(function, {"A", "B", "C"}));
+                EXPECT_TRUE(kernel.is_valid());
+                for_all_inputs(function, kernel, [](BooleanFunction::Value result, BooleanFunction::Value expected, const std::vector<BooleanFunction::Value>&) {
+                    EXPECT_EQ(result, expected);
+                });
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing pessimistic X-propagation: results equal BooleanFunction::evaluate for known inputs, otherwise they may only turn into X.
+     *
+     * Functions: compile, evaluate
+     */
+    TEST_F(LogicKernelTest, check_evaluate_x_pessimism)
+    {
+        TEST_START
+        {
+            for (const BooleanFunction& function : create_functions())
+            {
+                LogicKernel kernel;
+                ASSERT_TRUE(kernel.compile(function, {"A", "B", "C"}, true));
+                for_all_inputs(function, kernel, [](BooleanFunction::Value result, BooleanFunction::Value expected, const std::vector<BooleanFunction::Value>& values) {
+                    bool all_known = true;
+                    for (BooleanFunction::Value v : values)
+                    {
+                        all_known &= (v == BooleanFunction::Value::ZERO || v == BooleanFunction::Value::ONE);
+                    }
+                    if (all_known)
+                    {
+                        EXPECT_EQ(result, expected);
+                    }
+                    else
+                    {
+                        EXPECT_TRUE(result == expected || result == BooleanFunction::Value::X);
+                    }
+                });
+            }
+
+            // controlling values do not resolve unknown inputs
+            BooleanFunction::Value zero = BooleanFunction::Value::ZERO;
+            BooleanFunction::Value one  = BooleanFunction::Value::ONE;
+            BooleanFunction::Value x    = BooleanFunction::Value::X;
+            BooleanFunction::Value z    = BooleanFunction::Value::Z;
+            {
+                LogicKernel kernel;
+                ASSERT_TRUE(kernel.compile(BooleanFunction::from_string("A & B").get(), {"A", "B"}, true));
+                EXPECT_EQ(kernel.evaluate({&zero, &x}), x);
+                EXPECT_EQ(kernel.evaluate({&z, &zero}), x);
+                EXPECT_EQ(kernel.evaluate({&one, &one}), one);
+                ASSERT_TRUE(kernel.compile(BooleanFunction::from_string("A & B").get(), {"A", "B"}, false));
+                EXPECT_EQ(kernel.evaluate({&zero, &x}), zero);
+                EXPECT_EQ(kernel.evaluate({&z, &zero}), zero);
+            }
+            {
+                LogicKernel kernel;
+                ASSERT_TRUE(kernel.compile(BooleanFunction::from_string("A | B").get(), {"A", "B"}, true));
+                EXPECT_EQ(kernel.evaluate({&one, &x}), x);
+                EXPECT_EQ(kernel.evaluate({&z, &one}), x);
+                ASSERT_TRUE(kernel.compile(BooleanFunction::from_string("A | B").get(), {"A", "B"}, false));
+                EXPECT_EQ(kernel.evaluate({&one, &x}), one);
+                EXPECT_EQ(kernel.evaluate({&z, &one}), one);
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing that functions beyond the kernel operations are rejected.
+     *
+     * Functions: compile, is_valid
+     */
+    TEST_F(LogicKernelTest, check_compile_unsupported)
+    {
+        TEST_START
+        {
+            LogicKernel kernel;
+            EXPECT_FALSE(kernel.is_valid());
+
+            // empty function
+            EXPECT_FALSE(kernel.compile(BooleanFunction(), {"A"}));
+            EXPECT_FALSE(kernel.is_valid());
+
+            // variable not passed to compile()
+            EXPECT_FALSE(kernel.compile(BooleanFunction::from_string("A & D").get(), {"A", "B", "C"}));
+            EXPECT_FALSE(kernel.is_valid());
+
+            // arithmetic operation
+            EXPECT_FALSE(kernel.compile(BooleanFunction::Add(BooleanFunction::Var("A"), BooleanFunction::Var("B"), 1).get(), {"A", "B"}));
+            EXPECT_FALSE(kernel.is_valid());
+
+            // multi-bit function
+            EXPECT_FALSE(kernel.compile(BooleanFunction::Var("A", 2), {"A"}));
+            EXPECT_FALSE(kernel.is_valid());
+
+            // failed compilation invalidates a previously compiled kernel
+            ASSERT_TRUE(kernel.compile(BooleanFunction::from_string("A").get(), {"A"}));
+            EXPECT_TRUE(kernel.is_valid());
+            EXPECT_FALSE(kernel.compile(BooleanFunction::from_string("A & D").get(), {"A"}));
+            EXPECT_FALSE(kernel.is_valid());
+        }
+        TEST_END
+    }
+}    // namespace hal
@@ -0,0 +1,346 @@
+#include "netlist_simulator/netlist_simulator.h"
+
+#include "netlist_simulator/plugin_netlist_simulator.h"
+#include "netlist_simulator_controller/simulation_engine.h"
+#include "netlist_simulator_controller/simulation_input.h"
+#include "netlist_test_utils.h"
+
+#include <mutex>
+#include <random>
+
+namespace hal
+{
+    class NetlistSimulatorTest : public ::testing::Test
+    {
+    protected:
+        NetlistSimulatorPlugin m_plugin;
+
+        // duration of a single simulation step, i.e., one clock cycle, in picoseconds
+        static constexpr u64 step_duration = 10000;
+
+        virtual void SetUp()
+        {
+            NO_COUT_BLOCK;
+            test_utils::init_log_channels();
+            test_utils::create_sandbox_directory();
+            m_plugin.on_load();
+        }
+
+        virtual void TearDown()
+        {
+            m_plugin.on_unload();
+            test_utils::remove_sandbox_directory();
+        }
+
+        /*
+         *  4-bit shift register with feedback, i.e., an LFSR that is additionally driven by the input 'in':
+         *
+         *  q0 <= q3 ^ in;  q1 <= q0;  q2 <= q1 ^ q3;  q3 <= q2;  out = !q3
+         */
+        std::unique_ptr<Netlist> create_lfsr_netlist()
+        {
+            std::unique_ptr<Netlist> nl = test_utils::create_empty_netlist();
+            const GateLibrary* gl       = nl->get_gate_library();
+
+            std::vector<Gate*> ffs;
+            for (u32 i = 0; i < 4; i++)
+            {
+                ffs.push_back(nl->create_gate(gl->get_gate_type_by_name("DFF"), "ff" + std::to_string(i)));
+            }
+            Gate* x0  = nl->create_gate(gl->get_gate_type_by_name("XOR2"), "x0");
+            Gate* x2  = nl->create_gate(gl->get_gate_type_by_name("XOR2"), "x2");
+            Gate* inv = nl->create_gate(gl->get_gate_type_by_name("INV"), "inv");
+
+            Net* clk = nl->create_net("clk");
+            clk->mark_global_input_net();
+            for (Gate* ff : ffs)
+            {
+                clk->add_destination(ff, "CLK");
+            }
+
+            Net* in = nl->create_net("in");
+            in->mark_global_input_net();
+            in->add_destination(x0, "I1");
+
+            std::vector<Net*> qs;
+            for (u32 i = 0; i < 4; i++)
+            {
+                Net* q = nl->create_net("q" + std::to_string(i));
+                q->add_source(ffs.at(i), "Q");
+                qs.push_back(q);
+            }
+
+            qs.at(3)->add_destination(x0, "I0");
+            qs.at(0)->add_destination(ffs.at(1), "D");
+            qs.at(1)->add_destination(x2, "I0");
+            qs.at(3)->add_destination(x2, "I1");
+            qs.at(2)->add_destination(ffs.at(3), "D");
+            qs.at(3)->add_destination(inv, "I");
+
+            Net* d0 = nl->create_net("d0");
+            d0->add_source(x0, "O");
+            d0->add_destination(ffs.at(0), "D");
+
+            Net* d2 = nl->create_net("d2");
+            d2->add_source(x2, "O");
+            d2->add_destination(ffs.at(2), "D");
+
+            Net* out = nl->create_net("out");
+            out->add_source(inv, "O");
+            out->mark_global_output_net();
+
+            return nl;
+        }
+
+        std::unique_ptr<SimulationInput> create_simulation_input(Netlist* nl)
+        {
+            auto input = std::make_unique<SimulationInput>();
+            input->add_gates(nl->get_gates());
+            input->add_clock(SimulationInput::Clock{nl->get_nets(test_utils::net_name_filter("clk")).front(), step_duration / 2, false});
+            return input;
+        }
+
+        std::unique_ptr<NetlistSimulator> create_simulator(SimulationInput* input)
+        {
+            SimulationEngineFactory* factory = SimulationEngineFactories::instance()->factoryByName(m_plugin.get_name());
+            if (factory == nullptr)
+            {
+                return nullptr;
+            }
+            SimulationEngine* engine = factory->createEngine();
+            engine->setSimulationInput(input);
+            return std::unique_ptr<NetlistSimulator>(dynamic_cast<NetlistSimulator*>(engine));
+        }
+
+        static std::vector<BooleanFunction::Value> input_sequence(u32 seed, u32 length)
+        {
+            std::mt19937 rng(seed);
+            std::vector<BooleanFunction::Value> sequence;
+            for (u32 i = 0; i < length; i++)
+            {
+                sequence.push_back((rng() & 1) ? BooleanFunction::Value::ONE : BooleanFunction::Value::ZERO);
+            }
+            return sequence;
+        }
+
+        static void run_steps(NetlistSimulator* sim, const Net* in, const std::vector<BooleanFunction::Value>& sequence, u32 begin, u32 end)
+        {
+            for (u32 i = begin; i < end; i++)
+            {
+                sim->set_input(in, sequence.at(i));
+                sim->simulate(step_duration);
+            }
+        }
+
+        /// Compare the waveforms of all nets recorded in 'expected' within the time frame [from, to).
+        static void expect_equal_waveforms(const Simulation& expected, const Simulation& actual, u64 from, u64 to)
+        {
+            for (const auto& [net, expected_events] : expected.get_events())
+            {
+                std::vector<std::pair<u64, BooleanFunction::Value>> expected_changes;
+                for (const WaveEvent& e : expected_events)
+                {
+                    if (e.time > from && e.time < to)
+                    {
+                        expected_changes.push_back({e.time, e.new_value});
+                    }
+                }
+
+                std::vector<std::pair<u64, BooleanFunction::Value>> actual_changes;
+                for (const WaveEvent& e : actual.get_events_by_net_id(net->get_id()))
+                {
+                    if (e.time > from && e.time < to)
+                    {
+                        actual_changes.push_back({e.time, e.new_value});
+                    }
+                }
+
+                EXPECT_EQ(actual_changes, expected_changes) << "net '" << net->get_name() << "'";
+
+                for (u64 t = from; t < to; t += step_duration / 4)
+                {
+                    EXPECT_EQ(actual.get_net_value(net, t), expected.get_net_value(net, t)) << "net '" << net->get_name() << "' at " << t << " ps";
+                }
+            }
+        }
+    };
+
+    /**
+     * Testing that a simulation interrupted by a checkpoint, which is then restored into a new simulator (in memory or via
+     * a file), continues with exactly the same waveforms as an uninterrupted simulation.
+     *
+     * Functions: create_checkpoint, restore_checkpoint, save_checkpoint, load_checkpoint
+     */
+    TEST_F(NetlistSimulatorTest, check_checkpoint_restore)
+    {
+        TEST_START
+        {
+            const u32 num_steps       = 40;
+            const u32 checkpoint_step = 17;
+
+            std::unique_ptr<Netlist> nl = create_lfsr_netlist();
+            ASSERT_NE(nl, nullptr);
+            const Net* in                          = nl->get_nets(test_utils::net_name_filter("in")).front();
+            std::unique_ptr<SimulationInput> input = create_simulation_input(nl.get());
+            std::vector<BooleanFunction::Value> sequence = input_sequence(1, num_steps);
+
+            // uninterrupted reference
+            std::unique_ptr<NetlistSimulator> reference = create_simulator(input.get());
+            ASSERT_NE(reference, nullptr);
+            reference->initialize_sequential_gates(BooleanFunction::Value::ZERO);
+            run_steps(reference.get(), in, sequence, 0, num_steps);
+
+            // interrupted simulation
+            std::unique_ptr<NetlistSimulator> first = create_simulator(input.get());
+            ASSERT_NE(first, nullptr);
+            first->initialize_sequential_gates(BooleanFunction::Value::ZERO);
+            run_steps(first.get(), in, sequence, 0, checkpoint_step);
+            expect_equal_waveforms(first->get_simulation_state(), reference->get_simulation_state(), 0, checkpoint_step * step_duration);
+
+            std::vector<u8> checkpoint = first->create_checkpoint();
+            ASSERT_FALSE(checkpoint.empty());
+            std::filesystem::path checkpoint_file = test_utils::create_sandbox_path("lfsr.checkpoint");
+            ASSERT_TRUE(first->save_checkpoint(checkpoint_file));
+
+            std::unique_ptr<NetlistSimulator> from_memory = create_simulator(input.get());
+            ASSERT_NE(from_memory, nullptr);
+            ASSERT_TRUE(from_memory->restore_checkpoint(checkpoint));
+            run_steps(from_memory.get(), in, sequence, checkpoint_step, num_steps);
+            expect_equal_waveforms(reference->get_simulation_state(), from_memory->get_simulation_state(), checkpoint_step * step_duration, num_steps * step_duration);
+
+            std::unique_ptr<NetlistSimulator> from_file = create_simulator(input.get());
+            ASSERT_NE(from_file, nullptr);
+            ASSERT_TRUE(from_file->load_checkpoint(checkpoint_file));
+            run_steps(from_file.get(), in, sequence, checkpoint_step, num_steps);
+            expect_equal_waveforms(reference->get_simulation_state(), from_file->get_simulation_state(), checkpoint_step * step_duration, num_steps * step_duration);
+
+            // continuing the simulator that created the checkpoint is not affected by the checkpoint either
+            run_steps(first.get(), in, sequence, checkpoint_step, num_steps);
+            expect_equal_waveforms(reference->get_simulation_state(), first->get_simulation_state(), 0, num_steps * step_duration);
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing that corrupt checkpoints are rejected without altering the simulator state.
+     *
+     * Functions: restore_checkpoint
+     */
+    TEST_F(NetlistSimulatorTest, check_checkpoint_invalid)
+    {
+        TEST_START
+        {
+            std::unique_ptr<Netlist> nl = create_lfsr_netlist();
+            ASSERT_NE(nl, nullptr);
+            const Net* in                          = nl->get_nets(test_utils::net_name_filter("in")).front();
+            std::unique_ptr<SimulationInput> input = create_simulation_input(nl.get());
+            std::vector<BooleanFunction::Value> sequence = input_sequence(2, 10);
+
+            std::unique_ptr<NetlistSimulator> sim = create_simulator(input.get());
+            ASSERT_NE(sim, nullptr);
+            sim->initialize_sequential_gates(BooleanFunction::Value::ZERO);
+            run_steps(sim.get(), in, sequence, 0, 5);
+            std::vector<u8> checkpoint = sim->create_checkpoint();
+
+            std::unique_ptr<NetlistSimulator> other = create_simulator(input.get());
+            ASSERT_NE(other, nullptr);
+            other->initialize_sequential_gates(BooleanFunction::Value::ZERO);
+            run_steps(other.get(), in, sequence, 0, 8);
+            Simulation state = other->get_simulation_state();
+
+            {
+                NO_COUT_BLOCK;
+                EXPECT_FALSE(other->restore_checkpoint({}));
+                EXPECT_FALSE(other->restore_checkpoint(std::vector<u8>(checkpoint.begin(), checkpoint.end() - 1)));
+                std::vector<u8> trailing = checkpoint;
+                trailing.push_back(0);
+                EXPECT_FALSE(other->restore_checkpoint(trailing));
+                std::vector<u8> bad_magic = checkpoint;
+                bad_magic.at(0) ^= 0xff;
+                EXPECT_FALSE(other->restore_checkpoint(bad_magic));
+                EXPECT_FALSE(other->load_checkpoint(test_utils::create_sandbox_path("does_not_exist.checkpoint")));
+            }
+
+            // state is untouched, simulation continues as before
+            expect_equal_waveforms(state, other->get_simulation_state(), 0, 8 * step_duration);
+            run_steps(other.get(), in, sequence, 8, 10);
+            run_steps(sim.get(), in, sequence, 5, 10);
+            expect_equal_waveforms(sim->get_simulation_state(), other->get_simulation_state(), 0, 10 * step_duration);
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing parallel continuations forked from a common simulator state. Every continuation must produce the same
+     * waveforms as a sequential simulation restored from a checkpoint of the same state, and the forking simulator
+     * must not be altered.
+     *
+     * Functions: fork_continuations
+     */
+    TEST_F(NetlistSimulatorTest, check_fork_continuations)
+    {
+        TEST_START
+        {
+            const u32 num_steps = 30;
+            const u32 fork_step = 12;
+            const u32 num_fork  = 6;
+            const u64 fork_time = fork_step * step_duration;
+            const u64 end_time  = num_steps * step_duration;
+
+            std::unique_ptr<Netlist> nl = create_lfsr_netlist();
+            ASSERT_NE(nl, nullptr);
+            const Net* in                          = nl->get_nets(test_utils::net_name_filter("in")).front();
+            std::unique_ptr<SimulationInput> input = create_simulation_input(nl.get());
+
+            std::unique_ptr<NetlistSimulator> sim = create_simulator(input.get());
+            ASSERT_NE(sim, nullptr);
+            sim->initialize_sequential_gates(BooleanFunction::Value::ZERO);
+            run_steps(sim.get(), in, input_sequence(0, fork_step), 0, fork_step);
+            Simulation state_before_fork = sim->get_simulation_state();
+            std::vector<u8> checkpoint   = sim->create_checkpoint();
+
+            std::vector<Simulation> results(num_fork);
+            std::vector<u32> visited(num_fork, 0);
+            std::mutex mutex;
+            ASSERT_TRUE(sim->fork_continuations(
+                num_fork,
+                [&](NetlistSimulator* continuation, u32 index) {
+                    std::vector<BooleanFunction::Value> sequence = input_sequence(100 + index, num_steps);
+                    run_steps(continuation, in, sequence, fork_step, num_steps);
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    results.at(index) = continuation->get_simulation_state();
+                    visited.at(index)++;
+                },
+                3));
+
+            for (u32 i = 0; i < num_fork; i++)
+            {
+                EXPECT_EQ(visited.at(i), 1u);
+
+                std::unique_ptr<NetlistSimulator> sequential = create_simulator(input.get());
+                ASSERT_NE(sequential, nullptr);
+                ASSERT_TRUE(sequential->restore_checkpoint(checkpoint));
+                run_steps(sequential.get(), in, input_sequence(100 + i, num_steps), fork_step, num_steps);
+                expect_equal_waveforms(sequential->get_simulation_state(), results.at(i), fork_time, end_time);
+            }
+
+            // continuations are independent of each other
+            bool any_difference = false;
+            for (u64 t = fork_time; t <= end_time && !any_difference; t += step_duration)
+            {
+                any_difference = results.at(0).get_net_value(in, t) != results.at(1).get_net_value(in, t);
+            }
+            EXPECT_TRUE(any_difference);
+
+            // the forking simulator is unchanged and can continue on its own
+            expect_equal_waveforms(state_before_fork, sim->get_simulation_state(), 0, fork_time);
+            EXPECT_EQ(sim->get_simulation_state().get_events().size(), state_before_fork.get_events().size());
+            run_steps(sim.get(), in, input_sequence(100, num_steps), fork_step, num_steps);
+            expect_equal_waveforms(results.at(0), sim->get_simulation_state(), fork_time, end_time);
+
+            EXPECT_FALSE(sim->fork_continuations(2, nullptr));
+        }
+        TEST_END
+    }
+}    // namespace hal
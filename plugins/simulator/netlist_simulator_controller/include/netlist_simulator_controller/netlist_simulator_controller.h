@@ -42,6 +42,7 @@
 #include <sstream>
 #include <vector>
 
+#include "netlist_simulator_controller/simulation_activity.h"
 #include "netlist_simulator_controller/simulation_engine.h"
 #include "netlist_simulator_controller/simulation_input.h"
 #include "netlist_simulator_controller/wave_data.h"
@@ -364,6 +365,18 @@ public:
      */
     bool generate_vcd(const std::filesystem::path& path, u32 start_time=0, u32 end_time=0, std::set<const Net*> nets = {}) const;
 
+    /**
+     * Computes per net toggle counts, Hamming weight and Hamming distance per clock cycle, and switching activity
+     * per module from simulation results. Waveform files are streamed once, nets are processed in parallel.
+     *
+     * @param[in] clock_period - Length of clock cycle in picoseconds.
+     * @param[in] start_time - Start of analyzed timeframe (in picoseconds).
+     * @param[in] end_time - End of analyzed timeframe (in picoseconds), 0 for end of simulation.
+     * @param[in] num_threads - Number of worker threads, 0 for hardware concurrency.
+     * @returns The activity aggregates or nullptr on error.
+     */
+    std::shared_ptr<SimulationActivity> analyze_activity(u64 clock_period, u64 start_time=0, u64 end_time=0, u32 num_threads=0) const;
+
     /**
      * The working directory. Directory is temporary and will be removed when controller gets deleted
      * @return directory path
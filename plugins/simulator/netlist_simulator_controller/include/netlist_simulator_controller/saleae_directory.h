@@ -189,6 +189,9 @@ namespace hal
         /// Setter for filter pointer described above.
         void set_filter_entry(int filt) { mFilterEntry = filt; }
 
+        /// Set binary file holding derived waveform data, replaces previous file index
+        void set_file_index(const SaleaeDirectoryFileIndex& sdfi) { mFileIndexes.clear(); mFileIndexes.push_back(sdfi); }
+
         /// Test for null
         bool isNull() const { return !mId || !mType; }
 
@@ -27,6 +27,8 @@
 
 #include <fstream>
 #include <functional>
+#include <string>
+#include <vector>
 #ifdef STANDALONE_PARSER
 #include "saleae_directory.h"
 #else
@@ -54,7 +56,8 @@ namespace hal
         /// SALEAE storage format for transition time values
         enum StorageFormat { Double = 0,          /// Double values,
                              Uint64 = 0x206c6168,
-                             Coded = 0x786c6168 };
+                             Coded = 0x786c6168,
+                             Compressed = 0x7a6c6168 };
         char mIdent[9];
         int32_t mVersion;
         StorageFormat mStorageFormat;
@@ -87,6 +90,9 @@ namespace hal
         /// Setter for storage format, see above
         void setStorageFormat(StorageFormat sf) { mStorageFormat = sf; }
 
+        /// True if format stores value for each transition (required for undefined values)
+        bool hasCodedValues() const { return mStorageFormat == Coded || mStorageFormat == Compressed; }
+
         /// Getter for initial value
         int32_t value() const { return mValue; }
 
@@ -162,6 +168,74 @@ namespace hal
         bool readError() const { return mValue == sReadError; }
     };
 
+    /**
+     * @brief The SaleaeCompressedBlock class encodes and decodes a block of transitions in compressed SALEAE format.
+     * Each block holds sBlockSize transitions (the last block might hold fewer). Blocks start with a header
+     * (first transition time, first value, count, payload size) followed by the payload. Transitions are encoded as
+     * varint of time delta and value. A sequence of transitions with constant time delta where each value repeats
+     * the value two transitions before (e.g. clock) is run-length encoded. The file is terminated by the block index
+     * (first transition time and file offset for each block) allowing random access.
+     */
+    class SaleaeCompressedBlock
+    {
+    public:
+        struct IndexEntry
+        {
+            uint64_t mFirstTime;
+            uint64_t mOffset;
+        };
+
+        /// Number of transitions in block
+        static constexpr uint64_t sBlockSize = 4096;
+
+        /// Size of block header in bytes
+        static constexpr uint64_t sHeaderSize = 24;
+
+        /// Size of trailer (number of blocks and identifier) in bytes
+        static constexpr uint64_t sTrailerSize = 16;
+
+        /// Identifier at end of file
+        static const char* sTrailerIdent;
+
+        /// Transition times in block
+        std::vector<uint64_t> mTimes;
+
+        /// Transition values in block
+        std::vector<int> mValues;
+
+        /// Encode block and append it to buffer
+        void encode(std::string& buf) const;
+
+        /**
+         * Decode block.
+         * @param buf Points to block header
+         * @param size Number of bytes available
+         * @return true on success, false if data is corrupt
+         */
+        bool decode(const char* buf, uint64_t size);
+
+        /// Total size of block in bytes given pointer to block header
+        static uint64_t blockSize(const char* buf);
+
+        /**
+         * Parse block index from trailer.
+         * @param fileEnd Points behind last byte of file
+         * @param available Number of bytes available before fileEnd
+         * @param index Index to be filled
+         * @return Number of bytes occupied by index and trailer, 0 on error
+         */
+        static uint64_t parseIndex(const char* fileEnd, uint64_t available, std::vector<IndexEntry>& index);
+
+        /**
+         * Check block index against data area before any block gets accessed.
+         * @param index Block index as returned by parseIndex
+         * @param dataBegin File offset of first block (behind file header)
+         * @param dataEnd File offset of block index (behind last block)
+         * @return true if offsets are increasing and each block header fits into data area, false if index is corrupt
+         */
+        static bool checkIndex(const std::vector<IndexEntry>& index, uint64_t dataBegin, uint64_t dataEnd);
+    };
+
     class SaleaeInputFile : public std::ifstream
     {
         SaleaeHeader mHeader;
@@ -170,7 +244,15 @@ namespace hal
 
         std::function<uint64_t(bool*)> mReader;
 
-        void seekTransition(uint64_t pos) { seekg(pos*sizeof(uint64_t) + 44); }
+        std::vector<SaleaeCompressedBlock::IndexEntry> mBlockIndex;
+        uint64_t mBlockDataEnd;
+        SaleaeCompressedBlock mBlock;
+        int64_t mBlockNumber;
+        uint64_t mTransitionCursor;
+
+        void seekTransition(uint64_t pos);
+        bool readBlockIndex();
+        bool readCompressed(uint64_t transition, uint64_t& t, int& val);
     public:
         SaleaeInputFile(const std::string& filename);
 
@@ -209,10 +291,19 @@ namespace hal
         bool mFirstValue;
         int mLastWrittenValue;
         uint64_t mLastWrittenTime;
+        SaleaeCompressedBlock mBlock;
+        std::vector<SaleaeCompressedBlock::IndexEntry> mBlockIndex;
 
         void convertToCoded();
+        void writeBlock();
     public:
-        SaleaeOutputFile(const std::string& filename, int index_);
+        /**
+         * Constructor for SaleaeOutputFile
+         * @param filename The binary data file
+         * @param index_ Data file index (XXX in digital_XXX.bin)
+         * @param compressed Write compressed format instead of uncompressed Uint64/Coded format
+         */
+        SaleaeOutputFile(const std::string& filename, int index_, bool compressed = false);
         ~SaleaeOutputFile();
 
         /// Write single data tuple to disk
@@ -0,0 +1,165 @@
+// MIT License
+// 
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "netlist_simulator_controller/saleae_file.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+    /**
+     * @brief The SaleaeTimeIndex class is a sparse index mapping transition times to positions within a SALEAE data file.
+     * Every sStride-th transition time is recorded, thus a lookup only has to touch a single block of the data file
+     * after a binary search over the (small) index. The index is stored beside the data file ('digital_XXX.idx')
+     * and rebuilt automatically if it does not match the data file any more.
+     */
+    class SaleaeTimeIndex
+    {
+        uint64_t mNumTransitions;
+        uint64_t mBeginTime;
+        uint64_t mEndTime;
+        uint64_t mDataFileSize;
+        std::vector<uint64_t> mTimes;
+
+        static const char* sIdent;
+        static const uint32_t sVersion = 1;
+    public:
+        /// Number of transitions between two index entries
+        static const uint64_t sStride = 4096;
+
+        SaleaeTimeIndex() : mNumTransitions(0), mBeginTime(0), mEndTime(0), mDataFileSize(0) {;}
+
+        /// Get index filename for SALEAE data file (digital_XXX.bin -> digital_XXX.idx)
+        static std::string indexFilename(const std::string& datafile);
+
+        /// Load index from disk, returns false if index file does not exist or does not match given header and data file size
+        bool load(const std::string& filename, const SaleaeHeader& header, uint64_t dataFileSize);
+
+        /// Write index to disk
+        bool save(const std::string& filename) const;
+
+        /// Check whether index matches given header and data file size
+        bool matches(const SaleaeHeader& header, uint64_t dataFileSize) const;
+
+        /// Reset index for given header and data file size
+        void reset(const SaleaeHeader& header, uint64_t dataFileSize);
+
+        /// Append time of transition number (size() * sStride)
+        void append(uint64_t t) { mTimes.push_back(t); }
+
+        /// Number of index entries
+        uint64_t size() const { return mTimes.size(); }
+
+        /// Index of block which contains last transition with time less or equal t. Returns -1 if t precedes first indexed transition
+        int64_t block(uint64_t t) const;
+    };
+
+    /**
+     * @brief The SaleaeMappedFile class provides random read access to a SALEAE data file mapped into memory.
+     * Positions are numbered in the same way as in SaleaeInputFile: position 0 is the start value from header,
+     * position i > 0 is the i-th transition. Seeking to any time is O(log n) by means of the SaleaeTimeIndex
+     * which is built on first access and stored beside the data file. Iterating over a time window does not copy
+     * any data. Files in compressed format are indexed by their block index, the most recently used block is
+     * kept decoded, thus an instance must not be shared between threads.
+     */
+    class SaleaeMappedFile
+    {
+        std::string mFilename;
+        SaleaeHeader mHeader;
+        SaleaeStatus::ErrorCode mStatus;
+        const char* mMapped;
+        uint64_t mMappedSize;
+        bool mIsMmap;
+        const char* mTransitions;
+        SaleaeTimeIndex mIndex;
+        std::vector<SaleaeCompressedBlock::IndexEntry> mBlockIndex;
+        uint64_t mBlockDataEnd;
+        mutable SaleaeCompressedBlock mBlock;
+        mutable int64_t mBlockNumber;
+
+        static const uint64_t sHeaderSize = 44;
+
+        void mapFile();
+        void unmapFile();
+        void loadOrBuildIndex();
+        uint64_t rawTime(uint64_t transition) const;
+        const SaleaeCompressedBlock* decodedBlock(uint64_t transition) const;
+    public:
+        class const_iterator
+        {
+            const SaleaeMappedFile* mFile;
+            uint64_t mPos;
+        public:
+            const_iterator(const SaleaeMappedFile* smf, uint64_t pos) : mFile(smf), mPos(pos) {;}
+            SaleaeDataTuple operator*() const { return mFile->valueAt(mPos); }
+            const_iterator& operator++() { ++mPos; return *this; }
+            bool operator==(const const_iterator& other) const { return mPos == other.mPos; }
+            bool operator!=(const const_iterator& other) const { return mPos != other.mPos; }
+            uint64_t position() const { return mPos; }
+        };
+
+        SaleaeMappedFile(const std::string& filename);
+        ~SaleaeMappedFile();
+        SaleaeMappedFile(const SaleaeMappedFile&) = delete;
+        SaleaeMappedFile& operator=(const SaleaeMappedFile&) = delete;
+
+        /// True if file was opened and mapped successfully
+        bool good() const { return mStatus == SaleaeStatus::Ok; }
+
+        /// Get verbose error message based on internal status, empty string if no error
+        std::string get_last_error() const;
+
+        /// Getter for header information
+        const SaleaeHeader* header() const { return &mHeader; }
+
+        /// Number of values in file which is number of transitions + 1 (start value)
+        uint64_t numberValues() const { return good() ? mHeader.numTransitions() + 1 : 0; }
+
+        /// Get (time,value) tuple at position pos, read error tuple if pos is out of range
+        SaleaeDataTuple valueAt(uint64_t pos) const;
+
+        /// Position of last value with time less or equal t, -1 if t precedes first value
+        int64_t positionAt(uint64_t t) const;
+
+        /// Position of first value with time greater or equal t (greater than t if 'strict' is set), numberValues() if there is none
+        uint64_t successorPosition(uint64_t t, bool strict=false) const;
+
+        /// Get waveform value for time t, -1 if there is no value
+        int get_int_value(uint64_t t) const;
+
+        /// Iterator pointing to value valid at time t (which might have been set before t)
+        const_iterator begin(uint64_t t=0) const;
+
+        /// Iterator pointing to first value after time t, can be used as end of iteration over time window
+        const_iterator end(uint64_t t) const;
+
+        /// Iterator pointing behind last value
+        const_iterator end() const { return const_iterator(this, numberValues()); }
+    };
+}
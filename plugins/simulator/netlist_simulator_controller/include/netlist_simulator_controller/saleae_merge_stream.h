@@ -0,0 +1,161 @@
+// MIT License
+// 
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "netlist_simulator_controller/saleae_file.h"
+#include "netlist_simulator_controller/saleae_mapped_file.h"
+
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+    /**
+     * @brief The SaleaeMergeStream class merges the transitions of any number of SALEAE data files into a single
+     * stream of events ordered by time. Files are memory mapped and a heap holds the next transition of each input,
+     * thus memory consumption does not depend on the length of the waveforms. After each call to next() the values
+     * of all inputs valid at time() are available. For the first 32 inputs the values are additionally packed
+     * into bit masks which allows evaluating Boolean functions by table lookup.
+     */
+    class SaleaeMergeStream
+    {
+        struct Input
+        {
+            std::unique_ptr<SaleaeMappedFile> mFile;
+            uint64_t mPos;
+            int mValue;
+        };
+
+        typedef std::pair<uint64_t,uint32_t> HeapEntry;
+
+        std::vector<Input> mInputs;
+        std::priority_queue<HeapEntry,std::vector<HeapEntry>,std::greater<HeapEntry>> mHeap;
+        std::vector<uint32_t> mChanged;
+        uint64_t mTime;
+        uint32_t mBits;
+        uint32_t mUndefined;
+        bool mGood;
+    public:
+        /// Maximum number of inputs represented in bits() and undefined() masks
+        static const uint32_t sMaxMaskInputs = 32;
+
+        /**
+         * Constructor for SaleaeMergeStream
+         * @param datafiles Full path of SALEAE data file for each input
+         */
+        SaleaeMergeStream(const std::vector<std::string>& datafiles);
+
+        /// True if all input files could be mapped
+        bool good() const { return mGood; }
+
+        /// Number of inputs
+        uint32_t numberInputs() const { return mInputs.size(); }
+
+        /// Advance to next event time applying all transitions at that time, returns false if all inputs are exhausted
+        bool next();
+
+        /// Time of current event
+        uint64_t time() const { return mTime; }
+
+        /// Value of input inx valid at current event time, -1 if input has no value yet
+        int value(uint32_t inx) const { return mInputs.at(inx).mValue; }
+
+        /// Bit i is set if input i has value 1
+        uint32_t bits() const { return mBits; }
+
+        /// Bit i is set if input i has undefined value (no value yet, 'x' or 'z')
+        uint32_t undefined() const { return mUndefined; }
+
+        /// Inputs which have a transition at current event time
+        const std::vector<uint32_t>& changed() const { return mChanged; }
+
+        /**
+         * Evaluate all events and write derived waveform.
+         * @param sof Output file for derived waveform
+         * @param eval Evaluator with methods 'void event(const SaleaeMergeStream&, SaleaeOutputFile&)' and 'void finish(SaleaeOutputFile&)'
+         * @return Number of events evaluated
+         */
+        template<typename Evaluator> uint64_t evaluate(SaleaeOutputFile& sof, Evaluator& eval)
+        {
+            uint64_t retval = 0;
+            while (next())
+            {
+                eval.event(*this, sof);
+                ++retval;
+            }
+            eval.finish(sof);
+            return retval;
+        }
+    };
+
+    /**
+     * @brief Evaluator for Boolean waveforms. The Boolean function is compiled into a lookup table indexed by input bits.
+     */
+    class SaleaeBooleanEvaluator
+    {
+        std::vector<char> mTable;
+    public:
+        /**
+         * Constructor for SaleaeBooleanEvaluator
+         * @param truthTable Bit i is set if function is true for input combination i
+         * @param numberInputs Number of function inputs (max 16)
+         */
+        SaleaeBooleanEvaluator(const char* truthTable, int numberInputs);
+        void event(const SaleaeMergeStream& sms, SaleaeOutputFile& sof) const
+        {
+            sof.writeTimeValue(sms.time(), sms.undefined() ? -1 : mTable[sms.bits()]);
+        }
+        void finish(SaleaeOutputFile&) const {;}
+    };
+
+    /**
+     * @brief Evaluator for trigger time sets. A trigger at time t is written as value 1 at t followed by value 0 at t+1
+     * (unless there is another trigger at t+1).
+     * Input i triggers on transition to value toValue[i] (any transition if negative). If a filter input is given
+     * triggers are suppressed unless filter value is 1.
+     */
+    class SaleaeTriggerEvaluator
+    {
+        std::vector<int> mToValue;
+        int mFilterInput;
+        bool mStarted;
+        bool mPending;
+        uint64_t mPendingTime;
+    public:
+        /**
+         * Constructor for SaleaeTriggerEvaluator
+         * @param toValue Target value for each trigger input
+         * @param filterInput Index of filter input within merge stream, -1 if no filter
+         */
+        SaleaeTriggerEvaluator(const std::vector<int>& toValue, int filterInput = -1)
+            : mToValue(toValue), mFilterInput(filterInput), mStarted(false), mPending(false), mPendingTime(0) {;}
+        void event(const SaleaeMergeStream& sms, SaleaeOutputFile& sof);
+        void finish(SaleaeOutputFile& sof);
+    };
+}
@@ -0,0 +1,128 @@
+// MIT License
+// 
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "netlist_simulator_controller/saleae_file.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+    /**
+     * @brief Summary of all transitions within one time bucket of a SALEAE waveform
+     */
+    struct SaleaeSummaryBucket
+    {
+        /// Number of transitions within bucket
+        uint64_t mTransitions;
+
+        /// Accumulated time within bucket where waveform is logical 1
+        uint64_t mHighTime;
+
+        /// Waveform value at bucket start
+        int32_t mStartValue;
+
+        /// Smallest value within bucket
+        int16_t mMinValue;
+
+        /// Largest value within bucket
+        int16_t mMaxValue;
+
+        bool isConstant() const { return !mTransitions; }
+    };
+
+    /**
+     * @brief The SaleaeSummaryPyramid class is a multi-resolution min/max summary of a SALEAE data file.
+     * Level 0 divides the waveform into buckets of 2^baseShift time units, each higher level merges two buckets
+     * of the level below. The base width is chosen such that a level 0 bucket holds about sTransitionsPerBucket
+     * transitions on average, thus the pyramid is a small fraction of the data file. The pyramid is stored beside
+     * the data file ('digital_XXX.lod') and built on first access if the data file has at least sMinTransitions.
+     * Buckets are read from disk on demand, only the level table is kept in memory.
+     */
+    class SaleaeSummaryPyramid
+    {
+        std::string mFilename;
+        bool mGood;
+        uint64_t mNumTransitions;
+        uint64_t mBeginTime;
+        uint64_t mEndTime;
+        uint64_t mDataFileSize;
+        uint32_t mBaseShift;
+        std::vector<uint64_t> mLevelSize;
+        std::vector<uint64_t> mLevelOffset;
+
+        static const char* sIdent;
+        static const uint32_t sVersion = 1;
+
+        bool readHeader(const SaleaeHeader& header, uint64_t dataFileSize);
+        bool build(const std::string& datafile);
+    public:
+        /// Data files with fewer transitions are rendered from raw data, no pyramid gets built
+        static const uint64_t sMinTransitions = 1 << 16;
+
+        /// Average number of transitions in a level 0 bucket
+        static const uint64_t sTransitionsPerBucket = 256;
+
+        /// Get pyramid filename for SALEAE data file (digital_XXX.bin -> digital_XXX.lod)
+        static std::string summaryFilename(const std::string& datafile);
+
+        /**
+         * Open pyramid for given SALEAE data file. Pyramid gets (re)built if it does not exist or does not match data file.
+         * @param datafile SALEAE data file
+         */
+        SaleaeSummaryPyramid(const std::string& datafile);
+
+        /// True if pyramid is available
+        bool good() const { return mGood; }
+
+        /// Number of levels, the top level consists of a single bucket
+        int numberLevels() const { return mLevelSize.size(); }
+
+        /// Time width of a single bucket at given level
+        uint64_t bucketWidth(int level) const { return 1ull << (mBaseShift + level); }
+
+        /// Number of buckets at given level
+        uint64_t numberBuckets(int level) const { return mLevelSize.at(level); }
+
+        /**
+         * Pick the coarsest level where a bucket is not wider than a pixel.
+         * @param scale pixels per time unit
+         * @return The level or -1 if raw data should be rendered at this scale
+         */
+        int levelForScale(double scale) const;
+
+        /**
+         * Read buckets from disk.
+         * @param level the pyramid level
+         * @param first index of first bucket
+         * @param count max number of buckets
+         * @return The buckets, might be fewer than requested if range exceeds level size
+         */
+        std::vector<SaleaeSummaryBucket> buckets(int level, uint64_t first, uint64_t count) const;
+    };
+}
@@ -43,12 +43,14 @@ namespace hal
         std::filesystem::path mDir;
         SaleaeDirectory mSaleaeDirectory;
         std::unordered_map<int,SaleaeOutputFile*> mDataFiles;
+        bool mCompressed;
     public:
         /**
          * Constructor for SaleaeWriter
          * @param filename Full path and filename of SALEAE directory file
+         * @param compressed If set binary files are written in compressed (block encoded) format
          */
-        SaleaeWriter(const std::string& filename);
+        SaleaeWriter(const std::string& filename, bool compressed=false);
 
         /// Destructor closes all open binary files updating their file header. It also updates SALEAE directory
         ~SaleaeWriter();
@@ -0,0 +1,110 @@
+// MIT License
+// 
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+
+#include <string>
+#include <vector>
+
+namespace hal
+{
+    class Netlist;
+
+    /**
+     * @brief The SimulationActivity class holds switching activity aggregates computed from the SALEAE directory
+     * of a simulation. All results are dense arrays: per net, per clock cycle and per module. Arrays are
+     * computed by a single pass over each waveform file, nets are processed in parallel.
+     *
+     * Clock cycle c covers time interval [begin + c * period, begin + (c+1) * period). Net values are sampled
+     * at the start of each cycle for Hamming weight and Hamming distance. Only transitions between defined
+     * values (0 and 1) are counted as toggles.
+     */
+    class NETLIST_API SimulationActivity
+    {
+        u64 mBeginTime;
+        u64 mEndTime;
+        u64 mClockPeriod;
+        std::vector<u32> mNetIds;
+        std::vector<u64> mToggleCounts;
+        std::vector<u32> mHammingWeights;
+        std::vector<u32> mHammingDistances;
+        std::vector<u32> mCycleToggles;
+        std::vector<u32> mModuleIds;
+        std::vector<u64> mModuleToggles;
+
+    public:
+        /**
+         * Constructor, does not compute anything
+         * @param[in] clockPeriod Length of clock cycle in picoseconds
+         * @param[in] beginTime Start of analyzed time interval
+         * @param[in] endTime End of analyzed time interval (excluded)
+         */
+        SimulationActivity(u64 clockPeriod, u64 beginTime, u64 endTime);
+
+        /**
+         * Compute aggregates from SALEAE directory.
+         * @param[in] saleaeDirectoryFilename SALEAE directory file (JSON)
+         * @param[in] nl Netlist to determine module activity, might be nullptr
+         * @param[in] numThreads Number of worker threads, 0 for hardware concurrency
+         * @return true on success, false if directory could not be read
+         */
+        bool compute(const std::string& saleaeDirectoryFilename, const Netlist* nl = nullptr, u32 numThreads = 0);
+
+        /// Begin of analyzed time interval
+        u64 get_begin_time() const { return mBeginTime; }
+
+        /// End of analyzed time interval
+        u64 get_end_time() const { return mEndTime; }
+
+        /// Length of clock cycle
+        u64 get_clock_period() const { return mClockPeriod; }
+
+        /// Number of clock cycles in analyzed time interval
+        u64 get_number_cycles() const { return mHammingWeights.size(); }
+
+        /// Ids of analyzed nets, index into per net arrays
+        const std::vector<u32>& get_net_ids() const { return mNetIds; }
+
+        /// Toggle count for each net
+        const std::vector<u64>& get_toggle_counts() const { return mToggleCounts; }
+
+        /// Number of nets with value 1 at start of each clock cycle
+        const std::vector<u32>& get_hamming_weights() const { return mHammingWeights; }
+
+        /// Number of nets which changed value since start of previous clock cycle, 0 for first cycle
+        const std::vector<u32>& get_hamming_distances() const { return mHammingDistances; }
+
+        /// Number of toggles within each clock cycle including glitches
+        const std::vector<u32>& get_cycle_toggles() const { return mCycleToggles; }
+
+        /// Ids of modules, index into per module arrays
+        const std::vector<u32>& get_module_ids() const { return mModuleIds; }
+
+        /// Toggles of all nets driven by gates within module including submodules
+        const std::vector<u64>& get_module_toggles() const { return mModuleToggles; }
+    };
+}    // namespace hal
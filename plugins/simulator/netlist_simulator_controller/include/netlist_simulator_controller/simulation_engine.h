@@ -129,6 +129,12 @@ namespace hal
          */
         bool install_saleae_parser(std::string dirname) const;
 
+        /**
+         * Get the content of all files copied by install_saleae_parser, e.g., to detect changes of the parser
+         * @return the concatenated file names and contents
+         */
+        std::string get_saleae_parser_sources() const;
+
         /**
          * Must be implemented by derived class
          *
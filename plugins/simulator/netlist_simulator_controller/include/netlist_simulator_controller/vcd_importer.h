@@ -0,0 +1,116 @@
+// MIT License
+// 
+// Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+// Copyright (c) 2019 Marc Fyrbiak, Sebastian Wallat, Max Hoffmann ("ORIGINAL AUTHORS"). All rights reserved.
+// Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+// Copyright (c) 2021 Jörn Langheinrich, Julian Speith, Nils Albartus, René Walendy, Simon Klix ("ORIGINAL AUTHORS"). All Rights reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hal
+{
+    class SaleaeOutputFile;
+    class SaleaeWriter;
+
+    /**
+     * @brief The VcdImporter class converts a VCD file into SALEAE data files.
+     * The VCD file is mapped into memory, the value change section is split at timestamp boundaries into chunks which get
+     * parsed in parallel. Chunks are processed in rounds, after each round the transitions are merged per net into the
+     * SALEAE output files, thus memory consumption is bounded by the round size regardless of VCD file size.
+     * Identifier codes up to three characters (which covers more than 800,000 signals) are resolved by array lookup.
+     */
+    class VcdImporter
+    {
+    public:
+        /// Size of a single chunk of the value change section parsed by one thread
+        static const u64 sChunkSize = 16 << 20;
+
+        /**
+         * Constructor for VcdImporter
+         * @param saleaeDirectoryFilename Full path and filename of SALEAE directory file
+         * @param numThreads Number of worker threads, 0 for one thread per hardware core
+         */
+        VcdImporter(const std::string& saleaeDirectoryFilename, u32 numThreads = 0);
+
+        /// Import only waveforms with name in filter, the mapped value is the net id to be stored in SALEAE directory
+        void set_net_filter(const std::unordered_map<std::string,u32>& filter) { mNetFilter = filter; }
+
+        /// Set callback which gets called by the importing thread with percent of data processed
+        void set_progress_callback(const std::function<void(int)>& callback) { mProgressCallback = callback; }
+
+        /**
+         * Import VCD file. Single bit waveforms only, vector and real values are skipped.
+         * @param vcdFilename The VCD file
+         * @return true on success, false otherwise
+         */
+        bool import(const std::string& vcdFilename);
+
+        /// Highest timestamp found in last import
+        u64 get_max_time() const { return mMaxTime; }
+
+        /// Throughput of last import in MB/s
+        double get_throughput() const { return mThroughput; }
+
+    private:
+        struct Event
+        {
+            u64 mTime;
+            u32 mSlot;
+            i32 mValue;
+        };
+
+        struct Chunk
+        {
+            const char* mBegin;
+            const char* mEnd;
+            std::vector<Event> mEvents;
+            u64 mMaxTime;
+            u64 mErrors;
+        };
+
+        std::string mSaleaeDirectoryFilename;
+        u32 mNumThreads;
+        std::unordered_map<std::string,u32> mNetFilter;
+        std::function<void(int)> mProgressCallback;
+        u64 mMaxTime;
+        double mThroughput;
+
+        std::vector<int> mShortCodes;
+        std::unordered_map<std::string,int> mLongCodes;
+        std::vector<SaleaeOutputFile*> mSlots;
+
+        static const int sCodeRadix = 94;
+        static const int sMaxShortCode = 3;
+
+        static int shortCodeIndex(const char* code, int len);
+        void registerCode(const std::string& code, int slot);
+        int lookupSlot(const char* code, int len) const;
+        const char* parseHeader(const char* pos, const char* end, SaleaeWriter& writer);
+        void parseChunk(Chunk& chunk) const;
+    };
+}
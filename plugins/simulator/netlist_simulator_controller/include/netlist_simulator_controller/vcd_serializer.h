@@ -72,18 +72,13 @@ namespace hal {
         QList<VcdSerializerElement*> mWriteElements;
         QString mWorkdir;
         QString mSaleaeDirectoryFilename;
-        QMap<QString,QString> mAbbrevByName;
         QVector<int> mLastValue;
-        int mErrorCount[9];
+        int mErrorCount[4];
         bool mSaleae;
         int mLastProgress;
 
-        bool parseVcdDataline(char* buf, int len);
-        bool parseVcdDataNonDecimal(const QByteArray& line, int base);
-        void storeValue(int val, const QByteArray& abrev);
         bool parseCsvHeader(char* buf);
         bool parseCsvDataline(char* buf, int dataLineIndex);
-        bool parseVcdInternal(QFile& ff, const QList<const Net *>& onlyNets);
         bool parseCsvInternal(QFile& ff, const QList<const Net *>& onlyNets);
 
         void writeVcdEvent(QFile& of);
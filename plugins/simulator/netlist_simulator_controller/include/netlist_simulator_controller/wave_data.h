@@ -30,6 +30,8 @@
 #include <QList>
 #include <QSet>
 #include <QObject>
+#include <QMutex>
+#include <QAtomicInt>
 #include "hal_core/defines.h"
 #include "hal_core/netlist/boolean_function.h"
 #include "netlist_simulator_controller/simulation_input.h"
@@ -80,6 +82,9 @@ namespace hal {
         NetType mNetType;
         int mBits;
         int mSubscriber;
+        int mDerivedFileIndex;
+        QAtomicInt mDerivedRequest;
+        QMutex mDerivedMutex;
     protected:
         int mValueBase;
         QMap<u64,int> mData;
@@ -88,6 +93,8 @@ namespace hal {
 
         QMap<u64,int>::const_iterator timeIterator(double t) const;
         void resetWave();
+        void requestDerivedSaleae();
+        template<typename Evaluator> bool mergeDerivedSaleae(const QList<WaveData*>& inputs, Evaluator& eval);
     public:
         WaveData(const WaveData& other);
         WaveData(u32 id_, const QString& nam, NetType tp = RegularNet,
@@ -105,6 +112,7 @@ namespace hal {
         int     valueBase()                 const { return mValueBase; }
         std::string fileName()              const;
         SaleaeDirectoryNetEntry::Type composedType() const;
+        bool hasDerivedDataFile() const { return composedType() != SaleaeDirectoryNetEntry::None && mFileIndex >= 0; }
         void setId(u32 id_);
         bool rename(const QString& nam);
         void setBits(int bts);
@@ -119,6 +127,7 @@ namespace hal {
         virtual u64 neighborTransition(double t, bool next) const;
         void loadDataUnlessAlreadyLoaded();
         bool loadSaleae(const WaveDataTimeframe& tframe = WaveDataTimeframe());
+        virtual bool writeDerivedSaleae() { return false; }
         void saveSaleae();
         void setData(const QMap<u64,int>& dat);
         virtual int  intValue(double t) const;
@@ -276,6 +285,7 @@ namespace hal {
         QList<WaveData*> children() const;
         const char* truthTable() const { return mTruthTable; }
         virtual int intValue(double t) const override;
+        virtual bool writeDerivedSaleae() override;
     };
 
     class WaveDataTrigger : public WaveData
@@ -293,6 +303,7 @@ namespace hal {
         QList<WaveData*> children() const;
         virtual u64 neighborTransition(double t, bool next) const override;
         virtual int intValue(double t) const override;
+        virtual bool writeDerivedSaleae() override;
         void set_filter_wave(WaveData* wd);
         QList<int> toValueList() const;
         WaveData* get_filter_wave() const { return mFilterWave; }
@@ -29,6 +29,7 @@
 #include <QPair>
 #include "hal_core/defines.h"
 #include "netlist_simulator_controller/saleae_file.h"
+#include "netlist_simulator_controller/saleae_mapped_file.h"
 #include "netlist_simulator_controller/saleae_parser.h"
 #include "netlist_simulator_controller/simulation_input.h"
 #include "netlist_simulator_controller/wave_group_value.h"
@@ -71,8 +72,7 @@ namespace hal {
     {
     public:
         enum StoreData { Off, Recording, Complete, Failed};
-        SaleaeInputFile& mInputFile;
-        SaleaeDataBuffer* mBuffer;
+        SaleaeMappedFile mInputFile;
         u64 mIndex;
         const WaveDataTimeframe& mTimeframe;
         QMap<u64,int> mDataMap;
@@ -81,12 +81,12 @@ namespace hal {
         bool isRecording() const { return mStoreData == Recording; }
         void storeCurrentDatapoint();
     public:
-        WaveDataProviderFile(SaleaeInputFile& sif, const WaveDataTimeframe& tframe) : mInputFile(sif), mBuffer(nullptr), mIndex(0),
+        WaveDataProviderFile(const std::string& filename, const WaveDataTimeframe& tframe) : mInputFile(filename), mIndex(0),
             mTimeframe(tframe), mStoreData(Off) {;}
-        ~WaveDataProviderFile();
         virtual SaleaeDataTuple startValue(u64 t) override;
         virtual SaleaeDataTuple nextPoint() override;
 
+        bool good() const { return mInputFile.good(); }
         StoreData storeDataState() const { return mStoreData; }
         const QMap<u64,int>& dataMap() const { return mDataMap; }
     };
@@ -2,6 +2,7 @@
 
 #include "netlist_simulator_controller/netlist_simulator_controller.h"
 #include "netlist_simulator_controller/plugin_netlist_simulator_controller.h"
+#include "netlist_simulator_controller/simulation_activity.h"
 #include "netlist_simulator_controller/simulation_engine.h"
 #include "pybind11/operators.h"
 #include "pybind11/pybind11.h"
@@ -12,6 +13,25 @@ namespace py = pybind11;
 
 namespace hal
 {
+    namespace
+    {
+        // view on array owned by SimulationActivity, owner is kept alive as long as python holds a reference
+        struct ActivityArray
+        {
+            std::shared_ptr<SimulationActivity> mOwner;
+            const void* mData;
+            py::ssize_t mSize;
+            py::ssize_t mItemSize;
+            std::string mFormat;
+        };
+
+        template <typename T>
+        ActivityArray activityArray(const std::shared_ptr<SimulationActivity>& owner, const std::vector<T>& vec)
+        {
+            return ActivityArray{owner, vec.data(), (py::ssize_t)vec.size(), (py::ssize_t)sizeof(T), py::format_descriptor<T>::format()};
+        }
+    }    // namespace
+
 #ifdef PYBIND11_MODULE
     PYBIND11_MODULE(netlist_simulator_controller, m)
     {
@@ -373,6 +393,18 @@ namespace hal
                 :rtype: bool
             )")
 
+            .def("analyze_activity", &NetlistSimulatorController::analyze_activity, py::arg("clock_period"), py::arg("start_time") = 0, py::arg("end_time") = 0, py::arg("num_threads") = 0, R"(
+                Computes per net toggle counts, Hamming weight and Hamming distance per clock cycle, and switching activity per module.
+                Waveform files are streamed once, nets are processed in parallel.
+
+                :param int clock_period: Length of clock cycle in picoseconds.
+                :param int start_time: Start of analyzed timeframe (in picoseconds).
+                :param int end_time: End of analyzed timeframe (in picoseconds), 0 for end of simulation.
+                :param int num_threads: Number of worker threads, 0 for hardware concurrency.
+                :returns: The activity aggregates or None on error.
+                :rtype: netlist_simulator_controller.SimulationActivity or None
+            )")
+
             .def("get_waveform_by_net", &NetlistSimulatorController::get_waveform_by_net, py::arg("net"), R"(
                 Getter for a single waveform.
 
@@ -562,6 +594,86 @@ namespace hal
 
                 :param netlist_simulator_controller.WaveData wave: Regular or boolean waveform as filter.
         )");
+
+        py::class_<ActivityArray>(m, "ActivityArray", py::buffer_protocol(), R"(
+                Read-only one dimensional array owned by SimulationActivity. Supports the buffer protocol,
+                thus 'numpy.asarray()' or 'memoryview()' access the data without copying.
+        )")
+            .def_buffer([](const ActivityArray& arr) {
+                return py::buffer_info(const_cast<void*>(arr.mData), arr.mItemSize, arr.mFormat, 1, {arr.mSize}, {arr.mItemSize}, true);
+            })
+            .def("__len__", [](const ActivityArray& arr) { return arr.mSize; });
+
+        py::class_<SimulationActivity, std::shared_ptr<SimulationActivity>> py_simulation_activity(m, "SimulationActivity", R"(
+                Switching activity aggregates computed from simulation results. Clock cycle c covers the time interval
+                [begin + c * period, begin + (c+1) * period), values are sampled at the start of each cycle.
+        )");
+
+        py_simulation_activity.def_property_readonly("begin_time", &SimulationActivity::get_begin_time, R"(
+                Begin of analyzed timeframe.
+
+                :type: int
+        )");
+
+        py_simulation_activity.def_property_readonly("end_time", &SimulationActivity::get_end_time, R"(
+                End of analyzed timeframe.
+
+                :type: int
+        )");
+
+        py_simulation_activity.def_property_readonly("clock_period", &SimulationActivity::get_clock_period, R"(
+                Length of clock cycle.
+
+                :type: int
+        )");
+
+        py_simulation_activity.def_property_readonly("number_cycles", &SimulationActivity::get_number_cycles, R"(
+                Number of clock cycles in analyzed timeframe.
+
+                :type: int
+        )");
+
+        py_simulation_activity.def_property_readonly("net_ids", [](const std::shared_ptr<SimulationActivity>& sa) { return activityArray(sa, sa->get_net_ids()); }, R"(
+                IDs of analyzed nets, index into per net arrays.
+
+                :type: netlist_simulator_controller.ActivityArray
+        )");
+
+        py_simulation_activity.def_property_readonly("toggle_counts", [](const std::shared_ptr<SimulationActivity>& sa) { return activityArray(sa, sa->get_toggle_counts()); }, R"(
+                Toggle count for each net.
+
+                :type: netlist_simulator_controller.ActivityArray
+        )");
+
+        py_simulation_activity.def_property_readonly("hamming_weights", [](const std::shared_ptr<SimulationActivity>& sa) { return activityArray(sa, sa->get_hamming_weights()); }, R"(
+                Number of nets with value 1 at start of each clock cycle.
+
+                :type: netlist_simulator_controller.ActivityArray
+        )");
+
+        py_simulation_activity.def_property_readonly("hamming_distances", [](const std::shared_ptr<SimulationActivity>& sa) { return activityArray(sa, sa->get_hamming_distances()); }, R"(
+                Number of nets which changed value since start of previous clock cycle.
+
+                :type: netlist_simulator_controller.ActivityArray
+        )");
+
+        py_simulation_activity.def_property_readonly("cycle_toggles", [](const std::shared_ptr<SimulationActivity>& sa) { return activityArray(sa, sa->get_cycle_toggles()); }, R"(
+                Number of toggles within each clock cycle including glitches.
+
+                :type: netlist_simulator_controller.ActivityArray
+        )");
+
+        py_simulation_activity.def_property_readonly("module_ids", [](const std::shared_ptr<SimulationActivity>& sa) { return activityArray(sa, sa->get_module_ids()); }, R"(
+                IDs of modules, index into per module arrays.
+
+                :type: netlist_simulator_controller.ActivityArray
+        )");
+
+        py_simulation_activity.def_property_readonly("module_toggles", [](const std::shared_ptr<SimulationActivity>& sa) { return activityArray(sa, sa->get_module_toggles()); }, R"(
+                Toggles of all nets driven by gates within module including submodules.
+
+                :type: netlist_simulator_controller.ActivityArray
+        )");
 #ifndef PYBIND11_MODULE
         return m.ptr();
 #endif    // PYBIND11_MODULE
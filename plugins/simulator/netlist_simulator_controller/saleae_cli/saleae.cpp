@@ -253,7 +253,7 @@ void saleae_ls(std::string p_path, std::string size, std::string ids, bool valid
                     {
                         SaleaeInputFile *sf = new SaleaeInputFile(bin_path);
                         SaleaeDataBuffer *db = sf->get_buffered_data(sf->header()->mNumTransitions);
-                        if ((sdfi.beginTime() != sf->header()->mBeginTime) || (sdfi.endTime() != sf->header()->mEndTime) || (sdfi.numberValues() - 1 != sf->header()->mNumTransitions) || (QFileInfo(QString::fromStdString(bin_path)).size() != 44 + (sdfi.numberValues() - 1) * 8))
+                        if ((sdfi.beginTime() != sf->header()->mBeginTime) || (sdfi.endTime() != sf->header()->mEndTime) || (sdfi.numberValues() - 1 != sf->header()->mNumTransitions) || (sf->header()->storageFormat() != SaleaeHeader::Compressed && QFileInfo(QString::fromStdString(bin_path)).size() != 44 + (sdfi.numberValues() - 1) * 8) || !sf->good())
                         {
                             valid_char = "*";
                             val_cnt++;
@@ -330,6 +330,9 @@ void saleae_cat(std::string path, std::string file_name, bool dump_header, bool
         case SaleaeHeader::Coded:
             data_format = "Coded";
             break;
+        case SaleaeHeader::Compressed:
+            data_format = "Compressed";
+            break;
         }
 
         // collect length for better formatting
@@ -691,6 +694,63 @@ void saleae_diff(std::string path_1, std::string path_2, std::string ids, bool o
 }
 
 
+// saleae compress tool
+void saleae_compress(std::string path, bool uncompress)
+{
+    // handle --dir option
+    path = (path == "") ? "." : path;
+    std::string saleae_fp = path + "/saleae.json";
+    if (!file_exists(saleae_fp))
+    {
+        std::cout << "Cannot open file: " << saleae_fp << std::endl;
+        exit (1);
+    }
+
+    SaleaeDirectory sd(saleae_fp, false);
+    uint64_t bytes_before = 0;
+    uint64_t bytes_after = 0;
+    int count = 0;
+    for (const SaleaeDirectoryNetEntry& sdne : sd.dump())
+    {
+        for (const SaleaeDirectoryFileIndex& sdfi : sdne.indexes())
+        {
+            std::string bin_path = path + "/digital_" + std::to_string(sdfi.index()) + ".bin";
+            std::string tmp_path = bin_path + ".tmp";
+            {
+                SaleaeInputFile sf(bin_path);
+                if (!sf.good())
+                {
+                    std::cout << "Cannot read file: " << bin_path << " (" << sf.get_last_error() << ")" << std::endl;
+                    exit (1);
+                }
+                if ((sf.header()->storageFormat() == SaleaeHeader::Compressed) != uncompress) continue;
+
+                // copy in chunks, output file decides about storage format
+                SaleaeOutputFile sof(tmp_path, sdfi.index(), !uncompress);
+                while (SaleaeDataBuffer* db = sf.get_buffered_data(1 << 20))
+                {
+                    for (uint64_t i = 0; i < db->mCount; i++)
+                        sof.writeTimeValue(db->mTimeArray[i], db->mValueArray[i]);
+                    delete db;
+                }
+                sof.close();
+            }
+            bytes_before += QFileInfo(QString::fromStdString(bin_path)).size();
+            bytes_after  += QFileInfo(QString::fromStdString(tmp_path)).size();
+            if (rename(tmp_path.c_str(), bin_path.c_str()))
+            {
+                std::cout << "Cannot replace file: " << bin_path << std::endl;
+                exit (1);
+            }
+            ++count;
+        }
+    }
+    std::cout << (uncompress ? "Uncompressed " : "Compressed ") << count << " binary file(s), "
+              << bytes_before << " bytes -> " << bytes_after << " bytes" << std::endl;
+    exit (0);
+}
+
+
 // saleae export tool
 void saleae_export(std::string path_1, std::string path_2, std::string ids, std::string timerange)
 {
@@ -772,6 +832,7 @@ int main(int argc, const char* argv[])
     tool_options.add("cat", "Dump content of binary file <arg> into console", {""});
     tool_options.add("diff", "Compares content of database in current directory with other saleae database at <arg>", {""});
     tool_options.add("export", "Exports waveforms from database in current SALEAE directory to .VCD or .CSV file <arg>", {""});
+    tool_options.add("compress", "Converts all binary files of database in current SALEAE directory into compressed (block encoded) format");
 
     ProgramOptions ls_options("ls options");
     ls_options.add({"-d", "--dir"}, "lists saleae directory from directory given by absolute or relative path name <ARG>", {ProgramOptions::A_REQUIRED_PARAMETER});
@@ -795,6 +856,10 @@ int main(int argc, const char* argv[])
     export_options.add({"-i", "--id"}, "export only entries where ID matches entry in list <ARG>. Entries are separated by comma. A single entry can be either an ID or a range sepearated by hyphen", {ProgramOptions::A_REQUIRED_PARAMETER});
     export_options.add({"-r", "--time-range"}, "exports only events within given time range <ARG>. The value in <ARG> gets subtracted from every exported time stamp so that exported time starts at zero. A start value (last value before entering the time range) must be provided for each exported waveform.", {ProgramOptions::A_REQUIRED_PARAMETER});
 
+    ProgramOptions compress_options("compress options");
+    compress_options.add({"-d", "--dir"}, "database not in current directory but in directory given by path name <ARG>", {ProgramOptions::A_REQUIRED_PARAMETER});
+    compress_options.add({"-u", "--uncompress"}, "converts compressed binary files back into uncompressed format");
+
     ProgramArguments args = tool_options.parse(argc, argv);
 
     if (args.is_option_set("ls"))
@@ -909,6 +974,26 @@ int main(int argc, const char* argv[])
             saleae_export(export_path, args.get_parameter("--dir"), args.get_parameter("--id"), args.get_parameter("--time-range"));
         }
     }
+    else if (args.is_option_set("compress"))
+    {
+        compress_options.add(generic_options);
+        ProgramArguments args = compress_options.parse(argc, argv);
+
+        bool unknown_option_exists = false;
+        for (std::string opt : compress_options.get_unknown_arguments())
+        {
+            unknown_option_exists = (opt != "compress") ? true : unknown_option_exists;
+        }
+
+        if (args.is_option_set("--help") || unknown_option_exists)
+        {
+            std::cout << compress_options.get_options_string() << std::endl;
+        }
+        else
+        {
+            saleae_compress(args.get_parameter("--dir"), args.is_option_set("--uncompress"));
+        }
+    }
     else
     {
         tool_options.add(generic_options);
@@ -917,6 +1002,7 @@ int main(int argc, const char* argv[])
         std::cout << ls_options.get_options_string();
         std::cout << cat_options.get_options_string();
         std::cout << diff_options.get_options_string();
-        std::cout << export_options.get_options_string() << std::endl;
+        std::cout << export_options.get_options_string();
+        std::cout << compress_options.get_options_string() << std::endl;
     }
 }
@@ -1023,6 +1023,23 @@ namespace hal
         */
     }
 
+    std::shared_ptr<SimulationActivity> NetlistSimulatorController::analyze_activity(u64 clock_period, u64 start_time, u64 end_time, u32 num_threads) const
+    {
+        if (!mWaveDataList || !clock_period)
+            return nullptr;
+        if (!end_time)
+            end_time = get_max_simulated_time();
+
+        const Netlist* nl = mSimulationInput->get_gates().empty() ? nullptr : (*mSimulationInput->get_gates().begin())->get_netlist();
+        std::shared_ptr<SimulationActivity> retval = std::make_shared<SimulationActivity>(clock_period, start_time, end_time);
+        if (!retval->compute(mWaveDataList->saleaeDirectory().get_filename(), nl, num_threads))
+        {
+            log_warning(get_name(), "Cannot compute activity from SALEAE directory '{}'.", mWaveDataList->saleaeDirectory().get_filename());
+            return nullptr;
+        }
+        return retval;
+    }
+
     bool NetlistSimulatorController::generate_vcd(const std::filesystem::path& path, u32 start_time, u32 end_time, std::set<const Net*> nets) const
     {
         VcdSerializer writer(mWorkDir);
@@ -151,6 +151,19 @@ namespace hal
                     {
                         sdce.set_filter_entry(jcmpsd["filter"].GetInt());
                     }
+                    if (jcmpsd.HasMember("indexes"))
+                    {
+                        // derived waveform data written by merge engine
+                        for (auto& jinx : jcmpsd["indexes"].GetArray())
+                        {
+                            int      inx  = jinx["index"].GetInt();
+                            uint64_t tBeg = jinx["t_beg"].GetUint64();
+                            uint64_t tEnd = jinx["t_end"].GetUint64();
+                            uint64_t nVal = jinx["n_val"].GetUint64();
+                            sdce.addIndex(SaleaeDirectoryFileIndex(inx, tBeg, tEnd, nVal));
+                            if (inx >= mNextAvailableIndex) mNextAvailableIndex = inx + 1;
+                        }
+                    }
                     mComposedEntryMap[sdce.uniqueKey()]=sdce;
                 }
             }
@@ -210,6 +223,20 @@ namespace hal
                 {
                     jcmpsd["filter"] = cmpsd.get_filter_entry();
                 }
+                if (!cmpsd.indexes().empty())
+                {
+                    JsonWriteArray& jindexes = jcmpsd.add_array("indexes");
+                    for (const SaleaeDirectoryFileIndex& inx : cmpsd.indexes())
+                    {
+                        JsonWriteObject& jinx = jindexes.add_object();
+                        jinx["index"] = inx.index();
+                        jinx["t_beg"] = inx.beginTime();
+                        jinx["t_end"] = inx.endTime();
+                        jinx["n_val"] = inx.numberValues();
+                        jinx.close();
+                    }
+                    jindexes.close();
+                }
                 jcmpsd.close();
             }
             jcmpsds.close();
@@ -428,6 +455,8 @@ namespace hal
         SaleaeDirectoryStoreRequest save(this);
 #endif
         mComposedEntryMap[sdce.uniqueKey()] = sdce;
+        for (const SaleaeDirectoryFileIndex& sdfi : sdce.indexes())
+            if (sdfi.index() >= mNextAvailableIndex) mNextAvailableIndex = sdfi.index() + 1;
     }
 
     void SaleaeDirectory::remove_composed(uint32_t id, SaleaeDirectoryNetEntry::Type tp)
@@ -32,6 +32,163 @@ namespace hal
         if (mValueArray) delete [] mValueArray;
     }
 
+    const char* SaleaeCompressedBlock::sTrailerIdent = "<SALBLK>";
+
+    namespace
+    {
+        // minimum number of transitions to be run-length encoded
+        const uint64_t minRunLength = 4;
+
+        void putVarint(std::string& buf, uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                buf.push_back((char) ((v & 0x7f) | 0x80));
+                v >>= 7;
+            }
+            buf.push_back((char) v);
+        }
+
+        bool getVarint(const char*& pos, const char* end, uint64_t& v)
+        {
+            v = 0;
+            for (int shift = 0; pos < end && shift < 64; shift += 7)
+            {
+                uint8_t c = (uint8_t) *(pos++);
+                v |= ((uint64_t) (c & 0x7f)) << shift;
+                if (!(c & 0x80)) return true;
+            }
+            return false;
+        }
+    }
+
+    void SaleaeCompressedBlock::encode(std::string& buf) const
+    {
+        uint64_t n = mTimes.size();
+        if (!n) return;
+
+        uint64_t headerPos = buf.size();
+        buf.resize(headerPos + sHeaderSize);
+
+        uint64_t i = 1;
+        while (i < n)
+        {
+            uint64_t delta = mTimes[i] - mTimes[i-1];
+            uint64_t run = 0;
+            if (i >= 2)
+                while (i + run < n && mTimes[i+run] - mTimes[i+run-1] == delta && mValues[i+run] == mValues[i+run-2])
+                    ++run;
+            if (run >= minRunLength)
+            {
+                // run token: count, followed by constant delta
+                putVarint(buf, (run << 1) | 1);
+                putVarint(buf, delta);
+                i += run;
+            }
+            else
+            {
+                // literal token: delta, value
+                putVarint(buf, (delta << 3) | ((uint64_t) (mValues[i] + 2) << 1));
+                ++i;
+            }
+        }
+
+        uint64_t firstTime = mTimes.front();
+        int32_t firstValue = mValues.front();
+        uint32_t count = n;
+        uint64_t payload = buf.size() - headerPos - sHeaderSize;
+        char* hdr = &buf[headerPos];
+        memcpy(hdr,    &firstTime,  sizeof(firstTime));
+        memcpy(hdr+8,  &firstValue, sizeof(firstValue));
+        memcpy(hdr+12, &count,      sizeof(count));
+        memcpy(hdr+16, &payload,    sizeof(payload));
+    }
+
+    uint64_t SaleaeCompressedBlock::blockSize(const char* buf)
+    {
+        uint64_t payload;
+        memcpy(&payload, buf+16, sizeof(payload));
+        return sHeaderSize + payload;
+    }
+
+    bool SaleaeCompressedBlock::decode(const char* buf, uint64_t size)
+    {
+        mTimes.clear();
+        mValues.clear();
+        if (size < sHeaderSize) return false;
+
+        // payload size is compared without adding header size which might overflow on corrupt data
+        uint64_t payload;
+        memcpy(&payload, buf+16, sizeof(payload));
+        if (payload > size - sHeaderSize) return false;
+
+        uint64_t t;
+        int32_t val;
+        uint32_t count;
+        memcpy(&t,     buf,    sizeof(t));
+        memcpy(&val,   buf+8,  sizeof(val));
+        memcpy(&count, buf+12, sizeof(count));
+        if (!count || count > sBlockSize) return false;
+
+        mTimes.reserve(count);
+        mValues.reserve(count);
+        mTimes.push_back(t);
+        mValues.push_back(val);
+
+        const char* pos = buf + sHeaderSize;
+        const char* end = buf + sHeaderSize + payload;
+        while (mTimes.size() < count)
+        {
+            uint64_t token;
+            if (!getVarint(pos, end, token)) return false;
+            if (token & 1)
+            {
+                uint64_t run = token >> 1;
+                uint64_t delta;
+                if (!getVarint(pos, end, delta) || mTimes.size() < 2 || mTimes.size() + run > count) return false;
+                for (uint64_t j = 0; j < run; j++)
+                {
+                    t += delta;
+                    mTimes.push_back(t);
+                    mValues.push_back(mValues[mValues.size()-2]);
+                }
+            }
+            else
+            {
+                t += token >> 3;
+                mTimes.push_back(t);
+                mValues.push_back((int) ((token >> 1) & 0x3) - 2);
+            }
+        }
+        return pos == end;
+    }
+
+    uint64_t SaleaeCompressedBlock::parseIndex(const char* fileEnd, uint64_t available, std::vector<IndexEntry>& index)
+    {
+        index.clear();
+        if (available < sTrailerSize) return 0;
+        if (strncmp(fileEnd - 8, sTrailerIdent, 8)) return 0;
+
+        uint64_t nblocks;
+        memcpy(&nblocks, fileEnd - sTrailerSize, sizeof(nblocks));
+        if (nblocks > (available - sTrailerSize) / sizeof(IndexEntry)) return 0;
+
+        index.resize(nblocks);
+        if (nblocks) memcpy(index.data(), fileEnd - sTrailerSize - nblocks * sizeof(IndexEntry), nblocks * sizeof(IndexEntry));
+        return sTrailerSize + nblocks * sizeof(IndexEntry);
+    }
+
+    bool SaleaeCompressedBlock::checkIndex(const std::vector<IndexEntry>& index, uint64_t dataBegin, uint64_t dataEnd)
+    {
+        uint64_t minOffset = dataBegin;
+        for (const IndexEntry& entry : index)
+        {
+            if (entry.mOffset < minOffset || entry.mOffset > dataEnd || dataEnd - entry.mOffset < sHeaderSize) return false;
+            minOffset = entry.mOffset + sHeaderSize;
+        }
+        return true;
+    }
+
     SaleaeHeader::SaleaeHeader()
         : mVersion(0), mStorageFormat(Uint64),
           mValue(-1), mBeginTime(0), mEndTime(0), mNumTransitions(0)
@@ -56,6 +213,7 @@ namespace hal
         case Double:
         case Uint64:
         case Coded:
+        case Compressed:
             mStorageFormat = (StorageFormat) type;
             break;
         default:
@@ -97,13 +255,16 @@ namespace hal
 
     SaleaeInputFile::SaleaeInputFile(const std::string &filename)
         : std::ifstream(filename, std::ios::binary), mReadPointer(0),
-          mStatus(SaleaeStatus::Ok)
+          mStatus(SaleaeStatus::Ok), mBlockDataEnd(0), mBlockNumber(-1), mTransitionCursor(0)
     {
         if (good())
             mStatus = mHeader.read(*this);
         else
             mStatus = SaleaeStatus::ErrorOpenFile;
 
+        if (!mStatus && mHeader.storageFormat() == SaleaeHeader::Compressed && !readBlockIndex())
+            mStatus = SaleaeStatus::UnexpectedEof;
+
         if (mStatus)
             setstate(failbit);
 
@@ -130,11 +291,81 @@ namespace hal
                 return timeVal;
             };
             break;
+        case SaleaeHeader::Compressed:
+            // deliver transitions in same coded form as 'Coded' format
+            mReader = [this](bool* ok) {
+                uint64_t timeVal = 0;
+                int val = 0;
+                *ok = readCompressed(mTransitionCursor++, timeVal, val);
+                return timeVal | ((uint64_t) (val + 2) << 62);
+            };
+            break;
         }
 
         // printf("<%s> %d %d %d %.7f %.7f %lu\n", mIdent, mVersion, mType, mValue, mBeginTime, mEndTime, mNumTransitions );
     }
 
+    bool SaleaeInputFile::readBlockIndex()
+    {
+        std::streampos dataStart = tellg();
+        seekg(0, std::ios::end);
+        uint64_t fileSize = tellg();
+        uint64_t available = fileSize - dataStart;
+        if (available < SaleaeCompressedBlock::sTrailerSize) return false;
+
+        // read trailer to learn index size, then index and trailer together
+        std::string buf(SaleaeCompressedBlock::sTrailerSize, 0);
+        seekg(fileSize - SaleaeCompressedBlock::sTrailerSize);
+        read(&buf[0], buf.size());
+        uint64_t nblocks;
+        memcpy(&nblocks, buf.data(), sizeof(nblocks));
+        if (!good() || nblocks > (available - SaleaeCompressedBlock::sTrailerSize) / sizeof(SaleaeCompressedBlock::IndexEntry)) return false;
+        uint64_t indexSize = SaleaeCompressedBlock::sTrailerSize + nblocks * sizeof(SaleaeCompressedBlock::IndexEntry);
+
+        buf.resize(indexSize);
+        seekg(fileSize - indexSize);
+        read(&buf[0], buf.size());
+        if (!good()) return false;
+        seekg(dataStart);
+
+        mBlockDataEnd = fileSize - indexSize;
+        return SaleaeCompressedBlock::parseIndex(buf.data() + buf.size(), buf.size(), mBlockIndex) > 0
+                && mBlockIndex.size() == (mHeader.numTransitions() + SaleaeCompressedBlock::sBlockSize - 1) / SaleaeCompressedBlock::sBlockSize
+                && SaleaeCompressedBlock::checkIndex(mBlockIndex, dataStart, mBlockDataEnd);
+    }
+
+    bool SaleaeInputFile::readCompressed(uint64_t transition, uint64_t& t, int& val)
+    {
+        if (transition >= mHeader.numTransitions()) return false;
+        int64_t iblock = transition / SaleaeCompressedBlock::sBlockSize;
+        if (iblock != mBlockNumber)
+        {
+            mBlockNumber = -1;
+            // block extends up to next block or block index at most, offsets were checked when loading the index
+            uint64_t offset = mBlockIndex.at(iblock).mOffset;
+            uint64_t end = ((uint64_t) iblock + 1 < mBlockIndex.size()) ? mBlockIndex.at(iblock+1).mOffset : mBlockDataEnd;
+            clear();
+            std::string buf(end - offset, 0);
+            seekg(offset);
+            if (!read(&buf[0], buf.size())) return false;
+            if (!mBlock.decode(buf.data(), buf.size())) return false;
+            mBlockNumber = iblock;
+        }
+        uint64_t j = transition % SaleaeCompressedBlock::sBlockSize;
+        if (j >= mBlock.mTimes.size()) return false;
+        t = mBlock.mTimes.at(j);
+        val = mBlock.mValues.at(j);
+        return true;
+    }
+
+    void SaleaeInputFile::seekTransition(uint64_t pos)
+    {
+        if (mHeader.storageFormat() == SaleaeHeader::Compressed)
+            mTransitionCursor = pos;
+        else
+            seekg(pos*sizeof(uint64_t) + 44);
+    }
+
     SaleaeDataBuffer* SaleaeInputFile::get_buffered_data(uint64_t nread)
     {
         uint64_t n = nread;
@@ -191,6 +422,17 @@ namespace hal
                 retval->mTimeArray[i+j] &= 0x3fffffffffffffffull;
             }
             break;
+        case SaleaeHeader::Compressed:
+            for (uint64_t j=0; j<n; j++)
+            {
+                if (!readCompressed(mReadPointer-1+j, retval->mTimeArray[i+j], retval->mValueArray[i+j]))
+                {
+                    retval->mTimeArray[i+j] = 0;
+                    retval->mValueArray[i+j] = SaleaeDataTuple::sReadError;
+                }
+            }
+            mTransitionCursor = mReadPointer-1+n;
+            break;
         }
 
         mReadPointer += n;
@@ -234,7 +476,7 @@ namespace hal
             return retval;
         }
 
-        if (mHeader.storageFormat() == SaleaeHeader::Coded)
+        if (mHeader.hasCodedValues())
         {
             retval.mValue = ((retval.mTime >> 62) & 0x3) - 2;
             retval.mTime  &= 0x3fffffffffffffffull;
@@ -345,9 +587,11 @@ namespace hal
         if (pos < 0) return -1;
         bool ok = true;
 
-        if (mHeader.storageFormat() == SaleaeHeader::Coded)
+        if (mHeader.hasCodedValues())
         {
-            seekTransition(pos);
+            // position 0 is start value from header, position i is transition i-1
+            if (!pos) return mHeader.value();
+            seekTransition(pos-1);
             uint64_t tuple = mReader(&ok);
             return ((tuple >> 62) & 0x3) - 2;
         }
@@ -355,10 +599,12 @@ namespace hal
         return (pos%2==0) ? mHeader.value() : 1 - mHeader.value();
     }
 
-    SaleaeOutputFile::SaleaeOutputFile(const std::string &filename, int index_)
+    SaleaeOutputFile::SaleaeOutputFile(const std::string &filename, int index_, bool compressed)
         : std::ofstream(filename, std::ios::binary), mIndex(index_), mFilename(filename), mStatus(SaleaeStatus::Ok),
           mFirstValue(true), mLastWrittenValue(0), mLastWrittenTime(0)
     {
+        if (compressed)
+            mHeader.setStorageFormat(SaleaeHeader::Compressed);
         if (!good())
             mStatus = SaleaeStatus::ErrorOpenFile;
         else
@@ -381,11 +627,29 @@ namespace hal
         delete sdf;
     }
 
+    void SaleaeOutputFile::writeBlock()
+    {
+        if (mBlock.mTimes.empty()) return;
+        std::string buf;
+        mBlock.encode(buf);
+        mBlockIndex.push_back({mBlock.mTimes.front(), (uint64_t) tellp()});
+        write(buf.data(), buf.size());
+        mBlock.mTimes.clear();
+        mBlock.mValues.clear();
+    }
+
     void SaleaeOutputFile::put_data(SaleaeDataBuffer *buf)
     {
         if (!buf->mCount) return;
-        SaleaeHeader::StorageFormat sf = SaleaeHeader::Uint64;
-        for (uint64_t i = 0; i<buf->mCount; i++)
+        if (mHeader.storageFormat() == SaleaeHeader::Compressed)
+        {
+            for (uint64_t i = 0; i<buf->mCount; i++)
+                writeTimeValue(buf->mTimeArray[i], buf->mValueArray[i]);
+            return;
+        }
+        // keep coded format if already set, values written later might be negative
+        SaleaeHeader::StorageFormat sf = mHeader.storageFormat() == SaleaeHeader::Coded ? SaleaeHeader::Coded : SaleaeHeader::Uint64;
+        for (uint64_t i = 0; sf != SaleaeHeader::Coded && i<buf->mCount; i++)
         {
             if (buf->mValueArray[i] < 0)
             {
@@ -408,6 +672,9 @@ namespace hal
     {
         if (mFirstValue)
         {
+            // no transition written yet, alternating values cannot represent undefined start value
+            if (val < 0 && mHeader.storageFormat() == SaleaeHeader::Uint64)
+                mHeader.setStorageFormat(SaleaeHeader::Coded);
             mHeader.setValue(val);
             mHeader.setBeginTime(t);
             mHeader.setEndTime(t);
@@ -424,7 +691,14 @@ namespace hal
             mLastWrittenValue = val;
             mLastWrittenTime  = t;
 
-            if (mHeader.storageFormat() == SaleaeHeader::Coded)
+            if (mHeader.storageFormat() == SaleaeHeader::Compressed)
+            {
+                mBlock.mTimes.push_back(t);
+                mBlock.mValues.push_back(val);
+                if (mBlock.mTimes.size() >= SaleaeCompressedBlock::sBlockSize)
+                    writeBlock();
+            }
+            else if (mHeader.storageFormat() == SaleaeHeader::Coded)
             {
                 uint64_t buf = val + 2;
                 buf <<= 62;
@@ -447,9 +721,29 @@ namespace hal
     void SaleaeOutputFile::close()
     {
         if (!good()) return;
+        if (mHeader.storageFormat() == SaleaeHeader::Compressed)
+        {
+            // pending transitions and block index
+            writeBlock();
+            uint64_t nblocks = mBlockIndex.size();
+            write((char*)mBlockIndex.data(), nblocks * sizeof(SaleaeCompressedBlock::IndexEntry));
+            write((char*)&nblocks, sizeof(nblocks));
+            write(SaleaeCompressedBlock::sTrailerIdent, 8);
+        }
         seekp(std::ios_base::beg);
         mHeader.write(*this);
         std::ofstream::close();
+
+        // time index (digital_XXX.idx) and summary pyramid (digital_XXX.lod) built for previous content are not valid any more
+        if (mFilename.size() > 4 && mFilename.compare(mFilename.size()-4, 4, ".bin") == 0)
+        {
+            for (const char* ext : {".idx", ".lod"})
+            {
+                std::string derivedFile = mFilename;
+                derivedFile.replace(derivedFile.size()-4, 4, ext);
+                remove(derivedFile.c_str());
+            }
+        }
     }
 
     SaleaeDirectoryFileIndex SaleaeOutputFile::fileIndex() const
@@ -0,0 +1,389 @@
+#include "netlist_simulator_controller/saleae_mapped_file.h"
+#include "netlist_simulator_controller/saleae_parser.h"
+#include "hal_core/utilities/utils.h"
+
+#include <algorithm>
+#include <fstream>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hal
+{
+    const char* SaleaeTimeIndex::sIdent = "<SALIDX>";
+
+    std::string SaleaeTimeIndex::indexFilename(const std::string& datafile)
+    {
+        std::string retval = datafile;
+        size_t pos = retval.rfind(".bin");
+        if (pos != std::string::npos && pos == retval.size() - 4)
+            retval.erase(pos);
+        return retval + ".idx";
+    }
+
+    bool SaleaeTimeIndex::matches(const SaleaeHeader& header, uint64_t dataFileSize) const
+    {
+        return mNumTransitions == header.numTransitions()
+                && mBeginTime == header.beginTime()
+                && mEndTime == header.endTime()
+                && mDataFileSize == dataFileSize
+                && mTimes.size() == (mNumTransitions + sStride - 1) / sStride;
+    }
+
+    void SaleaeTimeIndex::reset(const SaleaeHeader& header, uint64_t dataFileSize)
+    {
+        mNumTransitions = header.numTransitions();
+        mBeginTime      = header.beginTime();
+        mEndTime        = header.endTime();
+        mDataFileSize   = dataFileSize;
+        mTimes.clear();
+        mTimes.reserve((mNumTransitions + sStride - 1) / sStride);
+    }
+
+    bool SaleaeTimeIndex::load(const std::string& filename, const SaleaeHeader& header, uint64_t dataFileSize)
+    {
+        std::ifstream ff(filename, std::ios::binary);
+        if (!ff.good()) return false;
+
+        char ident[9];
+        ff.read(ident,8);
+        ident[8] = 0;
+        if (ident != std::string(sIdent)) return false;
+
+        uint32_t version;
+        uint64_t stride;
+        uint64_t count;
+        ff.read((char*)&version,sizeof(version));
+        ff.read((char*)&stride,sizeof(stride));
+        ff.read((char*)&mNumTransitions,sizeof(mNumTransitions));
+        ff.read((char*)&mBeginTime,sizeof(mBeginTime));
+        ff.read((char*)&mEndTime,sizeof(mEndTime));
+        ff.read((char*)&mDataFileSize,sizeof(mDataFileSize));
+        ff.read((char*)&count,sizeof(count));
+        if (!ff.good() || version != sVersion || stride != sStride || count != (mNumTransitions + sStride - 1) / sStride)
+            return false;
+
+        mTimes.resize(count);
+        ff.read((char*)mTimes.data(),count*sizeof(uint64_t));
+        if (!ff.good()) return false;
+
+        return matches(header, dataFileSize);
+    }
+
+    bool SaleaeTimeIndex::save(const std::string& filename) const
+    {
+        // reader threads create indices on demand, write to a temporary file of this writer first
+        // so that neither concurrent readers nor concurrent writers observe an incomplete index
+        std::string tmpFilename = utils::get_unique_temp_path(filename).string();
+        {
+            std::ofstream of(tmpFilename, std::ios::binary);
+            if (!of.good()) return false;
+
+            uint32_t version = sVersion;
+            uint64_t stride  = sStride;
+            uint64_t count   = mTimes.size();
+            of.write(sIdent,8);
+            of.write((char*)&version,sizeof(version));
+            of.write((char*)&stride,sizeof(stride));
+            of.write((char*)&mNumTransitions,sizeof(mNumTransitions));
+            of.write((char*)&mBeginTime,sizeof(mBeginTime));
+            of.write((char*)&mEndTime,sizeof(mEndTime));
+            of.write((char*)&mDataFileSize,sizeof(mDataFileSize));
+            of.write((char*)&count,sizeof(count));
+            of.write((char*)mTimes.data(),count*sizeof(uint64_t));
+            if (!of.good())
+            {
+                of.close();
+                remove(tmpFilename.c_str());
+                return false;
+            }
+        }
+        if (rename(tmpFilename.c_str(), filename.c_str()) != 0)
+        {
+            remove(tmpFilename.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    int64_t SaleaeTimeIndex::block(uint64_t t) const
+    {
+        auto it = std::upper_bound(mTimes.begin(), mTimes.end(), t);
+        return (it - mTimes.begin()) - 1;
+    }
+
+    SaleaeMappedFile::SaleaeMappedFile(const std::string& filename)
+        : mFilename(filename), mStatus(SaleaeStatus::Ok), mMapped(nullptr), mMappedSize(0), mIsMmap(false), mTransitions(nullptr),
+          mBlockDataEnd(0), mBlockNumber(-1)
+    {
+        {
+            std::ifstream ff(filename, std::ios::binary);
+            if (!ff.good())
+            {
+                mStatus = SaleaeStatus::ErrorOpenFile;
+                return;
+            }
+            mStatus = mHeader.read(ff);
+            if (mStatus) return;
+        }
+
+        mapFile();
+        if (mStatus) return;
+
+        if (mHeader.storageFormat() == SaleaeHeader::Compressed)
+        {
+            uint64_t nblocks = (mHeader.numTransitions() + SaleaeCompressedBlock::sBlockSize - 1) / SaleaeCompressedBlock::sBlockSize;
+            uint64_t indexSize = mMappedSize < sHeaderSize ? 0 : SaleaeCompressedBlock::parseIndex(mMapped + mMappedSize, mMappedSize - sHeaderSize, mBlockIndex);
+            mBlockDataEnd = mMappedSize - indexSize;
+            if (!indexSize
+                    || mBlockIndex.size() != nblocks
+                    || !SaleaeCompressedBlock::checkIndex(mBlockIndex, sHeaderSize, mBlockDataEnd))
+            {
+                mStatus = SaleaeStatus::UnexpectedEof;
+                unmapFile();
+                return;
+            }
+        }
+        else if (mMappedSize < sHeaderSize + mHeader.numTransitions() * sizeof(uint64_t))
+        {
+            mStatus = SaleaeStatus::UnexpectedEof;
+            unmapFile();
+            return;
+        }
+        mTransitions = mMapped + sHeaderSize;
+
+        loadOrBuildIndex();
+    }
+
+    SaleaeMappedFile::~SaleaeMappedFile()
+    {
+        unmapFile();
+    }
+
+    void SaleaeMappedFile::mapFile()
+    {
+#ifdef _WIN32
+        std::ifstream ff(mFilename, std::ios::binary | std::ios::ate);
+        if (!ff.good())
+        {
+            mStatus = SaleaeStatus::ErrorOpenFile;
+            return;
+        }
+        mMappedSize = ff.tellg();
+        char* buf = new char[mMappedSize];
+        ff.seekg(0);
+        ff.read(buf, mMappedSize);
+        mMapped = buf;
+        mIsMmap = false;
+#else
+        int fd = open(mFilename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            mStatus = SaleaeStatus::ErrorOpenFile;
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) < 0)
+        {
+            close(fd);
+            mStatus = SaleaeStatus::ErrorOpenFile;
+            return;
+        }
+        mMappedSize = st.st_size;
+        void* addr = mmap(nullptr, mMappedSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED)
+        {
+            mMappedSize = 0;
+            mStatus = SaleaeStatus::ErrorOpenFile;
+            return;
+        }
+        // random access pattern: avoid useless read ahead for large files
+        madvise(addr, mMappedSize, MADV_RANDOM);
+        mMapped = (const char*) addr;
+        mIsMmap = true;
+#endif
+    }
+
+    void SaleaeMappedFile::unmapFile()
+    {
+        if (!mMapped) return;
+#ifndef _WIN32
+        if (mIsMmap)
+            munmap((void*) mMapped, mMappedSize);
+        else
+#endif
+            delete [] mMapped;
+        mMapped = nullptr;
+        mTransitions = nullptr;
+        mMappedSize = 0;
+    }
+
+    void SaleaeMappedFile::loadOrBuildIndex()
+    {
+        uint64_t n = mHeader.numTransitions();
+        if (mHeader.storageFormat() == SaleaeHeader::Compressed)
+        {
+            // block index from file trailer has same stride, no need to persist
+            mIndex.reset(mHeader, mMappedSize);
+            for (const SaleaeCompressedBlock::IndexEntry& entry : mBlockIndex)
+                mIndex.append(entry.mFirstTime);
+            return;
+        }
+
+        std::string idxFilename = SaleaeTimeIndex::indexFilename(mFilename);
+
+        // small files fit into a single block, persisting an index would not pay off
+        bool persist = n > SaleaeTimeIndex::sStride;
+
+        if (persist && mIndex.load(idxFilename, mHeader, mMappedSize)) return;
+
+        mIndex.reset(mHeader, mMappedSize);
+        for (uint64_t i = 0; i < n; i += SaleaeTimeIndex::sStride)
+            mIndex.append(rawTime(i));
+
+        if (persist) mIndex.save(idxFilename);
+    }
+
+    const SaleaeCompressedBlock* SaleaeMappedFile::decodedBlock(uint64_t transition) const
+    {
+        int64_t iblock = transition / SaleaeCompressedBlock::sBlockSize;
+        if (iblock == mBlockNumber) return &mBlock;
+
+        mBlockNumber = -1;
+        // block extends up to next block or block index at most, offsets were checked when loading the index
+        uint64_t offset = mBlockIndex.at(iblock).mOffset;
+        uint64_t end = ((uint64_t) iblock + 1 < mBlockIndex.size()) ? mBlockIndex.at(iblock+1).mOffset : mBlockDataEnd;
+        if (!mBlock.decode(mMapped + offset, end - offset)) return nullptr;
+        mBlockNumber = iblock;
+        return &mBlock;
+    }
+
+    uint64_t SaleaeMappedFile::rawTime(uint64_t transition) const
+    {
+        if (mHeader.storageFormat() == SaleaeHeader::Compressed)
+        {
+            const SaleaeCompressedBlock* blk = decodedBlock(transition);
+            if (!blk) return 0;
+            return blk->mTimes.at(transition % SaleaeCompressedBlock::sBlockSize);
+        }
+
+        uint64_t buf;
+        memcpy(&buf, mTransitions + transition * sizeof(uint64_t), sizeof(buf));
+        switch (mHeader.storageFormat())
+        {
+        case SaleaeHeader::Double:
+        {
+            double tmp;
+            memcpy(&tmp, &buf, sizeof(tmp));
+            return floor(tmp * SaleaeParser::sTimeScaleFactor + 0.5) - mHeader.beginTime();
+        }
+        case SaleaeHeader::Coded:
+            return buf & 0x3fffffffffffffffull;
+        default:
+            break;
+        }
+        return buf;
+    }
+
+    std::string SaleaeMappedFile::get_last_error() const
+    {
+        switch (mStatus) {
+        case SaleaeStatus::ErrorOpenFile:
+            return "Error opening or mapping SALEAE file";
+        case SaleaeStatus::BadIndentifier:
+            return "No <SALEAE> identifier found";
+        case SaleaeStatus::UnsupportedType:
+            return "Expected SALEAE type 0 (digital data)";
+        case SaleaeStatus::UnexpectedEof:
+            return "SALEAE file smaller than indicated by header";
+        default:
+            break;
+        }
+        return std::string();
+    }
+
+    SaleaeDataTuple SaleaeMappedFile::valueAt(uint64_t pos) const
+    {
+        if (pos >= numberValues()) return SaleaeDataTuple();
+        if (!pos) return SaleaeDataTuple(mHeader.beginTime(), mHeader.value());
+
+        if (mHeader.storageFormat() == SaleaeHeader::Compressed)
+        {
+            const SaleaeCompressedBlock* blk = decodedBlock(pos-1);
+            if (!blk) return SaleaeDataTuple();
+            uint64_t j = (pos-1) % SaleaeCompressedBlock::sBlockSize;
+            return SaleaeDataTuple(blk->mTimes.at(j), blk->mValues.at(j));
+        }
+
+        if (mHeader.storageFormat() == SaleaeHeader::Coded)
+        {
+            uint64_t buf;
+            memcpy(&buf, mTransitions + (pos-1) * sizeof(uint64_t), sizeof(buf));
+            return SaleaeDataTuple(buf & 0x3fffffffffffffffull, ((buf >> 62) & 0x3) - 2);
+        }
+
+        return SaleaeDataTuple(rawTime(pos-1), (pos%2==0) ? mHeader.value() : 1-mHeader.value());
+    }
+
+    uint64_t SaleaeMappedFile::successorPosition(uint64_t t, bool strict) const
+    {
+        // number of values which precede t (or t itself if strict)
+        auto precedes = [t,strict](uint64_t tval) { return strict ? tval <= t : tval < t; };
+
+        uint64_t n = numberValues();
+        if (!n) return 0;
+        if (!precedes(mHeader.beginTime())) return 0;
+        if (n == 1) return 1;
+
+        // index entry i holds time of transition i*stride which is position i*stride+1
+        // at this point t > beginTime, thus t-1 is safe
+        int64_t blk = mIndex.block(strict ? t : t-1);
+        if (blk < 0) return 1;
+
+        uint64_t lo = blk * SaleaeTimeIndex::sStride;                                          // transition which precedes t
+        uint64_t hi = std::min<uint64_t>(lo + SaleaeTimeIndex::sStride, mHeader.numTransitions()); // first transition which is known not to precede t
+        while (lo + 1 < hi)
+        {
+            uint64_t mid = lo + (hi - lo) / 2;
+            if (precedes(rawTime(mid)))
+                lo = mid;
+            else
+                hi = mid;
+        }
+        // transition lo is at position lo+1 and precedes t, successor position is next one
+        return lo + 2;
+    }
+
+    int64_t SaleaeMappedFile::positionAt(uint64_t t) const
+    {
+        return (int64_t) successorPosition(t, true) - 1;
+    }
+
+    int SaleaeMappedFile::get_int_value(uint64_t t) const
+    {
+        int64_t pos = positionAt(t);
+        if (pos < 0) return -1;
+        return valueAt(pos).mValue;
+    }
+
+    SaleaeMappedFile::const_iterator SaleaeMappedFile::begin(uint64_t t) const
+    {
+        int64_t pos = positionAt(t);
+        return const_iterator(this, pos < 0 ? 0 : pos);
+    }
+
+    SaleaeMappedFile::const_iterator SaleaeMappedFile::end(uint64_t t) const
+    {
+        return const_iterator(this, successorPosition(t, true));
+    }
+}
@@ -0,0 +1,105 @@
+#include "netlist_simulator_controller/saleae_merge_stream.h"
+
+namespace hal
+{
+    SaleaeMergeStream::SaleaeMergeStream(const std::vector<std::string>& datafiles)
+        : mTime(0), mBits(0), mUndefined(0), mGood(true)
+    {
+        mInputs.resize(datafiles.size());
+        for (uint32_t i = 0; i < datafiles.size(); i++)
+        {
+            Input& inp = mInputs[i];
+            inp.mFile.reset(new SaleaeMappedFile(datafiles.at(i)));
+            inp.mPos = 0;
+            inp.mValue = -1;
+            if (i < sMaxMaskInputs) mUndefined |= (1u << i);
+            if (!inp.mFile->good())
+            {
+                mGood = false;
+                continue;
+            }
+            if (inp.mFile->numberValues())
+                mHeap.push(HeapEntry(inp.mFile->valueAt(0).mTime, i));
+        }
+    }
+
+    bool SaleaeMergeStream::next()
+    {
+        mChanged.clear();
+        if (mHeap.empty()) return false;
+
+        mTime = mHeap.top().first;
+        while (!mHeap.empty() && mHeap.top().first == mTime)
+        {
+            uint32_t inx = mHeap.top().second;
+            mHeap.pop();
+            Input& inp = mInputs[inx];
+            inp.mValue = inp.mFile->valueAt(inp.mPos).mValue;
+            if (++inp.mPos < inp.mFile->numberValues())
+                mHeap.push(HeapEntry(inp.mFile->valueAt(inp.mPos).mTime, inx));
+            if (mChanged.empty() || mChanged.back() != inx)
+                mChanged.push_back(inx);
+
+            if (inx >= sMaxMaskInputs) continue;
+            uint32_t mask = 1u << inx;
+            if (inp.mValue < 0)
+                mUndefined |= mask;
+            else
+                mUndefined &= ~mask;
+            if (inp.mValue == 1)
+                mBits |= mask;
+            else
+                mBits &= ~mask;
+        }
+        return true;
+    }
+
+    SaleaeBooleanEvaluator::SaleaeBooleanEvaluator(const char* truthTable, int numberInputs)
+    {
+        if (numberInputs < 0 || numberInputs > 16) numberInputs = 0;
+        mTable.resize(1 << numberInputs);
+        for (uint32_t i = 0; i < mTable.size(); i++)
+            mTable[i] = (truthTable[i/8] & (1 << (i%8))) ? 1 : 0;
+    }
+
+    void SaleaeTriggerEvaluator::event(const SaleaeMergeStream& sms, SaleaeOutputFile& sof)
+    {
+        uint64_t t = sms.time();
+        if (mPending && mPendingTime < t)
+        {
+            sof.writeTimeValue(mPendingTime, 0);
+            mPending = false;
+        }
+
+        bool triggered = false;
+        for (uint32_t inx : sms.changed())
+        {
+            if (inx >= mToValue.size()) continue; // filter input
+            if (mToValue.at(inx) < 0 || mToValue.at(inx) == sms.value(inx))
+            {
+                triggered = true;
+                break;
+            }
+        }
+        if (!triggered) return;
+        if (mFilterInput >= 0 && sms.value(mFilterInput) != 1) return;
+
+        // no trigger before first one
+        if (!mStarted && t > 0)
+            sof.writeTimeValue(0, 0);
+        mStarted = true;
+        sof.writeTimeValue(t, 1);
+        mPending = true;
+        mPendingTime = t + 1;
+    }
+
+    void SaleaeTriggerEvaluator::finish(SaleaeOutputFile& sof)
+    {
+        if (mPending)
+            sof.writeTimeValue(mPendingTime, 0);
+        else if (!mStarted)
+            sof.writeTimeValue(0, 0);
+        mPending = false;
+        mStarted = true;
+    }
+}
@@ -0,0 +1,232 @@
+#include "netlist_simulator_controller/saleae_summary_pyramid.h"
+#include "netlist_simulator_controller/saleae_mapped_file.h"
+#include "hal_core/utilities/utils.h"
+
+#include <algorithm>
+#include <fstream>
+#include <math.h>
+#include <stdio.h>
+
+namespace hal
+{
+    const char* SaleaeSummaryPyramid::sIdent = "<SALLOD>";
+
+    std::string SaleaeSummaryPyramid::summaryFilename(const std::string& datafile)
+    {
+        std::string retval = datafile;
+        size_t pos = retval.rfind(".bin");
+        if (pos != std::string::npos && pos == retval.size() - 4)
+            retval.erase(pos);
+        return retval + ".lod";
+    }
+
+    SaleaeSummaryPyramid::SaleaeSummaryPyramid(const std::string& datafile)
+        : mFilename(summaryFilename(datafile)), mGood(false), mNumTransitions(0), mBeginTime(0), mEndTime(0), mDataFileSize(0), mBaseShift(0)
+    {
+        SaleaeHeader header;
+        uint64_t dataFileSize = 0;
+        {
+            std::ifstream ff(datafile, std::ios::binary | std::ios::ate);
+            if (!ff.good()) return;
+            dataFileSize = ff.tellg();
+            ff.seekg(0);
+            if (header.read(ff) != SaleaeStatus::Ok) return;
+        }
+
+        // small waveforms are rendered from raw data
+        if (header.numTransitions() < sMinTransitions) return;
+
+        if (readHeader(header, dataFileSize))
+        {
+            mGood = true;
+            return;
+        }
+
+        if (!build(datafile)) return;
+        mGood = readHeader(header, dataFileSize);
+    }
+
+    bool SaleaeSummaryPyramid::readHeader(const SaleaeHeader& header, uint64_t dataFileSize)
+    {
+        std::ifstream ff(mFilename, std::ios::binary);
+        if (!ff.good()) return false;
+
+        char ident[9];
+        ff.read(ident,8);
+        ident[8] = 0;
+        if (ident != std::string(sIdent)) return false;
+
+        uint32_t version;
+        uint32_t nlevels;
+        ff.read((char*)&version,sizeof(version));
+        ff.read((char*)&mBaseShift,sizeof(mBaseShift));
+        ff.read((char*)&mNumTransitions,sizeof(mNumTransitions));
+        ff.read((char*)&mBeginTime,sizeof(mBeginTime));
+        ff.read((char*)&mEndTime,sizeof(mEndTime));
+        ff.read((char*)&mDataFileSize,sizeof(mDataFileSize));
+        ff.read((char*)&nlevels,sizeof(nlevels));
+        if (!ff.good() || version != sVersion || nlevels > 64) return false;
+
+        if (mNumTransitions != header.numTransitions() || mBeginTime != header.beginTime()
+                || mEndTime != header.endTime() || mDataFileSize != dataFileSize)
+            return false;
+
+        mLevelSize.resize(nlevels);
+        ff.read((char*)mLevelSize.data(),nlevels*sizeof(uint64_t));
+        if (!ff.good()) return false;
+
+        mLevelOffset.resize(nlevels);
+        uint64_t offset = ff.tellg();
+        for (uint32_t i=0; i<nlevels; i++)
+        {
+            mLevelOffset[i] = offset;
+            offset += mLevelSize.at(i) * sizeof(SaleaeSummaryBucket);
+        }
+
+        ff.seekg(0, std::ios::end);
+        return (uint64_t) ff.tellg() == offset;
+    }
+
+    bool SaleaeSummaryPyramid::build(const std::string& datafile)
+    {
+        SaleaeMappedFile smf(datafile);
+        if (!smf.good() || smf.numberValues() < 2) return false;
+
+        const SaleaeHeader* header = smf.header();
+        uint64_t n = header->numTransitions();
+        uint64_t tmax = std::max(header->endTime(), smf.valueAt(n).mTime);
+
+        // base width: power of two covering sTransitionsPerBucket transitions on average
+        uint64_t wmin = (tmax + 1) / n * sTransitionsPerBucket;
+        uint32_t baseShift = 0;
+        while (baseShift < 62 && (1ull << baseShift) < wmin) ++baseShift;
+        uint64_t w = 1ull << baseShift;
+
+        std::vector<std::vector<SaleaeSummaryBucket>> levels;
+        levels.push_back(std::vector<SaleaeSummaryBucket>(tmax / w + 1));
+        std::vector<SaleaeSummaryBucket>& base = levels.front();
+
+        // distribute value segment [t0,t1) to buckets touched
+        auto addSegment = [&base, w](uint64_t t0, uint64_t t1, int val) {
+            while (t0 < t1)
+            {
+                uint64_t ibuck = t0 / w;
+                uint64_t tEnd  = std::min(t1, (ibuck + 1) * w);
+                SaleaeSummaryBucket& buck = base[ibuck];
+                if (t0 == ibuck * w)
+                {
+                    buck.mStartValue = val;
+                    buck.mMinValue   = val;
+                    buck.mMaxValue   = val;
+                }
+                else
+                {
+                    if (val < buck.mMinValue) buck.mMinValue = val;
+                    if (val > buck.mMaxValue) buck.mMaxValue = val;
+                }
+                if (val == 1) buck.mHighTime += tEnd - t0;
+                t0 = tEnd;
+            }
+        };
+
+        SaleaeDataTuple last = smf.valueAt(0);
+        uint64_t tLast = 0; // value prior to first transition extends to time 0
+        for (auto it = ++smf.begin(); it != smf.end(); ++it)
+        {
+            SaleaeDataTuple sdt = *it;
+            addSegment(tLast, sdt.mTime, last.mValue);
+            ++base[sdt.mTime / w].mTransitions;
+            tLast = sdt.mTime;
+            last = sdt;
+        }
+        addSegment(tLast, base.size() * w, last.mValue);
+
+        while (levels.back().size() > 1)
+        {
+            const std::vector<SaleaeSummaryBucket>& lower = levels.back();
+            std::vector<SaleaeSummaryBucket> upper((lower.size() + 1) / 2);
+            for (uint64_t i = 0; i < upper.size(); i++)
+            {
+                upper[i] = lower.at(2*i);
+                if (2*i+1 >= lower.size()) continue;
+                const SaleaeSummaryBucket& right = lower.at(2*i+1);
+                upper[i].mTransitions += right.mTransitions;
+                upper[i].mHighTime    += right.mHighTime;
+                if (right.mMinValue < upper[i].mMinValue) upper[i].mMinValue = right.mMinValue;
+                if (right.mMaxValue > upper[i].mMaxValue) upper[i].mMaxValue = right.mMaxValue;
+            }
+            levels.push_back(upper);
+        }
+
+        // write to temporary file first, concurrent loader threads must not see incomplete pyramid
+        // and concurrent writers of the same pyramid must not write into the same temporary file
+        std::string tmpFilename = utils::get_unique_temp_path(mFilename).string();
+        {
+            std::ofstream of(tmpFilename, std::ios::binary);
+            if (!of.good()) return false;
+
+            uint32_t version = sVersion;
+            uint32_t nlevels = levels.size();
+            uint64_t numTransitions = n;
+            uint64_t beginTime = header->beginTime();
+            uint64_t endTime = header->endTime();
+            uint64_t dataFileSize = 0;
+            {
+                std::ifstream ff(datafile, std::ios::binary | std::ios::ate);
+                dataFileSize = ff.tellg();
+            }
+            of.write(sIdent,8);
+            of.write((char*)&version,sizeof(version));
+            of.write((char*)&baseShift,sizeof(baseShift));
+            of.write((char*)&numTransitions,sizeof(numTransitions));
+            of.write((char*)&beginTime,sizeof(beginTime));
+            of.write((char*)&endTime,sizeof(endTime));
+            of.write((char*)&dataFileSize,sizeof(dataFileSize));
+            of.write((char*)&nlevels,sizeof(nlevels));
+            for (const std::vector<SaleaeSummaryBucket>& lvl : levels)
+            {
+                uint64_t sz = lvl.size();
+                of.write((char*)&sz,sizeof(sz));
+            }
+            for (const std::vector<SaleaeSummaryBucket>& lvl : levels)
+                of.write((char*)lvl.data(),lvl.size()*sizeof(SaleaeSummaryBucket));
+            if (!of.good())
+            {
+                of.close();
+                remove(tmpFilename.c_str());
+                return false;
+            }
+        }
+        if (rename(tmpFilename.c_str(), mFilename.c_str()) != 0)
+        {
+            remove(tmpFilename.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    int SaleaeSummaryPyramid::levelForScale(double scale) const
+    {
+        if (!mGood || scale <= 0) return -1;
+        double timePerPixel = 1. / scale;
+        int level = (int) floor(log2(timePerPixel)) - (int) mBaseShift;
+        if (level < 0) return -1;
+        if (level >= numberLevels()) return numberLevels() - 1;
+        return level;
+    }
+
+    std::vector<SaleaeSummaryBucket> SaleaeSummaryPyramid::buckets(int level, uint64_t first, uint64_t count) const
+    {
+        std::vector<SaleaeSummaryBucket> retval;
+        if (!mGood || level < 0 || level >= numberLevels() || first >= mLevelSize.at(level)) return retval;
+        if (count > mLevelSize.at(level) - first) count = mLevelSize.at(level) - first;
+
+        std::ifstream ff(mFilename, std::ios::binary);
+        if (!ff.good()) return retval;
+        ff.seekg(mLevelOffset.at(level) + first * sizeof(SaleaeSummaryBucket));
+        retval.resize(count);
+        ff.read((char*)retval.data(), count * sizeof(SaleaeSummaryBucket));
+        if (!ff.good()) retval.clear();
+        return retval;
+    }
+}
@@ -9,8 +9,8 @@
 
 namespace hal
 {
-   SaleaeWriter::SaleaeWriter(const std::string& filename)
-       : mSaleaeDirectory(filename,true)
+   SaleaeWriter::SaleaeWriter(const std::string& filename, bool compressed)
+       : mSaleaeDirectory(filename,true), mCompressed(compressed)
     {
         std::filesystem::path csvpath(filename);
         mDir = csvpath.parent_path();
@@ -77,7 +77,7 @@ namespace hal
 
             updateDirectory = true;
         }
-        sof = new SaleaeOutputFile(path.string(), fileIndex);
+        sof = new SaleaeOutputFile(path.string(), fileIndex, mCompressed);
         if (!sof->good())
         {
             delete sof;
@@ -0,0 +1,142 @@
+#include "netlist_simulator_controller/simulation_activity.h"
+#include "netlist_simulator_controller/saleae_directory.h"
+#include "netlist_simulator_controller/saleae_mapped_file.h"
+#include "hal_core/netlist/endpoint.h"
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/module.h"
+#include "hal_core/netlist/net.h"
+#include "hal_core/netlist/netlist.h"
+#include "hal_core/utilities/utils.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace hal
+{
+    namespace
+    {
+        struct ThreadAccumulator
+        {
+            std::vector<u32> mHammingWeights;
+            std::vector<u32> mHammingDistances;
+            std::vector<u32> mCycleToggles;
+        };
+
+        bool isDefined(int val)
+        {
+            return val == 0 || val == 1;
+        }
+    }
+
+    SimulationActivity::SimulationActivity(u64 clockPeriod, u64 beginTime, u64 endTime)
+        : mBeginTime(beginTime), mEndTime(endTime), mClockPeriod(clockPeriod ? clockPeriod : 1)
+    {;}
+
+    bool SimulationActivity::compute(const std::string& saleaeDirectoryFilename, const Netlist* nl, u32 numThreads)
+    {
+        SaleaeDirectory sd(saleaeDirectoryFilename);
+        std::vector<SaleaeDirectory::ListEntry> netList = sd.get_net_list();
+        if (netList.empty()) return false;
+
+        numThreads = utils::get_num_parallel_threads(netList.size(), numThreads);
+
+        u64 ncycles = mEndTime > mBeginTime ? (mEndTime - mBeginTime + mClockPeriod - 1) / mClockPeriod : 0;
+
+        mNetIds.resize(netList.size());
+        mToggleCounts.assign(netList.size(), 0);
+        std::vector<ThreadAccumulator> accu(numThreads);
+        for (ThreadAccumulator& acc : accu)
+        {
+            acc.mHammingWeights.assign(ncycles, 0);
+            acc.mHammingDistances.assign(ncycles, 0);
+            acc.mCycleToggles.assign(ncycles, 0);
+        }
+
+        utils::parallel_for_with_thread_index(netList.size(), numThreads, [&](u32 ithread, u32 inet) {
+            ThreadAccumulator& acc = accu[ithread];
+            const SaleaeDirectory::ListEntry& sdle = netList.at(inet);
+            mNetIds[inet] = sdle.id;
+            SaleaeMappedFile smf(sd.get_datafile_path(sdle.fileIndex));
+            if (!smf.good()) return;
+
+            // single pass: transitions are consumed up to each cycle start, then value gets sampled
+            u64 n    = smf.numberValues();
+            u64 pos  = smf.successorPosition(mBeginTime);
+            int cur  = pos ? smf.valueAt(pos-1).mValue : -1;
+            int prev = cur;
+            u64 toggles = 0;
+
+            auto consume = [&](u64 tmax) {
+                for (; pos < n; ++pos)
+                {
+                    SaleaeDataTuple sdt = smf.valueAt(pos);
+                    if (sdt.mTime > tmax) break;
+                    if (pos && isDefined(cur) && isDefined(sdt.mValue) && cur != sdt.mValue)
+                    {
+                        ++toggles;
+                        ++acc.mCycleToggles[(sdt.mTime - mBeginTime) / mClockPeriod];
+                    }
+                    cur = sdt.mValue;
+                }
+            };
+
+            for (u64 icycle = 0; icycle < ncycles; icycle++)
+            {
+                consume(mBeginTime + icycle * mClockPeriod);
+                if (cur == 1) ++acc.mHammingWeights[icycle];
+                if (icycle && isDefined(cur) && isDefined(prev) && cur != prev) ++acc.mHammingDistances[icycle];
+                prev = cur;
+            }
+            if (mEndTime > mBeginTime) consume(mEndTime - 1);
+            mToggleCounts[inet] = toggles;
+        });
+
+        mHammingWeights   = std::move(accu[0].mHammingWeights);
+        mHammingDistances = std::move(accu[0].mHammingDistances);
+        mCycleToggles     = std::move(accu[0].mCycleToggles);
+        for (u32 i = 1; i < numThreads; i++)
+        {
+            for (u64 icycle = 0; icycle < ncycles; icycle++)
+            {
+                mHammingWeights[icycle]   += accu[i].mHammingWeights[icycle];
+                mHammingDistances[icycle] += accu[i].mHammingDistances[icycle];
+                mCycleToggles[icycle]     += accu[i].mCycleToggles[icycle];
+            }
+        }
+
+        mModuleIds.clear();
+        mModuleToggles.clear();
+        if (!nl) return true;
+
+        // module activity: toggles are accounted to module of driving gate and all parent modules
+        std::vector<Module*> modules = nl->get_modules();
+        std::sort(modules.begin(), modules.end(), [](const Module* a, const Module* b) { return a->get_id() < b->get_id(); });
+        std::unordered_map<u32,u32> moduleIndex;
+        for (const Module* m : modules)
+        {
+            moduleIndex[m->get_id()] = mModuleIds.size();
+            mModuleIds.push_back(m->get_id());
+        }
+        mModuleToggles.assign(mModuleIds.size(), 0);
+
+        std::unordered_set<u32> netModules;
+        for (u32 inet = 0; inet < mNetIds.size(); inet++)
+        {
+            if (!mToggleCounts.at(inet)) continue;
+            const Net* net = nl->get_net_by_id(mNetIds.at(inet));
+            if (!net) continue;
+
+            // net with several sources (e.g. tristate bus) is accounted only once to each module
+            netModules.clear();
+            for (const Endpoint* ep : net->get_sources())
+            {
+                for (const Module* m = ep->get_gate()->get_module(); m; m = m->get_parent_module())
+                    if (!netModules.insert(moduleIndex.at(m->get_id())).second) break;
+            }
+            for (u32 imod : netModules)
+                mModuleToggles[imod] += mToggleCounts.at(inet);
+        }
+        return true;
+    }
+}
@@ -39,19 +39,23 @@ namespace hal
         mState = Failed;
     }
 
+    namespace
+    {
+        const char* saleae_parser_filenames[] = {":/include/saleae_parser.h", ":/src/saleae_parser.cpp",
+                                                 ":/include/saleae_file.h", ":/src/saleae_file.cpp",
+                                                 ":/include/saleae_directory.h", ":/src/saleae_directory.cpp", nullptr};
+    }
+
     bool SimulationEngine::install_saleae_parser(std::string dirname) const
     {
         QDir dir(QString::fromStdString(dirname));
         if (!dir.exists()) return false;
-        const char* filenames[] = {":/include/saleae_parser.h", ":/src/saleae_parser.cpp",
-                                   ":/include/saleae_file.h", ":/src/saleae_file.cpp",
-                                   ":/include/saleae_directory.h", ":/src/saleae_directory.cpp", nullptr};
-        for (int i=0; filenames[i]; i++)
+        for (int i=0; saleae_parser_filenames[i]; i++)
         {
             // add STAMDALONE_PARSER preprocessor directive to all source files
-            QFileInfo finfo(filenames[i]);
+            QFileInfo finfo(saleae_parser_filenames[i]);
             QString targetFile = dir.absoluteFilePath(finfo.fileName());
-            QFile ff(filenames[i]);
+            QFile ff(saleae_parser_filenames[i]);
             if (!ff.open(QIODevice::ReadOnly)) return false;
             QFile of(targetFile);
             if (!of.open(QIODevice::WriteOnly)) return false;
@@ -61,6 +65,21 @@ namespace hal
         return true;
     }
 
+    std::string SimulationEngine::get_saleae_parser_sources() const
+    {
+        std::string retval;
+        for (int i=0; saleae_parser_filenames[i]; i++)
+        {
+            QFile ff(saleae_parser_filenames[i]);
+            if (!ff.open(QIODevice::ReadOnly)) continue;
+            QByteArray content = ff.readAll();
+            retval += saleae_parser_filenames[i];
+            retval += '\n';
+            retval.append(content.constData(), content.size());
+        }
+        return retval;
+    }
+
     void SimulationEngine::set_engine_property(const std::string& key, const std::string& value)
     {
         mProperties[key] = value;
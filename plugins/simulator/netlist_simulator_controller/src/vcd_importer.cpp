@@ -0,0 +1,382 @@
+#include "netlist_simulator_controller/vcd_importer.h"
+#include "netlist_simulator_controller/saleae_writer.h"
+#include "netlist_simulator_controller/saleae_file.h"
+#include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
+
+#include <chrono>
+#include <fstream>
+#include <string.h>
+#include <thread>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hal
+{
+    namespace
+    {
+        const int maxErrorMessages = 3;
+
+        bool isBlank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        // next whitespace separated token, pos is moved behind token
+        bool nextToken(const char*& pos, const char* end, const char*& tok, int& len)
+        {
+            while (pos < end && isBlank(*pos)) ++pos;
+            if (pos >= end) return false;
+            tok = pos;
+            while (pos < end && !isBlank(*pos)) ++pos;
+            len = pos - tok;
+            return true;
+        }
+
+        bool tokenEquals(const char* tok, int len, const char* keyword)
+        {
+            return (int) strlen(keyword) == len && !strncmp(tok, keyword, len);
+        }
+
+        // skip tokens until '$end' keyword has been consumed
+        void skipToEnd(const char*& pos, const char* end)
+        {
+            const char* tok;
+            int len;
+            while (nextToken(pos, end, tok, len))
+                if (tokenEquals(tok, len, "$end")) return;
+        }
+
+        // find first line starting with timestamp at or after pos
+        const char* findTimestamp(const char* pos, const char* end)
+        {
+            while (pos < end)
+            {
+                const char* nl = (const char*) memchr(pos, '\n', end - pos);
+                if (!nl) return end;
+                pos = nl + 1;
+                if (pos < end && *pos == '#') return pos;
+            }
+            return end;
+        }
+
+        class MappedInputFile
+        {
+            const char* mData;
+            u64 mSize;
+            bool mIsMmap;
+        public:
+            MappedInputFile(const std::string& filename) : mData(nullptr), mSize(0), mIsMmap(false)
+            {
+#ifdef _WIN32
+                std::ifstream ff(filename, std::ios::binary | std::ios::ate);
+                if (!ff.good()) return;
+                mSize = ff.tellg();
+                char* buf = new char[mSize];
+                ff.seekg(0);
+                ff.read(buf, mSize);
+                mData = buf;
+#else
+                int fd = open(filename.c_str(), O_RDONLY);
+                if (fd < 0) return;
+                struct stat st;
+                if (fstat(fd, &st) < 0 || !st.st_size)
+                {
+                    close(fd);
+                    return;
+                }
+                void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                close(fd);
+                if (addr == MAP_FAILED) return;
+                madvise(addr, st.st_size, MADV_SEQUENTIAL);
+                mData = (const char*) addr;
+                mSize = st.st_size;
+                mIsMmap = true;
+#endif
+            }
+
+            ~MappedInputFile()
+            {
+                if (!mData) return;
+#ifndef _WIN32
+                if (mIsMmap)
+                    munmap((void*) mData, mSize);
+                else
+#endif
+                    delete [] mData;
+            }
+
+            bool good() const { return mData != nullptr; }
+            const char* data() const { return mData; }
+            u64 size() const { return mSize; }
+        };
+    }
+
+    VcdImporter::VcdImporter(const std::string& saleaeDirectoryFilename, u32 numThreads)
+        : mSaleaeDirectoryFilename(saleaeDirectoryFilename), mNumThreads(numThreads), mMaxTime(0), mThroughput(0)
+    {
+        if (!mNumThreads) mNumThreads = std::thread::hardware_concurrency();
+        if (!mNumThreads) mNumThreads = 1;
+    }
+
+    int VcdImporter::shortCodeIndex(const char* code, int len)
+    {
+        if (!len || len > sMaxShortCode) return -1;
+
+        // index space: all one character codes, followed by all two character codes ...
+        int inx = 0;
+        int offset = 0;
+        int range = 1;
+        for (int i = 0; i < len; i++)
+        {
+            offset += range;
+            range *= sCodeRadix;
+            int digit = code[i] - '!';
+            if (digit < 0 || digit >= sCodeRadix) return -1;
+            inx = inx * sCodeRadix + digit;
+        }
+        return inx + offset - 1;
+    }
+
+    void VcdImporter::registerCode(const std::string& code, int slot)
+    {
+        int inx = shortCodeIndex(code.data(), code.size());
+        if (inx >= 0)
+            mShortCodes[inx] = slot;
+        else
+            mLongCodes[code] = slot;
+    }
+
+    int VcdImporter::lookupSlot(const char* code, int len) const
+    {
+        int inx = shortCodeIndex(code, len);
+        if (inx >= 0) return mShortCodes[inx];
+        auto it = mLongCodes.find(std::string(code, len));
+        if (it == mLongCodes.end()) return -1;
+        return it->second;
+    }
+
+    const char* VcdImporter::parseHeader(const char* pos, const char* end, SaleaeWriter& writer)
+    {
+        std::unordered_set<std::string> names;
+        int errorCount = 0;
+        const char* tok;
+        int len;
+
+        while (nextToken(pos, end, tok, len))
+        {
+            if (tokenEquals(tok, len, "$enddefinitions"))
+            {
+                skipToEnd(pos, end);
+                return pos;
+            }
+
+            if (!tokenEquals(tok, len, "$var"))
+            {
+                // $scope, $timescale, $comment, ...
+                if (*tok == '$' && !tokenEquals(tok, len, "$end"))
+                    skipToEnd(pos, end);
+                continue;
+            }
+
+            std::vector<std::string> fields;
+            while (nextToken(pos, end, tok, len) && !tokenEquals(tok, len, "$end"))
+                fields.push_back(std::string(tok, len));
+            if (fields.size() < 4) continue;
+
+            // type width code name [bit select]
+            if (fields.at(0) == "real" || fields.at(1) != "1") continue; // single bit waveforms only
+            const std::string& code = fields.at(2);
+            std::string name = fields.at(3);
+            for (u32 i = 4; i < fields.size(); i++)
+                name += " " + fields.at(i);
+
+            u32 netId = 0;
+            if (!mNetFilter.empty())
+            {
+                auto it = mNetFilter.find(name);
+                if (it == mNetFilter.end()) continue; // net not found in given name list
+                netId = it->second;
+            }
+
+            if (!names.insert(name).second)
+            {
+                if (errorCount++ < maxErrorMessages)
+                    log_warning("waveform_viewer", "Waveform duplicate for '{}' in VCD file.", name);
+                continue;
+            }
+
+            int slot = lookupSlot(code.data(), code.size());
+            if (slot >= 0)
+            {
+                // output file already exists, need name entry
+                writer.add_directory_entry(mSlots.at(slot)->index(), name, netId);
+            }
+            else
+            {
+                SaleaeOutputFile* sof = writer.add_or_replace_waveform(name, netId);
+                if (!sof) continue;
+                registerCode(code, mSlots.size());
+                mSlots.push_back(sof);
+            }
+        }
+        return nullptr;
+    }
+
+    void VcdImporter::parseChunk(Chunk& chunk) const
+    {
+        const char* pos = chunk.mBegin;
+        const char* end = chunk.mEnd;
+        const char* tok;
+        int len;
+        u64 t = 0;
+
+        while (pos < end)
+        {
+            while (pos < end && isBlank(*pos)) ++pos;
+            if (pos >= end) break;
+
+            int val = 0;
+            switch (*pos)
+            {
+            case '#':
+            {
+                const char* digits = ++pos;
+                t = 0;
+                while (pos < end && *pos >= '0' && *pos <= '9')
+                    t = t * 10 + (*(pos++) - '0');
+                if (pos == digits) ++chunk.mErrors;
+                if (t > chunk.mMaxTime) chunk.mMaxTime = t;
+                continue;
+            }
+            case 'b':
+            case 'B':
+            case 'r':
+            case 'R':
+                // vector or real value followed by code, not supported
+                nextToken(pos, end, tok, len);
+                nextToken(pos, end, tok, len);
+                continue;
+            case '$':
+                nextToken(pos, end, tok, len);
+                if (tokenEquals(tok, len, "$comment"))
+                    skipToEnd(pos, end);
+                continue;
+            case '0':
+                val = 0;
+                break;
+            case '1':
+                val = 1;
+                break;
+            case 'x':
+            case 'X':
+                val = -1;
+                break;
+            case 'z':
+            case 'Z':
+                val = -2;
+                break;
+            default:
+                ++chunk.mErrors;
+                pos = (const char*) memchr(pos, '\n', end - pos);
+                if (!pos) pos = end;
+                continue;
+            }
+
+            const char* code = ++pos;
+            while (pos < end && !isBlank(*pos)) ++pos;
+            int slot = lookupSlot(code, pos - code);
+            if (slot >= 0)
+                chunk.mEvents.push_back({t, (u32) slot, val});
+        }
+    }
+
+    bool VcdImporter::import(const std::string& vcdFilename)
+    {
+        auto tStart = std::chrono::steady_clock::now();
+        mMaxTime = 0;
+        mThroughput = 0;
+        mSlots.clear();
+        mLongCodes.clear();
+        int shortCodeSpace = 0;
+        for (int i = 0, range = 1; i < sMaxShortCode; i++)
+            shortCodeSpace += (range *= sCodeRadix);
+        mShortCodes.assign(shortCodeSpace, -1);
+
+        MappedInputFile mif(vcdFilename);
+        if (!mif.good())
+        {
+            log_warning("waveform_viewer", "Cannot open VCD input file '{}'.", vcdFilename);
+            return false;
+        }
+        const char* end = mif.data() + mif.size();
+
+        SaleaeWriter writer(mSaleaeDirectoryFilename);
+
+        const char* pos = parseHeader(mif.data(), end, writer);
+        if (!pos)
+        {
+            log_warning("waveform_viewer", "No '$enddefinitions' found in VCD file '{}'.", vcdFilename);
+            return false;
+        }
+
+        std::vector<Chunk> chunks(mNumThreads);
+        u64 errors = 0;
+        while (pos < end)
+        {
+            // split next round into chunks, each chunk starts with timestamp
+            u32 nchunks = 0;
+            while (nchunks < mNumThreads && pos < end)
+            {
+                Chunk& chunk = chunks[nchunks++];
+                chunk.mBegin = pos;
+                pos = ((u64)(end - pos) > sChunkSize) ? findTimestamp(pos + sChunkSize, end) : end;
+                chunk.mEnd = pos;
+                chunk.mEvents.clear();
+                chunk.mMaxTime = 0;
+                chunk.mErrors = 0;
+            }
+
+            utils::parallel_for(nchunks, [this, &chunks](u32 i) { parseChunk(chunks[i]); }, mNumThreads);
+
+            // merge in chunk order, each thread writes to a disjoint set of output files
+            u32 numWriters = mSlots.size() < mNumThreads ? mSlots.size() : mNumThreads;
+            utils::parallel_for(numWriters, [this, &chunks, nchunks, numWriters](u32 iwriter) {
+                for (u32 i = 0; i < nchunks; i++)
+                    for (const Event& evt : chunks[i].mEvents)
+                        if (evt.mSlot % numWriters == iwriter)
+                            mSlots[evt.mSlot]->writeTimeValue(evt.mTime, evt.mValue);
+            }, numWriters);
+
+            for (u32 i = 0; i < nchunks; i++)
+            {
+                if (chunks[i].mMaxTime > mMaxTime) mMaxTime = chunks[i].mMaxTime;
+                errors += chunks[i].mErrors;
+            }
+
+            if (mProgressCallback)
+                mProgressCallback((int) ((pos - mif.data()) * 100 / mif.size()));
+        }
+
+        if (errors)
+        {
+            log_warning("waveform_viewer", "Cannot parse {} VCD data line(s) in file '{}'.", errors, vcdFilename);
+            return false;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+        double megabytes = mif.size() / 1048576.;
+        mThroughput = seconds > 0 ? megabytes / seconds : 0;
+        log_info("waveform_viewer", "Imported {} waveforms from VCD file '{}' ({:.1f} MB) in {:.2f} s, {:.1f} MB/s using {} threads.",
+                 mSlots.size(), vcdFilename, megabytes, seconds, mThroughput, mNumThreads);
+        return true;
+    }
+}
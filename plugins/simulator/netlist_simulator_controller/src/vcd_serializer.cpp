@@ -1,12 +1,12 @@
 #include "netlist_simulator_controller/vcd_serializer.h"
 #include "netlist_simulator_controller/netlist_simulator_controller.h"
 #include "netlist_simulator_controller/saleae_writer.h"
+#include "netlist_simulator_controller/vcd_importer.h"
 #include "netlist_simulator_controller/saleae_parser.h"
 #include "netlist_simulator_controller/saleae_file.h"
 #include "netlist_simulator_controller/wave_data.h"
 #include "hal_core/utilities/log.h"
 #include "hal_core/netlist/net.h"
-#include <QRegularExpression>
 #include <QDebug>
 #include <QDataStream>
 #include <QFileInfo>
@@ -71,7 +71,6 @@ namespace hal {
     void VcdSerializer::deleteFiles()
     {
         mSaleaeFiles.clear();
-        mAbbrevByName.clear();
         memset(mErrorCount, 0, sizeof(mErrorCount));
     }
 
@@ -145,92 +144,6 @@ namespace hal {
         return true;
     }
 
-    bool VcdSerializer::parseVcdDataNonDecimal(const QByteArray &line, int base)
-    {
-        QList<QByteArray> sl = line.split(' ');
-        if (sl.size()!=2) return false;
-        bool ok;
-        int val = sl.at(0).toUInt(&ok,base);
-        if (!ok)
-        {
-            if (mErrorCount[0]++ < maxErrorMessages)
-                log_warning("waveform_viewer", "Cannot parse VCD data value '{}'", std::string(sl.at(0).data()));
-            val = 0;
-        }
-        storeValue(val, sl.at(1));
-        // [return ok] return statement if we want to bail out upon data parse error
-        return true; // ignore parse errors
-    }
-
-    bool VcdSerializer::parseVcdDataline(char *buf, int len)
-    {
-        int pos = 0;
-        while (len)
-        {
-            int val = -1;
-            switch(*(buf+pos))
-            {
-            case 'b': return true; // parseVcdDataNonDecimal(QByteArray(buf+pos+1,len-1),2);
-            case 'o': return true; //parseVcdDataNonDecimal(QByteArray(buf+pos+1,len-1),8);
-            case 'h': return true; // parseVcdDataNonDecimal(QByteArray(buf+pos+1,len-1),16);
-            case '$':
-            {
-                QByteArray testKeyword = QByteArray(buf+pos+1,len-1);
-                if (testKeyword.startsWith("dumpvars") || testKeyword.startsWith("end"))
-                    return true;
-                return false;
-            }
-            case '#':
-            {
-                bool ok;
-                mTime = QByteArray(buf+pos+1,len-1).toULongLong(&ok);
-                Q_ASSERT(ok);
-                return true;
-            }
-            case 'x':
-                val = -1;
-                break;
-            case 'z':
-                val = -2;
-                break;
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-                val = *(buf+pos)-'0';
-                break;
-            default:
-                qDebug() << "cannot parse dataline entries starting with" << *(buf+pos) << buf;
-                return false;
-            }
-            int p = pos+1;
-            while (p<len && buf[p]>' ') ++p;
-            Q_ASSERT(p > pos+1);
-            int abbrevLen = p - pos - 1;
-            storeValue(val,QByteArray(buf+pos+1,abbrevLen));
-            pos = p;
-            len -= (abbrevLen+1) ;
-            while (buf[pos]==' ' && len > 0)
-            {
-                pos++;
-                len--;
-            }
-        }
-        return true;
-    }
-
-    void VcdSerializer::storeValue(int val, const QByteArray& abrev)
-    {
-        SaleaeOutputFile* sof = mSaleaeFiles.value(abrev);
-        if (!sof) return;
-    //    Q_ASSERT(wd);
-        sof->writeTimeValue(mTime,val);
-    }
-
     bool VcdSerializer::parseCsvHeader(char *buf)
     {
         int icol = 0;
@@ -422,14 +335,14 @@ namespace hal {
             int sizeRead = ff.readLine(buf,bufsize);
             if (sizeRead >= bufsize)
             {
-                if (mErrorCount[1]++ < maxErrorMessages)
+                if (mErrorCount[0]++ < maxErrorMessages)
                     log_warning("waveform_viewer", "CSV line {} exceeds buffer size {}.", dataLineIndex, bufsize);
                 return false;
             }
 
             if (sizeRead < 0)
             {
-                if (mErrorCount[2]++ < maxErrorMessages)
+                if (mErrorCount[1]++ < maxErrorMessages)
                     log_warning("waveform_viewer", "CSV parse error reading line {} from file '{}'.", dataLineIndex, ff.fileName().toStdString());
                 return false;
             }
@@ -439,7 +352,7 @@ namespace hal {
             {
                 if (!parseCsvHeader(buf))
                 {
-                    if (mErrorCount[3]++ < maxErrorMessages)
+                    if (mErrorCount[2]++ < maxErrorMessages)
                         log_warning("waveform_viewer", "Cannot parse CSV header line '{}'.", buf);
                     return false;
                 }
@@ -449,7 +362,7 @@ namespace hal {
             {
                 if (!parseCsvDataline(buf,dataLineIndex++))
                 {
-                    if (mErrorCount[4]++ < maxErrorMessages)
+                    if (mErrorCount[3]++ < maxErrorMessages)
                         log_warning("waveform_viewer", "Cannot parse CSV data line '{}'.", buf);
                     return false;
                 }
@@ -462,128 +375,24 @@ namespace hal {
     bool VcdSerializer::importVcd(const QString& vcdFilename, const QString& workdir, const QList<const Net*>& onlyNets)
     {
         mWorkdir = workdir.isEmpty() ? QDir::currentPath() : workdir;
-        deleteFiles();
         mTime = 0;
-        QFile ff(vcdFilename);
-        if (!ff.open(QIODevice::ReadOnly))
-        {
-            log_warning("waveform_viewer", "Cannot open VCD input file '{}'.", vcdFilename.toStdString());
-            return false;
-        }
 
         createSaleaeDirectory();
-        mSaleaeWriter =  new SaleaeWriter(mSaleaeDirectoryFilename.toStdString());
+        VcdImporter importer(mSaleaeDirectoryFilename.toStdString());
 
-        bool retval = parseVcdInternal(ff,onlyNets);
+        std::unordered_map<std::string,u32> netFilter;
+        for (const Net* n : onlyNets)
+            netFilter[n->get_name()] = n->get_id();
+        importer.set_net_filter(netFilter);
+        importer.set_progress_callback([this](int percent) { emitProgress(percent,100); });
 
-        delete mSaleaeWriter;
-        mSaleaeWriter = nullptr;
-        mSaleaeFiles.clear();
-        mAbbrevByName.clear();
+        bool retval = importer.import(vcdFilename.toStdString());
+        mTime = importer.get_max_time();
 
         if (retval) emitImportDone();
         return retval;
     }
 
-    bool VcdSerializer::parseVcdInternal(QFile& ff, const QList<const Net*>& onlyNets)
-    {
-        bool parseHeader = true;
-
-        QMap<QString, const Net*> netNames;
-        for (const Net* n : onlyNets)
-            netNames.insert(QString::fromStdString(n->get_name()),n);
-
-        QRegularExpression reHead("\\$(\\w*) (.*)\\$end");
-        QRegularExpression reWire("wire\\s+(\\d+) ([^ ]+) (.*) $");
-
-        quint64 fileSize = ff.size();
-        quint64 totalRead = 0;
-
-        static const int bufsize = 4095;
-        char buf[bufsize+1];
-
-        int iline = 0;
-        while(!ff.atEnd())
-        {
-            int sizeRead = ff.readLine(buf,bufsize);
-            ++iline;
-            totalRead += sizeRead;
-            emitProgress(totalRead,fileSize);
-            if (sizeRead >= bufsize)
-            {
-                if (mErrorCount[5]++ < maxErrorMessages)
-                    log_warning("waveform_viewer", "VCD line {} exceeds buffer size {}.", iline, bufsize);
-                return false;
-            }
-
-            if (sizeRead < 0)
-            {
-                if (mErrorCount[6]++ < maxErrorMessages)
-                    log_warning("waveform_viewer", "VCD parse error reading line {} from file '{}'.", iline, ff.fileName().toStdString());
-                return false;
-            }
-            if (sizeRead > 0 && buf[sizeRead-1]=='\n') --sizeRead;
-            if (sizeRead > 0 && buf[sizeRead-1]=='\r') --sizeRead;
-            if (!sizeRead) continue;
-
-
-            if (parseHeader)
-            {
-                QByteArray line(buf,sizeRead);
-                QRegularExpressionMatch mHead = reHead.match(line);
-                if (mHead.hasMatch())
-                {
-                    if (mHead.captured(1) == "enddefinitions")
-                        parseHeader = false;
-                    else if (mHead.captured(1) == "var")
-                    {
-                        QRegularExpressionMatch mWire = reWire.match(mHead.captured(2));
-                        bool ok;
-                        QString wireName   = mWire.captured(3);
-                        const Net* net = netNames.value(wireName);
-                        if (!netNames.isEmpty() && !net) continue; // net not found in given name list
-                        if (mAbbrevByName.contains(wireName))
-                        {
-                            if (mErrorCount[7]++ < maxErrorMessages)
-                                log_warning("waveform_viewer", "Waveform duplicate for '{}' in VCD file '{}'.", wireName.toStdString(), ff.fileName().toStdString());
-                            continue;
-                        }
-                        QString wireAbbrev = mWire.captured(2);
-                        mAbbrevByName.insert(wireName,wireAbbrev);
-                        int     wireBits   = mWire.captured(1).toUInt(&ok);
-                        if (!ok) wireBits = 1;
-                        if (wireBits > 1) continue; // TODO : decision whether we will be able to handle VCD with more bits
-
-                        u32 netId = net ? net->get_id() : 0;
-
-                        SaleaeOutputFile* sof = nullptr;
-                        if (mSaleaeFiles.contains(wireAbbrev))
-                        {
-                            // output file already exists, need name entry
-                            sof = mSaleaeFiles.value(wireAbbrev);
-                            if (sof) mSaleaeWriter->add_directory_entry(sof->index(), wireName.toStdString(), netId);
-                        }
-                        else
-                        {
-                            sof = mSaleaeWriter->add_or_replace_waveform(wireName.toStdString(), netId);
-                            if (sof) mSaleaeFiles.insert(wireAbbrev,sof);
-                        }
-                    }
-                }
-            }
-            else
-            {
-                if (!parseVcdDataline(buf,sizeRead))
-                {
-                    if (mErrorCount[8]++ < maxErrorMessages)
-                        log_warning("waveform_viewer", "Cannot parse VCD data line '{}'.", QByteArray(buf,sizeRead).data());
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
-
     bool VcdSerializer::importSaleae(const QString& saleaeDirecotry, const std::unordered_map<hal::Net*, int> &lookupTable, const QString& workdir, u64 timeScale)
     {
         mWorkdir = workdir.isEmpty() ? QDir::currentPath() : workdir;
@@ -1,5 +1,7 @@
 #include "netlist_simulator_controller/wave_data.h"
 #include "netlist_simulator_controller/saleae_file.h"
+#include "netlist_simulator_controller/saleae_mapped_file.h"
+#include "netlist_simulator_controller/saleae_merge_stream.h"
 #include "netlist_simulator_controller/plugin_netlist_simulator_controller.h"
 #include "netlist_simulator_controller/simulation_settings.h"
 #include "netlist_simulator_controller/wave_data_provider.h"
@@ -48,18 +50,18 @@ namespace hal {
 
     WaveData::WaveData(const WaveData& other)
         : mId(other.mId), mFileIndex(other.mFileIndex), mFileSize(other.mFileSize), mTimeframeSize(other.mTimeframeSize),
-          mName(other.mName), mNetType(other.mNetType), mBits(other.mBits), mValueBase(other.mValueBase),
+          mName(other.mName), mNetType(other.mNetType), mBits(other.mBits), mDerivedFileIndex(other.mDerivedFileIndex), mValueBase(other.mValueBase),
           mData(other.mData), mDirty(true)
     {;}
 
     WaveData::WaveData(u32 id_, const QString& nam, NetType tp, const QMap<u64,int> &dat)
-        : mId(id_), mFileIndex(-1), mFileSize(0), mTimeframeSize(0), mName(nam), mNetType(tp), mBits(1), mValueBase(16), mData(dat), mDirty(true)
+        : mId(id_), mFileIndex(-1), mFileSize(0), mTimeframeSize(0), mName(nam), mNetType(tp), mBits(1), mDerivedFileIndex(-1), mValueBase(16), mData(dat), mDirty(true)
     {;}
 
     WaveData::WaveData(const Net* n, NetType tp)
         : mId(n->get_id()), mFileIndex(-1), mFileSize(0), mTimeframeSize(0),
           mName(QString::fromStdString(n->get_name())),
-          mNetType(tp), mBits(1), mValueBase(16), mDirty(true)
+          mNetType(tp), mBits(1), mDerivedFileIndex(-1), mValueBase(16), mDirty(true)
     {;}
 
     WaveData::~WaveData()
@@ -78,6 +80,58 @@ namespace hal {
         mTimeframeSize = siz;
     }
 
+    void WaveData::requestDerivedSaleae()
+    {
+        // only reserve data file here, merge is done by writeDerivedSaleae() in loader thread
+        mFileIndex = -1;
+        mFileSize  = 0;
+        mDirty     = true;
+        mDerivedRequest.ref();
+        if (!mWaveDataList) return;
+        SaleaeDirectory& sd = mWaveDataList->saleaeDirectory();
+
+        SaleaeDirectoryComposedEntry sdce = sd.get_composed(id(), composedType());
+        if (sdce.isNull()) sdce = SaleaeDirectoryComposedEntry(get_name(), id(), composedType());
+        mDerivedFileIndex = sdce.dataFileIndex();
+        if (mDerivedFileIndex >= 0) return;
+
+        // time range and number of values are read from data file header
+        mDerivedFileIndex = sd.get_next_available_index();
+        sdce.set_file_index(SaleaeDirectoryFileIndex(mDerivedFileIndex));
+        sd.add_or_replace_composed(sdce);
+    }
+
+    template<typename Evaluator> bool WaveData::mergeDerivedSaleae(const QList<WaveData*>& inputs, Evaluator& eval)
+    {
+        QMutexLocker lock(&mDerivedMutex);
+        if (mFileIndex >= 0) return true; // already merged by other loader
+        int request = mDerivedRequest.loadAcquire();
+        if (!mWaveDataList || mDerivedFileIndex < 0 || inputs.isEmpty()) return false;
+        const SaleaeDirectory& sd = mWaveDataList->saleaeDirectory();
+
+        std::vector<std::string> datafiles;
+        for (const WaveData* wd : inputs)
+        {
+            // merge engine reads inputs from disk, waveforms which exist in memory only cannot be merged
+            if (wd->fileIndex() < 0) return false;
+            datafiles.push_back(sd.get_datafile_path(wd->fileIndex()));
+        }
+        SaleaeMergeStream sms(datafiles);
+        if (!sms.good()) return false;
+
+        SaleaeOutputFile sof(sd.get_datafile_path(mDerivedFileIndex), mDerivedFileIndex);
+        if (!sof.good()) return false;
+        sms.evaluate(sof, eval);
+        sof.close();
+
+        // waveform has been changed while merging, result is outdated
+        if (request != mDerivedRequest.loadAcquire()) return false;
+
+        setFileSize(sof.fileIndex().numberValues());
+        mFileIndex = mDerivedFileIndex;
+        return true;
+    }
+
     WaveData::LoadPolicy WaveData::loadPolicy() const
     {
         u64 maxSizeLoadable = NetlistSimulatorControllerPlugin::sSimulationSettings->maxSizeLoadable();
@@ -209,7 +263,7 @@ namespace hal {
         {
             WaveDataProvider* wdp = nullptr;
             std::string saleaeDirectory = mWaveDataList->saleaeDirectory().get_filename();
-            switch (mNetType)
+            switch (hasDerivedDataFile() && loadPolicy() == TooBigToLoad ? RegularNet : mNetType)
             {
             case WaveData::NetGroup:
             {
@@ -248,18 +302,16 @@ namespace hal {
                 std::filesystem::path path = mWaveDataList->saleaeDirectory().get_datafile_path(mFileIndex);
                 if (!path.empty())
                 {
-                    SaleaeInputFile sif(path);
-                    if (t0)
-                    {
-                        if (sif.get_file_position(t0,true) < 0)
-                            return retval;
-                    }
-                    SaleaeDataBuffer* sdb = sif.get_buffered_data(NetlistSimulatorControllerPlugin::sSimulationSettings->maxSizeLoadable());
-                    if (sdb)
+                    SaleaeMappedFile smf(path);
+                    if (!smf.good()) return retval;
+                    u64 maxSize = NetlistSimulatorControllerPlugin::sSimulationSettings->maxSizeLoadable();
+                    u64 pos = smf.successorPosition(t0);
+                    for (u64 n = 0; n < maxSize && pos < smf.numberValues(); ++n, ++pos)
                     {
-                        for (u64 i=0; i<sdb->mCount; i++)
-                            retval.push_back(std::make_pair(sdb->mTimeArray[i],sdb->mValueArray[i]));
-                        delete sdb;
+                        SaleaeDataTuple sdt = smf.valueAt(pos);
+                        // trigger file holds pulses, report rising edges only
+                        if (mNetType == TriggerTime && sdt.mValue != 1) continue;
+                        retval.push_back(std::make_pair(sdt.mTime,sdt.mValue));
                     }
                 }
             }
@@ -279,45 +331,18 @@ namespace hal {
         if (!mWaveDataList || mFileIndex<0) return false;
         std::filesystem::path path = mWaveDataList->saleaeDirectory().get_datafile_path(mFileIndex);
         if (path.empty()) return false;
-        SaleaeInputFile sif(path);
-        if (!sif.good()) return false;
+        SaleaeMappedFile smf(path);
+        if (!smf.good()) return false;
         u64 t0 = tframe.hasUserTimeframe() ? tframe.sceneMinTime() : 0;
         u64 t1 = tframe.hasUserTimeframe() ? tframe.sceneMaxTime() : 0;
         Q_ASSERT(t0 <= t1);
 
-        int lastVal = BooleanFunction::X;
-        bool valuePending = false;
-        while (sif.good())
+        // seek directly to value valid at t0 instead of reading all preceding transitions
+        auto itEnd = t1 ? smf.end(t1) : smf.end();
+        for (auto it = smf.begin(t0); it != itEnd; ++it)
         {
-            SaleaeDataBuffer* sdb = sif.get_buffered_data(NetlistSimulatorControllerPlugin::sSimulationSettings->maxSizeLoadable());
-            if (!sdb) break;
-            for (u64 i=0; i<sdb->mCount; i++)
-            {
-                u64 t = sdb->mTimeArray[i];
-                if (t < t0)
-                {
-                    lastVal = sdb->mValueArray[i];
-                    valuePending = true;
-                }
-                else if (t == t0)
-                {
-                    mData.insert(t,sdb->mValueArray[i]);
-                    valuePending = false;
-                }
-                else if (!t1 || t <= t1)
-                {
-                    if (valuePending) mData.insert(t0,lastVal);
-                    mData.insert(t,sdb->mValueArray[i]);
-                    valuePending = false;
-                }
-                else
-                {
-                    if (valuePending) mData.insert(t0,lastVal);
-                    valuePending = false;
-                    break;
-                }
-            }
-            delete sdb;
+            SaleaeDataTuple sdt = *it;
+            mData.insert(sdt.mTime < t0 ? t0 : sdt.mTime, sdt.mValue);
         }
         mDirty = true;
         return true;
@@ -432,29 +457,22 @@ namespace hal {
 
 
         if (!mWaveDataList) return notFound;
-        SaleaeInputFile sif(mWaveDataList->saleaeDirectory().get_datafile_path(mFileIndex));
-        if (!sif.good()) return notFound;
-
-        int64_t pos = sif.get_file_position(t,next);
+        SaleaeMappedFile smf(mWaveDataList->saleaeDirectory().get_datafile_path(mFileIndex));
+        if (!smf.good()) return notFound;
 
-        while (pos >= 0 && pos <= (int64_t) sif.header()->numTransitions())
+        u64 tfloor = (u64) floor(t);
+        if (next)
         {
-            SaleaeDataTuple sdt = sif.get_next_value();
-            if (sdt.readError()) return notFound;
-            if (next)
-            {
-                if (sdt.mTime > t) return sdt.mTime;
-                ++pos;
-            }
-            else
-            {
-                if (sdt.mTime < t) return sdt.mTime;
-                --pos;
-            }
-            sif.set_file_position(pos);
+            // first transition later than t
+            u64 pos = smf.successorPosition(tfloor, true);
+            if (pos >= smf.numberValues()) return notFound;
+            return smf.valueAt(pos).mTime;
         }
 
-        return notFound;
+        // last transition earlier than t
+        u64 pos = smf.successorPosition(tfloor < t ? tfloor + 1 : tfloor);
+        if (!pos) return notFound;
+        return smf.valueAt(pos-1).mTime;
     }
 
     int WaveData::intValue(double t) const
@@ -468,10 +486,10 @@ namespace hal {
             return it.value();
         }
 
-        if (!mWaveDataList) return -1;
-        SaleaeInputFile sif(mWaveDataList->saleaeDirectory().get_datafile_path(mFileIndex));
-        if (!sif.good()) return -1;
-        return sif.get_int_value(t);
+        if (!mWaveDataList || t < 0) return -1;
+        SaleaeMappedFile smf(mWaveDataList->saleaeDirectory().get_datafile_path(mFileIndex));
+        if (!smf.good()) return -1;
+        return smf.get_int_value((u64) floor(t));
     }
 
     QString WaveData::strValue(double t) const
@@ -684,12 +702,21 @@ namespace hal {
         if (mTruthTable) delete [] mTruthTable;
     }
 
+    bool WaveDataBoolean::writeDerivedSaleae()
+    {
+        if (!mTruthTable) return false;
+        SaleaeBooleanEvaluator eval(mTruthTable, mInputCount);
+        return mergeDerivedSaleae(children(), eval);
+    }
+
     void WaveDataBoolean::recalcData()
     {
         mData.clear();
         switch (loadPolicy())
         {
         case WaveData::TooBigToLoad:
+            // inputs cannot be loaded, input files get merged by loader thread
+            requestDerivedSaleae();
             return;
         case WaveData::LoadTimeframe:
             for (int i=0; i<mInputCount; i++)
@@ -825,6 +852,8 @@ namespace hal {
 
     int WaveDataTrigger::intValue(double t) const
     {
+        if (hasDerivedDataFile() && loadPolicy() == TooBigToLoad)
+            return WaveData::intValue(t) == 1 ? 1 : 0;
         if (loadPolicy() == LoadAllData)
         {
             for (int i=0; i<mTriggerCount; i++)
@@ -842,12 +871,23 @@ namespace hal {
         return 0;
     }
 
+    bool WaveDataTrigger::writeDerivedSaleae()
+    {
+        // filter is merged as additional input following trigger inputs
+        QList<WaveData*> inputs = children();
+        if (mFilterWave) inputs.append(mFilterWave);
+        SaleaeTriggerEvaluator eval(std::vector<int>(mToValue, mToValue + mTriggerCount), mFilterWave ? mTriggerCount : -1);
+        return mergeDerivedSaleae(inputs, eval);
+    }
+
     void WaveDataTrigger::recalcData()
     {
         mData.clear();
         switch (loadPolicy())
         {
         case TooBigToLoad:
+            // inputs cannot be loaded, input files get merged by loader thread
+            requestDerivedSaleae();
             return;
         case LoadTimeframe:
             for (int i=0; i<mTriggerCount; i++)
@@ -915,7 +955,20 @@ namespace hal {
             while (it != mData.constBegin() && it.key()>=t) --it;
             return it.key()>=t ? t : it.key();
         }
-        //TODO : from file
+        if (!hasDerivedDataFile()) return t;
+        SaleaeMappedFile smf(mWaveDataList->saleaeDirectory().get_datafile_path(fileIndex()));
+        if (!smf.good()) return t;
+
+        // triggers are stored as pulses, skip falling edges
+        u64 tfloor = (u64) floor(t);
+        if (next)
+        {
+            for (u64 pos = smf.successorPosition(tfloor, true); pos < smf.numberValues(); ++pos)
+                if (smf.valueAt(pos).mValue == 1) return smf.valueAt(pos).mTime;
+            return t;
+        }
+        for (u64 pos = smf.successorPosition(tfloor < t ? tfloor + 1 : tfloor); pos > 0; --pos)
+            if (smf.valueAt(pos-1).mValue == 1) return smf.valueAt(pos-1).mTime;
         return t;
     }
 
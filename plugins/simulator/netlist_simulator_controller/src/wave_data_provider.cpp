@@ -53,100 +53,72 @@ namespace hal {
     }
 
     //-----------------------------------------------------
-    WaveDataProviderFile::~WaveDataProviderFile()
-    {
-        if (mBuffer) delete mBuffer;
-    }
-
     SaleaeDataTuple WaveDataProviderFile::startValue(u64 t)
     {
         mDataMap.clear();
         mStoreData = mTimeframe.hasUserTimeframe() ? Recording : Off;
 
-        SaleaeDataTuple lastval;
         SaleaeDataTuple retval;
-        if (!mInputFile.good())
+        if (!mInputFile.good() || !mInputFile.numberValues())
             return retval;
 
-        bool skipData = true;
-
-        int loadCycle = 0;
+        // seek by index instead of reading all data preceding t, when recording
+        // start at user timeframe since data points in [sceneMinTime,t) need to be stored
+        u64 tSeek = (isRecording() && mTimeframe.sceneMinTime() < t) ? mTimeframe.sceneMinTime() : t;
+        int64_t pos = mInputFile.positionAt(tSeek);
+        mIndex = pos < 0 ? 0 : pos;
 
-        while (skipData && mInputFile.good())
+        while (mIndex < mInputFile.numberValues() && mInputFile.valueAt(mIndex).mTime < t)
         {
-            if (mBuffer) delete mBuffer;
-            mBuffer = mInputFile.get_buffered_data(NetlistSimulatorControllerPlugin::sSimulationSettings->maxSizeLoadable());
-            mIndex = 0;
-            ++loadCycle;
-            if (!mBuffer) return SaleaeDataTuple();
-
-            while (mIndex < mBuffer->mCount && mBuffer->mTimeArray[mIndex] < t)
-            {
-                if (isRecording()) storeCurrentDatapoint();
-                lastval.mTime = mBuffer->mTimeArray[mIndex];
-                lastval.mValue = mBuffer->mValueArray[mIndex];
-                ++mIndex;
-            }
-
-            skipData = (mBuffer->mTimeArray[mIndex] < t);
+            if (isRecording()) storeCurrentDatapoint();
+            retval = mInputFile.valueAt(mIndex);
+            ++mIndex;
         }
 
-        if (mIndex < mBuffer->mCount && mBuffer->mTimeArray[mIndex] == t)
+        if (mIndex < mInputFile.numberValues() && mInputFile.valueAt(mIndex).mTime == t)
         {
             //exact hit
-            retval.mTime = mBuffer->mTimeArray[mIndex];
-            retval.mValue = mBuffer->mValueArray[mIndex];
+            retval = mInputFile.valueAt(mIndex);
             if (isRecording()) storeCurrentDatapoint();
             ++mIndex;
         }
-        else if (mIndex || loadCycle > 1)
-        {
-            //value of last data point before entering t-range
-            retval = lastval;
-        }
-        else if (mIndex < mBuffer->mCount)
+        else if (!mIndex)
         {
             //no previous data but not empty
             retval.mTime = t;
             retval.mValue = -1;
         }
+        // else: value of last data point before entering t-range
         return retval;
-
     }
 
     void WaveDataProviderFile::storeCurrentDatapoint()
     {
-        if (mBuffer->mTimeArray[mIndex] < mTimeframe.sceneMinTime())
-            mDataMap[mTimeframe.sceneMinTime()] = mBuffer->mValueArray[mIndex];
-        else if (mBuffer->mTimeArray[mIndex] > mTimeframe.sceneMaxTime())
+        SaleaeDataTuple sdt = mInputFile.valueAt(mIndex);
+        if (sdt.mTime < mTimeframe.sceneMinTime())
+            mDataMap[mTimeframe.sceneMinTime()] = sdt.mValue;
+        else if (sdt.mTime > mTimeframe.sceneMaxTime())
             mStoreData = Complete;
         else
         {
-            mDataMap[mBuffer->mTimeArray[mIndex]] = mBuffer->mValueArray[mIndex];
+            mDataMap[sdt.mTime] = sdt.mValue;
             if (mDataMap.size() > NetlistSimulatorControllerPlugin::sSimulationSettings->maxSizeLoadable())
             {
                 mStoreData = Failed;
                 mDataMap.clear();
             }
-            else if (mIndex >= mBuffer->mCount-1 || mBuffer->mTimeArray[mIndex] == mTimeframe.sceneMaxTime())
+            else if (mIndex >= mInputFile.numberValues()-1 || sdt.mTime == mTimeframe.sceneMaxTime())
                 mStoreData = Complete;
         }
     }
 
     SaleaeDataTuple WaveDataProviderFile::nextPoint()
     {
+        if (mIndex >= mInputFile.numberValues()) return SaleaeDataTuple();
+
         if (isRecording()) storeCurrentDatapoint();
 
-        if (mIndex >= mBuffer->mCount)
-        {
-            if (!mInputFile.good()) return SaleaeDataTuple();
-            if (mBuffer) delete mBuffer;
-            mBuffer = mInputFile.get_buffered_data(NetlistSimulatorControllerPlugin::sSimulationSettings->maxSizeLoadable());
-            mIndex = 0;
-            if (!mBuffer) return SaleaeDataTuple();
-       }
-
-        SaleaeDataTuple retval(mBuffer->mTimeArray[mIndex],mBuffer->mValueArray[mIndex]);
+        SaleaeDataTuple retval = mInputFile.valueAt(mIndex);
         ++mIndex;
         return retval;
     }
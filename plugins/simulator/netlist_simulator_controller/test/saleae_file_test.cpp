@@ -0,0 +1,431 @@
+#include "netlist_simulator_controller/saleae_file.h"
+#include "netlist_simulator_controller/saleae_mapped_file.h"
+
+#include "netlist_test_utils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace hal
+{
+    class SaleaeFileTest : public ::testing::Test
+    {
+    protected:
+        virtual void SetUp()
+        {
+            NO_COUT_BLOCK;
+            test_utils::init_log_channels();
+            test_utils::create_sandbox_directory();
+        }
+
+        virtual void TearDown()
+        {
+            test_utils::remove_sandbox_directory();
+        }
+
+        /// Random transitions with time deltas of up to 'max_delta' and values in range -2..1 (value changes on every transition).
+        static void random_transitions(std::mt19937_64& rng, u64 count, u64 max_delta, u64 t0, std::vector<u64>& times, std::vector<int>& values)
+        {
+            std::uniform_int_distribution<u64> delta_dist(1, max_delta);
+            std::uniform_int_distribution<int> value_dist(-2, 1);
+            u64 t = t0;
+            for (u64 i = 0; i < count; i++)
+            {
+                int val;
+                do
+                {
+                    val = value_dist(rng);
+                } while (!values.empty() && val == values.back());
+                times.push_back(t);
+                values.push_back(val);
+                t += delta_dist(rng);
+            }
+        }
+
+        /// Clock-like transitions with constant period, alternating between 0 and 1.
+        static void clock_transitions(u64 count, u64 period, u64 t0, std::vector<u64>& times, std::vector<int>& values)
+        {
+            int val = values.empty() ? 0 : 1 - std::max(0, values.back());
+            for (u64 i = 0; i < count; i++)
+            {
+                times.push_back(t0 + i * period);
+                values.push_back(val);
+                val = 1 - val;
+            }
+        }
+
+        /// Encode block, decode the result and compare with the original transitions.
+        static void check_block_round_trip(const SaleaeCompressedBlock& block)
+        {
+            std::string buf;
+            block.encode(buf);
+            ASSERT_GE(buf.size(), SaleaeCompressedBlock::sHeaderSize);
+            EXPECT_EQ(SaleaeCompressedBlock::blockSize(buf.data()), buf.size());
+
+            SaleaeCompressedBlock decoded;
+            ASSERT_TRUE(decoded.decode(buf.data(), buf.size()));
+            EXPECT_EQ(decoded.mTimes, block.mTimes);
+            EXPECT_EQ(decoded.mValues, block.mValues);
+        }
+    };
+
+    /**
+     * Testing encoding and decoding of blocks filled with random transitions, including full blocks with large time deltas.
+     *
+     * Functions: SaleaeCompressedBlock::encode, SaleaeCompressedBlock::decode, SaleaeCompressedBlock::blockSize
+     */
+    TEST_F(SaleaeFileTest, check_block_random)
+    {
+        TEST_START
+        {
+            std::mt19937_64 rng(0x5a1eae);
+            for (u64 count : std::vector<u64>{2, 3, 100, SaleaeCompressedBlock::sBlockSize})
+            {
+                for (u64 max_delta : std::vector<u64>{1, 1000, 1ull << 40})
+                {
+                    SaleaeCompressedBlock block;
+                    random_transitions(rng, count, max_delta, 12345, block.mTimes, block.mValues);
+                    check_block_round_trip(block);
+                }
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing encoding and decoding of clock-like blocks, which are stored as run tokens, as well as clock runs interrupted
+     * by random transitions and runs too short to be run-length encoded.
+     *
+     * Functions: SaleaeCompressedBlock::encode, SaleaeCompressedBlock::decode
+     */
+    TEST_F(SaleaeFileTest, check_block_clock)
+    {
+        TEST_START
+        {
+            {
+                // pure clock: single run token after the first two transitions
+                SaleaeCompressedBlock block;
+                clock_transitions(SaleaeCompressedBlock::sBlockSize, 10, 0, block.mTimes, block.mValues);
+                std::string buf;
+                block.encode(buf);
+                EXPECT_LT(buf.size(), SaleaeCompressedBlock::sHeaderSize + 16);
+                check_block_round_trip(block);
+            }
+            {
+                // clock runs of various lengths separated by random transitions
+                std::mt19937_64 rng(42);
+                SaleaeCompressedBlock block;
+                clock_transitions(2, 5, 0, block.mTimes, block.mValues);
+                for (u64 run : std::vector<u64>{1, 3, 4, 5, 17, 200})
+                {
+                    random_transitions(rng, 3, 50, block.mTimes.back() + 7, block.mTimes, block.mValues);
+                    clock_transitions(run, 5, block.mTimes.back() + 5, block.mTimes, block.mValues);
+                }
+                check_block_round_trip(block);
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing blocks holding a single transition, which have an empty payload, as well as empty and corrupt blocks.
+     *
+     * Functions: SaleaeCompressedBlock::encode, SaleaeCompressedBlock::decode
+     */
+    TEST_F(SaleaeFileTest, check_block_single_and_corrupt)
+    {
+        TEST_START
+        {
+            {
+                SaleaeCompressedBlock block;
+                block.mTimes.push_back(987654321);
+                block.mValues.push_back(-1);
+                std::string buf;
+                block.encode(buf);
+                EXPECT_EQ(buf.size(), SaleaeCompressedBlock::sHeaderSize);
+                check_block_round_trip(block);
+            }
+            {
+                // empty block is not encoded at all
+                SaleaeCompressedBlock block;
+                std::string buf;
+                block.encode(buf);
+                EXPECT_TRUE(buf.empty());
+            }
+            {
+                std::mt19937_64 rng(7);
+                SaleaeCompressedBlock block;
+                random_transitions(rng, 50, 100, 0, block.mTimes, block.mValues);
+                std::string buf;
+                block.encode(buf);
+
+                SaleaeCompressedBlock decoded;
+                EXPECT_FALSE(decoded.decode(buf.data(), SaleaeCompressedBlock::sHeaderSize - 1));
+                EXPECT_FALSE(decoded.decode(buf.data(), buf.size() - 1));
+
+                // payload ends in the middle of the last transition
+                std::string truncated = buf;
+                u64 payload = buf.size() - SaleaeCompressedBlock::sHeaderSize - 1;
+                memcpy(&truncated[16], &payload, sizeof(payload));
+                truncated.pop_back();
+                EXPECT_FALSE(decoded.decode(truncated.data(), truncated.size()));
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing the block index stored in front of the trailer for a buffer holding several blocks.
+     *
+     * Functions: SaleaeCompressedBlock::parseIndex
+     */
+    TEST_F(SaleaeFileTest, check_block_index)
+    {
+        TEST_START
+        {
+            std::mt19937_64 rng(1);
+            std::string buf;
+            std::vector<SaleaeCompressedBlock> blocks(5);
+            std::vector<SaleaeCompressedBlock::IndexEntry> index;
+            u64 t = 100;
+            for (SaleaeCompressedBlock& block : blocks)
+            {
+                random_transitions(rng, 1 + rng() % 300, 20, t, block.mTimes, block.mValues);
+                t = block.mTimes.back() + 1;
+                index.push_back({block.mTimes.front(), buf.size()});
+                block.encode(buf);
+            }
+            u64 data_size = buf.size();
+            u64 nblocks   = index.size();
+            buf.append((const char*)index.data(), nblocks * sizeof(SaleaeCompressedBlock::IndexEntry));
+            buf.append((const char*)&nblocks, sizeof(nblocks));
+            buf.append(SaleaeCompressedBlock::sTrailerIdent, 8);
+
+            std::vector<SaleaeCompressedBlock::IndexEntry> parsed;
+            EXPECT_EQ(SaleaeCompressedBlock::parseIndex(buf.data() + buf.size(), buf.size(), parsed), buf.size() - data_size);
+            ASSERT_EQ(parsed.size(), blocks.size());
+            for (u64 i = 0; i < blocks.size(); i++)
+            {
+                EXPECT_EQ(parsed.at(i).mFirstTime, index.at(i).mFirstTime);
+                EXPECT_EQ(parsed.at(i).mOffset, index.at(i).mOffset);
+
+                // every block can be decoded by its index entry alone
+                SaleaeCompressedBlock decoded;
+                ASSERT_TRUE(decoded.decode(buf.data() + parsed.at(i).mOffset, data_size - parsed.at(i).mOffset));
+                EXPECT_EQ(decoded.mTimes, blocks.at(i).mTimes);
+                EXPECT_EQ(decoded.mValues, blocks.at(i).mValues);
+            }
+
+            // index larger than the available data or missing identifier
+            EXPECT_EQ(SaleaeCompressedBlock::parseIndex(buf.data() + buf.size(), SaleaeCompressedBlock::sTrailerSize + sizeof(SaleaeCompressedBlock::IndexEntry), parsed), 0u);
+            EXPECT_EQ(SaleaeCompressedBlock::parseIndex(buf.data() + buf.size(), SaleaeCompressedBlock::sTrailerSize - 1, parsed), 0u);
+            buf.back() = 'x';
+            EXPECT_EQ(SaleaeCompressedBlock::parseIndex(buf.data() + buf.size(), buf.size(), parsed), 0u);
+            EXPECT_TRUE(parsed.empty());
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing a compressed file spanning several blocks written by SaleaeOutputFile. The content is read back sequentially,
+     * by random access through the block index and by time lookup.
+     *
+     * Functions: SaleaeOutputFile::writeTimeValue, SaleaeInputFile::get_next_value, SaleaeInputFile::set_file_position,
+     *            SaleaeInputFile::get_buffered_data, SaleaeInputFile::get_int_value
+     */
+    TEST_F(SaleaeFileTest, check_compressed_file)
+    {
+        TEST_START
+        {
+            std::mt19937_64 rng(2024);
+            std::vector<u64> times;
+            std::vector<int> values;
+            random_transitions(rng, SaleaeCompressedBlock::sBlockSize + 100, 1000, 50, times, values);
+            clock_transitions(SaleaeCompressedBlock::sBlockSize + 7, 10, times.back() + 10, times, values);
+            random_transitions(rng, SaleaeCompressedBlock::sBlockSize / 2, 1ull << 30, times.back() + 3, times, values);
+            u64 num_transitions = times.size() - 1;
+            u64 num_blocks      = (num_transitions + SaleaeCompressedBlock::sBlockSize - 1) / SaleaeCompressedBlock::sBlockSize;
+            ASSERT_GT(num_blocks, 2u);
+
+            std::string filename = test_utils::create_sandbox_path("digital_0.bin").string();
+            {
+                SaleaeOutputFile sof(filename, 0, true);
+                for (u64 i = 0; i < times.size(); i++)
+                {
+                    sof.writeTimeValue(times.at(i), values.at(i));
+                }
+                sof.close();
+            }
+
+            {
+                SaleaeInputFile sif(filename);
+                ASSERT_TRUE(sif.good());
+                EXPECT_TRUE(sif.header()->storageFormat() == SaleaeHeader::Compressed);
+                EXPECT_EQ(sif.header()->numTransitions(), num_transitions);
+                EXPECT_EQ(sif.header()->beginTime(), times.front());
+                EXPECT_EQ(sif.header()->endTime(), times.back());
+                EXPECT_EQ(sif.header()->value(), values.front());
+
+                // sequential read
+                for (u64 i = 0; i < times.size(); i++)
+                {
+                    SaleaeDataTuple sdt = sif.get_next_value();
+                    ASSERT_FALSE(sdt.readError());
+                    ASSERT_EQ(sdt.mTime, times.at(i));
+                    ASSERT_EQ(sdt.mValue, values.at(i));
+                }
+                EXPECT_TRUE(sif.get_next_value().readError());
+            }
+
+            {
+                // random access jumping back and forth between blocks, including first and last position of each block
+                SaleaeInputFile sif(filename);
+                std::vector<u64> positions = {times.size() - 1, 0, 1};
+                for (u64 i = 0; i < num_blocks; i++)
+                {
+                    positions.push_back(i * SaleaeCompressedBlock::sBlockSize + 1);
+                    positions.push_back(std::min((i + 1) * SaleaeCompressedBlock::sBlockSize, num_transitions));
+                }
+                std::uniform_int_distribution<u64> pos_dist(0, times.size() - 1);
+                for (u32 i = 0; i < 500; i++)
+                {
+                    positions.push_back(pos_dist(rng));
+                }
+                std::shuffle(positions.begin() + 3, positions.end(), rng);
+
+                for (u64 pos : positions)
+                {
+                    sif.set_file_position(pos);
+                    SaleaeDataTuple sdt = sif.get_next_value();
+                    ASSERT_FALSE(sdt.readError()) << "position " << pos;
+                    ASSERT_EQ(sdt.mTime, times.at(pos)) << "position " << pos;
+                    ASSERT_EQ(sdt.mValue, values.at(pos)) << "position " << pos;
+                }
+
+                // buffered read across block boundaries
+                u64 first = SaleaeCompressedBlock::sBlockSize - 10;
+                sif.set_file_position(first);
+                SaleaeDataBuffer* sdb = sif.get_buffered_data(SaleaeCompressedBlock::sBlockSize + 20);
+                ASSERT_NE(sdb, nullptr);
+                ASSERT_EQ(sdb->mCount, SaleaeCompressedBlock::sBlockSize + 20);
+                for (u64 i = 0; i < sdb->mCount; i++)
+                {
+                    ASSERT_EQ(sdb->mTimeArray[i], times.at(first + i));
+                    ASSERT_EQ(sdb->mValueArray[i], values.at(first + i));
+                }
+                delete sdb;
+            }
+
+            {
+                // value lookup by time
+                SaleaeInputFile sif(filename);
+                for (u32 i = 0; i < 300; i++)
+                {
+                    u64 pos = rng() % times.size();
+                    EXPECT_EQ(sif.get_int_value(times.at(pos)), values.at(pos)) << "position " << pos;
+                    if (pos + 1 < times.size() && times.at(pos + 1) > times.at(pos) + 1)
+                    {
+                        EXPECT_EQ(sif.get_int_value(times.at(pos) + 1), values.at(pos)) << "position " << pos;
+                    }
+                }
+                EXPECT_EQ(sif.get_int_value(times.back() + 100), values.back());
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing that files with a corrupt block index are rejected when opened instead of reading outside of the data area.
+     *
+     * Functions: SaleaeCompressedBlock::checkIndex, SaleaeInputFile::SaleaeInputFile, SaleaeMappedFile::SaleaeMappedFile
+     */
+    TEST_F(SaleaeFileTest, check_corrupt_block_index)
+    {
+        TEST_START
+        {
+            std::mt19937_64 rng(7);
+            std::vector<u64> times;
+            std::vector<int> values;
+            random_transitions(rng, 3 * SaleaeCompressedBlock::sBlockSize, 100, 10, times, values);
+            u64 num_blocks = (times.size() - 1 + SaleaeCompressedBlock::sBlockSize - 1) / SaleaeCompressedBlock::sBlockSize;
+            ASSERT_EQ(num_blocks, 3u);
+
+            std::string filename = test_utils::create_sandbox_path("digital_0.bin").string();
+            {
+                SaleaeOutputFile sof(filename, 0, true);
+                for (u64 i = 0; i < times.size(); i++)
+                {
+                    sof.writeTimeValue(times.at(i), values.at(i));
+                }
+                sof.close();
+            }
+            std::string content;
+            {
+                std::ifstream ff(filename, std::ios::binary);
+                content.assign(std::istreambuf_iterator<char>(ff), std::istreambuf_iterator<char>());
+            }
+            const u64 index_pos = content.size() - SaleaeCompressedBlock::sTrailerSize - num_blocks * sizeof(SaleaeCompressedBlock::IndexEntry);
+
+            auto check_file = [&](const std::string& data, bool expect_good) {
+                {
+                    std::ofstream ff(filename, std::ios::binary | std::ios::trunc);
+                    ff.write(data.data(), data.size());
+                }
+                {
+                    SaleaeInputFile sif(filename);
+                    EXPECT_EQ(sif.good(), expect_good);
+                }
+                {
+                    SaleaeMappedFile smf(filename);
+                    EXPECT_EQ(smf.good(), expect_good);
+                    if (expect_good)
+                    {
+                        EXPECT_EQ(smf.valueAt(times.size() - 1).mTime, times.back());
+                    }
+                }
+            };
+            auto with_offset = [&](u64 iblock, u64 offset) {
+                std::string data = content;
+                memcpy(&data[index_pos + iblock * sizeof(SaleaeCompressedBlock::IndexEntry) + 8], &offset, sizeof(offset));
+                return data;
+            };
+            auto offset_of = [&](u64 iblock) {
+                u64 offset;
+                memcpy(&offset, &content[index_pos + iblock * sizeof(SaleaeCompressedBlock::IndexEntry) + 8], sizeof(offset));
+                return offset;
+            };
+
+            check_file(content, true);
+
+            // offset far behind the end of file
+            check_file(with_offset(1, 1ull << 62), false);
+
+            // block header of last block overlapping the block index
+            check_file(with_offset(2, index_pos - SaleaeCompressedBlock::sHeaderSize + 1), false);
+
+            // offsets not increasing or blocks overlapping the header of the previous block
+            check_file(with_offset(2, offset_of(1)), false);
+            check_file(with_offset(1, offset_of(0) + 1), false);
+
+            // first block overlapping the file header
+            check_file(with_offset(0, 0), false);
+
+            // number of blocks too large for the file, index size calculation must not overflow
+            {
+                std::string data = content;
+                u64 nblocks      = (1ull << 60) + num_blocks;
+                memcpy(&data[data.size() - SaleaeCompressedBlock::sTrailerSize], &nblocks, sizeof(nblocks));
+                check_file(data, false);
+            }
+
+            // truncated file
+            check_file(content.substr(0, content.size() / 2), false);
+        }
+        TEST_END
+    }
+}    // namespace hal
@@ -0,0 +1,139 @@
+#include "netlist_simulator_controller/simulation_activity.h"
+
+#include "hal_core/netlist/module.h"
+#include "netlist_simulator_controller/saleae_file.h"
+#include "netlist_simulator_controller/saleae_writer.h"
+#include "netlist_test_utils.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hal
+{
+    class SimulationActivityTest : public ::testing::Test
+    {
+    protected:
+        virtual void SetUp()
+        {
+            NO_COUT_BLOCK;
+            test_utils::init_log_channels();
+            test_utils::create_sandbox_directory();
+        }
+
+        virtual void TearDown()
+        {
+            test_utils::remove_sandbox_directory();
+        }
+    };
+
+    /**
+     * Testing toggle counts, Hamming weight, Hamming distance, and module accounting on a small, known waveform.
+     * The netlist contains nets driven by several gates (within the same module and across modules), which must be
+     * accounted only once to each module.
+     *
+     * Functions: compute
+     */
+    TEST_F(SimulationActivityTest, check_known_waveform)
+    {
+        TEST_START
+        {
+            // module 'a' with gates a0, a1, a2 and module 'b' with gates b0, b1, both children of the top module
+            std::unique_ptr<Netlist> nl = test_utils::create_empty_netlist();
+            ASSERT_NE(nl, nullptr);
+            GateType* buf = nl->get_gate_library()->get_gate_type_by_name("BUF");
+            std::vector<Gate*> gates_a;
+            std::vector<Gate*> gates_b;
+            for (u32 i = 0; i < 3; i++)
+            {
+                gates_a.push_back(nl->create_gate(buf, "a" + std::to_string(i)));
+            }
+            for (u32 i = 0; i < 2; i++)
+            {
+                gates_b.push_back(nl->create_gate(buf, "b" + std::to_string(i)));
+            }
+            Module* top = nl->get_top_module();
+            Module* mod_a = nl->create_module("a", top, gates_a);
+            Module* mod_b = nl->create_module("b", top, gates_b);
+            ASSERT_NE(mod_a, nullptr);
+            ASSERT_NE(mod_b, nullptr);
+
+            // driven by two gates of module 'a'
+            Net* wired_a = nl->create_net("wired_a");
+            wired_a->add_source(gates_a.at(0), "O");
+            wired_a->add_source(gates_a.at(1), "O");
+
+            // driven by one gate of module 'a' and one gate of module 'b'
+            Net* wired_ab = nl->create_net("wired_ab");
+            wired_ab->add_source(gates_a.at(2), "O");
+            wired_ab->add_source(gates_b.at(0), "O");
+
+            Net* single_b = nl->create_net("single_b");
+            single_b->add_source(gates_b.at(1), "O");
+
+            // clock period 10, cycle c covers [10c, 10c+10), analyzed interval [0, 100)
+            std::vector<std::pair<u64, int>> wave_wired_a  = {{0, 0}, {15, 1}, {25, 0}, {27, 1}, {45, 0}};
+            std::vector<std::pair<u64, int>> wave_wired_ab = {{0, 1}, {30, 0}, {31, -1}, {50, 1}};
+            std::vector<std::pair<u64, int>> wave_single_b;
+            for (u64 t = 0; t <= 100; t += 10)
+            {
+                wave_single_b.push_back({t, (t / 10) % 2});
+            }
+            // waveform of a net which is not part of the netlist
+            std::vector<std::pair<u64, int>> wave_orphan = {{0, 0}, {55, 1}};
+            const u32 orphan_id                          = 9999;
+
+            std::string saleae_file = (test_utils::create_sandbox_path("saleae") / "saleae.json").string();
+            {
+                SaleaeWriter writer(saleae_file);
+                auto write_wave = [&writer](const std::string& name, u32 id, const std::vector<std::pair<u64, int>>& wave) {
+                    SaleaeOutputFile* sof = writer.add_or_replace_waveform(name, id);
+                    ASSERT_NE(sof, nullptr);
+                    for (const auto& [t, val] : wave)
+                    {
+                        sof->writeTimeValue(t, val);
+                    }
+                };
+                write_wave(wired_a->get_name(), wired_a->get_id(), wave_wired_a);
+                write_wave(wired_ab->get_name(), wired_ab->get_id(), wave_wired_ab);
+                write_wave(single_b->get_name(), single_b->get_id(), wave_single_b);
+                write_wave("orphan", orphan_id, wave_orphan);
+            }
+
+            for (u32 num_threads : {1, 3})
+            {
+                SimulationActivity activity(10, 0, 100);
+                ASSERT_TRUE(activity.compute(saleae_file, nl.get(), num_threads));
+                EXPECT_EQ(activity.get_number_cycles(), 10u);
+
+                // toggles between defined values only, transition at time 100 is outside of analyzed interval
+                std::map<u32, u64> toggles;
+                for (u32 i = 0; i < activity.get_net_ids().size(); i++)
+                {
+                    toggles[activity.get_net_ids().at(i)] = activity.get_toggle_counts().at(i);
+                }
+                EXPECT_EQ(toggles, (std::map<u32, u64>{{wired_a->get_id(), 4}, {wired_ab->get_id(), 1}, {single_b->get_id(), 9}, {orphan_id, 1}}));
+
+                EXPECT_EQ(activity.get_hamming_weights(), (std::vector<u32>{1, 2, 2, 2, 1, 2, 2, 3, 2, 3}));
+                EXPECT_EQ(activity.get_hamming_distances(), (std::vector<u32>{0, 1, 2, 2, 1, 2, 2, 1, 1, 1}));
+                EXPECT_EQ(activity.get_cycle_toggles(), (std::vector<u32>{0, 2, 3, 2, 2, 2, 1, 1, 1, 1}));
+
+                // every net is accounted once to each module containing one of its sources
+                std::map<u32, u64> module_toggles;
+                for (u32 i = 0; i < activity.get_module_ids().size(); i++)
+                {
+                    module_toggles[activity.get_module_ids().at(i)] = activity.get_module_toggles().at(i);
+                }
+                EXPECT_EQ(module_toggles, (std::map<u32, u64>{{top->get_id(), 4 + 1 + 9}, {mod_a->get_id(), 4 + 1}, {mod_b->get_id(), 1 + 9}}));
+            }
+
+            // no module accounting without netlist
+            SimulationActivity activity(10, 0, 100);
+            ASSERT_TRUE(activity.compute(saleae_file));
+            EXPECT_TRUE(activity.get_module_ids().empty());
+            EXPECT_TRUE(activity.get_module_toggles().empty());
+        }
+        TEST_END
+    }
+}    // namespace hal
@@ -80,7 +80,8 @@ namespace hal
                                                  "}\n"
                                                  "\n"
                                                  "int main(int argc, char **argv, char **env) {\n"
-                                                 "  hal::SaleaeParser sp(\"saleae/saleae.json\");\n"
+                                                 "  // stimulus and result file given at runtime, compiled model can be reused for other stimulus\n"
+                                                 "  hal::SaleaeParser sp(argc > 1 ? argv[1] : \"saleae/saleae.json\");\n"
                                                  "\n"
                                                  "  std::unordered_map<std::string,hal::Net*> netMap;\n"
                                                  "  for (const hal::SaleaeDirectory::ListEntry& sdle : sp.get_directory().get_net_list())\n"
@@ -91,7 +92,7 @@ namespace hal
                                                  "  Verilated::traceEverOn(true);\n"
                                                  "\n"
                                                  "  dut->trace(m_trace, 1);\n"
-                                                 "  m_trace->open(\"waveform.vcd\");\n"
+                                                 "  m_trace->open(argc > 2 ? argv[2] : \"waveform.vcd\");\n"
                                                  "\n"
                                                  "//  <set_vcc>\n"
                                                  "//  <set_gnd>\n"
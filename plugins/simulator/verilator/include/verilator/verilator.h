@@ -164,8 +164,22 @@ namespace hal
             bool finalize() override;
 
         private:
-            bool write_testbench_files(SimulationInput* simInput);
-            int m_num_of_threads = 4;
+            std::string generate_testbench_cpp(SimulationInput* simInput) const;
+            bool write_testbench_files(const std::string& testbench_cpp);
+
+            /**
+             * Hash over everything the compiled model depends on: netlist, testbench port binding, gate library,
+             * provided models and verilator options. Stimulus is read at runtime and does not contribute.
+             */
+            std::string compute_build_hash(const std::filesystem::path& netlist_verilog, const std::string& testbench_cpp, const std::filesystem::path& provided_models) const;
+            bool restore_cached_build();
+            void store_cached_build() const;
+
+            int m_num_of_threads       = 4;
+            int m_verilator_threads    = 0;
+            bool m_cached_build        = false;
+            std::filesystem::path m_build_cache_dir;
+            std::string m_build_hash;
             std::string m_compiler;
         };
 
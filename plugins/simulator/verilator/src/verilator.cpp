@@ -3,6 +3,7 @@
 
 #include "hal_core/netlist/boolean_function.h"
 #include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/gate_library/gate_library.h"
 #include "hal_core/netlist/gate_library/gate_type.h"
 #include "hal_core/netlist/gate_library/gate_type_component/init_component.h"
 #include "hal_core/netlist/net.h"
@@ -12,12 +13,14 @@
 #include "hal_core/plugin_system/plugin_manager.h"
 #include "hal_core/utilities/log.h"
 #include "hal_core/utilities/utils.h"
+#include "hal_version.h"
 #include "netlist_simulator_controller/simulation_input.h"
 #include "verilator/templates.h"
 
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -117,8 +120,40 @@ namespace hal
                 m_num_of_threads = std::stoi(get_engine_property("num_of_threads"));
             }
 
+            if (!get_engine_property("verilator_threads").empty())
+            {
+                m_verilator_threads = std::stoi(get_engine_property("verilator_threads"));
+            }
+
+            // compiled models are cached across simulation runs unless 'build_cache' is set to 'none'
+            std::string build_cache = get_engine_property("build_cache");
+            if (build_cache == "none")
+            {
+                m_build_cache_dir.clear();
+            }
+            else
+            {
+                m_build_cache_dir = build_cache.empty() ? utils::get_user_share_directory() / "verilator_cache" : std::filesystem::path(build_cache);
+            }
+
+            netlist_writer_manager::write(m_partial_netlist.get(), netlist_verilog);
+
+            std::string testbench_cpp = generate_testbench_cpp(simInput);
+
+            m_cached_build = false;
+            m_build_hash.clear();
+            if (!m_build_cache_dir.empty())
+            {
+                m_build_hash = compute_build_hash(netlist_verilog, testbench_cpp, provided_models);
+                if (restore_cached_build())
+                {
+                    log_info("verilator", "reusing compiled model '{}' from build cache.", m_build_hash);
+                    return true;
+                }
+            }
+
             // prepare folder
-            if (!write_testbench_files(simInput))
+            if (!write_testbench_files(testbench_cpp))
             {
                 log_error("verilator", "error, testbench files for verilog could not be written");
             }
@@ -129,21 +164,11 @@ namespace hal
                 return false;
             };
 
-            netlist_writer_manager::write(m_partial_netlist.get(), netlist_verilog);
-
             return true;    // everything ok
         }
 
-        bool VerilatorEngine::write_testbench_files(SimulationInput* simInput)
+        std::string VerilatorEngine::generate_testbench_cpp(SimulationInput* simInput) const
         {
-            // write necessary parser files
-            if (!install_saleae_parser(m_simulator_dir.string()))
-            {
-                log_error("verilator", "could not install saleae parser in directory '{}'.", m_simulator_dir.string());
-                return false;
-            }
-
-            // write / copy saleae binaries
             std::string testbench_cpp = get_testbench_cpp_template();
             testbench_cpp             = utils::replace(testbench_cpp, std::string("<design_name>"), m_partial_netlist->get_design_name());
 
@@ -170,7 +195,17 @@ namespace hal
                 callbacks << callback.str() << std::endl;
             }
 
-            testbench_cpp = utils::replace(testbench_cpp, std::string("<set_callbacks>"), callbacks.str());
+            return utils::replace(testbench_cpp, std::string("<set_callbacks>"), callbacks.str());
+        }
+
+        bool VerilatorEngine::write_testbench_files(const std::string& testbench_cpp)
+        {
+            // write necessary parser files
+            if (!install_saleae_parser(m_simulator_dir.string()))
+            {
+                log_error("verilator", "could not install saleae parser in directory '{}'.", m_simulator_dir.string());
+                return false;
+            }
 
             std::ofstream testbench_cpp_file(m_simulator_dir / "testbench.cpp");
             testbench_cpp_file << testbench_cpp;
@@ -179,13 +214,130 @@ namespace hal
             return true;
         }
 
+        std::string VerilatorEngine::compute_build_hash(const std::filesystem::path& netlist_verilog, const std::string& testbench_cpp, const std::filesystem::path& provided_models) const
+        {
+            u64 hash       = utils::FNV1A_OFFSET_BASIS;
+            auto hash_data = [&hash](const char* data, size_t len) { hash = utils::fnv1a_hash(hash, data, len); };
+            auto hash_string = [&hash_data](const std::string& str) { hash_data(str.c_str(), str.size() + 1); };
+            auto hash_file   = [&hash_data, &hash_string](const std::filesystem::path& path) {
+                hash_string(path.filename().string());
+                std::ifstream ff(path, std::ios::binary);
+                char buf[65536];
+                while (ff.read(buf, sizeof(buf)) || ff.gcount() > 0)
+                {
+                    hash_data(buf, ff.gcount());
+                }
+            };
+
+            hash_file(netlist_verilog);
+            hash_string(testbench_cpp);
+
+            // the saleae parser compiled into the model as well as the writer of netlist and gate models ship with HAL
+            hash_string(get_saleae_parser_sources());
+            hash_string(hal_version::version);
+            hash_string(hal_version::git_hash);
+            if (hal_version::is_dirty)
+            {
+                hash_string(hal_version::build_timestamp);
+            }
+
+            const GateLibrary* gl = m_partial_netlist->get_gate_library();
+            hash_string(gl->get_name());
+            if (std::filesystem::is_regular_file(gl->get_path()))
+            {
+                hash_file(gl->get_path());
+            }
+
+            if (!provided_models.empty() && std::filesystem::is_directory(provided_models))
+            {
+                std::vector<std::filesystem::path> models;
+                for (const auto& entry : std::filesystem::directory_iterator(provided_models))
+                {
+                    if (entry.is_regular_file())
+                    {
+                        models.push_back(entry.path());
+                    }
+                }
+                std::sort(models.begin(), models.end());
+                for (const auto& model : models)
+                {
+                    hash_file(model);
+                }
+            }
+
+            // verilator options
+            for (const std::string& arg : commandLine(0))
+            {
+                hash_string(arg);
+            }
+
+            std::stringstream retval;
+            retval << std::hex << std::setw(16) << std::setfill('0') << hash;
+            return retval.str();
+        }
+
+        bool VerilatorEngine::restore_cached_build()
+        {
+            std::filesystem::path cached_model = m_build_cache_dir / m_build_hash / ("V" + m_design_name);
+            if (!std::filesystem::is_regular_file(cached_model))
+            {
+                return false;
+            }
+
+            std::error_code ec;
+            std::filesystem::create_directories(m_simulator_dir / "obj_dir", ec);
+            std::filesystem::copy_file(cached_model, m_simulator_dir / "obj_dir" / ("V" + m_design_name), std::filesystem::copy_options::overwrite_existing, ec);
+            if (ec)
+            {
+                log_warning("verilator", "cannot copy cached model '{}': {}", cached_model.string(), ec.message());
+                return false;
+            }
+
+            m_cached_build = true;
+            return true;
+        }
+
+        void VerilatorEngine::store_cached_build() const
+        {
+            std::filesystem::path model = m_simulator_dir / "obj_dir" / ("V" + m_design_name);
+            if (!std::filesystem::is_regular_file(model))
+            {
+                // model might have been built on remote host
+                return;
+            }
+
+            // copy to temporary name first, concurrent simulations must not pick up incomplete model
+            std::error_code ec;
+            std::filesystem::path cache_entry = m_build_cache_dir / m_build_hash;
+            std::filesystem::path cached_tmp  = cache_entry / ("V" + m_design_name + ".tmp");
+            std::filesystem::create_directories(cache_entry, ec);
+            if (!ec)
+            {
+                std::filesystem::copy_file(model, cached_tmp, std::filesystem::copy_options::overwrite_existing, ec);
+            }
+            if (!ec)
+            {
+                std::filesystem::rename(cached_tmp, cache_entry / ("V" + m_design_name), ec);
+            }
+            if (ec)
+            {
+                log_warning("verilator", "cannot store compiled model in build cache '{}': {}", cache_entry.string(), ec.message());
+            }
+        }
+
         int VerilatorEngine::numberCommandLines() const
         {
-            return s_command_lines;
+            // cached model only needs to be executed
+            return m_cached_build ? 1 : s_command_lines;
         }
 
         std::vector<std::string> VerilatorEngine::commandLine(int lineIndex) const
         {
+            if (m_cached_build)
+            {
+                lineIndex += s_command_lines - 1;
+            }
+
             // returns commands to be executed
             switch (lineIndex)
             {
@@ -196,10 +348,6 @@ namespace hal
                                                        "-Wno-fatal",
                                                        "--MMD",
                                                        "-trace",
-                                                       //    "--trace-threads",
-                                                       //    "1",
-                                                       //    "--threads",
-                                                       //    "1",
                                                        "-y",
                                                        "gate_definitions/",
                                                        "--Mdir",
@@ -227,6 +375,12 @@ namespace hal
                         retval.push_back(m_compiler);
                     }
 
+                    if (m_verilator_threads > 0)
+                    {
+                        retval.push_back("--threads");
+                        retval.push_back(std::to_string(m_verilator_threads));
+                    }
+
                     return retval;
                     break;
                 }
@@ -235,7 +389,7 @@ namespace hal
                     break;
                 }
                 case 2: {
-                    return {"obj_dir/V" + m_design_name};
+                    return {"obj_dir/V" + m_design_name, "saleae/saleae.json", "waveform.vcd"};
                     break;
                 }
                 default:
@@ -251,6 +405,10 @@ namespace hal
 
         bool VerilatorEngine::finalize()
         {
+            if (!m_cached_build && !m_build_hash.empty())
+            {
+                store_cached_build();
+            }
             mResultFilename = std::string(m_simulator_dir / "waveform.vcd");
             mState          = Done;
             return true;
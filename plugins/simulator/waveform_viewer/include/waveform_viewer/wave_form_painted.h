@@ -42,6 +42,7 @@ namespace hal {
     class WaveScrollbar;
     class WaveTransform;
     class WaveDataProvider;
+    class SaleaeSummaryPyramid;
 
     class TimeInterval
     {
@@ -72,6 +73,7 @@ namespace hal {
         void paint(int y0, QPainter& painter);
 
         void generate(WaveDataProvider* wdp, const WaveTransform* trans, const WaveScrollbar* sbar, bool* loop);
+        void generateSummary(const SaleaeSummaryPyramid* pyramid, int level, const WaveTransform* trans, const WaveScrollbar* sbar, bool* loop);
         void generateTrigger(WaveDataProvider* wdp, const WaveTransform* trans, const WaveScrollbar* sbar, bool* loop);
         bool generateGroup(const WaveData* wd, const WaveItemHash *hash);
         bool generateBoolean(const WaveData* wd, const WaveDataList* wdList, const WaveItemHash *hash);
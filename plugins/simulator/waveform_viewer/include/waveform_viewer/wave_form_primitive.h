@@ -82,6 +82,7 @@ namespace hal {
         double mAccumTime[2];
     public:
         WaveFormPrimitiveFilled(float x0, float x1, int val);
+        WaveFormPrimitiveFilled(float x0, float x1, double accumLow, double accumHigh);
         void paint(int y0, QPainter& painter);
         void add(const WaveFormPrimitiveFilled& other);
         int value() const { return WaveGroupValue::sTooManyTransitions; }
@@ -117,6 +117,7 @@ namespace hal {
         void dump(QTextStream& xout) const;
         bool hasLoader() const { return mLoader != nullptr; }
         void loadSaleae();
+        bool writeDerivedSaleae();
         State state() const { return mState; }
 
    //     int waveIndex() const { return mWaveIndex; }
@@ -2,6 +2,7 @@
 #include "netlist_simulator_controller/wave_data.h"
 #include "netlist_simulator_controller/wave_group_value.h"
 #include "netlist_simulator_controller/wave_data_provider.h"
+#include "netlist_simulator_controller/saleae_summary_pyramid.h"
 #include "waveform_viewer/wave_item.h"
 #include "waveform_viewer/wave_form_primitive.h"
 #include "waveform_viewer/wave_transform.h"
@@ -306,6 +307,89 @@ namespace hal {
         }
     }
 
+    void WaveFormPainted::generateSummary(const SaleaeSummaryPyramid* pyramid, int level, const WaveTransform* trans, const WaveScrollbar* sbar, bool* loop)
+    {
+        mValidity = WaveZoomShift(trans, sbar);
+        *loop = true;
+
+        quint64 tleft = sbar->tLeftI();
+        bool refreshCursor = (mCursorTime >= tleft);
+        float xMax = sbar->viewportWidth();
+
+        // max time within visibible t window
+        if (sbar->xPosF(trans->tMax()) < xMax)
+            xMax = sbar->xPosF(trans->tMax());
+
+        u64 w = pyramid->bucketWidth(level);
+        u64 firstBucket = tleft / w;
+        u64 lastBucket = (u64) ceil(sbar->tPosF(ceil(xMax))) / w;
+        if (lastBucket < firstBucket) return;
+        std::vector<SaleaeSummaryBucket> buckets = pyramid->buckets(level, firstBucket, lastBucket - firstBucket + 1);
+
+        // pending run of constant value or pending area with transitions
+        float xRun = -1;
+        int valRun = SaleaeDataTuple::sReadError;
+        bool filledRun = false;
+        double accum[2] = {0, 0};
+
+        auto flushRun = [&](float xEnd) {
+            if (xRun < 0 || xEnd <= xRun) return;
+            if (filledRun)
+                mPrimitives.append(new WaveFormPrimitiveFilled(xRun,xEnd,accum[0],accum[1]));
+            else if (valRun < 0)
+                mPrimitives.append(new WaveFormPrimitiveUndefined(xRun,xEnd));
+            else
+                mPrimitives.append(new WaveFormPrimitiveHline(xRun,xEnd,valRun));
+        };
+
+        float x1 = 0;
+        for (u64 i = 0; *loop && i < buckets.size(); i++)
+        {
+            const SaleaeSummaryBucket& buck = buckets.at(i);
+            u64 t0 = (firstBucket + i) * w;
+            float x0 = t0 < tleft ? 0 : sbar->xPosF(t0);
+            x1 = sbar->xPosF(t0 + w);
+            if (x1 > xMax) x1 = xMax;
+            if (x0 >= x1) break;
+
+            if (buck.isConstant())
+            {
+                if (filledRun || xRun < 0 || valRun != buck.mStartValue)
+                {
+                    flushRun(x0);
+                    if (!filledRun && xRun >= 0 && valRun >= 0 && buck.mStartValue >= 0)
+                        mPrimitives.append(new WaveFormPrimitiveTransition(x0));
+                    xRun = x0;
+                    valRun = buck.mStartValue;
+                    filledRun = false;
+                }
+                if (refreshCursor && t0 + w > mCursorTime)
+                {
+                    mCursorValue = buck.mStartValue;
+                    refreshCursor = false;
+                }
+            }
+            else
+            {
+                if (!filledRun)
+                {
+                    flushRun(x0);
+                    xRun = x0;
+                    accum[0] = accum[1] = 0;
+                    filledRun = true;
+                }
+                double high = (x1 - x0) * buck.mHighTime / w;
+                accum[1] += high;
+                accum[0] += (x1 - x0) - high;
+                // value at cursor not known from summary
+                if (refreshCursor && t0 + w > mCursorTime)
+                    refreshCursor = false;
+            }
+        }
+        flushRun(x1);
+        *loop = false;
+    }
+
     void WaveFormPainted::generate(WaveDataProvider* wdp, const WaveTransform* trans, const WaveScrollbar* sbar, bool *loop)
     {
         if (wdp->isTrigger())
@@ -55,6 +55,13 @@ namespace hal {
             mAccumTime[val] = x1-x0;
     }
 
+    WaveFormPrimitiveFilled::WaveFormPrimitiveFilled(float x0, float x1, double accumLow, double accumHigh)
+        : WaveFormPrimitive(x0,x1)
+    {
+        mAccumTime[0] = accumLow;
+        mAccumTime[1] = accumHigh;
+    }
+
     void WaveFormPrimitiveFilled::add(const WaveFormPrimitiveFilled &other)
     {
         for (int i=0; i<2; i++)
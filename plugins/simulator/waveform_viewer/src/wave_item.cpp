@@ -256,6 +256,11 @@ namespace hal {
         mData->loadSaleae();
     }
 
+    bool WaveItem::writeDerivedSaleae()
+    {
+        return mData->writeDerivedSaleae();
+    }
+
 
     bool WaveItem::hasRequest(Request rq) const
     {
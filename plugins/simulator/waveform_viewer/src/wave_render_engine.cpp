@@ -7,6 +7,7 @@
 #include <QDir>
 #include <QPaintEvent>
 #include "netlist_simulator_controller/saleae_file.h"
+#include "netlist_simulator_controller/saleae_summary_pyramid.h"
 #include "netlist_simulator_controller/plugin_netlist_simulator_controller.h"
 #include "netlist_simulator_controller/simulation_settings.h"
 #include "netlist_simulator_controller/wave_data_provider.h"
@@ -25,6 +26,32 @@ namespace hal {
     {
         mItem->setState(WaveItem::Loading);
         const WaveData* wd = mItem->wavedata();
+        if (wd->loadPolicy() == WaveData::TooBigToLoad && !wd->hasDerivedDataFile())
+        {
+            // derived waveform requested by recalcData(), merge input files here to keep GUI thread responsive
+            mItem->writeDerivedSaleae();
+        }
+        if (wd->hasDerivedDataFile() && wd->loadPolicy() == WaveData::TooBigToLoad)
+        {
+            // derived waveform too big to load has been written to disk by merge engine
+            try {
+                std::string dataFilename = mWorkDir.absoluteFilePath(QString("digital_%1.bin").arg(wd->fileIndex())).toStdString();
+                WaveDataProviderFile wdpFile(dataFilename, mTimeframe);
+                if (!wdpFile.good())
+                {
+                    mItem->setState(WaveItem::Failed);
+                    return;
+                }
+                wdpFile.setWaveType(wd->netType(),wd->bits(),wd->valueBase());
+                mItem->mPainted.clearPrimitives();
+                if (mItem->isAborted()) return;
+                mItem->mPainted.generate(&wdpFile,mTransform,mScrollbar,&mItem->mLoop);
+                mItem->setState(WaveItem::Finished);
+            } catch (...) {
+                mItem->setState(WaveItem::Failed);
+            }
+            return;
+        }
         switch (wd->netType()) {
         case WaveData::ClockNet:
         {
@@ -146,8 +173,9 @@ namespace hal {
                 break;
             break;
        default:
-            SaleaeInputFile sif(mWorkDir.absoluteFilePath(QString("digital_%1.bin").arg(mItem->wavedata()->fileIndex())).toStdString());
-            if (sif.good())
+            std::string dataFilename = mWorkDir.absoluteFilePath(QString("digital_%1.bin").arg(mItem->wavedata()->fileIndex())).toStdString();
+            WaveDataProviderFile wdpFile(dataFilename, mTimeframe);
+            if (wdpFile.good())
             {
                 if (mItem->wavedata()->loadPolicy()==WaveData::LoadAllData)
                 {
@@ -168,9 +196,14 @@ namespace hal {
                 else
                 {
                     try {
-                        WaveDataProviderFile wdpFile(sif, mTimeframe);
                         WaveFormPainted shadowPaint(mItem->mPainted);
-                        shadowPaint.generate(&wdpFile,mTransform,mScrollbar,&mItem->mLoop);
+                        // zoomed out far enough to have many transitions per pixel: render from summary pyramid
+                        SaleaeSummaryPyramid pyramid(dataFilename);
+                        int level = pyramid.levelForScale(mTransform->scale());
+                        if (level >= 0)
+                            shadowPaint.generateSummary(&pyramid,level,mTransform,mScrollbar,&mItem->mLoop);
+                        else
+                            shadowPaint.generate(&wdpFile,mTransform,mScrollbar,&mItem->mLoop);
 
                         mItem->mMutex.lock();
                         mItem->mPainted = shadowPaint;
@@ -242,7 +275,22 @@ namespace hal {
                             try {
                                 WaveDataProvider* wdp = nullptr;
                                 std::string saleaeDirectory = mWorkDir.absoluteFilePath("saleae.json").toStdString();
-                                switch (wree->wavedata()->netType())
+                                if (wd->loadPolicy() == WaveData::TooBigToLoad && !wd->hasDerivedDataFile())
+                                    wree->writeDerivedSaleae();
+                                if (wd->hasDerivedDataFile() && wd->loadPolicy() == WaveData::TooBigToLoad)
+                                {
+                                    // derived waveform written to disk by merge engine
+                                    QString dataFilename = mWorkDir.absoluteFilePath(QString("digital_%1.bin").arg(wd->fileIndex()));
+                                    WaveDataProviderFile* wdpFile = new WaveDataProviderFile(dataFilename.toStdString(), mTimeframe);
+                                    if (wdpFile->good())
+                                    {
+                                        wdpFile->setWaveType(wd->netType(),wd->bits(),wd->valueBase());
+                                        wdp = wdpFile;
+                                    }
+                                    else
+                                        delete wdpFile;
+                                }
+                                else switch (wree->wavedata()->netType())
                                 {
                                 case WaveData::NetGroup:
                                 {
@@ -265,10 +313,21 @@ namespace hal {
                                 default:
                                 {
                                     QString dataFilename = mWorkDir.absoluteFilePath(QString("digital_%1.bin").arg(wree->wavedata()->fileIndex()));
-                                    SaleaeInputFile sif(dataFilename.toStdString());
-                                    if (sif.good()) wdp = new WaveDataProviderFile(sif, mTimeframe);
+                                    SaleaeSummaryPyramid pyramid(dataFilename.toStdString());
+                                    int level = pyramid.levelForScale(mTransform->scale());
+                                    if (level >= 0)
+                                    {
+                                        wree->mPainted.generateSummary(&pyramid,level,mTransform,mScrollbar,&wree->mLoop);
+                                        wree->setState(WaveItem::Painted);
+                                        break;
+                                    }
+                                    WaveDataProviderFile* wdpFile = new WaveDataProviderFile(dataFilename.toStdString(), mTimeframe);
+                                    if (wdpFile->good()) wdp = wdpFile;
                                     else
+                                    {
                                         qDebug() << "cannot open file" << dataFilename;
+                                        delete wdpFile;
+                                    }
                                 }
                                 }
                                 if (wdp)
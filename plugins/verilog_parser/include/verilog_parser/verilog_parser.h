@@ -31,10 +31,11 @@
 #include "hal_core/netlist/net.h"
 #include "hal_core/netlist/netlist_parser/netlist_parser.h"
 #include "hal_core/utilities/special_strings.h"
+#include "hal_core/utilities/text_scanner.h"
 #include "hal_core/utilities/token_stream.h"
 
 #include <optional>
-#include <sstream>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -61,12 +62,32 @@ namespace hal
 
         /**
          * Instantiate the parsed Verilog netlist using the specified gate library.
+         * May be called concurrently for different gate libraries.
+         * The top module is annotated with the data entries 'definition_hashes' and 'naming_hash' of category 'verilog_parser' that are required by update().
+         * They are stored along with the netlist, removing them only causes the next update to instantiate the netlist from scratch.
          *
          * @param[in] gate_library - The gate library.
          * @returns A pointer to the resulting netlist.
          */
         Result<std::unique_ptr<Netlist>> instantiate(const GateLibrary* gate_library) override;
 
+        /**
+         * Get the types of all instances within the parsed Verilog netlist that are not modules defined within the netlist.
+         *
+         * @returns The set of required gate type names.
+         */
+        std::set<std::string> get_required_gate_types() const override;
+
+        /**
+         * Update a netlist that has been instantiated from a previous version of the parsed Verilog netlist.
+         * The hashes of all module definitions annotated to the top module by instantiate() are compared to the parsed definitions, so that only module instances with changed definitions need to be rebuilt.
+         * If the changes cannot be applied exactly, e.g., because they affect the unique names of other instances, the netlist is instantiated from scratch instead.
+         *
+         * @param[in] netlist - The netlist to update, it is consumed by the update.
+         * @returns The updated netlist and a report on the differences to the previous version.
+         */
+        Result<std::pair<std::unique_ptr<Netlist>, NetlistUpdateReport>> update(std::unique_ptr<Netlist> netlist) override;
+
     private:
         using identifier_t        = std::string;
         using ranged_identifier_t = std::pair<std::string, std::vector<std::vector<u32>>>;
@@ -118,7 +139,7 @@ namespace hal
             std::vector<VerilogPortAssignment> m_port_assignments;
             std::vector<VerilogDataEntry> m_parameters;
             std::vector<VerilogDataEntry> m_attributes;
-            std::vector<std::pair<std::string, std::string>> m_expanded_port_assignments;
+            std::vector<std::pair<std::string, std::string>> m_expanded_port_assignments;    // only for module instances, gate instances depend on the gate library
         };
 
         struct VerilogModule
@@ -143,6 +164,10 @@ namespace hal
             u32 m_line_number;
             std::vector<VerilogDataEntry> m_attributes;    // module attributes
 
+            // hashes of the module definition and of the definition including all instantiated modules
+            u64 m_hash                        = 0;
+            std::optional<u64> m_subtree_hash = std::nullopt;
+
             // ports
             std::vector<std::unique_ptr<VerilogPort>> m_ports;
             std::map<std::string, VerilogPort*> m_ports_by_identifier;
@@ -162,8 +187,9 @@ namespace hal
             std::map<std::string, VerilogInstance*> m_instances_by_name;
         };
 
-        std::stringstream m_fs;
         std::filesystem::path m_path;
+        MappedTextFile m_file;
+        StringArena m_arena;
 
         // temporary netlist
         Netlist* m_netlist = nullptr;
@@ -173,8 +199,8 @@ namespace hal
         std::unordered_map<std::string, VerilogModule*> m_modules_by_name;
         std::string m_last_module;
 
-        // token stream of entire input file
-        TokenStream<std::string> m_token_stream;
+        // token stream of entire input file, tokens are views on m_file or m_arena
+        TokenStream<std::string_view> m_token_stream;
 
         // some caching
         std::unordered_map<std::string, GateType*> m_gate_types;
@@ -182,6 +208,8 @@ namespace hal
         std::unordered_map<std::string, GateType*> m_gnd_gate_types;
         std::unordered_map<Net*, std::vector<std::pair<Module*, u32>>> m_module_port_by_net;
         std::unordered_map<Module*, std::vector<std::tuple<std::string, Net*>>> m_module_ports;
+        std::vector<std::pair<Module*, VerilogModule*>> m_instantiated_modules;
+        std::unordered_map<const VerilogInstance*, std::vector<std::pair<std::string, std::string>>> m_expanded_gate_port_assignments;
 
         // unique aliases
         std::unordered_map<std::string, u32> m_module_instantiation_count;
@@ -197,32 +225,49 @@ namespace hal
         // parse HDL into intermediate format
         void tokenize();
         Result<std::monostate> parse_tokens();
-        Result<std::monostate> parse_module(std::vector<VerilogDataEntry>& attributes);
-        void parse_port_list(VerilogModule* module);
-        Result<std::monostate> parse_port_declaration_list(VerilogModule* module);
-        Result<std::monostate> parse_port_definition(VerilogModule* module, std::vector<VerilogDataEntry>& attributes);
-        Result<std::monostate> parse_signal_definition(VerilogModule* module, std::vector<VerilogDataEntry>& attributes);
-        Result<std::monostate> parse_assignment(VerilogModule* module);
-        Result<std::monostate> parse_defparam(VerilogModule* module);
-        void parse_attribute(std::vector<VerilogDataEntry>& attributes);
-        Result<std::monostate> parse_instance(VerilogModule* module, std::vector<VerilogDataEntry>& attributes);
-        Result<std::monostate> parse_port_assign(VerilogInstance* instance);
-        Result<std::vector<VerilogDataEntry>> parse_parameter_assign();
+        Result<std::unique_ptr<VerilogModule>> parse_module(TokenStream<std::string_view>& stream, std::vector<VerilogDataEntry>& attributes);
+        void parse_port_list(TokenStream<std::string_view>& stream, VerilogModule* module);
+        Result<std::monostate> parse_port_declaration_list(TokenStream<std::string_view>& stream, VerilogModule* module);
+        Result<std::monostate> parse_port_definition(TokenStream<std::string_view>& stream, VerilogModule* module, std::vector<VerilogDataEntry>& attributes);
+        Result<std::monostate> parse_signal_definition(TokenStream<std::string_view>& stream, VerilogModule* module, std::vector<VerilogDataEntry>& attributes);
+        Result<std::monostate> parse_assignment(TokenStream<std::string_view>& stream, VerilogModule* module);
+        Result<std::monostate> parse_defparam(TokenStream<std::string_view>& stream, VerilogModule* module);
+        void parse_attribute(TokenStream<std::string_view>& stream, std::vector<VerilogDataEntry>& attributes);
+        Result<std::monostate> parse_instance(TokenStream<std::string_view>& stream, VerilogModule* module, std::vector<VerilogDataEntry>& attributes);
+        Result<std::monostate> parse_port_assign(TokenStream<std::string_view>& stream, VerilogInstance* instance);
+        Result<std::vector<VerilogDataEntry>> parse_parameter_assign(TokenStream<std::string_view>& stream);
+        u64 compute_subtree_hash(VerilogModule* verilog_module, std::unordered_set<VerilogModule*>& visited);
 
         // construct netlist from intermediate format
+        void prepare_instantiation(const GateLibrary* gate_library);
+        Result<VerilogModule*> find_top_module() const;
+        Result<std::monostate> instantiate_netlist();
         Result<std::monostate> construct_netlist(VerilogModule* top_module);
+        void count_name_occurences(VerilogModule* top_module);
+        void expand_gate_port_assignments();
         Result<Module*>
             instantiate_module(const std::string& instance_name, VerilogModule* verilog_module, Module* parent, const std::unordered_map<std::string, std::string>& parent_module_assignments);
+        Result<std::unordered_map<std::string, std::string>> get_instance_assignments(const VerilogInstance* instance, const std::unordered_map<std::string, std::string>& signal_alias) const;
+        Result<std::monostate> merge_nets(const std::unordered_set<Net*>& protected_nets);
+        Result<std::monostate> add_global_constant_gates();
+        Result<std::monostate> assign_module_pins();
+        void delete_unused_nets(const std::vector<Net*>& nets);
+
+        // incremental updates
+        std::string get_naming_hash() const;
+        std::map<std::string, std::pair<u64, u64>> get_definition_hashes(const Module* top_module) const;
+        void set_definition_hashes(Module* top_module, const std::map<std::string, std::pair<u64, u64>>& hashes) const;
+        Result<std::monostate> update_netlist();
 
         // helper functions
         std::string get_unique_alias(const std::string& parent_name, const std::string& name, const std::unordered_map<std::string, u32>& name_occurences) const;
-        std::vector<u32> parse_range(TokenStream<std::string>& stream) const;
+        std::vector<u32> parse_range(TokenStream<std::string_view>& stream) const;
         void expand_ranges_recursively(std::vector<std::string>& expanded_names, const std::string& current_name, const std::vector<std::vector<u32>>& ranges, u32 dimension) const;
         std::vector<std::string> expand_ranges(const std::string& name, const std::vector<std::vector<u32>>& ranges) const;
         Result<std::vector<BooleanFunction::Value>> get_binary_vector(std::string value) const;
         Result<std::string> get_hex_from_literal(const Token<std::string>& value_token) const;
         Result<std::pair<std::string, std::string>> parse_parameter_value(const Token<std::string>& value_token) const;
-        Result<std::vector<VerilogParser::assignment_t>> parse_assignment_expression(TokenStream<std::string>&& stream) const;
+        Result<std::vector<VerilogParser::assignment_t>> parse_assignment_expression(TokenStream<std::string_view>&& stream) const;
         std::vector<std::string> expand_assignment_expression(VerilogModule* verilog_module, const std::vector<assignment_t>& vars) const;
     };
 }    // namespace hal
@@ -8,15 +8,75 @@
 #include "hal_core/utilities/log.h"
 #include "hal_core/utilities/utils.h"
 
+#include <cstring>
+#include <exception>
 #include <fstream>
 #include <iomanip>
 #include <queue>
+#include <sstream>
 
 namespace hal
 {
     namespace
     {
+        /**
+         * Extends an FNV-1a hash by a string.
+         * Every string is terminated so that consecutive strings cannot be shifted into each other without changing the hash.
+         */
+        u64 hash_string(u64 hash, std::string_view str)
+        {
+            return utils::fnv1a_hash(utils::fnv1a_hash(hash, str.data(), str.size()), 0xff);
+        }
+
+        std::string hash_to_string(u64 hash)
+        {
+            std::stringstream ss;
+            ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+            return ss.str();
+        }
+
+        /**
+         * Get the names of all nets that have been merged into the given net by depth, as annotated by the parser.
+         */
+        std::vector<std::vector<std::string>> get_merged_net_names(const Net* net)
+        {
+            std::vector<std::vector<std::string>> merged_names;
+            const std::string annotation = std::get<1>(net->get_data("parser_annotation", "merged_nets"));
+
+            // the annotation is a JSON formatted list of lists of strings
+            u32 level = 0;
+            for (size_t i = 0; i < annotation.size(); i++)
+            {
+                if (annotation[i] == '[')
+                {
+                    if (++level == 2)
+                    {
+                        merged_names.emplace_back();
+                    }
+                }
+                else if (annotation[i] == ']')
+                {
+                    level--;
+                }
+                else if (annotation[i] == '"' && level == 2)
+                {
+                    const size_t end = annotation.find('"', i + 1);
+                    if (end == std::string::npos)
+                    {
+                        break;
+                    }
+                    merged_names.back().push_back(annotation.substr(i + 1, end - i - 1));
+                    i = end;
+                }
+            }
+
+            return merged_names;
+        }
 
+        // data entries of the top module used to recognize unchanged module definitions when updating a netlist, see VerilogParser::instantiate
+        const std::string update_data_category = "verilog_parser";
+        const std::string definition_hashes_key = "definition_hashes";
+        const std::string naming_hash_key       = "naming_hash";
     }    // namespace
 
     Result<std::monostate> VerilogParser::parse(const std::filesystem::path& file_path)
@@ -25,15 +85,10 @@ namespace hal
         m_modules.clear();
         m_modules_by_name.clear();
 
+        // tokens are views on the mapped file content or the arena
+        if (!m_file.open(file_path))
         {
-            std::ifstream ifs;
-            ifs.open(file_path.string(), std::ifstream::in);
-            if (!ifs.is_open())
-            {
-                return ERR("could not parse Verilog file '" + m_path.string() + "' : unable to open file");
-            }
-            m_fs << ifs.rdbuf();
-            ifs.close();
+            return ERR("could not parse Verilog file '" + m_path.string() + "' : unable to open file");
         }
 
         // tokenize file
@@ -47,7 +102,7 @@ namespace hal
                 return ERR_APPEND(res.get_error(), "could not parse Verilog file '" + file_path.string() + "': unable to parse tokens");
             }
         }
-        catch (TokenStream<std::string>::TokenStreamException& e)
+        catch (TokenStream<std::string_view>::TokenStreamException& e)
         {
             if (e.line_number != (u32)-1)
             {
@@ -59,15 +114,41 @@ namespace hal
             }
         }
 
+        // the intermediate format owns its strings, so the tokens and the file content are no longer needed
+        m_token_stream = TokenStream<std::string_view>();
+        m_arena.clear();
+        m_file.close();
+
         if (m_modules.empty())
         {
             return ERR("could not parse Verilog file '" + m_path.string() + "': does not contain any modules");
         }
 
         // expand module port identifiers, signals, and assignments
+        std::vector<VerilogModule*> verilog_modules;
+        std::vector<VerilogSignal*> verilog_signals;
+        std::vector<std::pair<VerilogModule*, VerilogAssignment*>> verilog_assignments;
+        std::vector<std::pair<VerilogModule*, VerilogInstance*>> verilog_instances;
         for (auto& [module_name, verilog_module] : m_modules_by_name)
         {
-            // expand port identifiers
+            verilog_modules.push_back(verilog_module);
+            for (auto& signal : verilog_module->m_signals)
+            {
+                verilog_signals.push_back(signal.get());
+            }
+            for (auto& assignment : verilog_module->m_assignments)
+            {
+                verilog_assignments.push_back(std::make_pair(verilog_module, &assignment));
+            }
+            for (auto& instance : verilog_module->m_instances)
+            {
+                verilog_instances.push_back(std::make_pair(verilog_module, instance.get()));
+            }
+        }
+
+        // expand port identifiers
+        utils::parallel_for(verilog_modules.size(), [this, &verilog_modules](u32 i) {
+            VerilogModule* verilog_module = verilog_modules.at(i);
             for (const auto& port : verilog_module->m_ports)
             {
                 if (port->m_expression == port->m_identifier)
@@ -101,256 +182,270 @@ namespace hal
                     }
                 }
             }
+        });
 
-            // expand signals
-            for (auto& signal : verilog_module->m_signals)
+        // expand signals, individually since flattened netlists often consist of a single huge module
+        utils::parallel_for(verilog_signals.size(), [this, &verilog_signals](u32 i) {
+            VerilogSignal* signal = verilog_signals.at(i);
+            if (!signal->m_ranges.empty())
             {
-                if (!signal->m_ranges.empty())
-                {
-                    signal->m_expanded_names = expand_ranges(signal->m_name, signal->m_ranges);
-                }
-                else
+                signal->m_expanded_names = expand_ranges(signal->m_name, signal->m_ranges);
+            }
+            else
+            {
+                signal->m_expanded_names = std::vector<std::string>({signal->m_name});
+            }
+        });
+
+        // expand assignments, results are collected per assignment to retain their order within the module
+        std::vector<std::vector<std::pair<std::string, std::string>>> expanded_assignments(verilog_assignments.size());
+        std::vector<u8> assignment_failed(verilog_assignments.size(), 0);
+        utils::parallel_for(verilog_assignments.size(), [this, &verilog_assignments, &expanded_assignments, &assignment_failed](u32 idx) {
+            auto [verilog_module, assignment]                          = verilog_assignments.at(idx);
+            std::vector<std::pair<std::string, std::string>>& expanded = expanded_assignments.at(idx);
+
+            const std::vector<std::string> left_signals  = expand_assignment_expression(verilog_module, assignment->m_variable);
+            const std::vector<std::string> right_signals = expand_assignment_expression(verilog_module, assignment->m_assignment);
+            if (left_signals.empty() || right_signals.empty())
+            {
+                assignment_failed.at(idx) = 1;
+                return;
+            }
+
+            u32 left_size  = left_signals.size();
+            u32 right_size = right_signals.size();
+            if (left_size <= right_size)
+            {
+                // cut off redundant bits
+                for (u32 i = 0; i < left_size; i++)
                 {
-                    signal->m_expanded_names = std::vector<std::string>({signal->m_name});
+                    expanded.push_back(std::make_pair(left_signals.at(i), right_signals.at(i)));
                 }
             }
-
-            // expand assignments
-            for (auto& assignment : verilog_module->m_assignments)
+            else
             {
-                const std::vector<std::string> left_signals  = expand_assignment_expression(verilog_module, assignment.m_variable);
-                const std::vector<std::string> right_signals = expand_assignment_expression(verilog_module, assignment.m_assignment);
-                if (left_signals.empty() || right_signals.empty())
+                for (u32 i = 0; i < right_size; i++)
                 {
-                    return ERR("could not parse Verilog file '" + m_path.string() + "': unable to expand assignments within module '" + verilog_module->m_name + "'");
+                    expanded.push_back(std::make_pair(left_signals.at(i), right_signals.at(i)));
                 }
 
-                u32 left_size  = left_signals.size();
-                u32 right_size = right_signals.size();
-                if (left_size <= right_size)
+                // implicit "0"
+                for (u32 i = 0; i < left_size - right_size; i++)
                 {
-                    // cut off redundant bits
-                    for (u32 i = 0; i < left_size; i++)
-                    {
-                        verilog_module->m_expanded_assignments.push_back(std::make_pair(left_signals.at(i), right_signals.at(i)));
-                    }
+                    expanded.push_back(std::make_pair(left_signals.at(i + right_size), "'0'"));
                 }
-                else
-                {
-                    for (u32 i = 0; i < right_size; i++)
-                    {
-                        verilog_module->m_expanded_assignments.push_back(std::make_pair(left_signals.at(i), right_signals.at(i)));
-                    }
+            }
+        });
 
-                    // implicit "0"
-                    for (u32 i = 0; i < left_size - right_size; i++)
-                    {
-                        verilog_module->m_expanded_assignments.push_back(std::make_pair(left_signals.at(i + right_size), "'0'"));
-                    }
-                }
+        for (u32 i = 0; i < verilog_assignments.size(); i++)
+        {
+            VerilogModule* verilog_module = verilog_assignments.at(i).first;
+            if (assignment_failed.at(i))
+            {
+                return ERR("could not parse Verilog file '" + m_path.string() + "': unable to expand assignments within module '" + verilog_module->m_name + "'");
             }
+            verilog_module->m_expanded_assignments.insert(
+                verilog_module->m_expanded_assignments.end(), std::make_move_iterator(expanded_assignments.at(i).begin()), std::make_move_iterator(expanded_assignments.at(i).end()));
         }
 
         // expand module port assignments
-        for (auto& [module_name, verilog_module] : m_modules_by_name)
-        {
-            for (auto& instance : verilog_module->m_instances)
+        std::vector<std::string> instance_errors(verilog_instances.size());
+        utils::parallel_for(verilog_instances.size(), [this, &verilog_instances, &instance_errors](u32 idx) {
+            auto [verilog_module, instance] = verilog_instances.at(idx);
+            if (auto module_it = m_modules_by_name.find(instance->m_type); module_it != m_modules_by_name.end())
             {
-                if (auto module_it = m_modules_by_name.find(instance->m_type); module_it != m_modules_by_name.end())
+                instance->m_is_module = true;
+                if (!instance->m_port_assignments.empty())
                 {
-                    instance->m_is_module = true;
-                    if (!instance->m_port_assignments.empty())
+                    // all port assignments by name
+                    if (instance->m_port_assignments.front().m_port_name.has_value())
                     {
-                        // all port assignments by name
-                        if (instance->m_port_assignments.front().m_port_name.has_value())
+                        for (const auto& port_assignment : instance->m_port_assignments)
                         {
-                            for (const auto& port_assignment : instance->m_port_assignments)
+                            const std::vector<std::string> right_port = expand_assignment_expression(verilog_module, port_assignment.m_assignment);
+                            if (!right_port.empty())
                             {
-                                const std::vector<std::string> right_port = expand_assignment_expression(verilog_module, port_assignment.m_assignment);
-                                if (!right_port.empty())
+                                VerilogPort* port;
+                                if (const auto port_it = module_it->second->m_ports_by_identifier.find(port_assignment.m_port_name.value());
+                                    port_it == module_it->second->m_ports_by_identifier.end())
+                                {
+                                    instance_errors.at(idx) = "could not parse Verilog file '" + m_path.string() + "': unable to assign signal to port '" + port_assignment.m_port_name.value()
+                                                              + "' as it is not a port of module '" + module_it->first + "'";
+                                    return;
+                                }
+                                else
+                                {
+                                    port = port_it->second;
+                                }
+                                const std::vector<std::string>& left_port = port->m_expanded_identifiers;
+                                if (left_port.empty())
+                                {
+                                    instance_errors.at(idx) = "could not parse Verilog file '" + m_path.string() + "': unable to expand port assignment";
+                                    return;
+                                }
+
+                                u32 max_size = right_port.size() <= left_port.size() ? right_port.size() : left_port.size();
+
+                                for (u32 i = 0; i < max_size; i++)
                                 {
-                                    VerilogPort* port;
-                                    if (const auto port_it = module_it->second->m_ports_by_identifier.find(port_assignment.m_port_name.value());
-                                        port_it == module_it->second->m_ports_by_identifier.end())
-                                    {
-                                        return ERR("could not parse Verilog file '" + m_path.string() + "': unable to assign signal to port '" + port_assignment.m_port_name.value()
-                                                   + "' as it is not a port of module '" + module_it->first + "'");
-                                    }
-                                    else
-                                    {
-                                        port = port_it->second;
-                                    }
-                                    const std::vector<std::string>& left_port = port->m_expanded_identifiers;
-                                    if (left_port.empty())
-                                    {
-                                        return ERR("could not parse Verilog file '" + m_path.string() + "': unable to expand port assignment");
-                                    }
-
-                                    u32 max_size = right_port.size() <= left_port.size() ? right_port.size() : left_port.size();
-
-                                    for (u32 i = 0; i < max_size; i++)
-                                    {
-                                        instance->m_expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
-                                    }
+                                    instance->m_expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
                                 }
                             }
                         }
-                        // all port assignments by order
-                        else
+                    }
+                    // all port assignments by order
+                    else
+                    {
+                        std::vector<std::string> ports;
+                        for (const auto& port : module_it->second->m_ports)
                         {
-                            std::vector<std::string> ports;
-                            for (const auto& port : m_modules_by_name.at(instance->m_type)->m_ports)
-                            {
-                                ports.insert(ports.end(), port->m_expanded_identifiers.begin(), port->m_expanded_identifiers.end());
-                            }
+                            ports.insert(ports.end(), port->m_expanded_identifiers.begin(), port->m_expanded_identifiers.end());
+                        }
 
-                            auto port_it = ports.begin();
+                        auto port_it = ports.begin();
 
-                            for (const auto& port_assignment : instance->m_port_assignments)
+                        for (const auto& port_assignment : instance->m_port_assignments)
+                        {
+                            std::vector<std::string> right_port = expand_assignment_expression(verilog_module, port_assignment.m_assignment);
+                            if (!right_port.empty())
                             {
-                                std::vector<std::string> right_port = expand_assignment_expression(verilog_module, port_assignment.m_assignment);
-                                if (!right_port.empty())
-                                {
-                                    std::vector<std::string> left_port;
+                                std::vector<std::string> left_port;
 
-                                    for (u32 i = 0; i < right_port.size() && port_it != ports.end(); i++)
-                                    {
-                                        left_port.push_back(*port_it++);
-                                    }
+                                for (u32 i = 0; i < right_port.size() && port_it != ports.end(); i++)
+                                {
+                                    left_port.push_back(*port_it++);
+                                }
 
-                                    u32 max_size = right_port.size() <= left_port.size() ? right_port.size() : left_port.size();
+                                u32 max_size = right_port.size() <= left_port.size() ? right_port.size() : left_port.size();
 
-                                    for (u32 i = 0; i < max_size; i++)
-                                    {
-                                        instance->m_expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
-                                    }
+                                for (u32 i = 0; i < max_size; i++)
+                                {
+                                    instance->m_expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
                                 }
                             }
                         }
                     }
                 }
             }
+        });
+
+        for (const std::string& error : instance_errors)
+        {
+            if (!error.empty())
+            {
+                return ERR(error);
+            }
         }
 
         return OK({});
     }
 
-    Result<std::unique_ptr<Netlist>> VerilogParser::instantiate(const GateLibrary* gate_library)
+    std::set<std::string> VerilogParser::get_required_gate_types() const
     {
-        // create empty netlist
-        std::unique_ptr<Netlist> result = netlist_factory::create_netlist(gate_library);
-        m_netlist                       = result.get();
-        if (m_netlist == nullptr)
-        {
-            return ERR("could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': failed to create empty netlist");
-        }
-
-        m_gate_types.clear();
-        m_gnd_gate_types.clear();
-        m_vcc_gate_types.clear();
-        m_module_instantiation_count.clear();
-        m_instance_name_occurences.clear();
-        m_net_name_occurences.clear();
-        m_net_by_name.clear();
-        m_nets_to_merge.clear();
-        m_module_ports.clear();
-        m_module_port_by_net.clear();
+        std::set<std::string> gate_types;
         for (const auto& verilog_module : m_modules)
         {
             for (const auto& instance : verilog_module->m_instances)
             {
                 if (!instance->m_is_module)
                 {
-                    instance->m_expanded_port_assignments.clear();
+                    gate_types.insert(instance->m_type);
                 }
             }
         }
+        return gate_types;
+    }
 
-        // buffer gate types
-        m_gate_types     = gate_library->get_gate_types();
-        m_gnd_gate_types = gate_library->get_gnd_gate_types();
-        m_vcc_gate_types = gate_library->get_vcc_gate_types();
-
-        // create const 0 and const 1 net, will be removed if unused
-        m_zero_net = m_netlist->create_net("'0'");
-        if (m_zero_net == nullptr)
+    Result<std::unique_ptr<Netlist>> VerilogParser::instantiate(const GateLibrary* gate_library)
+    {
+        // create empty netlist
+        std::unique_ptr<Netlist> result = netlist_factory::create_netlist(gate_library);
+        if (result == nullptr)
         {
-            return ERR("could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': failed to create zero net");
+            return ERR("could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': failed to create empty netlist");
         }
-        m_net_by_name[m_zero_net->get_name()] = m_zero_net;
 
-        m_one_net = m_netlist->create_net("'1'");
-        if (m_one_net == nullptr)
-        {
-            return ERR("could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': failed to create one net");
-        }
-        m_net_by_name[m_one_net->get_name()] = m_one_net;
+        // all instantiation state is kept by a separate parser that only reads the parsed modules, so multiple gate libraries can be instantiated concurrently
+        VerilogParser instantiation;
+        instantiation.m_path            = m_path;
+        instantiation.m_modules_by_name = m_modules_by_name;
+        instantiation.m_netlist         = result.get();
 
-        // TODO: This tries to find the topmodule by searching for a module that is not referenced by any other module. This fails when there are multiple of those modules (for example with unused modules). There is also a top=1 flag that is set bz yosys for example that we could check first, before using this approach.
-        std::map<std::string, u32> module_name_to_refereneces;
-        for (const auto& [_name, module] : m_modules_by_name)
+        if (auto res = instantiation.instantiate_netlist(); res.is_error())
         {
-            for (const auto& instance : module->m_instances)
-            {
-                if (const auto it = m_modules_by_name.find(instance->m_type); it != m_modules_by_name.end())
-                {
-                    module_name_to_refereneces[it->first]++;
-                }
-            }
+            return ERR(res.get_error());
         }
 
-        std::vector<std::string> top_module_candidates;
-        for (const auto& [name, module] : m_modules_by_name)
+        return OK(std::move(result));
+    }
+
+    Result<std::pair<std::unique_ptr<Netlist>, NetlistUpdateReport>> VerilogParser::update(std::unique_ptr<Netlist> netlist)
+    {
+        if (netlist == nullptr)
         {
-            if (module_name_to_refereneces.find(name) == module_name_to_refereneces.end())
-            {
-                top_module_candidates.push_back(name);
-            }
+            return ERR("could not update netlist with Verilog netlist '" + m_path.string() + "': netlist is a 'nullptr'");
         }
 
-        if (top_module_candidates.empty())
+        const GateLibrary* gate_library = netlist->get_gate_library();
+
+        // remember the previous module definitions, modules that have not been annotated count as changed
+        std::map<std::string, std::optional<u64>> previous_modules;
+        for (const Module* module : netlist->get_modules())
         {
-            return ERR("could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': unable to find any top module candidates");
+            previous_modules[module->get_name()] = std::nullopt;
         }
-
-        if (top_module_candidates.size() > 1)
+        for (const auto& [name, hashes] : get_definition_hashes(netlist->get_top_module()))
         {
-            return ERR("could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': found multiple modules as candidates for the top module");
+            previous_modules[name] = hashes.second;
         }
 
-        // construct the netlist with the the top module
-        VerilogModule* top_module = m_modules_by_name.at(top_module_candidates.front());
+        NetlistUpdateReport report;
 
-        if (const auto res = construct_netlist(top_module); res.is_error())
+        m_netlist = netlist.get();
+        if (auto res = update_netlist(); res.is_error())
         {
-            return ERR_APPEND(res.get_error(), "could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': unable to construct netlist");
-        }
+            log_info("verilog_parser", "could not update netlist incrementally, instantiating Verilog netlist '{}' from scratch:\n{}", m_path.string(), res.get_error().get());
 
-        // delete unused nets
-        std::queue<Net*> nets_to_be_deleted;
+            // the previous netlist may already have been modified and is discarded
+            netlist.reset();
 
-        for (auto net : m_netlist->get_nets())
-        {
-            const u32 num_of_sources      = net->get_num_of_sources();
-            const u32 num_of_destinations = net->get_num_of_destinations();
-            const bool no_source          = num_of_sources == 0 && !(net->is_global_input_net() && num_of_destinations != 0);
-            const bool no_destination     = num_of_destinations == 0 && !(net->is_global_output_net() && num_of_sources != 0);
-            if (no_source && no_destination)
+            if (auto inst_res = instantiate(gate_library); inst_res.is_error())
             {
-                nets_to_be_deleted.push(net);
+                return ERR_APPEND(inst_res.get_error(), "could not update netlist with Verilog netlist '" + m_path.string() + "': failed to instantiate netlist");
+            }
+            else
+            {
+                netlist = inst_res.get();
             }
+            report.full_rebuild = true;
         }
 
-        while (!nets_to_be_deleted.empty())
+        for (const auto& [name, hashes] : get_definition_hashes(netlist->get_top_module()))
         {
-            Net* net = nets_to_be_deleted.front();
-            nets_to_be_deleted.pop();
-            m_netlist->delete_net(net);
+            if (const auto it = previous_modules.find(name); it == previous_modules.end())
+            {
+                report.added_modules.push_back(name);
+            }
+            else
+            {
+                if (it->second == hashes.second)
+                {
+                    report.unchanged_modules.push_back(name);
+                }
+                else
+                {
+                    report.changed_modules.push_back(name);
+                }
+                previous_modules.erase(it);
+            }
         }
 
-        m_netlist->load_gate_locations_from_data();
+        for (const auto& [name, _] : previous_modules)
+        {
+            report.removed_modules.push_back(name);
+        }
 
-        return OK(std::move(result));
+        return OK(std::make_pair(std::move(netlist), std::move(report)));
     }
 
     // ###########################################################################
@@ -359,132 +454,214 @@ namespace hal
 
     void VerilogParser::tokenize()
     {
-        const std::string delimiters = "`,()[]{}\\#*: ;=./";
-        std::string current_token;
-        u32 line_number = 0;
+        static const CharacterSet delimiters("`,()[]{}\\#*: ;=./", true);
+        static const CharacterSet whitespace("", true);
+        // characters ending a run of plain token characters in the respective lexer state
+        static const CharacterSet plain_stop("`,()[]{}\\#*: ;=./\"", true);
+        static const CharacterSet escaped_stop("\\", true);
+        static const CharacterSet string_stop("\"\n");
 
-        std::string line;
+        m_arena.clear();
+
+        const std::string_view text = m_file.get_text();
+        const char* const text_begin = text.data();
+        const char* const text_end   = text_begin + text.size();
+        auto in_text                 = [text_begin, text_end](std::string_view s) { return s.data() >= text_begin && s.data() + s.size() <= text_end; };
+
+        u32 line_number = 1;
         char prev_char  = 0;
         bool in_string  = false;
         bool escaped    = false;
         bool in_comment = false;
 
-        std::vector<Token<std::string>> parsed_tokens;
-        while (std::getline(m_fs, line))
-        {
-            line_number++;
-            // this->remove_comments(line, multi_line_comment);
+        // the current token is a view on the text as long as it is contiguous, otherwise it is assembled separately
+        const char* token_begin = nullptr;
+        const char* token_end   = nullptr;
+        std::string assembled;
+        bool is_assembled = false;
 
-            for (char c : line)
+        auto append = [&](const char* from, const char* to) {
+            if (is_assembled)
             {
-                // deal with comments
-                if (in_comment)
-                {
-                    if (c == '/' && prev_char == '*')
-                    {
-                        in_comment = false;
-                    }
+                assembled.append(from, to);
+            }
+            else if (token_begin == token_end)
+            {
+                token_begin = from;
+                token_end   = to;
+            }
+            else if (token_end == from)
+            {
+                token_end = to;
+            }
+            else
+            {
+                assembled.assign(token_begin, token_end);
+                assembled.append(from, to);
+                is_assembled = true;
+            }
+        };
 
-                    prev_char = c;
-                    continue;
-                }
+        auto token_empty = [&]() { return is_assembled ? assembled.empty() : token_begin == token_end; };
 
-                // deal with escaping and strings
-                if (!in_string && c == '\\')
-                {
-                    escaped = true;
-                    continue;
-                }
-                else if (escaped && std::isspace(c))
-                {
-                    escaped = false;
-                    continue;
-                }
-                else if (!escaped && c == '"')
+        auto take_token = [&]() {
+            std::string_view token = is_assembled ? m_arena.store(std::move(assembled)) : std::string_view(token_begin, token_end - token_begin);
+            assembled.clear();
+            is_assembled = false;
+            token_begin = token_end = nullptr;
+            return token;
+        };
+
+        std::vector<Token<std::string_view>> parsed_tokens;
+
+        for (const char* p = text_begin; p < text_end; ++p)
+        {
+            const char c = *p;
+
+            if (c == '\n')
+            {
+                if (!token_empty())
                 {
-                    in_string = !in_string;
+                    parsed_tokens.emplace_back(line_number, take_token());
                 }
+                line_number++;
+                continue;
+            }
 
-                if (!in_comment && ((!std::isspace(c) && delimiters.find(c) == std::string::npos) || escaped || in_string))
+            // deal with comments
+            if (in_comment)
+            {
+                if (c == '/' && prev_char == '*')
                 {
-                    current_token += c;
+                    in_comment = false;
                 }
-                else
+
+                prev_char = c;
+                continue;
+            }
+
+            // deal with escaping and strings
+            if (!in_string && c == '\\')
+            {
+                escaped = true;
+                continue;
+            }
+            else if (escaped && whitespace.contains(c))
+            {
+                escaped = false;
+                continue;
+            }
+            else if (!escaped && c == '"')
+            {
+                in_string = !in_string;
+            }
+
+            if ((!whitespace.contains(c) && !delimiters.contains(c)) || escaped || in_string)
+            {
+                // consume the entire run of characters that cannot change the lexer state at once
+                const CharacterSet& stop = in_string ? string_stop : (escaped ? escaped_stop : plain_stop);
+                const char* run_end      = (c == '"') ? p + 1 : stop.find_first(p + 1, text_end);
+                append(p, run_end);
+                p = run_end - 1;
+            }
+            else
+            {
+                // deal with floats
+                if (!token_empty())
                 {
-                    // deal with floats
-                    if (!current_token.empty())
+                    std::string_view current_token = take_token();
+                    if (parsed_tokens.size() > 1 && utils::is_digits(parsed_tokens.at(parsed_tokens.size() - 2).string) && parsed_tokens.at(parsed_tokens.size() - 1) == "."
+                        && utils::is_digits(current_token))
                     {
-                        if (parsed_tokens.size() > 1 && utils::is_digits(parsed_tokens.at(parsed_tokens.size() - 2).string) && parsed_tokens.at(parsed_tokens.size() - 1) == "."
-                            && utils::is_digits(current_token))
+                        std::string_view dot     = parsed_tokens.back().string;
+                        parsed_tokens.pop_back();
+                        std::string_view integer = parsed_tokens.back().string;
+                        if (in_text(integer) && in_text(dot) && in_text(current_token) && integer.data() + integer.size() == dot.data() && dot.data() + 1 == current_token.data())
                         {
-                            parsed_tokens.pop_back();
-                            parsed_tokens.back() += "." + current_token;
+                            parsed_tokens.back() = std::string_view(integer.data(), integer.size() + 1 + current_token.size());
                         }
                         else
                         {
-                            parsed_tokens.emplace_back(line_number, current_token);
+                            parsed_tokens.back() = m_arena.store(std::string(integer) + "." + std::string(current_token));
                         }
-                        current_token.clear();
                     }
-
-                    if (!parsed_tokens.empty())
+                    else
                     {
-                        // deal with multi-character tokens
-                        if (c == '(' && parsed_tokens.back() == "#")
-                        {
-                            parsed_tokens.back() = "#(";
-                            continue;
-                        }
-                        else if (c == '*' && parsed_tokens.back() == "(")
-                        {
-                            parsed_tokens.back() = "(*";
-                            continue;
-                        }
-                        else if (c == ')' && parsed_tokens.back() == "*")
-                        {
-                            parsed_tokens.back() = "*)";
-                            continue;
-                        }
-                        // start a comment
-                        else if (c == '/' && parsed_tokens.back() == "/")
-                        {
-                            parsed_tokens.pop_back();
-                            break;
-                        }
-                        else if (c == '*' && parsed_tokens.back() == "/")
-                        {
-                            in_comment = true;
-                            parsed_tokens.pop_back();
-                            continue;
-                        }
+                        parsed_tokens.emplace_back(line_number, current_token);
                     }
+                }
 
-                    if (!std::isspace(c))
+                if (!parsed_tokens.empty())
+                {
+                    // deal with multi-character tokens
+                    if (c == '(' && parsed_tokens.back() == "#")
+                    {
+                        parsed_tokens.back() = "#(";
+                        continue;
+                    }
+                    else if (c == '*' && parsed_tokens.back() == "(")
                     {
-                        parsed_tokens.emplace_back(line_number, std::string(1, c));
+                        parsed_tokens.back() = "(*";
+                        continue;
+                    }
+                    else if (c == ')' && parsed_tokens.back() == "*")
+                    {
+                        parsed_tokens.back() = "*)";
+                        continue;
+                    }
+                    // start a comment
+                    else if (c == '/' && parsed_tokens.back() == "/")
+                    {
+                        parsed_tokens.pop_back();
+                        const char* eol = static_cast<const char*>(memchr(p, '\n', text_end - p));
+                        p               = (eol ? eol : text_end) - 1;
+                        continue;
+                    }
+                    else if (c == '*' && parsed_tokens.back() == "/")
+                    {
+                        in_comment = true;
+                        parsed_tokens.pop_back();
+                        continue;
                     }
                 }
-            }
-            if (!current_token.empty())
-            {
-                parsed_tokens.emplace_back(line_number, current_token);
-                current_token.clear();
+
+                if (!whitespace.contains(c))
+                {
+                    parsed_tokens.emplace_back(line_number, std::string_view(p, 1));
+                }
             }
         }
+        if (!token_empty())
+        {
+            parsed_tokens.emplace_back(line_number, take_token());
+        }
 
-        m_token_stream = TokenStream(parsed_tokens, {"(", "["}, {")", "]"});
+        m_token_stream = TokenStream<std::string_view>(std::move(parsed_tokens), {"(", "["}, {")", "]"});
     }
 
     Result<std::monostate> VerilogParser::parse_tokens()
     {
+        struct ModuleJob
+        {
+            TokenStream<std::string_view> stream;
+            std::vector<VerilogDataEntry> attributes;
+            std::string name;
+            u32 line_number;
+            u64 hash = utils::FNV1A_OFFSET_BASIS;
+            std::unique_ptr<VerilogModule> module;
+            std::optional<Error> error;
+            std::exception_ptr exception;
+        };
+
+        std::vector<ModuleJob> jobs;
         std::vector<VerilogDataEntry> attributes;
-        u32 line_number;
 
+        // split the token stream at module boundaries, attributes and directives in between are handled right away
         while (m_token_stream.remaining() > 0)
         {
             if (m_token_stream.peek() == "(*")
             {
-                parse_attribute(attributes);
+                parse_attribute(m_token_stream, attributes);
             }
             else if (m_token_stream.peek() == "`")
             {
@@ -493,77 +670,173 @@ namespace hal
             }
             else
             {
-                line_number = m_token_stream.peek().number;
-                if (auto res = parse_module(attributes); res.is_error())
+                ModuleJob job;
+                job.line_number = m_token_stream.peek().number;
+                if (m_token_stream.remaining() > 1)
                 {
-                    return ERR_APPEND(res.get_error(), "could not parse tokens: unable to parse module (line " + std::to_string(line_number) + ")");
+                    job.name = std::string(m_token_stream.peek(1).string);
                 }
+
+                // the module is parsed from a sub-stream that shares the tokens of the whole file instead of copying them
+                const u32 begin = m_token_stream.position();
+                const u32 end   = std::min(m_token_stream.find_next("endmodule", TokenStream<std::string_view>::END_OF_STREAM, false), m_token_stream.size() - 1);
+                m_token_stream.set_position(end + 1);
+
+                job.stream     = m_token_stream.sub_stream(begin, end + 1);
+                job.attributes = std::move(attributes);
+                attributes.clear();
+                jobs.push_back(std::move(job));
+            }
+        }
+
+        // parse modules concurrently, exceptions are passed on to the caller in the order of the modules
+        utils::parallel_for(jobs.size(), [this, &jobs](u32 i) {
+            ModuleJob& job = jobs.at(i);
+
+            // hash the definition independent of its position within the file
+            for (const VerilogDataEntry& attribute : job.attributes)
+            {
+                job.hash = hash_string(hash_string(hash_string(job.hash, attribute.m_name), attribute.m_type), attribute.m_value);
+            }
+            for (u32 j = 0; j < job.stream.size(); j++)
+            {
+                job.hash = hash_string(job.hash, job.stream.at(j).string);
+            }
+
+            try
+            {
+                if (auto res = parse_module(job.stream, job.attributes); res.is_error())
+                {
+                    job.error.emplace(res.get_error());
+                }
+                else
+                {
+                    job.module = res.get();
+                }
+            }
+            catch (...)
+            {
+                job.exception = std::current_exception();
+            }
+        });
+
+        for (ModuleJob& job : jobs)
+        {
+            // verify module name
+            if (const auto it = m_modules_by_name.find(job.name); it != m_modules_by_name.end())
+            {
+                const u32 name_line_number = job.stream.size() > 1 ? job.stream.at(1).number : job.line_number;
+                const Error error(__FILE__,
+                                  __LINE__,
+                                  "could not parse module '" + job.name + "' (line " + std::to_string(name_line_number) + "): a module with the same name already exists (line "
+                                      + std::to_string(it->second->m_line_number) + ")");
+                return ERR_APPEND(error, "could not parse tokens: unable to parse module (line " + std::to_string(job.line_number) + ")");
             }
+
+            if (job.exception)
+            {
+                std::rethrow_exception(job.exception);
+            }
+
+            if (job.error.has_value())
+            {
+                return ERR_APPEND(job.error.value(), "could not parse tokens: unable to parse module (line " + std::to_string(job.line_number) + ")");
+            }
+
+            job.module->m_hash                    = job.hash;
+            m_modules_by_name[job.module->m_name] = job.module.get();
+            m_last_module                         = job.module->m_name;
+            m_modules.push_back(std::move(job.module));
+        }
+
+        std::unordered_set<VerilogModule*> visited;
+        for (const auto& verilog_module : m_modules)
+        {
+            compute_subtree_hash(verilog_module.get(), visited);
         }
 
         return OK({});
     }
 
-    Result<std::monostate> VerilogParser::parse_module(std::vector<VerilogDataEntry>& attributes)
+    u64 VerilogParser::compute_subtree_hash(VerilogModule* verilog_module, std::unordered_set<VerilogModule*>& visited)
     {
-        std::set<std::string> port_names;
-        std::vector<VerilogDataEntry> internal_attributes;
+        if (verilog_module->m_subtree_hash.has_value())
+        {
+            return verilog_module->m_subtree_hash.value();
+        }
 
-        m_token_stream.consume("module", true);
-        const u32 line_number         = m_token_stream.peek().number;
-        const std::string module_name = m_token_stream.consume();
+        // guard against (invalid) recursive instantiations
+        if (!visited.insert(verilog_module).second)
+        {
+            return verilog_module->m_hash;
+        }
 
-        // verify entity name
-        if (const auto it = m_modules_by_name.find(module_name); it != m_modules_by_name.end())
+        u64 hash = hash_string(utils::FNV1A_OFFSET_BASIS, hash_to_string(verilog_module->m_hash));
+        for (const auto& instance : verilog_module->m_instances)
         {
-            return ERR("could not parse module '" + module_name + "' (line " + std::to_string(line_number) + "): a module with the same name already exists (line "
-                       + std::to_string(it->second->m_line_number) + ")");
+            if (const auto it = m_modules_by_name.find(instance->m_type); it != m_modules_by_name.end())
+            {
+                hash = hash_string(hash, hash_to_string(compute_subtree_hash(it->second, visited)));
+            }
         }
 
+        verilog_module->m_subtree_hash = hash;
+        return hash;
+    }
+
+    Result<std::unique_ptr<VerilogParser::VerilogModule>> VerilogParser::parse_module(TokenStream<std::string_view>& stream, std::vector<VerilogDataEntry>& attributes)
+    {
+        std::set<std::string> port_names;
+        std::vector<VerilogDataEntry> internal_attributes;
+
+        stream.consume("module", true);
+        const u32 line_number         = stream.peek().number;
+        const std::string module_name = std::string(stream.consume().string);
+
         auto verilog_module               = std::make_unique<VerilogModule>();
         VerilogModule* verilog_module_raw = verilog_module.get();
         verilog_module_raw->m_line_number = line_number;
         verilog_module_raw->m_name        = module_name;
 
         // parse parameter list
-        if (m_token_stream.consume("#("))
+        if (stream.consume("#("))
         {
             // TODO add support for parameter parsing
-            m_token_stream.consume_until(")");
-            m_token_stream.consume(")", true);
+            stream.consume_until(")");
+            stream.consume(")", true);
             log_warning("verilog_parser", "could not parse parameter list provided for module '{}'.", module_name);
         }
 
         // parse port (declaration) list
-        m_token_stream.consume("(", true);
-        Token<std::string> next_token = m_token_stream.peek();
+        stream.consume("(", true);
+        Token<std::string_view> next_token = stream.peek();
         if (next_token == "input" || next_token == "output" || next_token == "inout")
         {
-            if (auto res = parse_port_declaration_list(verilog_module_raw); res.is_error())
+            if (auto res = parse_port_declaration_list(stream, verilog_module_raw); res.is_error())
             {
                 return ERR_APPEND(res.get_error(), "could not parse module '" + module_name + "': unable to parse port declaration list (line " + std::to_string(line_number) + ")");
             }
         }
         else
         {
-            parse_port_list(verilog_module_raw);
+            parse_port_list(stream, verilog_module_raw);
         }
 
-        m_token_stream.consume(";", true);
+        stream.consume(";", true);
 
-        next_token = m_token_stream.peek();
+        next_token = stream.peek();
         while (next_token != "endmodule")
         {
             if (next_token == "input" || next_token == "output" || next_token == "inout")
             {
-                if (auto res = parse_port_definition(verilog_module_raw, internal_attributes); res.is_error())
+                if (auto res = parse_port_definition(stream, verilog_module_raw, internal_attributes); res.is_error())
                 {
                     return ERR_APPEND(res.get_error(), "could not parse module '" + module_name + "': unable to parse port definition (line " + std::to_string(line_number) + ")");
                 }
             }
             else if (next_token == "wire" || next_token == "tri")
             {
-                if (auto res = parse_signal_definition(verilog_module_raw, internal_attributes); res.is_error())
+                if (auto res = parse_signal_definition(stream, verilog_module_raw, internal_attributes); res.is_error())
                 {
                     return ERR_APPEND(res.get_error(), "could not parse module '" + module_name + "': unable to parse signal definition (line " + std::to_string(line_number) + ")");
                 }
@@ -571,40 +844,40 @@ namespace hal
             else if (next_token == "parameter")
             {
                 // TODO add support for parameter parsing
-                m_token_stream.consume_until(";");
-                m_token_stream.consume(";", true);
+                stream.consume_until(";");
+                stream.consume(";", true);
                 log_warning("verilog_parser", "could not parse parameter provided for module '{}'.", module_name);
             }
             else if (next_token == "assign")
             {
-                if (auto res = parse_assignment(verilog_module_raw); res.is_error())
+                if (auto res = parse_assignment(stream, verilog_module_raw); res.is_error())
                 {
                     return ERR_APPEND(res.get_error(), "could not parse module '" + module_name + "': unable to parse assignment (line " + std::to_string(line_number) + ")");
                 }
             }
             else if (next_token == "defparam")
             {
-                if (auto res = parse_defparam(verilog_module_raw); res.is_error())
+                if (auto res = parse_defparam(stream, verilog_module_raw); res.is_error())
                 {
                     return ERR_APPEND(res.get_error(), "could not parse module '" + module_name + "': unable to parse defparam (line " + std::to_string(line_number) + ")");
                 }
             }
             else if (next_token == "(*")
             {
-                parse_attribute(internal_attributes);
+                parse_attribute(stream, internal_attributes);
             }
             else
             {
-                if (auto res = parse_instance(verilog_module_raw, internal_attributes); res.is_error())
+                if (auto res = parse_instance(stream, verilog_module_raw, internal_attributes); res.is_error())
                 {
                     return ERR_APPEND(res.get_error(), "could not parse module '" + module_name + "': unable to parse instance (line " + std::to_string(line_number) + ")");
                 }
             }
 
-            next_token = m_token_stream.peek();
+            next_token = stream.peek();
         }
 
-        m_token_stream.consume("endmodule", true);
+        stream.consume("endmodule", true);
 
         // assign attributes to entity
         if (!attributes.empty())
@@ -613,22 +886,17 @@ namespace hal
             attributes.clear();
         }
 
-        // add to collection of entities
-        m_modules.push_back(std::move(verilog_module));
-        m_modules_by_name[module_name] = verilog_module_raw;
-        m_last_module                  = module_name;
-
-        return OK({});
+        return OK(std::move(verilog_module));
     }
 
-    void VerilogParser::parse_port_list(VerilogModule* verilog_module)
+    void VerilogParser::parse_port_list(TokenStream<std::string_view>& stream, VerilogModule* verilog_module)
     {
-        TokenStream<std::string> ports_stream = m_token_stream.extract_until(")");
-        m_token_stream.consume(")", true);
+        TokenStream<std::string_view> ports_stream = stream.extract_until(")");
+        stream.consume(")", true);
 
         while (ports_stream.remaining() > 0)
         {
-            Token<std::string> next_token = ports_stream.consume();
+            Token<std::string_view> next_token = ports_stream.consume();
             auto port                     = std::make_unique<VerilogPort>();
 
             if (next_token == ".")
@@ -652,19 +920,19 @@ namespace hal
         }
     }
 
-    Result<std::monostate> VerilogParser::parse_port_declaration_list(VerilogModule* verilog_module)
+    Result<std::monostate> VerilogParser::parse_port_declaration_list(TokenStream<std::string_view>& stream, VerilogModule* verilog_module)
     {
-        TokenStream<std::string> ports_stream = m_token_stream.extract_until(")");
-        m_token_stream.consume(")", true);
+        TokenStream<std::string_view> ports_stream = stream.extract_until(")");
+        stream.consume(")", true);
 
         while (ports_stream.remaining() > 0)
         {
             // direction
-            const Token<std::string> direction_token = ports_stream.consume();
-            PinDirection direction                   = enum_from_string<PinDirection>(direction_token.string, PinDirection::none);
+            const Token<std::string_view> direction_token = ports_stream.consume();
+            PinDirection direction                   = enum_from_string<PinDirection>(std::string(direction_token.string), PinDirection::none);
             if (direction == PinDirection::none || direction == PinDirection::internal)
             {
-                return ERR("could not parse port declaration list: invalid direction '" + direction_token.string + "' (line " + std::to_string(direction_token.number) + ")");
+                return ERR("could not parse port declaration list: invalid direction '" + std::string(direction_token.string) + "' (line " + std::to_string(direction_token.number) + ")");
             }
 
             // ranges
@@ -680,7 +948,7 @@ namespace hal
             // port expressions
             do
             {
-                const Token<std::string> next_token = ports_stream.peek();
+                const Token<std::string_view> next_token = ports_stream.peek();
                 if (next_token == "input" || next_token == "output" || next_token == "inout")
                 {
                     break;
@@ -688,7 +956,7 @@ namespace hal
                 ports_stream.consume();
 
                 auto port                          = std::make_unique<VerilogPort>();
-                const std::string& port_expression = next_token.string;
+                const std::string port_expression  = std::string(next_token.string);
                 port->m_identifier                 = port_expression;
                 port->m_expression                 = port_expression;
                 port->m_direction                  = direction;
@@ -718,22 +986,22 @@ namespace hal
         return OK({});
     }
 
-    Result<std::monostate> VerilogParser::parse_port_definition(VerilogModule* verilog_module, std::vector<VerilogDataEntry>& attributes)
+    Result<std::monostate> VerilogParser::parse_port_definition(TokenStream<std::string_view>& stream, VerilogModule* verilog_module, std::vector<VerilogDataEntry>& attributes)
     {
         // port direction
-        const Token<std::string> direction_token = m_token_stream.consume();
-        PinDirection direction                   = enum_from_string<PinDirection>(direction_token.string, PinDirection::none);
+        const Token<std::string_view> direction_token = stream.consume();
+        PinDirection direction                   = enum_from_string<PinDirection>(std::string(direction_token.string), PinDirection::none);
         if (direction == PinDirection::none || direction == PinDirection::internal)
         {
-            return ERR("could not parse port definition: invalid direction '" + direction_token.string + "' (line " + std::to_string(direction_token.number) + ")");
+            return ERR("could not parse port definition: invalid direction '" + std::string(direction_token.string) + "' (line " + std::to_string(direction_token.number) + ")");
         }
 
         // ranges
         std::vector<std::vector<u32>> ranges;
-        while (m_token_stream.consume("["))
+        while (stream.consume("["))
         {
-            const std::vector<u32> range = parse_range(m_token_stream);
-            m_token_stream.consume("]", true);
+            const std::vector<u32> range = parse_range(stream);
+            stream.consume("]", true);
 
             ranges.emplace_back(range);
         }
@@ -741,8 +1009,8 @@ namespace hal
         // port expressions
         do
         {
-            Token<std::string> port_expression_token = m_token_stream.consume();
-            std::string port_expression              = port_expression_token.string;
+            Token<std::string_view> port_expression_token = stream.consume();
+            std::string port_expression              = std::string(port_expression_token.string);
 
             VerilogPort* port;
             if (const auto it = verilog_module->m_ports_by_expression.find(port_expression); it == verilog_module->m_ports_by_expression.end())
@@ -779,21 +1047,21 @@ namespace hal
                 auto* signal = signal_it->second;
                 signal->m_attributes.insert(signal->m_attributes.end(), attributes.begin(), attributes.end());
             }
-        } while (m_token_stream.consume(",", false));
+        } while (stream.consume(",", false));
 
-        m_token_stream.consume(";", true);
+        stream.consume(";", true);
         attributes.clear();
 
         return OK({});
     }
 
-    Result<std::monostate> VerilogParser::parse_signal_definition(VerilogModule* verilog_module, std::vector<VerilogDataEntry>& attributes)
+    Result<std::monostate> VerilogParser::parse_signal_definition(TokenStream<std::string_view>& stream, VerilogModule* verilog_module, std::vector<VerilogDataEntry>& attributes)
     {
         // consume "wire" or "tri"
-        u32 line_number = m_token_stream.consume().number;
+        u32 line_number = stream.consume().number;
 
-        TokenStream<std::string> signal_stream = m_token_stream.extract_until(";");
-        m_token_stream.consume(";", true);
+        TokenStream<std::string_view> signal_stream = stream.extract_until(";");
+        stream.consume(";", true);
 
         // extract bounds
         std::vector<std::vector<u32>> ranges;
@@ -808,11 +1076,11 @@ namespace hal
         // extract names
         do
         {
-            Token<std::string> signal_name = signal_stream.consume();
+            Token<std::string_view> signal_name = signal_stream.consume();
             if (signal_stream.remaining() > 0 && signal_stream.peek() == "=")
             {
                 VerilogAssignment assignment;
-                assignment.m_variable.push_back(signal_name);
+                assignment.m_variable.push_back(std::string(signal_name.string));
                 signal_stream.consume("=", true);
                 if (auto res = parse_assignment_expression(signal_stream.extract_until(",")); res.is_error())
                 {
@@ -826,7 +1094,7 @@ namespace hal
             }
 
             // create signal if not already implicitly declared otherwise
-            if (const auto signal_it = verilog_module->m_signals_by_name.find(signal_name.string); signal_it == verilog_module->m_signals_by_name.end())
+            if (const auto signal_it = verilog_module->m_signals_by_name.find(std::string(signal_name.string)); signal_it == verilog_module->m_signals_by_name.end())
             {
                 auto signal    = std::make_unique<VerilogSignal>();
                 signal->m_name = signal_name.string;
@@ -835,7 +1103,7 @@ namespace hal
                     signal->m_ranges = ranges;
                 }
                 signal->m_attributes.insert(signal->m_attributes.end(), attributes.begin(), attributes.end());
-                verilog_module->m_signals_by_name[signal_name.string] = signal.get();
+                verilog_module->m_signals_by_name[std::string(signal_name.string)] = signal.get();
                 verilog_module->m_signals.push_back(std::move(signal));
             }
             else
@@ -851,13 +1119,13 @@ namespace hal
         return OK({});
     }
 
-    Result<std::monostate> VerilogParser::parse_assignment(VerilogModule* verilog_module)
+    Result<std::monostate> VerilogParser::parse_assignment(TokenStream<std::string_view>& stream, VerilogModule* verilog_module)
     {
-        m_token_stream.consume("assign", true);
-        u32 line_number = m_token_stream.peek().number;
+        stream.consume("assign", true);
+        u32 line_number = stream.peek().number;
         VerilogAssignment assignment;
 
-        if (auto res = parse_assignment_expression(m_token_stream.extract_until("=")); res.is_error())
+        if (auto res = parse_assignment_expression(stream.extract_until("=")); res.is_error())
         {
             return ERR_APPEND(res.get_error(), "could not parse assignment: unable to parse assignment expression (line " + std::to_string(line_number) + ")");
         }
@@ -865,9 +1133,9 @@ namespace hal
         {
             assignment.m_variable = res.get();
         }
-        m_token_stream.consume("=", true);
+        stream.consume("=", true);
 
-        if (auto res = parse_assignment_expression(m_token_stream.extract_until(";")); res.is_error())
+        if (auto res = parse_assignment_expression(stream.extract_until(";")); res.is_error())
         {
             return ERR_APPEND(res.get_error(), "could not parse assignment: unable to parse assignment expression (line " + std::to_string(line_number) + ")");
         }
@@ -902,25 +1170,26 @@ namespace hal
                 }
             }
         }
-        m_token_stream.consume(";", true);
+        stream.consume(";", true);
 
         verilog_module->m_assignments.push_back(std::move(assignment));
         return OK({});
     }
 
-    Result<std::monostate> VerilogParser::parse_defparam(VerilogModule* module)
+    Result<std::monostate> VerilogParser::parse_defparam(TokenStream<std::string_view>& stream, VerilogModule* module)
     {
-        m_token_stream.consume("defparam", true);
-        std::string instance_name = m_token_stream.consume().string;
-        m_token_stream.consume(".", true);
+        stream.consume("defparam", true);
+        std::string instance_name = std::string(stream.consume().string);
+        stream.consume(".", true);
 
         if (const auto inst_it = module->m_instances_by_name.find(instance_name); inst_it != module->m_instances_by_name.end())
         {
             VerilogDataEntry param;
-            param.m_name = m_token_stream.consume().string;
-            m_token_stream.consume("=", true);
+            param.m_name = stream.consume().string;
+            stream.consume("=", true);
 
-            if (const auto res = parse_parameter_value(m_token_stream.consume()); res.is_ok())
+            const Token<std::string_view> value_token = stream.consume();
+            if (const auto res = parse_parameter_value({value_token.number, std::string(value_token.string)}); res.is_ok())
             {
                 const auto value = res.get();
                 param.m_type     = value.first;
@@ -934,28 +1203,28 @@ namespace hal
         }
         else
         {
-            m_token_stream.consume(";", true);
+            stream.consume(";", true);
             return ERR("could not parse defparam: no instance with name '" + instance_name + "' exists within module '" + module->m_name + "'");
         }
 
-        m_token_stream.consume(";", true);
+        stream.consume(";", true);
         return OK({});
     }
 
-    void VerilogParser::parse_attribute(std::vector<VerilogDataEntry>& attributes)
+    void VerilogParser::parse_attribute(TokenStream<std::string_view>& stream, std::vector<VerilogDataEntry>& attributes)
     {
-        m_token_stream.consume("(*", true);
+        stream.consume("(*", true);
 
         // extract attributes
         do
         {
             VerilogDataEntry attribute;
-            attribute.m_name = m_token_stream.consume().string;
+            attribute.m_name = stream.consume().string;
 
             // attribute value specified?
-            if (m_token_stream.consume("="))
+            if (stream.consume("="))
             {
-                attribute.m_value = m_token_stream.consume();
+                attribute.m_value = stream.consume();
 
                 // remove "
                 if (attribute.m_value[0] == '\"' && attribute.m_value.back() == '\"')
@@ -966,145 +1235,330 @@ namespace hal
 
             attributes.push_back(std::move(attribute));
 
-        } while (m_token_stream.consume(",", false));
+        } while (stream.consume(",", false));
+
+        stream.consume("*)", true);
+    }
+
+    Result<std::monostate> VerilogParser::parse_instance(TokenStream<std::string_view>& stream, VerilogModule* verilog_module, std::vector<VerilogDataEntry>& attributes)
+    {
+        auto instance    = std::make_unique<VerilogInstance>();
+        u32 line_number  = stream.peek().number;
+        instance->m_type = stream.consume().string;
+
+        // parse generics map
+        if (stream.consume("#("))
+        {
+            if (auto res = parse_parameter_assign(stream); res.is_error())
+            {
+                return ERR_APPEND(res.get_error(), "could not parse instance of type '" + instance->m_type + "': unable to parse parameter assignment (line " + std::to_string(line_number) + ")");
+            }
+            else
+            {
+                instance->m_parameters = res.get();
+            }
+        }
+
+        // parse instance name
+        instance->m_name = stream.consume().string;
+
+        // parse port map
+        if (auto res = parse_port_assign(stream, instance.get()); res.is_error())
+        {
+            return ERR_APPEND(res.get_error(),
+                              "could not parse instance '" + instance->m_name + "' of type '" + instance->m_type + "': unable to parse port assignment (line " + std::to_string(line_number) + ")");
+        }
+
+        // assign attributes to instance
+        instance->m_attributes = attributes;
+        attributes.clear();
+
+        verilog_module->m_instances_by_name[instance->m_name] = instance.get();
+        verilog_module->m_instances.push_back(std::move(instance));
+
+        return OK({});
+    }
+
+    Result<std::monostate> VerilogParser::parse_port_assign(TokenStream<std::string_view>& stream, VerilogInstance* instance)
+    {
+        u32 line_number = stream.peek().number;
+        stream.consume("(", true);
+        u32 line_end = stream.find_next(";");
+        if (stream.peek() == ".")
+        {
+            do
+            {
+                stream.consume(".");
+                VerilogPortAssignment port_assignment;
+                port_assignment.m_port_name = stream.consume().string;
+                stream.consume("(", true);
+                if (auto res = parse_assignment_expression(stream.extract_until(")")); res.is_error())
+                {
+                    return ERR_APPEND(res.get_error(), "could not parse port assignment: unable to parse assignment expression (line " + std::to_string(line_number) + ")");
+                }
+                else
+                {
+                    port_assignment.m_assignment = res.get();
+                }
+                stream.consume(")", true);
+                if (port_assignment.m_assignment.empty())
+                {
+                    continue;
+                }
+                instance->m_port_assignments.push_back(std::move(port_assignment));
+            } while (stream.consume(",", false));
+        }
+        else
+        {
+            do
+            {
+                VerilogPortAssignment port_assignment;
+                if (auto res = parse_assignment_expression(stream.extract_until(",", line_end - 1)); res.is_error())
+                {
+                    return ERR_APPEND(res.get_error(), "could not parse port assignment: unable to parse assignment expression (line " + std::to_string(line_number) + ")");
+                }
+                else
+                {
+                    port_assignment.m_assignment = res.get();
+                }
+                if (port_assignment.m_assignment.empty())
+                {
+                    continue;
+                }
+                instance->m_port_assignments.push_back(std::move(port_assignment));
+            } while (stream.consume(",", false));
+        }
+
+        stream.consume(")", true);
+        stream.consume(";", true);
+
+        return OK({});
+    }
+
+    Result<std::vector<VerilogParser::VerilogDataEntry>> VerilogParser::parse_parameter_assign(TokenStream<std::string_view>& stream)
+    {
+        std::vector<VerilogDataEntry> generics;
+
+        do
+        {
+            if (stream.consume(".", false))
+            {
+                const Token<std::string> lhs = stream.join_until("(", "");
+                stream.consume("(", true);
+                const Token<std::string> rhs = stream.join_until(")", "");
+                stream.consume(")", true);
+
+                if (const auto res = parse_parameter_value(rhs); res.is_ok())
+                {
+                    const auto value = res.get();
+                    generics.push_back(VerilogDataEntry({lhs.string, value.first, value.second}));
+                }
+                else
+                {
+                    log_warning("verilog_parser", "{}", res.get_error().get());
+                }
+            }
+        } while (stream.consume(",", false));
+
+        stream.consume(")", true);
+
+        return OK(generics);
+    }
+
+    // ###########################################################################
+    // ###########      Assemble Netlist from Intermediate Format       ##########
+    // ###########################################################################
+
+    void VerilogParser::prepare_instantiation(const GateLibrary* gate_library)
+    {
+        m_gate_types.clear();
+        m_gnd_gate_types.clear();
+        m_vcc_gate_types.clear();
+        m_module_instantiation_count.clear();
+        m_instance_name_occurences.clear();
+        m_net_name_occurences.clear();
+        m_net_by_name.clear();
+        m_nets_to_merge.clear();
+        m_module_ports.clear();
+        m_module_port_by_net.clear();
+        m_instantiated_modules.clear();
+        m_expanded_gate_port_assignments.clear();
+        m_zero_net = nullptr;
+        m_one_net  = nullptr;
+
+        // buffer gate types
+        m_gate_types     = gate_library->get_gate_types();
+        m_gnd_gate_types = gate_library->get_gnd_gate_types();
+        m_vcc_gate_types = gate_library->get_vcc_gate_types();
+    }
+
+    Result<VerilogParser::VerilogModule*> VerilogParser::find_top_module() const
+    {
+        // TODO: This tries to find the topmodule by searching for a module that is not referenced by any other module. This fails when there are multiple of those modules (for example with unused modules). There is also a top=1 flag that is set bz yosys for example that we could check first, before using this approach.
+        std::map<std::string, u32> module_name_to_refereneces;
+        for (const auto& [_name, module] : m_modules_by_name)
+        {
+            for (const auto& instance : module->m_instances)
+            {
+                if (const auto it = m_modules_by_name.find(instance->m_type); it != m_modules_by_name.end())
+                {
+                    module_name_to_refereneces[it->first]++;
+                }
+            }
+        }
+
+        std::vector<std::string> top_module_candidates;
+        for (const auto& [name, module] : m_modules_by_name)
+        {
+            if (module_name_to_refereneces.find(name) == module_name_to_refereneces.end())
+            {
+                top_module_candidates.push_back(name);
+            }
+        }
+
+        if (top_module_candidates.empty())
+        {
+            return ERR("could not find top module of Verilog netlist '" + m_path.string() + "': unable to find any top module candidates");
+        }
+
+        if (top_module_candidates.size() > 1)
+        {
+            return ERR("could not find top module of Verilog netlist '" + m_path.string() + "': found multiple modules as candidates for the top module");
+        }
 
-        m_token_stream.consume("*)", true);
+        return OK(m_modules_by_name.at(top_module_candidates.front()));
     }
 
-    Result<std::monostate> VerilogParser::parse_instance(VerilogModule* verilog_module, std::vector<VerilogDataEntry>& attributes)
+    Result<std::monostate> VerilogParser::instantiate_netlist()
     {
-        auto instance    = std::make_unique<VerilogInstance>();
-        u32 line_number  = m_token_stream.peek().number;
-        instance->m_type = m_token_stream.consume().string;
+        const GateLibrary* gate_library = m_netlist->get_gate_library();
 
-        // parse generics map
-        if (m_token_stream.consume("#("))
+        prepare_instantiation(gate_library);
+
+        // create const 0 and const 1 net, will be removed if unused
+        m_zero_net = m_netlist->create_net("'0'");
+        if (m_zero_net == nullptr)
         {
-            if (auto res = parse_parameter_assign(); res.is_error())
-            {
-                return ERR_APPEND(res.get_error(), "could not parse instance of type '" + instance->m_type + "': unable to parse parameter assignment (line " + std::to_string(line_number) + ")");
-            }
-            else
-            {
-                instance->m_parameters = res.get();
-            }
+            return ERR("could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': failed to create zero net");
         }
+        m_net_by_name[m_zero_net->get_name()] = m_zero_net;
 
-        // parse instance name
-        instance->m_name = m_token_stream.consume().string;
+        m_one_net = m_netlist->create_net("'1'");
+        if (m_one_net == nullptr)
+        {
+            return ERR("could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': failed to create one net");
+        }
+        m_net_by_name[m_one_net->get_name()] = m_one_net;
 
-        // parse port map
-        if (auto res = parse_port_assign(instance.get()); res.is_error())
+        VerilogModule* top_module;
+        if (auto res = find_top_module(); res.is_error())
         {
-            return ERR_APPEND(res.get_error(),
-                              "could not parse instance '" + instance->m_name + "' of type '" + instance->m_type + "': unable to parse port assignment (line " + std::to_string(line_number) + ")");
+            return ERR_APPEND(res.get_error(), "could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': unable to find top module");
+        }
+        else
+        {
+            top_module = res.get();
         }
 
-        // assign attributes to instance
-        instance->m_attributes = attributes;
-        attributes.clear();
+        // construct the netlist with the the top module
+        if (const auto res = construct_netlist(top_module); res.is_error())
+        {
+            return ERR_APPEND(res.get_error(), "could not instantiate Verilog netlist '" + m_path.string() + "' with gate library '" + gate_library->get_name() + "': unable to construct netlist");
+        }
 
-        verilog_module->m_instances_by_name[instance->m_name] = instance.get();
-        verilog_module->m_instances.push_back(std::move(instance));
+        delete_unused_nets(m_netlist->get_nets());
+
+        m_netlist->load_gate_locations_from_data();
+
+        // remember the module definitions to allow for incremental updates
+        std::map<std::string, std::pair<u64, u64>> hashes;
+        for (const auto& [module, verilog_module] : m_instantiated_modules)
+        {
+            hashes[module->get_name()] = std::make_pair(verilog_module->m_hash, verilog_module->m_subtree_hash.value_or(verilog_module->m_hash));
+        }
+        set_definition_hashes(m_netlist->get_top_module(), hashes);
+        m_netlist->get_top_module()->set_data(update_data_category, naming_hash_key, "string", get_naming_hash());
 
         return OK({});
     }
 
-    Result<std::monostate> VerilogParser::parse_port_assign(VerilogInstance* instance)
+    Result<std::monostate> VerilogParser::construct_netlist(VerilogModule* top_module)
     {
-        u32 line_number = m_token_stream.peek().number;
-        m_token_stream.consume("(", true);
-        u32 line_end = m_token_stream.find_next(";");
-        if (m_token_stream.peek() == ".")
+        m_netlist->set_design_name(top_module->m_name);
+        m_netlist->enable_automatic_net_checks(false);
+
+        count_name_occurences(top_module);
+        expand_gate_port_assignments();
+
+        // for the top module, generate global i/o signals for all ports
+        std::unordered_map<std::string, std::string> top_assignments;
+        for (const auto& port : top_module->m_ports)
         {
-            do
+            for (const auto& expanded_port_identifier : port->m_expanded_identifiers)
             {
-                m_token_stream.consume(".");
-                VerilogPortAssignment port_assignment;
-                port_assignment.m_port_name = m_token_stream.consume().string;
-                m_token_stream.consume("(", true);
-                if (auto res = parse_assignment_expression(m_token_stream.extract_until(")")); res.is_error())
+                const auto signal_name = get_unique_alias("", expanded_port_identifier + "__GLOBAL_IO__", m_net_name_occurences);
+
+                Net* global_port_net = m_netlist->create_net(signal_name);
+                if (global_port_net == nullptr)
                 {
-                    return ERR_APPEND(res.get_error(), "could not parse port assignment: unable to parse assignment expression (line " + std::to_string(line_number) + ")");
+                    return ERR("could not construct netlist: failed to create global I/O net '" + signal_name + "'");
                 }
-                else
+
+                m_net_by_name[signal_name] = global_port_net;
+
+                // assign global port nets to ports of top module
+                top_assignments[expanded_port_identifier] = signal_name;
+
+                if (port->m_direction == PinDirection::input || port->m_direction == PinDirection::inout)
                 {
-                    port_assignment.m_assignment = res.get();
+                    if (!global_port_net->mark_global_input_net())
+                    {
+                        return ERR("could not construct netlist: failed to mark global I/O net '" + signal_name + "' as global input");
+                    }
                 }
-                m_token_stream.consume(")", true);
-                if (port_assignment.m_assignment.empty())
+
+                if (port->m_direction == PinDirection::output || port->m_direction == PinDirection::inout)
                 {
-                    continue;
+                    if (!global_port_net->mark_global_output_net())
+                    {
+                        return ERR("could not construct netlist: failed to mark global I/O net '" + signal_name + "' as global output");
+                    }
                 }
-                instance->m_port_assignments.push_back(std::move(port_assignment));
-            } while (m_token_stream.consume(",", false));
+            }
         }
-        else
+
+        if (auto res = instantiate_module("top_module", top_module, nullptr, top_assignments); res.is_error())
         {
-            do
-            {
-                VerilogPortAssignment port_assignment;
-                if (auto res = parse_assignment_expression(m_token_stream.extract_until(",", line_end - 1)); res.is_error())
-                {
-                    return ERR_APPEND(res.get_error(), "could not parse port assignment: unable to parse assignment expression (line " + std::to_string(line_number) + ")");
-                }
-                else
-                {
-                    port_assignment.m_assignment = res.get();
-                }
-                if (port_assignment.m_assignment.empty())
-                {
-                    continue;
-                }
-                instance->m_port_assignments.push_back(std::move(port_assignment));
-            } while (m_token_stream.consume(",", false));
+            return ERR_APPEND(res.get_error(), "could not construct netlist: unable to instantiate top module");
         }
 
-        m_token_stream.consume(")", true);
-        m_token_stream.consume(";", true);
-
-        return OK({});
-    }
-
-    Result<std::vector<VerilogParser::VerilogDataEntry>> VerilogParser::parse_parameter_assign()
-    {
-        std::vector<VerilogDataEntry> generics;
+        if (auto res = merge_nets({}); res.is_error())
+        {
+            return ERR_APPEND(res.get_error(), "could not construct netlist: unable to merge nets");
+        }
 
-        do
+        if (auto res = add_global_constant_gates(); res.is_error())
         {
-            if (m_token_stream.consume(".", false))
-            {
-                const Token<std::string> lhs = m_token_stream.join_until("(", "");
-                m_token_stream.consume("(", true);
-                const Token<std::string> rhs = m_token_stream.join_until(")", "");
-                m_token_stream.consume(")", true);
+            return ERR_APPEND(res.get_error(), "could not construct netlist: unable to add global constant gates");
+        }
 
-                if (const auto res = parse_parameter_value(rhs); res.is_ok())
-                {
-                    const auto value = res.get();
-                    generics.push_back(VerilogDataEntry({lhs.string, value.first, value.second}));
-                }
-                else
-                {
-                    log_warning("verilog_parser", "{}", res.get_error().get());
-                }
-            }
-        } while (m_token_stream.consume(",", false));
+        // update module nets, internal nets, input nets, and output nets
+        for (Module* module : m_netlist->get_modules())
+        {
+            module->update_nets();
+        }
 
-        m_token_stream.consume(")", true);
+        if (auto res = assign_module_pins(); res.is_error())
+        {
+            return ERR_APPEND(res.get_error(), "could not construct netlist: unable to assign module pins");
+        }
 
-        return OK(generics);
+        m_netlist->enable_automatic_net_checks(true);
+        return OK({});
     }
 
-    // ###########################################################################
-    // ###########      Assemble Netlist from Intermediate Format       ##########
-    // ###########################################################################
-
-    Result<std::monostate> VerilogParser::construct_netlist(VerilogModule* top_module)
+    void VerilogParser::count_name_occurences(VerilogModule* top_module)
     {
-        m_netlist->set_design_name(top_module->m_name);
-        m_netlist->enable_automatic_net_checks(false);
-
         // preparations for alias: count the occurences of all names
         std::queue<VerilogModule*> q;
         q.push(top_module);
@@ -1138,139 +1592,114 @@ namespace hal
                 }
             }
         }
+    }
 
+    void VerilogParser::expand_gate_port_assignments()
+    {
+        // detect unused modules
+        std::vector<std::pair<VerilogModule*, VerilogInstance*>> used_instances;
         for (auto& [module_name, verilog_module] : m_modules_by_name)
         {
-            // detect unused modules
             if (m_module_instantiation_count[module_name] == 0)
             {
                 log_warning("verilog_parser", "module '{}' has been defined in the netlist but is not instantiated.", module_name);
                 continue;
             }
 
-            // expand gate pin assignments
             for (const auto& instance : verilog_module->m_instances)
             {
-                if (const auto gate_type_it = m_gate_types.find(instance->m_type); gate_type_it != m_gate_types.end())
+                used_instances.push_back(std::make_pair(verilog_module, instance.get()));
+                if (m_gate_types.find(instance->m_type) != m_gate_types.end())
+                {
+                    m_expanded_gate_port_assignments[instance.get()];
+                }
+            }
+        }
+
+        // expand gate pin assignments, all entries exist beforehand so that every job only writes to its own list
+        utils::parallel_for(used_instances.size(), [this, &used_instances](u32 idx) {
+            auto [verilog_module, instance] = used_instances.at(idx);
+            if (const auto gate_type_it = m_gate_types.find(instance->m_type); gate_type_it != m_gate_types.end())
+            {
+                auto& expanded_port_assignments = m_expanded_gate_port_assignments.at(instance);
+                if (!instance->m_port_assignments.empty())
                 {
-                    if (!instance->m_port_assignments.empty())
+                    // all port assignments by name
+                    if (instance->m_port_assignments.front().m_port_name.has_value())
                     {
-                        // all port assignments by name
-                        if (instance->m_port_assignments.front().m_port_name.has_value())
+                        // cache pin groups
+                        std::unordered_map<std::string, std::vector<std::string>> pin_groups;
+                        for (const auto pin_group : gate_type_it->second->get_pin_groups())
                         {
-                            // cache pin groups
-                            std::unordered_map<std::string, std::vector<std::string>> pin_groups;
-                            for (const auto pin_group : gate_type_it->second->get_pin_groups())
+                            const auto pins = pin_group->get_pins();
+                            for (auto it = pins.rbegin(); it != pins.rend(); it++)
                             {
-                                const auto pins = pin_group->get_pins();
-                                for (auto it = pins.rbegin(); it != pins.rend(); it++)
-                                {
-                                    const auto* pin = *it;
-                                    pin_groups[pin_group->get_name()].push_back(pin->get_name());
-                                }
+                                const auto* pin = *it;
+                                pin_groups[pin_group->get_name()].push_back(pin->get_name());
                             }
+                        }
 
-                            for (const auto& port_assignment : instance->m_port_assignments)
+                        for (const auto& port_assignment : instance->m_port_assignments)
+                        {
+                            std::vector<std::string> right_port = expand_assignment_expression(verilog_module, port_assignment.m_assignment);
+                            if (!right_port.empty())
                             {
-                                std::vector<std::string> right_port = expand_assignment_expression(verilog_module, port_assignment.m_assignment);
-                                if (!right_port.empty())
+                                std::vector<std::string> left_port;
+
+                                const auto& port_name = port_assignment.m_port_name.value();
+                                if (const auto group_it = pin_groups.find(port_name); group_it != pin_groups.end())
                                 {
-                                    std::vector<std::string> left_port;
-
-                                    const auto& port_name = port_assignment.m_port_name.value();
-                                    if (const auto group_it = pin_groups.find(port_name); group_it != pin_groups.end())
-                                    {
-                                        left_port = group_it->second;
-                                    }
-                                    else
-                                    {
-                                        left_port.push_back(port_name);
-                                    }
-
-                                    u32 max_size = right_port.size() <= left_port.size() ? right_port.size() : left_port.size();
-
-                                    for (u32 i = 0; i < max_size; i++)
-                                    {
-                                        instance->m_expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
-                                    }
+                                    left_port = group_it->second;
                                 }
-                            }
-                        }
-                        // all port assignments by order
-                        else
-                        {
-                            // cache pins
-                            std::vector<std::string> pins = gate_type_it->second->get_pin_names();
-                            auto pin_it                   = pins.begin();
-
-                            for (const auto& port_assignment : instance->m_port_assignments)
-                            {
-                                std::vector<std::string> right_port = expand_assignment_expression(verilog_module, port_assignment.m_assignment);
-                                if (!right_port.empty())
+                                else
                                 {
-                                    std::vector<std::string> left_port;
-
-                                    for (u32 i = 0; i < right_port.size() && pin_it != pins.end(); i++)
-                                    {
-                                        left_port.push_back(*pin_it++);
-                                    }
+                                    left_port.push_back(port_name);
+                                }
 
-                                    u32 max_size = right_port.size() <= left_port.size() ? right_port.size() : left_port.size();
+                                u32 max_size = right_port.size() <= left_port.size() ? right_port.size() : left_port.size();
 
-                                    for (u32 i = 0; i < max_size; i++)
-                                    {
-                                        instance->m_expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
-                                    }
+                                for (u32 i = 0; i < max_size; i++)
+                                {
+                                    expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
                                 }
                             }
                         }
                     }
-                }
-            }
-        }
-
-        // for the top module, generate global i/o signals for all ports
-        std::unordered_map<std::string, std::string> top_assignments;
-        for (const auto& port : top_module->m_ports)
-        {
-            for (const auto& expanded_port_identifier : port->m_expanded_identifiers)
-            {
-                const auto signal_name = get_unique_alias("", expanded_port_identifier + "__GLOBAL_IO__", m_net_name_occurences);
-
-                Net* global_port_net = m_netlist->create_net(signal_name);
-                if (global_port_net == nullptr)
-                {
-                    return ERR("could not construct netlist: failed to create global I/O net '" + signal_name + "'");
-                }
+                    // all port assignments by order
+                    else
+                    {
+                        // cache pins
+                        std::vector<std::string> pins = gate_type_it->second->get_pin_names();
+                        auto pin_it                   = pins.begin();
 
-                m_net_by_name[signal_name] = global_port_net;
+                        for (const auto& port_assignment : instance->m_port_assignments)
+                        {
+                            std::vector<std::string> right_port = expand_assignment_expression(verilog_module, port_assignment.m_assignment);
+                            if (!right_port.empty())
+                            {
+                                std::vector<std::string> left_port;
 
-                // assign global port nets to ports of top module
-                top_assignments[expanded_port_identifier] = signal_name;
+                                for (u32 i = 0; i < right_port.size() && pin_it != pins.end(); i++)
+                                {
+                                    left_port.push_back(*pin_it++);
+                                }
 
-                if (port->m_direction == PinDirection::input || port->m_direction == PinDirection::inout)
-                {
-                    if (!global_port_net->mark_global_input_net())
-                    {
-                        return ERR("could not construct netlist: failed to mark global I/O net '" + signal_name + "' as global input");
-                    }
-                }
+                                u32 max_size = right_port.size() <= left_port.size() ? right_port.size() : left_port.size();
 
-                if (port->m_direction == PinDirection::output || port->m_direction == PinDirection::inout)
-                {
-                    if (!global_port_net->mark_global_output_net())
-                    {
-                        return ERR("could not construct netlist: failed to mark global I/O net '" + signal_name + "' as global output");
+                                for (u32 i = 0; i < max_size; i++)
+                                {
+                                    expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
+                                }
+                            }
+                        }
                     }
                 }
             }
-        }
-
-        if (auto res = instantiate_module("top_module", top_module, nullptr, top_assignments); res.is_error())
-        {
-            return ERR_APPEND(res.get_error(), "could not construct netlist: unable to instantiate top module");
-        }
+        });
+    }
 
+    Result<std::monostate> VerilogParser::merge_nets(const std::unordered_set<Net*>& protected_nets)
+    {
         // merge nets without gates in between them
         std::unordered_map<std::string, std::string> merged_nets;
         std::unordered_map<std::string, std::vector<std::string>> master_to_slaves;
@@ -1311,6 +1740,12 @@ namespace hal
                 continue;
             }
 
+            if (protected_nets.find(slave_net) != protected_nets.end())
+            {
+                return ERR("could not merge nets: net '" + slave_net->get_name() + "' with ID " + std::to_string(slave_net->get_id()) + " cannot be merged into net '" + master_net->get_name()
+                           + "' with ID " + std::to_string(master_net->get_id()) + " as it must not be deleted");
+            }
+
             // merge sources
             if (slave_net->is_global_input_net())
             {
@@ -1324,14 +1759,14 @@ namespace hal
 
                 if (!slave_net->remove_source(src))
                 {
-                    return ERR("could not construct netlist: failed to remove source from net '" + slave_net->get_name() + "' with ID " + std::to_string(slave_net->get_id()));
+                    return ERR("could not merge nets: failed to remove source from net '" + slave_net->get_name() + "' with ID " + std::to_string(slave_net->get_id()));
                 }
 
                 if (!master_net->is_a_source(src_gate, src_pin))
                 {
                     if (!master_net->add_source(src_gate, src_pin))
                     {
-                        return ERR("could not construct netlist: failed to add source to net '" + master_net->get_name() + "' with ID " + std::to_string(master_net->get_id()));
+                        return ERR("could not merge nets: failed to add source to net '" + master_net->get_name() + "' with ID " + std::to_string(master_net->get_id()));
                     }
                 }
             }
@@ -1349,14 +1784,14 @@ namespace hal
 
                 if (!slave_net->remove_destination(dst))
                 {
-                    return ERR("could not construct netlist: failed to remove destination from net '" + slave_net->get_name() + "' with ID " + std::to_string(slave_net->get_id()));
+                    return ERR("could not merge nets: failed to remove destination from net '" + slave_net->get_name() + "' with ID " + std::to_string(slave_net->get_id()));
                 }
 
                 if (!master_net->is_a_destination(dst_gate, dst_pin))
                 {
                     if (!master_net->add_destination(dst_gate, dst_pin))
                     {
-                        return ERR("could not construct netlist: failed to add destination to net '" + master_net->get_name() + "' with ID " + std::to_string(master_net->get_id()));
+                        return ERR("could not merge nets: failed to add destination to net '" + master_net->get_name() + "' with ID " + std::to_string(master_net->get_id()));
                     }
                 }
             }
@@ -1386,6 +1821,15 @@ namespace hal
                 m_module_port_by_net.erase(it);
             }
 
+            if (slave_net == m_zero_net)
+            {
+                m_zero_net = nullptr;
+            }
+            else if (slave_net == m_one_net)
+            {
+                m_one_net = nullptr;
+            }
+
             m_netlist->delete_net(slave_net);
             m_net_by_name.erase(slave);
             merged_nets[slave] = master;
@@ -1393,16 +1837,15 @@ namespace hal
         }
 
         // annotate all surviving master nets with the net names that where merged into them
-        for (auto& master_net : m_netlist->get_nets())
+        for (const auto& [master_name, master_net] : m_net_by_name)
         {
-            const auto master_name = master_net->get_name();
-
             if (const auto m2s_it = master_to_slaves.find(master_name); m2s_it != master_to_slaves.end())
             {
-                std::vector<std::vector<std::string>> merged_slaves;
-                auto current_slaves = m2s_it->second;
+                // nets that existed before an incremental update may already carry an annotation that is extended
+                std::vector<std::vector<std::string>> merged_slaves = get_merged_net_names(master_net);
+                auto current_slaves                                 = m2s_it->second;
 
-                while (!current_slaves.empty())
+                for (u32 depth = 0; !current_slaves.empty(); depth++)
                 {
                     std::vector<std::string> next_slaves;
                     for (const auto& s : current_slaves)
@@ -1413,7 +1856,21 @@ namespace hal
                         }
                     }
 
-                    merged_slaves.push_back(current_slaves);
+                    if (depth == merged_slaves.size())
+                    {
+                        merged_slaves.push_back(current_slaves);
+                    }
+                    else
+                    {
+                        std::vector<std::string>& slaves = merged_slaves.at(depth);
+                        for (const auto& s : current_slaves)
+                        {
+                            if (std::find(slaves.begin(), slaves.end(), s) == slaves.end())
+                            {
+                                slaves.push_back(s);
+                            }
+                        }
+                    }
                     current_slaves = next_slaves;
                     next_slaves.clear();
                 }
@@ -1440,8 +1897,13 @@ namespace hal
             }
         }
 
+        return OK({});
+    }
+
+    Result<std::monostate> VerilogParser::add_global_constant_gates()
+    {
         // add global GND gate if required by any instance
-        if (m_netlist->get_gnd_gates().empty())
+        if (m_zero_net != nullptr && m_netlist->get_gnd_gates().empty())
         {
             if (!m_zero_net->get_destinations().empty())
             {
@@ -1467,7 +1929,7 @@ namespace hal
         }
 
         // add global VCC gate if required by any instance
-        if (m_netlist->get_vcc_gates().empty())
+        if (m_one_net != nullptr && m_netlist->get_vcc_gates().empty())
         {
             if (!m_one_net->get_destinations().empty())
             {
@@ -1492,12 +1954,11 @@ namespace hal
             }
         }
 
-        // update module nets, internal nets, input nets, and output nets
-        for (Module* module : m_netlist->get_modules())
-        {
-            module->update_nets();
-        }
+        return OK({});
+    }
 
+    Result<std::monostate> VerilogParser::assign_module_pins()
+    {
         // assign module pins
         for (const auto& [module, ports] : m_module_ports)
         {
@@ -1514,14 +1975,37 @@ namespace hal
                 if (auto res = module->create_pin(port_name, port_net); res.is_error())
                 {
                     return ERR_APPEND(res.get_error(),
-                                      "could not construct netlist: failed to create pin '" + port_name + "' at net '" + port_net->get_name() + "' with ID " + std::to_string(port_net->get_id())
+                                      "could not assign module pins: failed to create pin '" + port_name + "' at net '" + port_net->get_name() + "' with ID " + std::to_string(port_net->get_id())
                                           + " within module '" + module->get_name() + "' with ID " + std::to_string(module->get_id()));
                 }
             }
         }
 
-        m_netlist->enable_automatic_net_checks(true);
-        return OK({});
+        return OK({});
+    }
+
+    void VerilogParser::delete_unused_nets(const std::vector<Net*>& nets)
+    {
+        std::queue<Net*> nets_to_be_deleted;
+
+        for (auto net : nets)
+        {
+            const u32 num_of_sources      = net->get_num_of_sources();
+            const u32 num_of_destinations = net->get_num_of_destinations();
+            const bool no_source          = num_of_sources == 0 && !(net->is_global_input_net() && num_of_destinations != 0);
+            const bool no_destination     = num_of_destinations == 0 && !(net->is_global_output_net() && num_of_sources != 0);
+            if (no_source && no_destination)
+            {
+                nets_to_be_deleted.push(net);
+            }
+        }
+
+        while (!nets_to_be_deleted.empty())
+        {
+            Net* net = nets_to_be_deleted.front();
+            nets_to_be_deleted.pop();
+            m_netlist->delete_net(net);
+        }
     }
 
     Result<Module*> VerilogParser::instantiate_module(const std::string& instance_identifier,
@@ -1555,6 +2039,7 @@ namespace hal
             return ERR("could not create instance '" + instance_identifier + "' of type '" + instance_type + "': failed to create module");
         }
         module->set_type(instance_type);
+        m_instantiated_modules.push_back(std::make_pair(module, verilog_module));
 
         // assign entity-level attributes
         for (const VerilogDataEntry& attribute : verilog_module->m_attributes)
@@ -1687,31 +2172,18 @@ namespace hal
             // will later hold either module or gate, so attributes can be assigned properly
             DataContainer* container = nullptr;
 
-            // assign actual signal names to ports
-            std::unordered_map<std::string, std::string> instance_assignments;
-
             // if the instance is another entity, recursively instantiate it
             if (auto module_it = m_modules_by_name.find(instance->m_type); module_it != m_modules_by_name.end())
             {
-                // expand port assignments
-                for (const auto& [port, assignment] : instance->m_expanded_port_assignments)
+                // assign actual signal names to ports
+                std::unordered_map<std::string, std::string> instance_assignments;
+                if (auto res = get_instance_assignments(instance.get(), signal_alias); res.is_error())
                 {
-                    if (const auto alias_it = signal_alias.find(assignment); alias_it != signal_alias.end())
-                    {
-                        instance_assignments[port] = alias_it->second;
-                    }
-                    else if (assignment == "'0'" || assignment == "'1'")
-                    {
-                        instance_assignments[port] = assignment;
-                    }
-                    else if (assignment == "'Z'" || assignment == "'X'" || assignment.empty())
-                    {
-                        continue;
-                    }
-                    else
-                    {
-                        return ERR("could not create instance '" + instance_identifier + "' of type '" + instance_type + "': port assignment '" + port + " = " + assignment + "' is invalid");
-                    }
+                    return ERR_APPEND(res.get_error(), "could not create instance '" + instance_identifier + "' of type '" + instance_type + "': unable to assign ports of instance '" + instance->m_name + "'");
+                }
+                else
+                {
+                    instance_assignments = res.get();
                 }
 
                 if (auto res = instantiate_module(instance->m_name, module_it->second, module, instance_assignments); res.is_error())
@@ -1764,7 +2236,7 @@ namespace hal
                 }
 
                 // expand pin assignments
-                for (const auto& [pin, assignment] : instance->m_expanded_port_assignments)
+                for (const auto& [pin, assignment] : m_expanded_gate_port_assignments.at(instance.get()))
                 {
                     std::string signal;
 
@@ -1878,6 +2350,429 @@ namespace hal
         return OK(module);
     }
 
+    Result<std::unordered_map<std::string, std::string>> VerilogParser::get_instance_assignments(const VerilogInstance* instance,
+                                                                                                 const std::unordered_map<std::string, std::string>& signal_alias) const
+    {
+        std::unordered_map<std::string, std::string> instance_assignments;
+
+        // expand port assignments
+        for (const auto& [port, assignment] : instance->m_expanded_port_assignments)
+        {
+            if (const auto alias_it = signal_alias.find(assignment); alias_it != signal_alias.end())
+            {
+                instance_assignments[port] = alias_it->second;
+            }
+            else if (assignment == "'0'" || assignment == "'1'")
+            {
+                instance_assignments[port] = assignment;
+            }
+            else if (assignment == "'Z'" || assignment == "'X'" || assignment.empty())
+            {
+                continue;
+            }
+            else
+            {
+                return ERR("could not assign ports of instance '" + instance->m_name + "' of type '" + instance->m_type + "': port assignment '" + port + " = " + assignment + "' is invalid");
+            }
+        }
+
+        return OK(instance_assignments);
+    }
+
+    // ###########################################################################
+    // ###################          Incremental Update          ##################
+    // ###########################################################################
+
+    std::string VerilogParser::get_naming_hash() const
+    {
+        // unique aliases only depend on which instance and net names occur more than once
+        auto hash_ambiguous_names = [](const std::unordered_map<std::string, u32>& name_occurences) {
+            std::vector<std::string_view> names;
+            for (const auto& [name, occurences] : name_occurences)
+            {
+                if (occurences > 1)
+                {
+                    names.push_back(name);
+                }
+            }
+            std::sort(names.begin(), names.end());
+
+            u64 hash = utils::FNV1A_OFFSET_BASIS;
+            for (const auto& name : names)
+            {
+                hash = hash_string(hash, name);
+            }
+            return hash_to_string(hash);
+        };
+
+        return hash_ambiguous_names(m_instance_name_occurences) + hash_ambiguous_names(m_net_name_occurences);
+    }
+
+    std::map<std::string, std::pair<u64, u64>> VerilogParser::get_definition_hashes(const Module* top_module) const
+    {
+        std::map<std::string, std::pair<u64, u64>> hashes;
+
+        // one line per module: definition hash, subtree hash, and module name
+        std::stringstream ss(std::get<1>(top_module->get_data(update_data_category, definition_hashes_key)));
+        std::string line;
+        while (std::getline(ss, line))
+        {
+            if (line.size() < 34)
+            {
+                continue;
+            }
+
+            try
+            {
+                hashes[line.substr(34)] = std::make_pair(std::stoull(line.substr(0, 16), nullptr, 16), std::stoull(line.substr(17, 16), nullptr, 16));
+            }
+            catch (const std::exception&)
+            {
+                continue;
+            }
+        }
+
+        return hashes;
+    }
+
+    void VerilogParser::set_definition_hashes(Module* top_module, const std::map<std::string, std::pair<u64, u64>>& hashes) const
+    {
+        std::string data;
+        for (const auto& [name, module_hashes] : hashes)
+        {
+            data += hash_to_string(module_hashes.first) + " " + hash_to_string(module_hashes.second) + " " + name + "\n";
+        }
+        top_module->set_data(update_data_category, definition_hashes_key, "string", data);
+    }
+
+    Result<std::monostate> VerilogParser::update_netlist()
+    {
+        prepare_instantiation(m_netlist->get_gate_library());
+
+        VerilogModule* top_module;
+        if (auto res = find_top_module(); res.is_error())
+        {
+            return ERR_APPEND(res.get_error(), "could not update netlist: unable to find top module");
+        }
+        else
+        {
+            top_module = res.get();
+        }
+
+        count_name_occurences(top_module);
+
+        // the previous netlist must have been instantiated from the same top module using the same unique aliases
+        Module* top                                        = m_netlist->get_top_module();
+        std::map<std::string, std::pair<u64, u64>> hashes = get_definition_hashes(top);
+        const auto top_hash_it                             = hashes.find(top->get_name());
+        if (top_hash_it == hashes.end() || top_hash_it->second.first != top_module->m_hash || top->get_type() != top_module->m_name)
+        {
+            return ERR("could not update netlist: the definition of the top module has changed");
+        }
+
+        if (std::get<1>(top->get_data(update_data_category, naming_hash_key)) != get_naming_hash())
+        {
+            return ERR("could not update netlist: the unique names of instances or nets have changed");
+        }
+
+        if (top_hash_it->second.second == top_module->m_subtree_hash.value_or(top_module->m_hash))
+        {
+            return OK({});
+        }
+
+        expand_gate_port_assignments();
+
+        // find the module instances with changed definitions within modules with unchanged definitions, these are rebuilt
+        struct Rebuild
+        {
+            Module* parent;
+            VerilogModule* parent_definition;
+            VerilogInstance* instance;
+            VerilogModule* definition;
+            Module* previous;
+            std::unordered_map<std::string, std::string> assignments;
+        };
+
+        std::vector<Rebuild> rebuilds;
+        std::vector<std::pair<Module*, VerilogModule*>> ancestors;
+        std::vector<std::pair<Module*, VerilogModule*>> stack = {std::make_pair(top, top_module)};
+        while (!stack.empty())
+        {
+            const auto [module, verilog_module] = stack.back();
+            stack.pop_back();
+            ancestors.push_back(std::make_pair(module, verilog_module));
+
+            std::unordered_map<std::string, Module*> submodules_by_name;
+            for (Module* submodule : module->get_submodules())
+            {
+                submodules_by_name[submodule->get_name()] = submodule;
+            }
+
+            std::vector<std::pair<Module*, VerilogModule*>> changed_submodules;
+            for (const auto& instance : verilog_module->m_instances)
+            {
+                const auto module_it = m_modules_by_name.find(instance->m_type);
+                if (module_it == m_modules_by_name.end())
+                {
+                    continue;
+                }
+                VerilogModule* definition = module_it->second;
+
+                const std::string alias = get_unique_alias(module->get_name(), instance->m_name, m_instance_name_occurences);
+                const auto submodule_it = submodules_by_name.find(alias);
+                if (submodule_it == submodules_by_name.end())
+                {
+                    return ERR("could not update netlist: module instance '" + alias + "' does not exist within module '" + module->get_name() + "'");
+                }
+                Module* submodule = submodule_it->second;
+                submodules_by_name.erase(submodule_it);
+
+                if (const auto hash_it = hashes.find(alias); hash_it != hashes.end() && submodule->get_type() == definition->m_name)
+                {
+                    if (hash_it->second.second == definition->m_subtree_hash.value_or(definition->m_hash))
+                    {
+                        continue;
+                    }
+                    else if (hash_it->second.first == definition->m_hash)
+                    {
+                        changed_submodules.push_back(std::make_pair(submodule, definition));
+                        continue;
+                    }
+                }
+
+                rebuilds.push_back({module, verilog_module, instance.get(), definition, submodule, {}});
+            }
+
+            if (!submodules_by_name.empty())
+            {
+                return ERR("could not update netlist: module '" + submodules_by_name.begin()->first + "' within module '" + module->get_name() + "' has not been created by the parser");
+            }
+
+            stack.insert(stack.end(), changed_submodules.rbegin(), changed_submodules.rend());
+        }
+
+        // find all nets by name, including the names of nets that have been merged into others
+        std::unordered_map<std::string, Net*> nets_by_name;
+        std::unordered_set<std::string> ambiguous_names;
+        auto add_net_name = [&nets_by_name, &ambiguous_names](const std::string& name, Net* net) {
+            if (const auto [it, inserted] = nets_by_name.emplace(name, net); !inserted && it->second != net)
+            {
+                ambiguous_names.insert(name);
+            }
+        };
+        for (Net* net : m_netlist->get_nets())
+        {
+            add_net_name(net->get_name(), net);
+            for (const auto& merged_names : get_merged_net_names(net))
+            {
+                for (const auto& name : merged_names)
+                {
+                    add_net_name(name, net);
+                }
+            }
+        }
+
+        // nets that already exist must survive merging
+        std::unordered_set<Net*> protected_nets;
+
+        for (auto [constant, constant_net] : {std::make_pair("'0'", &m_zero_net), std::make_pair("'1'", &m_one_net)})
+        {
+            if (const auto it = nets_by_name.find(constant); it != nets_by_name.end() && it->second->get_name() == constant && ambiguous_names.find(constant) == ambiguous_names.end())
+            {
+                *constant_net = it->second;
+                protected_nets.insert(it->second);
+            }
+            else if (*constant_net = m_netlist->create_net(constant); *constant_net == nullptr)
+            {
+                return ERR("could not update netlist: failed to create constant net " + std::string(constant));
+            }
+            m_net_by_name[constant] = *constant_net;
+        }
+
+        // connect the new module instances to the nets of the previous ones, which must not have been merged with each other
+        std::unordered_map<const Module*, std::unordered_map<std::string, std::string>> parent_signal_aliases;
+        for (Rebuild& rebuild : rebuilds)
+        {
+            auto& signal_alias = parent_signal_aliases[rebuild.parent];
+            if (signal_alias.empty())
+            {
+                for (const auto& signal : rebuild.parent_definition->m_signals)
+                {
+                    for (const auto& expanded_name : signal->m_expanded_names)
+                    {
+                        signal_alias[expanded_name] = get_unique_alias(rebuild.parent->get_name(), expanded_name, m_net_name_occurences);
+                    }
+                }
+            }
+
+            if (auto res = get_instance_assignments(rebuild.instance, signal_alias); res.is_error())
+            {
+                return ERR_APPEND(res.get_error(), "could not update netlist: unable to assign ports of module instance '" + rebuild.previous->get_name() + "'");
+            }
+            else
+            {
+                rebuild.assignments = res.get();
+            }
+
+            for (const auto& [port, signal] : rebuild.assignments)
+            {
+                if (m_net_by_name.find(signal) != m_net_by_name.end())
+                {
+                    continue;
+                }
+
+                const auto net_it = nets_by_name.find(signal);
+                if (net_it == nets_by_name.end() || ambiguous_names.find(signal) != ambiguous_names.end())
+                {
+                    return ERR("could not update netlist: unable to find net '" + signal + "' connected to module instance '" + rebuild.previous->get_name() + "'");
+                }
+
+                if (!protected_nets.insert(net_it->second).second)
+                {
+                    return ERR("could not update netlist: net '" + net_it->second->get_name() + "' connected to module instance '" + rebuild.previous->get_name()
+                               + "' has been merged with other nets");
+                }
+                m_net_by_name[signal] = net_it->second;
+            }
+        }
+
+        // the ports of all modules containing rebuilt module instances must not change, constant nets are not considered
+        auto get_port_nets = [](const Module* module) {
+            auto is_port = [module](Net* net) { return module->get_pin_by_net(net) != nullptr || (net->get_name() != "'0'" && net->get_name() != "'1'"); };
+            std::pair<std::unordered_set<Net*>, std::unordered_set<Net*>> port_nets;
+            std::copy_if(module->get_input_nets().begin(), module->get_input_nets().end(), std::inserter(port_nets.first, port_nets.first.end()), is_port);
+            std::copy_if(module->get_output_nets().begin(), module->get_output_nets().end(), std::inserter(port_nets.second, port_nets.second.end()), is_port);
+            return port_nets;
+        };
+
+        std::vector<std::pair<std::unordered_set<Net*>, std::unordered_set<Net*>>> previous_port_nets;
+        for (const auto& [module, _] : ancestors)
+        {
+            previous_port_nets.push_back(get_port_nets(module));
+        }
+
+        m_netlist->enable_automatic_net_checks(false);
+
+        // delete the previous module instances
+        std::unordered_set<Net*> affected_nets;
+        for (const Rebuild& rebuild : rebuilds)
+        {
+            for (Gate* gate : rebuild.previous->get_gates(nullptr, true))
+            {
+                for (Net* net : gate->get_fan_in_nets())
+                {
+                    affected_nets.insert(net);
+                }
+                for (Net* net : gate->get_fan_out_nets())
+                {
+                    affected_nets.insert(net);
+                }
+
+                if (!m_netlist->delete_gate(gate))
+                {
+                    return ERR("could not update netlist: failed to delete gate '" + gate->get_name() + "' with ID " + std::to_string(gate->get_id()));
+                }
+            }
+
+            // delete submodules before their parents
+            std::vector<Module*> modules = rebuild.previous->get_submodules(nullptr, true);
+            modules.insert(modules.begin(), rebuild.previous);
+            for (auto it = modules.rbegin(); it != modules.rend(); it++)
+            {
+                hashes.erase((*it)->get_name());
+                if (!m_netlist->delete_module(*it))
+                {
+                    return ERR("could not update netlist: failed to delete module '" + (*it)->get_name() + "' with ID " + std::to_string((*it)->get_id()));
+                }
+            }
+        }
+
+        // instantiate the new module instances
+        for (const Rebuild& rebuild : rebuilds)
+        {
+            if (auto res = instantiate_module(rebuild.instance->m_name, rebuild.definition, rebuild.parent, rebuild.assignments); res.is_error())
+            {
+                return ERR_APPEND(res.get_error(),
+                                  "could not update netlist: unable to create instance '" + rebuild.instance->m_name + "' of type '" + rebuild.definition->m_name + "' within module '"
+                                      + rebuild.parent->get_name() + "'");
+            }
+        }
+
+        if (auto res = merge_nets(protected_nets); res.is_error())
+        {
+            return ERR_APPEND(res.get_error(), "could not update netlist: unable to merge nets");
+        }
+
+        // remove global constant gates that have been added by the parser but are no longer required
+        for (Net* constant_net : {m_zero_net, m_one_net})
+        {
+            if (constant_net == nullptr || !constant_net->get_destinations().empty() || constant_net->get_num_of_sources() != 1)
+            {
+                continue;
+            }
+
+            Gate* gate = constant_net->get_sources().front()->get_gate();
+            if (gate->get_module() == top && ((gate->get_name() == "global_gnd" && gate->is_gnd_gate()) || (gate->get_name() == "global_vcc" && gate->is_vcc_gate())))
+            {
+                m_netlist->delete_gate(gate);
+            }
+        }
+
+        if (auto res = add_global_constant_gates(); res.is_error())
+        {
+            return ERR_APPEND(res.get_error(), "could not update netlist: unable to add global constant gates");
+        }
+
+        // update module nets, internal nets, input nets, and output nets
+        for (const auto& [module, _] : m_instantiated_modules)
+        {
+            module->update_nets();
+        }
+
+        for (u32 i = 0; i < ancestors.size(); i++)
+        {
+            Module* module = ancestors.at(i).first;
+            module->update_nets();
+            if (get_port_nets(module) != previous_port_nets.at(i))
+            {
+                return ERR("could not update netlist: the nets connected to the ports of module '" + module->get_name() + "' with ID " + std::to_string(module->get_id()) + " have changed");
+            }
+        }
+
+        if (auto res = assign_module_pins(); res.is_error())
+        {
+            return ERR_APPEND(res.get_error(), "could not update netlist: unable to assign module pins");
+        }
+
+        // delete nets that are no longer used
+        std::unordered_set<Net*> unused_net_candidates = affected_nets;
+        for (const auto& [_, net] : m_net_by_name)
+        {
+            unused_net_candidates.insert(net);
+        }
+
+        std::vector<Net*> nets;
+        std::copy_if(unused_net_candidates.begin(), unused_net_candidates.end(), std::back_inserter(nets), [this](Net* net) { return m_netlist->is_net_in_netlist(net); });
+        delete_unused_nets(nets);
+
+        m_netlist->enable_automatic_net_checks(true);
+
+        m_netlist->load_gate_locations_from_data();
+
+        // remember the new module definitions
+        for (const auto& [module, verilog_module] : m_instantiated_modules)
+        {
+            hashes[module->get_name()] = std::make_pair(verilog_module->m_hash, verilog_module->m_subtree_hash.value_or(verilog_module->m_hash));
+        }
+        for (const auto& [module, verilog_module] : ancestors)
+        {
+            hashes[module->get_name()] = std::make_pair(verilog_module->m_hash, verilog_module->m_subtree_hash.value_or(verilog_module->m_hash));
+        }
+        set_definition_hashes(top, hashes);
+
+        return OK({});
+    }
+
     // ###########################################################################
     // ###################          Helper Functions          ####################
     // ###########################################################################
@@ -1940,17 +2835,17 @@ namespace hal
         return unique_alias;
     }
 
-    std::vector<u32> VerilogParser::parse_range(TokenStream<std::string>& stream) const
+    std::vector<u32> VerilogParser::parse_range(TokenStream<std::string_view>& stream) const
     {
         if (stream.remaining() == 1)
         {
-            return {(u32)std::stoi(stream.consume().string)};
+            return {(u32)std::stoi(std::string(stream.consume().string))};
         }
 
         // MSB to LSB
-        const int end = std::stoi(stream.consume().string);
+        const int end = std::stoi(std::string(stream.consume().string));
         stream.consume(":", true);
-        const int start = std::stoi(stream.consume().string);
+        const int start = std::stoi(std::string(stream.consume().string));
 
         const int direction = (start <= end) ? 1 : -1;
 
@@ -2261,9 +3156,9 @@ namespace hal
         return OK(value);
     }
 
-    Result<std::vector<VerilogParser::assignment_t>> VerilogParser::parse_assignment_expression(TokenStream<std::string>&& stream) const
+    Result<std::vector<VerilogParser::assignment_t>> VerilogParser::parse_assignment_expression(TokenStream<std::string_view>&& stream) const
     {
-        std::vector<TokenStream<std::string>> parts;
+        std::vector<TokenStream<std::string_view>> parts;
 
         if (stream.size() == 0)
         {
@@ -2274,7 +3169,7 @@ namespace hal
         {
             stream.consume("{", true);
 
-            TokenStream<std::string> assignment_list_str = stream.extract_until("}");
+            TokenStream<std::string_view> assignment_list_str = stream.extract_until("}");
             stream.consume("}", true);
 
             do
@@ -2292,15 +3187,15 @@ namespace hal
 
         for (auto it = parts.rbegin(); it != parts.rend(); it++)
         {
-            TokenStream<std::string>& part_stream = *it;
+            TokenStream<std::string_view>& part_stream = *it;
 
-            const Token<std::string> signal_name_token = part_stream.consume();
-            std::string signal_name                    = signal_name_token.string;
+            const Token<std::string_view> signal_name_token = part_stream.consume();
+            std::string signal_name                         = std::string(signal_name_token.string);
 
             // (3) NUMBER
             if (isdigit(signal_name[0]) || signal_name[0] == '\'')
             {
-                if (auto res = get_binary_vector(signal_name_token); res.is_error())
+                if (auto res = get_binary_vector(signal_name); res.is_error())
                 {
                     return ERR_APPEND(res.get_error(), "could not parse assignment expression: unable to convert token to binary vector");
                 }
@@ -2320,7 +3215,7 @@ namespace hal
                     std::vector<std::vector<u32>> ranges;
                     do
                     {
-                        TokenStream<std::string> range_str = part_stream.extract_until("]");
+                        TokenStream<std::string_view> range_str = part_stream.extract_until("]");
                         ranges.emplace_back(parse_range(range_str));
                         part_stream.consume("]", true);
                     } while (part_stream.consume("[", false));
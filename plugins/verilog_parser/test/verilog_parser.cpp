@@ -5,6 +5,7 @@
 
 #include <bitset>
 #include <filesystem>
+#include <set>
 
 namespace hal {
 
@@ -3078,6 +3079,117 @@ namespace hal {
             }
         TEST_END
     }
+    /**
+     * Testing the incremental update of a netlist after the Verilog source has been edited.
+     *
+     * Functions: update
+     */
+    TEST_F(VerilogParserTest, check_incremental_update) {
+        TEST_START
+            {
+                // Change the definition of a single sub-module, the other sub-module is reused
+                const std::string sub_modules("module sub_a (a_in, a_out) ;"
+                                              "  input a_in ;"
+                                              "  output a_out ;"
+                                              "BUF gate_a ("
+                                              "  .I (a_in ),"
+                                              "  .O (a_out )"
+                                              " ) ;"
+                                              "endmodule "
+                                              "module sub_b (b_in, b_out) ;"
+                                              "  input b_in ;"
+                                              "  output b_out ;");
+                const std::string top_module("endmodule "
+                                             "module top (global_in, global_out) ;"
+                                             "  input global_in ;"
+                                             "  output global_out ;"
+                                             "  wire net_0 ;"
+                                             "sub_a inst_a ("
+                                             "  .a_in (global_in ),"
+                                             "  .a_out (net_0 )"
+                                             " ) ;"
+                                             "sub_b inst_b ("
+                                             "  .b_in (net_0 ),"
+                                             "  .b_out (global_out )"
+                                             " ) ;"
+                                             "endmodule");
+                const std::string netlist_input(sub_modules + "BUF gate_b (  .I (b_in ),  .O (b_out ) ) ;" + top_module);
+                const std::string netlist_edited(sub_modules + "INV gate_b (  .I (b_in ),  .O (b_out ) ) ;" + top_module);
+
+                const GateLibrary* gate_lib = test_utils::get_gate_library();
+                auto verilog_file = test_utils::create_sandbox_file("netlist.v", netlist_input);
+                VerilogParser verilog_parser;
+                auto nl_res = verilog_parser.parse_and_instantiate(verilog_file, gate_lib);
+                ASSERT_TRUE(nl_res.is_ok());
+                std::unique_ptr<Netlist> nl = nl_res.get();
+                ASSERT_NE(nl, nullptr);
+
+                ASSERT_EQ(nl->get_gates(test_utils::gate_name_filter("gate_a")).size(), 1);
+                Gate* gate_a = nl->get_gates(test_utils::gate_name_filter("gate_a")).front();
+
+                verilog_file = test_utils::create_sandbox_file("netlist.v", netlist_edited);
+                VerilogParser update_parser;
+                ASSERT_TRUE(update_parser.parse(verilog_file).is_ok());
+                auto update_res = update_parser.update(std::move(nl));
+                ASSERT_TRUE(update_res.is_ok());
+                auto [updated_nl, report] = update_res.get();
+                ASSERT_NE(updated_nl, nullptr);
+
+                EXPECT_FALSE(report.full_rebuild);
+                EXPECT_EQ(std::set<std::string>(report.unchanged_modules.begin(), report.unchanged_modules.end()), std::set<std::string>({"inst_a"}));
+                EXPECT_EQ(std::set<std::string>(report.changed_modules.begin(), report.changed_modules.end()), std::set<std::string>({"top_module", "inst_b"}));
+                EXPECT_TRUE(report.added_modules.empty());
+                EXPECT_TRUE(report.removed_modules.empty());
+
+                // the gate of the unchanged sub-module is kept, the gate of the changed sub-module is replaced
+                EXPECT_EQ(updated_nl->get_gates(test_utils::gate_name_filter("gate_a")), std::vector<Gate*>({gate_a}));
+                ASSERT_EQ(updated_nl->get_gates(test_utils::gate_type_filter("INV")).size(), 1);
+                Gate* gate_b = updated_nl->get_gates(test_utils::gate_type_filter("INV")).front();
+                EXPECT_EQ(gate_b->get_name(), "gate_b");
+                EXPECT_EQ(gate_b->get_module()->get_name(), "inst_b");
+                EXPECT_TRUE(updated_nl->get_gates(test_utils::gate_type_filter("BUF")).size() == 1);
+
+                Net* net_0 = updated_nl->get_nets(test_utils::net_name_filter("net_0")).front();
+                ASSERT_EQ(net_0->get_sources().size(), 1);
+                EXPECT_EQ(net_0->get_sources().front()->get_gate(), gate_a);
+                ASSERT_EQ(net_0->get_destinations().size(), 1);
+                EXPECT_EQ(net_0->get_destinations().front()->get_gate(), gate_b);
+            }
+            {
+                // Changing the top module falls back to instantiating the netlist from scratch
+                const std::string netlist_input("module top (global_in, global_out) ;"
+                                                "  input global_in ;"
+                                                "  output global_out ;"
+                                                "BUF gate_0 (  .I (global_in ),  .O (global_out ) ) ;"
+                                                "endmodule");
+                const std::string netlist_edited("module top (global_in, global_out) ;"
+                                                 "  input global_in ;"
+                                                 "  output global_out ;"
+                                                 "INV gate_0 (  .I (global_in ),  .O (global_out ) ) ;"
+                                                 "endmodule");
+
+                const GateLibrary* gate_lib = test_utils::get_gate_library();
+                auto verilog_file = test_utils::create_sandbox_file("netlist.v", netlist_input);
+                VerilogParser verilog_parser;
+                auto nl_res = verilog_parser.parse_and_instantiate(verilog_file, gate_lib);
+                ASSERT_TRUE(nl_res.is_ok());
+
+                verilog_file = test_utils::create_sandbox_file("netlist.v", netlist_edited);
+                VerilogParser update_parser;
+                ASSERT_TRUE(update_parser.parse(verilog_file).is_ok());
+                auto update_res = update_parser.update(nl_res.get());
+                ASSERT_TRUE(update_res.is_ok());
+                auto [updated_nl, report] = update_res.get();
+                ASSERT_NE(updated_nl, nullptr);
+
+                EXPECT_TRUE(report.full_rebuild);
+                EXPECT_EQ(report.changed_modules, std::vector<std::string>({"top_module"}));
+                EXPECT_EQ(updated_nl->get_gates(test_utils::gate_type_filter("INV")).size(), 1);
+                EXPECT_TRUE(updated_nl->get_gates(test_utils::gate_type_filter("BUF")).empty());
+            }
+        TEST_END
+    }
+
     /**
      * Testing the correct handling of invalid input
      *
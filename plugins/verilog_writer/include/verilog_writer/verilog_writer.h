@@ -29,13 +29,15 @@
 #include "hal_core/netlist/netlist_writer/netlist_writer.h"
 
 #include <set>
-#include <sstream>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace hal
 {
     class GateType;
+    class GatePin;
     class DataContainer;
     class Net;
     class Gate;
@@ -62,24 +64,33 @@ namespace hal
     private:
         static const std::set<std::string> valid_types;
 
-        Result<std::monostate> write_module_declaration(std::stringstream& res_stream,
+        struct EscapedGateType
+        {
+            std::string m_name;
+            std::vector<std::pair<std::string, std::vector<const GatePin*>>> m_pin_groups;
+        };
+
+        // escaped identifiers that are reused across gate instances and modules
+        std::unordered_map<const Net*, std::string> m_escaped_net_names;
+        std::unordered_map<const GateType*, EscapedGateType> m_escaped_gate_types;
+
+        Result<std::monostate> write_module_declaration(std::string& out,
                                                         const Module* module,
                                                         std::unordered_map<const Module*, std::string>& module_type_aliases,
-                                                        std::unordered_map<std::string, u32>& module_type_occurrences) const;
-        Result<std::monostate> write_gate_instance(std::stringstream& res_stream,
-                                                   const Gate* gate,
-                                                   std::unordered_map<const DataContainer*, std::string>& aliases,
-                                                   std::unordered_map<std::string, u32>& identifier_occurrences) const;
-        Result<std::monostate> write_module_instance(std::stringstream& res_stream,
+                                                        std::unordered_map<std::string, u32>& module_type_occurrences);
+        Result<std::monostate> write_gate_instance(std::string& out, const Gate* gate, const std::unordered_map<const DataContainer*, std::string>& aliases) const;
+        Result<std::monostate> write_module_instance(std::string& out,
                                                      const Module* module,
                                                      std::unordered_map<const DataContainer*, std::string>& aliases,
                                                      std::unordered_map<std::string, u32>& identifier_occurrences,
-                                                     std::unordered_map<const Module*, std::string>& module_type_aliases) const;
-        Result<std::monostate> write_parameter_assignments(std::stringstream& res_stream, const DataContainer* container) const;
-        Result<std::monostate> write_pin_assignments(std::stringstream& res_stream,
-                                                     const std::vector<std::pair<std::string, std::vector<const Net*>>>& pin_assignments,
-                                                     std::unordered_map<const DataContainer*, std::string>& aliases) const;
-        Result<std::monostate> write_parameter_value(std::stringstream& res_stream, const std::string& type, const std::string& value) const;
+                                                     const std::unordered_map<const Module*, std::string>& module_type_aliases) const;
+        Result<std::monostate> write_parameter_assignments(std::string& out, const DataContainer* container) const;
+        Result<std::monostate> write_pin_assignments(std::string& out,
+                                                     const std::vector<std::pair<std::string_view, std::vector<const Net*>>>& pin_assignments,
+                                                     const std::unordered_map<const DataContainer*, std::string>& aliases) const;
+        Result<std::monostate> write_parameter_value(std::string& out, const std::string& type, const std::string& value) const;
+        const EscapedGateType& get_escaped_gate_type(const GateType* gate_type);
+        const std::string& get_escaped_net_name(const Net* net);
         std::string get_unique_alias(std::unordered_map<std::string, u32>& name_occurrences, const std::string& name) const;
         std::string escape(const std::string& s) const;
     };
@@ -5,17 +5,27 @@
 #include "hal_core/netlist/net.h"
 #include "hal_core/netlist/netlist.h"
 #include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
 
 #include <fstream>
+#include <optional>
 
 namespace hal
 {
+    namespace
+    {
+        // number of gate instances whose text is generated by one task
+        constexpr u32 GATES_PER_CHUNK = 1024;
+
+        // size of the output file buffer
+        constexpr size_t FILE_BUFFER_SIZE = 1 << 20;
+
+    }    // namespace
+
     const std::set<std::string> VerilogWriter::valid_types = {"string", "integer", "floating_point", "bit_value", "bit_vector", "bit_string"};
 
     Result<std::monostate> VerilogWriter::write(Netlist* netlist, const std::filesystem::path& file_path)
     {
-        std::stringstream res_stream;
-
         if (netlist == nullptr)
         {
             return ERR("could not write netlist to Verilog file '" + file_path.string() + "': netlist is a 'nullptr'");
@@ -54,35 +64,53 @@ namespace hal
 
         // TODO take care of 1 and 0 nets (probably rework their handling within the core to supply a "is_gnd_net" and "is_vcc_net" function)
 
+        m_escaped_net_names.clear();
+        m_escaped_gate_types.clear();
+
+        // module declarations are streamed to the file one after another instead of assembling the entire output in memory
+        std::vector<char> file_buffer(FILE_BUFFER_SIZE);
+        std::ofstream file;
+        file.rdbuf()->pubsetbuf(file_buffer.data(), file_buffer.size());
+        file.open(file_path.string(), std::ofstream::out);
+        if (!file.is_open())
+        {
+            return ERR("could not write netlist to Verilog file '" + file_path.string() + "': failed to open file");
+        }
+        file << "`timescale 1 ps/1 ps\n";
+
         std::unordered_map<const Module*, std::string> module_aliases;
         std::unordered_map<std::string, u32> module_identifier_occurrences;
+        std::string module_text;
         for (Module* mod : ordered_modules)
         {
-            if (auto res = write_module_declaration(res_stream, mod, module_aliases, module_identifier_occurrences); res.is_error())
+            module_text.clear();
+            if (auto res = write_module_declaration(module_text, mod, module_aliases, module_identifier_occurrences); res.is_error())
             {
+                file.close();
+                std::error_code ec;
+                std::filesystem::remove(file_path, ec);
                 return ERR_APPEND(res.get_error(), "could not write netlist to Verilog file '" + file_path.string() + "': failed to write module declaration");
             }
-            res_stream << std::endl;
+            module_text += "\n";
+            file.write(module_text.data(), module_text.size());
         }
 
-        // write to file
-        std::ofstream file;
-        file.open(file_path.string(), std::ofstream::out);
-        if (!file.is_open())
+        file.close();
+        if (file.fail())
         {
-            return ERR("could not write netlist to Verilog file '" + file_path.string() + "': failed to open file");
+            return ERR("could not write netlist to Verilog file '" + file_path.string() + "': failed to write file");
         }
-        file << "`timescale 1 ps/1 ps" << std::endl;
-        file << res_stream.str();
-        file.close();
+
+        m_escaped_net_names.clear();
+        m_escaped_gate_types.clear();
 
         return OK({});
     }
 
-    Result<std::monostate> VerilogWriter::write_module_declaration(std::stringstream& res_stream,
+    Result<std::monostate> VerilogWriter::write_module_declaration(std::string& out,
                                                                    const Module* module,
                                                                    std::unordered_map<const Module*, std::string>& module_type_aliases,
-                                                                   std::unordered_map<std::string, u32>& module_type_occurrences) const
+                                                                   std::unordered_map<std::string, u32>& module_type_occurrences)
     {
         // deal with empty modules
         if (module->get_gates(nullptr, true).empty() && !module->is_top_module())
@@ -104,20 +132,24 @@ namespace hal
 
         if (const std::string& design_name = module->get_netlist()->get_design_name(); module_type_aliases.at(module) == "top_module" && !design_name.empty())
         {
-            res_stream << "module " << escape(design_name);
+            out += "module " + escape(design_name);
         }
         else
         {
-            res_stream << "module " << escape(module_type_aliases.at(module));
+            out += "module " + escape(module_type_aliases.at(module));
         }
 
+        // nets and gates make up nearly all identifiers, reserve upfront to avoid rehashing for large modules
+        const size_t num_identifiers = module->get_nets().size() + module->get_gates().size();
         std::unordered_map<const DataContainer*, std::string> aliases;
         std::unordered_map<std::string, u32> identifier_occurrences;
+        aliases.reserve(num_identifiers);
+        identifier_occurrences.reserve(num_identifiers);
 
         bool first_port = true;
-        std::stringstream tmp_stream;
+        std::string port_declarations;
 
-        res_stream << "(";
+        out += "(";
         for (const auto* pin : module->get_pins())
         {
             Net* net = pin->get_net();
@@ -127,17 +159,17 @@ namespace hal
             }
             else
             {
-                res_stream << ",";
+                out += ",";
             }
 
             aliases[net] = escape(get_unique_alias(identifier_occurrences, pin->get_name()));
 
-            res_stream << aliases.at(net);
-            tmp_stream << "    " << enum_to_string(pin->get_direction()) << " " << aliases.at(net) << ";" << std::endl;
+            out += aliases.at(net);
+            port_declarations += "    " + enum_to_string(pin->get_direction()) + " " + aliases.at(net) + ";\n";
         }
 
-        res_stream << ");" << std::endl;
-        res_stream << tmp_stream.str();
+        out += ");\n";
+        out += port_declarations;
 
         {
             // module parameters
@@ -153,13 +185,13 @@ namespace hal
                     continue;
                 }
 
-                res_stream << "    parameter " << escape(key) << " = ";
-                if (auto res = write_parameter_value(res_stream, type, value); res.is_error())
+                out += "    parameter " + escape(key) + " = ";
+                if (auto res = write_parameter_value(out, type, value); res.is_error())
                 {
                     return ERR_APPEND(res.get_error(),
                                       "could not write declaration of module '" + module->get_name() + "' with ID " + std::to_string(module->get_id()) + ": failed to write parameter value");
                 }
-                res_stream << ";" << std::endl;
+                out += ";\n";
             }
         }
 
@@ -177,28 +209,67 @@ namespace hal
 
             if (aliases.find(net) == aliases.end())
             {
-                aliases[net] = escape(get_unique_alias(identifier_occurrences, net->get_name()));
-                res_stream << "    wire " << aliases.at(net) << ";" << std::endl;
+                if (const std::string alias = get_unique_alias(identifier_occurrences, net->get_name()); alias == net->get_name())
+                {
+                    aliases[net] = get_escaped_net_name(net);
+                }
+                else
+                {
+                    aliases[net] = escape(alias);
+                }
+                out += "    wire " + aliases.at(net) + ";\n";
             }
         }
 
         // write gate instances
-        for (const Gate* gate : module->get_gates())
+        // aliases are assigned up front, afterwards the instances are generated concurrently in chunks that are appended in order
+        const std::vector<Gate*>& gates = module->get_gates();
+        for (const Gate* gate : gates)
+        {
+            aliases[gate] = escape(get_unique_alias(identifier_occurrences, gate->get_name()));
+            get_escaped_gate_type(gate->get_type());
+        }
+
+        struct GateChunk
         {
-            res_stream << std::endl;
-            if (auto res = write_gate_instance(res_stream, gate, aliases, identifier_occurrences); res.is_error())
+            std::string text;
+            const Gate* failed_gate = nullptr;
+            std::optional<Error> error;
+        };
+
+        std::vector<GateChunk> chunks((gates.size() + GATES_PER_CHUNK - 1) / GATES_PER_CHUNK);
+        utils::parallel_for(chunks.size(), [this, &chunks, &gates, &aliases](u32 chunk_index) {
+            GateChunk& chunk = chunks.at(chunk_index);
+            const u32 end    = std::min((u32)gates.size(), (chunk_index + 1) * GATES_PER_CHUNK);
+            for (u32 i = chunk_index * GATES_PER_CHUNK; i < end; i++)
             {
-                return ERR_APPEND(res.get_error(),
-                                  "could not write declaration of module '" + module->get_name() + "' with ID " + std::to_string(module->get_id()) + ": failed to write gate '" + gate->get_name()
-                                      + "' with ID " + std::to_string(gate->get_id()));
+                chunk.text += "\n";
+                if (auto res = write_gate_instance(chunk.text, gates.at(i), aliases); res.is_error())
+                {
+                    chunk.failed_gate = gates.at(i);
+                    chunk.error.emplace(res.get_error());
+                    return;
+                }
+            }
+        });
+
+        for (GateChunk& chunk : chunks)
+        {
+            if (chunk.error.has_value())
+            {
+                return ERR_APPEND(chunk.error.value(),
+                                  "could not write declaration of module '" + module->get_name() + "' with ID " + std::to_string(module->get_id()) + ": failed to write gate '"
+                                      + chunk.failed_gate->get_name() + "' with ID " + std::to_string(chunk.failed_gate->get_id()));
             }
+            out += chunk.text;
+            std::string().swap(chunk.text);
         }
 
         // write module instances
         for (const Module* sub_module : module->get_submodules())
         {
-            res_stream << std::endl;
-            if (auto res = write_module_instance(res_stream, sub_module, aliases, identifier_occurrences, module_type_aliases); res.is_error())
+            out += "\n";
+            if (auto res = write_module_instance(out, sub_module, aliases, identifier_occurrences, module_type_aliases); res.is_error())
             {
                 return ERR_APPEND(res.get_error(),
                                   "could not write declaration of module '" + module->get_name() + "' with ID " + std::to_string(module->get_id()) + ": failed to write sub-module '"
@@ -206,46 +277,46 @@ namespace hal
             }
         }
 
-        res_stream << "endmodule" << std::endl;
+        out += "endmodule\n";
 
         return OK({});
     }
 
-    Result<std::monostate> VerilogWriter::write_gate_instance(std::stringstream& res_stream,
-                                                              const Gate* gate,
-                                                              std::unordered_map<const DataContainer*, std::string>& aliases,
-                                                              std::unordered_map<std::string, u32>& identifier_occurrences) const
+    Result<std::monostate> VerilogWriter::write_gate_instance(std::string& out, const Gate* gate, const std::unordered_map<const DataContainer*, std::string>& aliases) const
     {
-        const GateType* gate_type = gate->get_type();
+        const EscapedGateType& gate_type = m_escaped_gate_types.at(gate->get_type());
 
-        res_stream << "    " << escape(gate_type->get_name());
-        if (auto res = write_parameter_assignments(res_stream, gate); res.is_error())
+        out += "    ";
+        out += gate_type.m_name;
+        if (auto res = write_parameter_assignments(out, gate); res.is_error())
         {
             return ERR_APPEND(res.get_error(), "could not write gate '" + gate->get_name() + "' with ID " + std::to_string(gate->get_id()) + ": failed to write parameter assignments");
         }
-        aliases[gate] = escape(get_unique_alias(identifier_occurrences, gate->get_name()));
-        res_stream << " " << aliases.at(gate);
+        out += " ";
+        out += aliases.at(gate);
 
         // collect all endpoints (i.e., pins that are actually in use)
-        std::unordered_map<const GatePin*, const Net*> connections;
+        std::vector<std::pair<const GatePin*, const Net*>> connections;
+        connections.reserve(gate->get_fan_in_endpoints().size() + gate->get_fan_out_endpoints().size());
         for (const Endpoint* ep : gate->get_fan_in_endpoints())
         {
-            connections[ep->get_pin()] = ep->get_net();
+            connections.emplace_back(ep->get_pin(), ep->get_net());
         }
 
         for (const Endpoint* ep : gate->get_fan_out_endpoints())
         {
-            connections[ep->get_pin()] = ep->get_net();
+            connections.emplace_back(ep->get_pin(), ep->get_net());
         }
 
         // extract pin assignments (in order, respecting pin groups)
-        std::vector<std::pair<std::string, std::vector<const Net*>>> pin_assignments;
-        for (const PinGroup<GatePin>* pin_group : gate_type->get_pin_groups())
+        std::vector<std::pair<std::string_view, std::vector<const Net*>>> pin_assignments;
+        for (const auto& [pin_group_name, pins] : gate_type.m_pin_groups)
         {
             std::vector<const Net*> nets;
-            for (const GatePin* pin : pin_group->get_pins())
+            nets.reserve(pins.size());
+            for (const GatePin* pin : pins)
             {
-                if (const auto ep_it = connections.find(pin); ep_it != connections.end())
+                if (const auto ep_it = std::find_if(connections.begin(), connections.end(), [pin](const auto& connection) { return connection.first == pin; }); ep_it != connections.end())
                 {
                     nets.push_back(ep_it->second);
                 }
@@ -258,53 +329,64 @@ namespace hal
             // only append if at least one pin of the group is connected
             if (std::any_of(nets.begin(), nets.end(), [](const Net* net) { return net != nullptr; }))
             {
-                pin_assignments.push_back(std::make_pair(pin_group->get_name(), nets));
+                pin_assignments.emplace_back(pin_group_name, std::move(nets));
             }
         }
 
-        if (auto res = write_pin_assignments(res_stream, pin_assignments, aliases); res.is_error())
+        if (auto res = write_pin_assignments(out, pin_assignments, aliases); res.is_error())
         {
             return ERR_APPEND(res.get_error(), "could not write gate '" + gate->get_name() + "' with ID " + std::to_string(gate->get_id()) + ": failed to write pin assignments");
         }
 
-        res_stream << ";" << std::endl;
+        out += ";\n";
 
         return OK({});
     }
 
-    Result<std::monostate> VerilogWriter::write_module_instance(std::stringstream& res_stream,
+    Result<std::monostate> VerilogWriter::write_module_instance(std::string& out,
                                                                 const Module* module,
                                                                 std::unordered_map<const DataContainer*, std::string>& aliases,
                                                                 std::unordered_map<std::string, u32>& identifier_occurrences,
-                                                                std::unordered_map<const Module*, std::string>& module_type_aliases) const
+                                                                const std::unordered_map<const Module*, std::string>& module_type_aliases) const
     {
-        res_stream << "    " << escape(module_type_aliases.at(module));
-        if (auto res = write_parameter_assignments(res_stream, module); res.is_error())
+        const auto type_it = module_type_aliases.find(module);
+        if (type_it == module_type_aliases.end())
+        {
+            return ERR("could not write sub-module '" + module->get_name() + "' with ID " + std::to_string(module->get_id()) + ": no module declaration has been written");
+        }
+
+        out += "    " + escape(type_it->second);
+        if (auto res = write_parameter_assignments(out, module); res.is_error())
         {
             return ERR_APPEND(res.get_error(), "could not write sub-module '" + module->get_name() + "' with ID " + std::to_string(module->get_id()) + ": failed to write parameter assignments");
         }
         aliases[module] = escape(get_unique_alias(identifier_occurrences, module->get_name()));
-        res_stream << " " << aliases.at(module);
+        out += " " + aliases.at(module);
 
         // extract port assignments
-        std::vector<std::pair<std::string, std::vector<const Net*>>> port_assignments;
+        const std::vector<ModulePin*> pins = module->get_pins();
+        std::vector<std::string> port_names;
+        port_names.reserve(pins.size());
+        std::vector<std::pair<std::string_view, std::vector<const Net*>>> port_assignments;
+        port_assignments.reserve(pins.size());
 
-        for (const ModulePin* pin : module->get_pins())
+        for (const ModulePin* pin : pins)
         {
-            port_assignments.push_back(std::make_pair(pin->get_name(), std::vector<const Net*>({pin->get_net()})));
+            port_names.push_back(escape(pin->get_name()));
+            port_assignments.push_back(std::make_pair(std::string_view(port_names.back()), std::vector<const Net*>({pin->get_net()})));
         }
 
-        if (auto res = write_pin_assignments(res_stream, port_assignments, aliases); res.is_error())
+        if (auto res = write_pin_assignments(out, port_assignments, aliases); res.is_error())
         {
             return ERR_APPEND(res.get_error(), "could not write sub-module '" + module->get_name() + "' with ID " + std::to_string(module->get_id()) + ": failed to write pin assignments");
         }
 
-        res_stream << ";" << std::endl;
+        out += ";\n";
 
         return OK({});
     }
 
-    Result<std::monostate> VerilogWriter::write_parameter_assignments(std::stringstream& res_stream, const DataContainer* container) const
+    Result<std::monostate> VerilogWriter::write_parameter_assignments(std::string& out, const DataContainer* container) const
     {
         const std::map<std::tuple<std::string, std::string>, std::tuple<std::string, std::string>>& data = container->get_data_map();
 
@@ -321,37 +403,37 @@ namespace hal
 
             if (first_parameter)
             {
-                res_stream << " #(" << std::endl;
+                out += " #(\n";
                 first_parameter = false;
             }
             else
             {
-                res_stream << "," << std::endl;
+                out += ",\n";
             }
 
-            res_stream << "        ." << escape(key) << "(";
+            out += "        ." + escape(key) + "(";
 
-            if (auto res = write_parameter_value(res_stream, type, value); res.is_error())
+            if (auto res = write_parameter_value(out, type, value); res.is_error())
             {
                 return ERR_APPEND(res.get_error(), "could not write parameter assignments: failed to write parameter value '" + value + "' of type '" + type + "'");
             }
 
-            res_stream << ")";
+            out += ")";
         }
 
         if (!first_parameter)
         {
-            res_stream << std::endl << "    )";
+            out += "\n    )";
         }
 
         return OK({});
     }
 
-    Result<std::monostate> VerilogWriter::write_pin_assignments(std::stringstream& res_stream,
-                                                                const std::vector<std::pair<std::string, std::vector<const Net*>>>& pin_assignments,
-                                                                std::unordered_map<const DataContainer*, std::string>& aliases) const
+    Result<std::monostate> VerilogWriter::write_pin_assignments(std::string& out,
+                                                                const std::vector<std::pair<std::string_view, std::vector<const Net*>>>& pin_assignments,
+                                                                const std::unordered_map<const DataContainer*, std::string>& aliases) const
     {
-        res_stream << " (" << std::endl;
+        out += " (\n";
         bool first_pin = true;
         for (const auto& [pin, nets] : pin_assignments)
         {
@@ -361,13 +443,15 @@ namespace hal
             }
             else
             {
-                res_stream << "," << std::endl;
+                out += ",\n";
             }
 
-            res_stream << "        ." << escape(pin) << "(";
+            out += "        .";
+            out += pin;
+            out += "(";
             if (nets.size() > 1)
             {
-                res_stream << "{";
+                out += "{";
             }
 
             bool first_net = true;
@@ -383,12 +467,12 @@ namespace hal
                     }
                     else
                     {
-                        res_stream << "," << std::endl;
+                        out += ",\n";
                     }
 
                     if (const auto alias_it = aliases.find(net); alias_it != aliases.end())
                     {
-                        res_stream << alias_it->second;
+                        out += alias_it->second;
                     }
                     else
                     {
@@ -398,36 +482,36 @@ namespace hal
                 else
                 {
                     // unconnected pin of a group with at least one connection
-                    res_stream << "1'bz";
+                    out += "1'bz";
                 }
             }
 
             if (nets.size() > 1)
             {
-                res_stream << "}";
+                out += "}";
             }
 
-            res_stream << ")";
+            out += ")";
         }
 
-        res_stream << std::endl << "    )";
+        out += "\n    )";
 
         return OK({});
     }
 
-    Result<std::monostate> VerilogWriter::write_parameter_value(std::stringstream& res_stream, const std::string& type, const std::string& value) const
+    Result<std::monostate> VerilogWriter::write_parameter_value(std::string& out, const std::string& type, const std::string& value) const
     {
         if (type == "string")
         {
-            res_stream << "\"" << value << "\"";
+            out += "\"" + value + "\"";
         }
         else if (type == "integer" || type == "floating_point")
         {
-            res_stream << value;
+            out += value;
         }
         else if (type == "bit_value")
         {
-            res_stream << "1'b" << value;
+            out += "1'b" + value;
         }
         else if (type == "bit_vector")
         {
@@ -444,7 +528,7 @@ namespace hal
             // {
             //     len -= 1;
             // }
-            res_stream << len << "'h" << value;
+            out += std::to_string(len) + "'h" + value;
         }
         else if (type == "bit_string")
         {
@@ -461,7 +545,7 @@ namespace hal
             // {
             //     len -= 1;
             // }
-            res_stream << len << "'b" << value;
+            out += std::to_string(len) + "'b" + value;
         }
         else
         {
@@ -471,6 +555,33 @@ namespace hal
         return OK({});
     }
 
+    const VerilogWriter::EscapedGateType& VerilogWriter::get_escaped_gate_type(const GateType* gate_type)
+    {
+        if (const auto it = m_escaped_gate_types.find(gate_type); it != m_escaped_gate_types.end())
+        {
+            return it->second;
+        }
+
+        EscapedGateType& escaped = m_escaped_gate_types[gate_type];
+        escaped.m_name           = escape(gate_type->get_name());
+        for (const PinGroup<GatePin>* pin_group : gate_type->get_pin_groups())
+        {
+            const std::vector<GatePin*> pins = pin_group->get_pins();
+            escaped.m_pin_groups.emplace_back(escape(pin_group->get_name()), std::vector<const GatePin*>(pins.begin(), pins.end()));
+        }
+        return escaped;
+    }
+
+    const std::string& VerilogWriter::get_escaped_net_name(const Net* net)
+    {
+        if (const auto it = m_escaped_net_names.find(net); it != m_escaped_net_names.end())
+        {
+            return it->second;
+        }
+
+        return m_escaped_net_names[net] = escape(net->get_name());
+    }
+
     std::string VerilogWriter::get_unique_alias(std::unordered_map<std::string, u32>& name_occurrences, const std::string& name) const
     {
         // if the name only appears once, we don't have to suffix it
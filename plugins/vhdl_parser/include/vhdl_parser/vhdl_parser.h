@@ -32,10 +32,10 @@
 #include "hal_core/netlist/netlist_parser/netlist_parser.h"
 #include "hal_core/utilities/result.h"
 #include "hal_core/utilities/special_strings.h"
+#include "hal_core/utilities/text_scanner.h"
 #include "hal_core/utilities/token_stream.h"
 
 #include <optional>
-#include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -61,14 +61,23 @@ namespace hal
 
         /**
          * Instantiate the parsed VHDL netlist using the specified gate library.
+         * May be called concurrently for different gate libraries.
          *
          * @param[in] gate_library - The gate library.
          * @returns A pointer to the resulting netlist.
          */
         Result<std::unique_ptr<Netlist>> instantiate(const GateLibrary* gate_library) override;
 
+        /**
+         * Get the types of all instances within the parsed VHDL netlist that are not entities defined within the netlist.
+         *
+         * @returns The set of required gate type names.
+         */
+        std::set<std::string> get_required_gate_types() const override;
+
     private:
         using ci_string           = core_strings::CaseInsensitiveString;
+        using ci_string_view      = core_strings::CaseInsensitiveStringView;
         using identifier_t        = ci_string;
         using ranged_identifier_t = std::pair<ci_string, std::vector<std::vector<u32>>>;
         using numeral_t           = std::vector<BooleanFunction::Value>;
@@ -119,7 +128,7 @@ namespace hal
             std::vector<VhdlPortAssignment> m_port_assignments;
             std::vector<VhdlDataEntry> m_generics;
             std::vector<VhdlDataEntry> m_attributes;
-            std::vector<std::pair<ci_string, ci_string>> m_expanded_port_assignments;
+            std::vector<std::pair<ci_string, ci_string>> m_expanded_port_assignments;    // only for entity instances, gate instances depend on the gate library
         };
 
         struct VhdlEntity
@@ -171,8 +180,9 @@ namespace hal
 
         using attribute_buffer_t = std::map<AttributeTarget, std::map<ci_string, VhdlDataEntry>>;
 
-        std::stringstream m_fs;
         std::filesystem::path m_path;
+        MappedTextFile m_file;
+        StringArena m_arena;
 
         // temporary netlist
         Netlist* m_netlist = nullptr;
@@ -185,8 +195,8 @@ namespace hal
         // std::unordered_map<ci_string, VhdlEntity> m_entities;
         // ci_string m_last_entity;
 
-        // token stream of entire input file
-        TokenStream<ci_string> m_token_stream;
+        // token stream of entire input file, tokens are views on m_file or m_arena
+        TokenStream<ci_string_view> m_token_stream;
 
         // some caching
         std::unordered_map<ci_string, GateType*> m_gate_types;
@@ -194,6 +204,7 @@ namespace hal
         std::unordered_map<ci_string, GateType*> m_gnd_gate_types;
         std::unordered_map<Net*, std::vector<std::pair<Module*, u32>>> m_module_port_by_net;
         std::unordered_map<Module*, std::vector<std::pair<std::string, Net*>>> m_module_ports;
+        std::unordered_map<const VhdlInstance*, std::vector<std::pair<ci_string, ci_string>>> m_expanded_gate_port_assignments;
         attribute_buffer_t m_attribute_buffer;
         std::unordered_map<ci_string, ci_string> m_attribute_types;
 
@@ -228,18 +239,19 @@ namespace hal
         Result<std::monostate> assign_attributes(VhdlEntity* vhdl_entity);
 
         // construct netlist from intermediate format
+        Result<std::unique_ptr<Netlist>> instantiate_netlist(const GateLibrary* gate_library);
         Result<std::monostate> construct_netlist(VhdlEntity* top_entity);
         Result<Module*> instantiate_entity(const ci_string& instance_name, VhdlEntity* vhdl_entity, Module* parent, const std::unordered_map<ci_string, ci_string>& parent_module_assignments);
 
         // helper functions
         ci_string get_unique_alias(const ci_string& parent_name, const ci_string& name, const std::unordered_map<ci_string, u32>& name_occurences) const;
-        std::vector<u32> parse_range(TokenStream<ci_string>& range_stream) const;
-        Result<std::vector<std::vector<u32>>> parse_signal_ranges(TokenStream<ci_string>& signal_stream) const;
+        std::vector<u32> parse_range(TokenStream<ci_string_view>& range_stream) const;
+        Result<std::vector<std::vector<u32>>> parse_signal_ranges(TokenStream<ci_string_view>& signal_stream) const;
         void expand_ranges_recursively(std::vector<ci_string>& expanded_names, const ci_string& current_name, const std::vector<std::vector<u32>>& ranges, u32 dimension) const;
         std::vector<ci_string> expand_ranges(const ci_string& name, const std::vector<std::vector<u32>>& ranges) const;
         Result<std::vector<BooleanFunction::Value>> get_binary_vector(std::string value) const;
         Result<std::string> get_hex_from_literal(const Token<ci_string>& value_token) const;
-        Result<std::vector<assignment_t>> parse_assignment_expression(TokenStream<ci_string>&& stream) const;
+        Result<std::vector<assignment_t>> parse_assignment_expression(TokenStream<ci_string_view>&& stream) const;
         Result<std::vector<ci_string>> expand_assignment_expression(VhdlEntity* vhdl_entity, const std::vector<assignment_t>& vars) const;
     };
 }    // namespace hal
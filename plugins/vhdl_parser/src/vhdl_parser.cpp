@@ -8,9 +8,10 @@
 #include "hal_core/utilities/log.h"
 #include "hal_core/utilities/utils.h"
 
-#include <fstream>
+#include <cstring>
 #include <iomanip>
 #include <queue>
+#include <sstream>
 
 namespace hal
 {
@@ -26,15 +27,10 @@ namespace hal
         m_attribute_buffer.clear();
         m_attribute_types.clear();
 
+        // tokens are views on the mapped file content or the arena
+        if (!m_file.open(file_path))
         {
-            std::ifstream ifs;
-            ifs.open(file_path.string(), std::ifstream::in);
-            if (!ifs.is_open())
-            {
-                return ERR("unable to open VHDL file '" + file_path.string() + "'");
-            }
-            m_fs << ifs.rdbuf();
-            ifs.close();
+            return ERR("unable to open VHDL file '" + file_path.string() + "'");
         }
 
         // tokenize file
@@ -48,7 +44,7 @@ namespace hal
                 return ERR_APPEND(res.get_error(), "could not parse VHDL file '" + m_path.string() + "'");
             }
         }
-        catch (TokenStream<ci_string>::TokenStreamException& e)
+        catch (TokenStream<ci_string_view>::TokenStreamException& e)
         {
             if (e.line_number != (u32)-1)
             {
@@ -60,6 +56,11 @@ namespace hal
             }
         }
 
+        // the intermediate format owns its strings, so the tokens and the file content are no longer needed
+        m_token_stream = TokenStream<ci_string_view>();
+        m_arena.clear();
+        m_file.close();
+
         if (m_entities.empty())
         {
             return ERR("could not parse VHDL file '" + m_path.string() + "': it does not contain any entities");
@@ -238,7 +239,33 @@ namespace hal
         return OK({});
     }
 
+    std::set<std::string> VHDLParser::get_required_gate_types() const
+    {
+        std::set<std::string> gate_types;
+        for (const auto& vhdl_entity : m_entities)
+        {
+            for (const auto& instance : vhdl_entity->m_instances)
+            {
+                if (!instance->m_is_entity)
+                {
+                    gate_types.insert(core_strings::to<std::string>(instance->m_type));
+                }
+            }
+        }
+        return gate_types;
+    }
+
     Result<std::unique_ptr<Netlist>> VHDLParser::instantiate(const GateLibrary* gate_library)
+    {
+        // all instantiation state is kept by a separate parser that only reads the parsed entities, so multiple gate libraries can be instantiated concurrently
+        VHDLParser instantiation;
+        instantiation.m_path             = m_path;
+        instantiation.m_entities_by_name = m_entities_by_name;
+
+        return instantiation.instantiate_netlist(gate_library);
+    }
+
+    Result<std::unique_ptr<Netlist>> VHDLParser::instantiate_netlist(const GateLibrary* gate_library)
     {
         // create empty netlist
         std::unique_ptr<Netlist> result = netlist_factory::create_netlist(gate_library);
@@ -257,16 +284,7 @@ namespace hal
         m_nets_to_merge.clear();
         m_module_ports.clear();
         m_module_port_by_net.clear();
-        for (const auto& vhdl_entity : m_entities)
-        {
-            for (const auto& instance : vhdl_entity->m_instances)
-            {
-                if (!instance->m_is_entity)
-                {
-                    instance->m_expanded_port_assignments.clear();
-                }
-            }
-        }
+        m_expanded_gate_port_assignments.clear();
 
         // buffer gate types
         for (const auto& [gt_name, gt] : gate_library->get_gate_types())
@@ -420,30 +438,94 @@ namespace hal
 
     void VHDLParser::tokenize()
     {
-        std::vector<Token<core_strings::CaseInsensitiveString>> parsed_tokens;
-        const std::string delimiters = ",(): ;=><&";
-        core_strings::CaseInsensitiveString current_token;
+        static const CharacterSet delimiters(",(): ;=><&", true);
+        static const CharacterSet whitespace("", true);
+        // characters ending a run of plain token characters in the respective lexer state
+        static const CharacterSet plain_stop(",(): ;=><&\\\"", true);
+        static const CharacterSet escaped_stop("\\", true);
+        static const CharacterSet string_stop("\"");
+
+        m_arena.clear();
+
+        const std::string_view text = m_file.get_text();
+        const char* const text_end  = text.data() + text.size();
+
         u32 line_number = 0;
+        bool in_string  = false;
+        bool escaped    = false;
 
-        std::string line;
-        bool in_string = false;
-        bool escaped   = false;
+        // the current token is a view on the text as long as it is contiguous, otherwise it is assembled separately
+        const char* token_begin = nullptr;
+        const char* token_end   = nullptr;
+        std::string assembled;
+        bool is_assembled = false;
 
-        while (std::getline(m_fs, line))
+        auto append = [&](const char* from, const char* to) {
+            if (is_assembled)
+            {
+                assembled.append(from, to);
+            }
+            else if (token_begin == token_end)
+            {
+                token_begin = from;
+                token_end   = to;
+            }
+            else if (token_end == from)
+            {
+                token_end = to;
+            }
+            else
+            {
+                assembled.assign(token_begin, token_end);
+                assembled.append(from, to);
+                is_assembled = true;
+            }
+        };
+
+        auto token_empty = [&]() { return is_assembled ? assembled.empty() : token_begin == token_end; };
+
+        auto take_token = [&]() {
+            std::string_view token = is_assembled ? m_arena.store(std::move(assembled)) : std::string_view(token_begin, token_end - token_begin);
+            assembled.clear();
+            is_assembled = false;
+            token_begin = token_end = nullptr;
+            return ci_string_view(token.data(), token.size());
+        };
+
+        // tokens stay views on the original spelling, which is needed for net, gate, and module names.
+        // identifiers are therefore not interned in a case-folded form; the comparisons within CaseInsensitiveCharTraits
+        // are cheap compared to tokenizing and building the intermediate format.
+        std::vector<Token<ci_string_view>> parsed_tokens;
+        // rough estimate of one token per 8 characters to avoid repeated reallocation on large netlists
+        parsed_tokens.reserve(text.size() / 8);
+
+        for (const char* line_begin = text.data(); line_begin < text_end;)
         {
+            const char* eol      = static_cast<const char*>(memchr(line_begin, '\n', text_end - line_begin));
+            const char* line_end = eol ? eol : text_end;
             line_number++;
-            if (line.find("--") != std::string::npos)
+
+            std::string_view line(line_begin, line_end - line_begin);
+            line_begin = line_end + 1;
+
+            // strip comments and surrounding whitespace
+            if (const auto comment = line.find("--"); comment != std::string_view::npos)
             {
-                line = line.substr(0, line.find("--"));
+                line = line.substr(0, comment);
             }
-            for (char c : utils::trim(line))
+            line = utils::trim(line);
+
+            const char* const end = line.data() + line.size();
+            for (const char* p = line.data(); p < end; ++p)
             {
+                const char c = *p;
+
                 if (in_string == false && c == '\\')
                 {
                     escaped = !escaped;
                     continue;
                 }
-                else if (escaped && std::isspace(c))
+                else if (escaped && whitespace.contains(c))
                 {
                     escaped = false;
                     continue;
@@ -453,25 +535,31 @@ namespace hal
                     in_string = !in_string;
                 }
 
-                if (delimiters.find(c) == std::string::npos || escaped || in_string)
+                if (!delimiters.contains(c) || escaped || in_string)
                 {
-                    current_token += c;
+                    // consume the entire run of characters that cannot change the lexer state at once
+                    const CharacterSet& stop = in_string ? string_stop : (escaped ? escaped_stop : plain_stop);
+                    const char* run_end      = (c == '"') ? p + 1 : stop.find_first(p + 1, end);
+                    append(p, run_end);
+                    p = run_end - 1;
                 }
                 else
                 {
-                    if (!current_token.empty())
+                    if (!token_empty())
                     {
+                        ci_string_view current_token = take_token();
                         if (parsed_tokens.size() > 1 && utils::is_digits(parsed_tokens.at(parsed_tokens.size() - 2).string) && parsed_tokens.at(parsed_tokens.size() - 1) == "."
                             && utils::is_digits(current_token))
                         {
                             parsed_tokens.pop_back();
-                            parsed_tokens.back() += "." + current_token;
+                            std::string_view merged =
+                                m_arena.store(std::string(parsed_tokens.back().string.data(), parsed_tokens.back().string.size()) + "." + std::string(current_token.data(), current_token.size()));
+                            parsed_tokens.back() = ci_string_view(merged.data(), merged.size());
                         }
                         else
                         {
                             parsed_tokens.emplace_back(line_number, current_token);
                         }
-                        current_token.clear();
                     }
 
                     if (!parsed_tokens.empty())
@@ -493,19 +581,19 @@ namespace hal
                         }
                     }
 
-                    if (!std::isspace(c))
+                    if (!whitespace.contains(c))
                     {
-                        parsed_tokens.emplace_back(line_number, core_strings::CaseInsensitiveString(1, c));
+                        parsed_tokens.emplace_back(line_number, ci_string_view(p, 1));
                     }
                 }
             }
-            if (!current_token.empty())
+            if (!token_empty())
             {
-                parsed_tokens.emplace_back(line_number, current_token);
-                current_token.clear();
+                parsed_tokens.emplace_back(line_number, take_token());
             }
         }
-        m_token_stream = TokenStream(parsed_tokens, {"("}, {")"});
+
+        m_token_stream = TokenStream<ci_string_view>(std::move(parsed_tokens), {"("}, {")"});
     }
 
     Result<std::monostate> VHDLParser::parse_tokens()
@@ -545,7 +633,7 @@ namespace hal
         if (m_token_stream.peek() == "use")
         {
             m_token_stream.consume("use", true);
-            auto lib = m_token_stream.consume().string;
+            ci_string lib = ci_string(m_token_stream.consume().string);
             m_token_stream.consume(";", true);
 
             // remove specific import like ".all" but keep the "."
@@ -563,7 +651,7 @@ namespace hal
     {
         m_token_stream.consume("entity", true);
         const u32 line_number       = m_token_stream.peek().number;
-        const ci_string entity_name = m_token_stream.consume().string;
+        const ci_string entity_name = ci_string(m_token_stream.consume().string);
 
         // verify entity name
         if (const auto it = m_entities_by_name.find(entity_name); it != m_entities_by_name.end())
@@ -580,7 +668,7 @@ namespace hal
 
         m_attribute_buffer.clear();
 
-        Token<ci_string> next_token = m_token_stream.peek();
+        Token<ci_string_view> next_token = m_token_stream.peek();
         while (next_token != "end")
         {
             if (next_token == "generic")
@@ -642,14 +730,14 @@ namespace hal
             // extract names
             do
             {
-                port_names.push_back(port_def_stream.consume().string);
+                port_names.emplace_back(port_def_stream.consume().string);
             } while (port_def_stream.consume(",", false));
 
             port_def_stream.consume(":", true);
 
             // extract direction
             PinDirection direction;
-            const ci_string direction_str = port_def_stream.consume().string;
+            const ci_string_view direction_str = port_def_stream.consume().string;
             if (direction_str == "in")
             {
                 direction = PinDirection::input;
@@ -669,7 +757,7 @@ namespace hal
             }
 
             // extract ranges
-            TokenStream<ci_string> port_stream = port_def_stream.extract_until(";");
+            TokenStream<ci_string_view> port_stream = port_def_stream.extract_until(";");
             std::vector<std::vector<u32>> ranges;
             if (auto res = parse_signal_ranges(port_stream); res.is_error())
             {
@@ -716,7 +804,7 @@ namespace hal
         const u32 line_number = m_token_stream.peek().number;
 
         m_token_stream.consume("attribute", true);
-        const ci_string attribute_name = m_token_stream.consume().string;
+        const ci_string attribute_name = ci_string(m_token_stream.consume().string);
 
         if (m_token_stream.peek() == ":")
         {
@@ -728,9 +816,9 @@ namespace hal
         {
             AttributeTarget target_class;
             m_token_stream.consume("of", true);
-            const ci_string attribute_target = m_token_stream.consume().string;
+            const ci_string attribute_target = ci_string(m_token_stream.consume().string);
             m_token_stream.consume(":", true);
-            const ci_string attribute_class = m_token_stream.consume().string;
+            const ci_string attribute_class = ci_string(m_token_stream.consume().string);
             m_token_stream.consume("is", true);
             ci_string attribute_value = m_token_stream.join_until(";", " ").string;
             m_token_stream.consume(";", true);
@@ -792,7 +880,7 @@ namespace hal
         u32 line_number              = m_token_stream.peek().number;
         const auto entity_name_token = m_token_stream.consume();
 
-        if (const auto it = m_entities_by_name.find(entity_name_token.string); it == m_entities_by_name.end())
+        if (const auto it = m_entities_by_name.find(ci_string(entity_name_token.string)); it == m_entities_by_name.end())
         {
             return ERR("could not parse architecture: architecture refers to non-existent entity '" + core_strings::to<std::string>(entity_name_token.string) + "' (line "
                        + std::to_string(entity_name_token.number) + ")");
@@ -836,7 +924,7 @@ namespace hal
             {
                 // components are ignored
                 m_token_stream.consume("component", true);
-                const ci_string component_name = m_token_stream.consume().string;
+                const ci_string component_name = ci_string(m_token_stream.consume().string);
                 m_token_stream.consume_until("end");
                 m_token_stream.consume("end", true);
                 m_token_stream.consume("component", true);
@@ -873,13 +961,13 @@ namespace hal
         std::vector<ci_string> signal_names;
         do
         {
-            signal_names.push_back(m_token_stream.consume().string);
+            signal_names.emplace_back(m_token_stream.consume().string);
         } while (m_token_stream.consume(",", false));
 
         m_token_stream.consume(":", true);
 
         // extract bounds
-        TokenStream<ci_string> signal_stream = m_token_stream.extract_until(";");
+        TokenStream<ci_string_view> signal_stream = m_token_stream.extract_until(";");
         std::vector<std::vector<u32>> ranges;
         if (auto res = parse_signal_ranges(signal_stream); res.is_error())
         {
@@ -1061,16 +1149,16 @@ namespace hal
         m_token_stream.consume("port", true);
         m_token_stream.consume("map", true);
         m_token_stream.consume("(", true);
-        TokenStream<ci_string> port_stream = m_token_stream.extract_until(")");
+        TokenStream<ci_string_view> port_stream = m_token_stream.extract_until(")");
         m_token_stream.consume(")", true);
 
-        if (port_stream.find_next("=>") != TokenStream<ci_string>::END_OF_STREAM)
+        if (port_stream.find_next("=>") != TokenStream<ci_string_view>::END_OF_STREAM)
         {
             while (port_stream.remaining() > 0)
             {
-                TokenStream<ci_string> left_stream = port_stream.extract_until("=>");
+                TokenStream<ci_string_view> left_stream = port_stream.extract_until("=>");
                 port_stream.consume("=>", true);
-                TokenStream<ci_string> right_stream = port_stream.extract_until(",");
+                TokenStream<ci_string_view> right_stream = port_stream.extract_until(",");
                 port_stream.consume(",", port_stream.remaining() > 0);    // last entry has no comma
 
                 if (!right_stream.consume("open"))
@@ -1104,7 +1192,7 @@ namespace hal
         {
             while (port_stream.remaining() > 0)
             {
-                TokenStream<ci_string> right_stream = port_stream.extract_until(",");
+                TokenStream<ci_string_view> right_stream = port_stream.extract_until(",");
                 port_stream.consume(",", port_stream.remaining() > 0);    // last entry has no comma
 
                 if (!right_stream.consume("open"))
@@ -1138,7 +1226,7 @@ namespace hal
     {
         m_token_stream.consume("map", true);
         m_token_stream.consume("(", true);
-        TokenStream<ci_string> generic_stream = m_token_stream.extract_until(")");
+        TokenStream<ci_string_view> generic_stream = m_token_stream.extract_until(")");
         m_token_stream.consume(")", true);
 
         while (generic_stream.remaining() > 0)
@@ -1323,6 +1411,7 @@ namespace hal
             {
                 if (const auto gate_type_it = m_gate_types.find(instance->m_type); gate_type_it != m_gate_types.end())
                 {
+                    auto& expanded_port_assignments = m_expanded_gate_port_assignments[instance.get()];
                     if (!instance->m_port_assignments.empty())
                     {
                         // all port assignments by name
@@ -1381,7 +1470,7 @@ namespace hal
 
                                     for (u32 i = 0; i < left_port.size(); i++)
                                     {
-                                        instance->m_expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
+                                        expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
                                     }
                                 }
                             }
@@ -1419,7 +1508,7 @@ namespace hal
 
                                     for (u32 i = 0; i < max_size; i++)
                                     {
-                                        instance->m_expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
+                                        expanded_port_assignments.push_back(std::make_pair(left_port.at(i), right_port.at(i)));
                                     }
                                 }
                             }
@@ -1937,7 +2026,7 @@ namespace hal
                 }
 
                 // expand pin assignments
-                for (const auto& [pin, assignment] : instance->m_expanded_port_assignments)
+                for (const auto& [pin, assignment] : m_expanded_gate_port_assignments.at(instance.get()))
                 {
                     ci_string signal;
 
@@ -2062,7 +2151,7 @@ namespace hal
 
     namespace
     {
-        const static std::map<core_strings::CaseInsensitiveString, size_t> id_to_dim = {{"std_logic_vector", 1}, {"std_logic_vector2", 2}, {"std_logic_vector3", 3}};
+        const static std::map<core_strings::CaseInsensitiveString, size_t, std::less<>> id_to_dim = {{"std_logic_vector", 1}, {"std_logic_vector2", 2}, {"std_logic_vector3", 3}};
 
         static const std::map<char, BooleanFunction::Value> bin_map = {{'0', BooleanFunction::Value::ZERO},
                                                                        {'1', BooleanFunction::Value::ONE},
@@ -2118,7 +2207,7 @@ namespace hal
         return unique_alias;
     }
 
-    std::vector<u32> VHDLParser::parse_range(TokenStream<ci_string>& range_stream) const
+    std::vector<u32> VHDLParser::parse_range(TokenStream<ci_string_view>& range_stream) const
     {
         if (range_stream.remaining() == 1)
         {
@@ -2148,32 +2237,32 @@ namespace hal
         return res;
     }
 
-    Result<std::vector<std::vector<u32>>> VHDLParser::parse_signal_ranges(TokenStream<ci_string>& signal_stream) const
+    Result<std::vector<std::vector<u32>>> VHDLParser::parse_signal_ranges(TokenStream<ci_string_view>& signal_stream) const
     {
         std::vector<std::vector<u32>> ranges;
         const u32 line_number = signal_stream.peek().number;
 
-        const Token<ci_string> type_name = signal_stream.consume();
+        const Token<ci_string_view> type_name = signal_stream.consume();
         if (type_name == "std_logic")
         {
             return OK(ranges);
         }
 
         signal_stream.consume("(", true);
-        TokenStream<ci_string> signal_bounds_stream = signal_stream.extract_until(")");
+        TokenStream<ci_string_view> signal_bounds_stream = signal_stream.extract_until(")");
 
         // process ranges
         do
         {
-            TokenStream<ci_string> bound_stream = signal_bounds_stream.extract_until(",");
+            TokenStream<ci_string_view> bound_stream = signal_bounds_stream.extract_until(",");
             ranges.emplace_back(parse_range(bound_stream));
         } while (signal_bounds_stream.consume(","));
 
         signal_stream.consume(")", true);
 
-        if (id_to_dim.find(type_name) != id_to_dim.end())
+        if (const auto dim_it = id_to_dim.find(type_name.string); dim_it != id_to_dim.end())
         {
-            const size_t dimension = id_to_dim.at(type_name);
+            const size_t dimension = dim_it->second;
 
             if (ranges.size() != dimension)
             {
@@ -2404,7 +2493,7 @@ namespace hal
         return OK(ss.str());
     }
 
-    Result<std::vector<VHDLParser::assignment_t>> VHDLParser::parse_assignment_expression(TokenStream<ci_string>&& stream) const
+    Result<std::vector<VHDLParser::assignment_t>> VHDLParser::parse_assignment_expression(TokenStream<ci_string_view>&& stream) const
     {
         // PARSE ASSIGNMENT
         //   assignment can currently be one of the following:
@@ -2414,7 +2503,7 @@ namespace hal
         //   (4) NAME(BEGIN_INDEX1 to/downto END_INDEX1, BEGIN_INDEX2 to/downto END_INDEX2, ...)
         //   (5) ((1 - 4), (1 - 4), ...)
 
-        std::vector<TokenStream<ci_string>> parts;
+        std::vector<TokenStream<ci_string_view>> parts;
 
         if (stream.size() == 0)
         {
@@ -2441,10 +2530,10 @@ namespace hal
 
         for (auto it = parts.rbegin(); it != parts.rend(); it++)
         {
-            TokenStream<ci_string>& part_stream = *it;
+            TokenStream<ci_string_view>& part_stream = *it;
 
-            const Token<ci_string> signal_name_token = part_stream.consume();
-            ci_string signal_name                    = signal_name_token.string;
+            const Token<ci_string_view> signal_name_token = part_stream.consume();
+            ci_string signal_name                         = ci_string(signal_name_token.string);
 
             // (2) NUMBER
             if (utils::starts_with(signal_name, core_strings::CaseInsensitiveString("\"")) || utils::starts_with(signal_name, core_strings::CaseInsensitiveString("b\""))
@@ -2485,7 +2574,7 @@ namespace hal
                     u32 closing_pos = part_stream.find_next(")");
                     do
                     {
-                        TokenStream<ci_string> range_stream = part_stream.extract_until(",", closing_pos);
+                        TokenStream<ci_string_view> range_stream = part_stream.extract_until(",", closing_pos);
                         ranges.emplace_back(parse_range(range_stream));
 
                     } while (part_stream.consume(",", false));
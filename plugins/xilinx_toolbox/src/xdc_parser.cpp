@@ -1,229 +1,221 @@
 #include "hal_core/netlist/gate.h"
 #include "hal_core/netlist/net.h"
 #include "hal_core/netlist/netlist.h"
-#include "hal_core/utilities/token_stream.h"
+#include "hal_core/utilities/text_scanner.h"
+#include "hal_core/utilities/utils.h"
 #include "xilinx_toolbox/plugin_xilinx_toolbox.h"
 #include "xilinx_toolbox/types.h"
 
-#include <fstream>
-#include <regex>
+#include <charconv>
 
 namespace hal
 {
     namespace xilinx_toolbox
     {
-        // TODO ignore comments
-        // TODO there is some weird escaping with curly braces happening
-        TokenStream<std::string> tokenize(std::stringstream& ss)
+        namespace
         {
-            const std::string delimiters = " ";
-            std::string current_token;
-            u32 line_number = 0;
+            // size of the pieces of the file that are parsed concurrently
+            const size_t xdc_chunk_size = 1 << 20;
 
-            std::string line;
-            bool escaped   = false;
-
-            std::vector<Token<std::string>> parsed_tokens;
-            while (std::getline(ss, line))
+            bool is_xdc_whitespace(char c)
             {
-                line_number++;
+                return c == ' ' || c == '\t' || c == '\r';
+            }
 
-                for (char c : line)
+            std::string_view next_xdc_token(std::string_view& line)
+            {
+                size_t begin = 0;
+                while (begin < line.size() && is_xdc_whitespace(line[begin]))
                 {
-                    // deal with escaping and strings
-                    if (c == '\\')
-                    {
-                        escaped = true;
-                        continue;
-                    }
-                    else if (escaped && std::isspace(c))
-                    {
-                        escaped = false;
-                        continue;
-                    }
-
-                    if (((!std::isspace(c) && delimiters.find(c) == std::string::npos) || escaped))
-                    {
-                        current_token += c;
-                    }
-                    else
-                    {
-                        if (!current_token.empty())
-                        {
-                            parsed_tokens.emplace_back(line_number, current_token);
-                            current_token.clear();
-                        }
-
-                        if (!std::isspace(c))
-                        {
-                            parsed_tokens.emplace_back(line_number, std::string(1, c));
-                        }
-                    }
+                    begin++;
                 }
 
-                if (!current_token.empty())
+                size_t end = begin;
+                while (end < line.size() && !is_xdc_whitespace(line[end]))
                 {
-                    parsed_tokens.emplace_back(line_number, current_token);
-                    current_token.clear();
+                    end++;
                 }
-            }
-
-            return TokenStream(parsed_tokens, {}, {});
-        }
 
-        Result<LOC> parse_LOC(TokenStream<std::string>& ts)
-        {
-            const auto loc_token = ts.consume();
-            std::string loc_str  = loc_token.string;
-
-            LOC new_loc;
-            new_loc.loc_name = loc_str;
-
-            // test for pin names
-            const auto pin_pattern = std::regex("^[a-zA-Z]\\d+$");
-            std::smatch match;
-            if (std::regex_match(loc_str, match, pin_pattern)) {
-                return OK(new_loc);
+                const std::string_view token = line.substr(begin, end - begin);
+                line.remove_prefix(end);
+                return token;
             }
 
-            // test for slice type + x and y coordinates
-            const std::string loc_type_str = loc_str.substr(0, loc_str.find_first_of("_"));
-
-            if (is_valid_enum<LOCType>(loc_type_str))
-            {
-                new_loc.loc_type = enum_from_string<LOCType>(loc_type_str);
-            }
-            else
+            std::string_view trim_xdc(std::string_view str)
             {
-                return ERR("cannot parse LOC: encountered unknown LOC type '" + loc_type_str + "'" + " at line " + std::to_string(loc_token.number));
+                while (!str.empty() && is_xdc_whitespace(str.front()))
+                {
+                    str.remove_prefix(1);
+                }
+                while (!str.empty() && is_xdc_whitespace(str.back()))
+                {
+                    str.remove_suffix(1);
+                }
+                return str;
             }
 
-            loc_str = loc_str.substr(loc_type_str.size());
-            loc_str = loc_str.substr(std::string("_X").size());
-
-            const std::string x_str = loc_str.substr(0, loc_str.find_first_of("Y"));
-
-            loc_str = loc_str.substr(x_str.size());
-            loc_str = loc_str.substr(std::string("Y").size());
-
-            const std::string y_str = loc_str;
-
-            if (const auto res = utils::wrapped_stoull(x_str); res.is_ok())
+            Result<u64> parse_xdc_number(std::string_view str)
             {
-                new_loc.loc_x = res.get();
-            }
-            else
-            {
-                return ERR_APPEND(res.get_error(), "cannot parse LOC: failed to extract x position form " + loc_token.string + " at line " + std::to_string(loc_token.number));
+                u64 value            = 0;
+                const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+                if (str.empty() || ec != std::errc() || ptr != str.data() + str.size())
+                {
+                    return ERR("invalid number '" + std::string(str) + "'");
+                }
+                return OK(value);
             }
 
-            if (const auto res = utils::wrapped_stoull(y_str); res.is_ok())
+            Result<LOC> parse_LOC(std::string_view loc_str, u32 line_number)
             {
-                new_loc.loc_y = res.get();
-            }
-            else
-            {
-                return ERR_APPEND(res.get_error(), "cannot parse LOC: failed to extract y position form " + loc_token.string + " at line " + std::to_string(loc_token.number));
-            }
+                LOC new_loc;
+                new_loc.loc_name = std::string(loc_str);
 
-            return OK(new_loc);
-        }
+                // test for pin names, i.e., a letter followed by digits
+                if (loc_str.size() > 1 && std::isalpha(static_cast<unsigned char>(loc_str.front()))
+                    && std::all_of(loc_str.begin() + 1, loc_str.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); }))
+                {
+                    new_loc.loc_type = LOCType::PIN;
+                    return OK(new_loc);
+                }
 
-        Result<std::string> parse_single_cell(TokenStream<std::string>& ts)
-        {
-            const auto loc_token = ts.consume();
-            if(loc_token.string != "[get_cells")
-            {
-                return ERR("cannot parse cell name: expected token " + loc_token.string + " at line " + std::to_string(loc_token.number) + " to be exactly '[get_cells'");
-            }
+                // test for slice type + x and y coordinates, e.g., 'SLICE_X12Y34'
+                const std::string loc_type_str(loc_str.substr(0, loc_str.find('_')));
 
-            const auto cell_token = ts.consume();
-            std::string cell_str  = cell_token.string;
+                if (is_valid_enum<LOCType>(loc_type_str))
+                {
+                    new_loc.loc_type = enum_from_string<LOCType>(loc_type_str);
+                }
+                else
+                {
+                    return ERR("cannot parse LOC: encountered unknown LOC type '" + loc_type_str + "'" + " at line " + std::to_string(line_number));
+                }
 
-            // TODO handle excaping with curly braces in tokenize()
-            // if (cell_str.substr(0, 1) != "{")
-            // {
-            //     return ERR("cannot parse cell name: expected cell token '" + cell_str + " at line " + std::to_string(loc_token.number) + "' to start with '{'");
-            // }
+                std::string_view coordinates = loc_str.substr(std::min(loc_str.size(), loc_type_str.size() + std::string_view("_X").size()));
+                const size_t y_pos           = coordinates.find('Y');
 
-            // if (cell_str.substr(cell_str.size() - 2, 2) != "}]")
-            // {
-            //     return ERR("cannot parse cell name: expected cell token '" + cell_str + " at line " + std::to_string(loc_token.number) + "' to end with '}]'");
-            // }
+                if (const auto res = parse_xdc_number(coordinates.substr(0, y_pos)); res.is_ok())
+                {
+                    new_loc.loc_x = res.get();
+                }
+                else
+                {
+                    return ERR_APPEND(res.get_error(), "cannot parse LOC: failed to extract x position form " + new_loc.loc_name + " at line " + std::to_string(line_number));
+                }
 
-            bool is_escpaed = cell_str.substr(0, 1) == "{" && cell_str.substr(cell_str.size() - 2, 1) == "}";
+                if (const auto res = parse_xdc_number(y_pos == std::string_view::npos ? std::string_view() : coordinates.substr(y_pos + 1)); res.is_ok())
+                {
+                    new_loc.loc_y = res.get();
+                }
+                else
+                {
+                    return ERR_APPEND(res.get_error(), "cannot parse LOC: failed to extract y position form " + new_loc.loc_name + " at line " + std::to_string(line_number));
+                }
 
-            if (cell_str.substr(cell_str.size() - 1, 1) != "]")
-            {
-                return ERR("cannot parse cell name: expected cell token '" + cell_str + " at line " + std::to_string(loc_token.number) + "' to end with ']'");
+                return OK(new_loc);
             }
 
-            cell_str = cell_str.substr(is_escpaed ? 1 : 0, cell_str.size() - (is_escpaed ? 2 : 1));
-
-            return OK(cell_str);
-        }
-
-        Result<std::unordered_map<std::string, CellData>> parse_tokens(TokenStream<std::string>& ts)
-        {
-            std::unordered_map<std::string, CellData> cell_data;
-
-            while (true)
+            Result<std::string_view> parse_single_cell(std::string_view cell_str, u32 line_number)
             {
-                ts.consume_until("set_property");
-                if (ts.remaining() == 0)
+                if (next_xdc_token(cell_str) != "[get_cells")
                 {
-                    break;
+                    return ERR("cannot parse cell name: expected '[get_cells' at line " + std::to_string(line_number));
                 }
 
-                ts.consume("set_property");
+                cell_str = trim_xdc(cell_str);
+                if (cell_str.empty() || cell_str.back() != ']')
+                {
+                    return ERR("cannot parse cell name: expected cell token '" + std::string(cell_str) + "' at line " + std::to_string(line_number) + " to end with ']'");
+                }
+                cell_str.remove_suffix(1);
 
-                if (ts.peek().string == "BEL")
+                // names may be escaped with curly braces
+                if (cell_str.size() >= 2 && cell_str.front() == '{' && cell_str.back() == '}')
                 {
-                    ts.consume("BEL");
+                    cell_str = cell_str.substr(1, cell_str.size() - 2);
+                }
+
+                return OK(cell_str);
+            }
 
-                    const auto bel_type = enum_from_string<BELType>(ts.consume().string);
+            struct CellChunk
+            {
+                // LOC constraints in the order of the file
+                std::vector<std::pair<Gate*, LOC>> locs;
+                u32 bel_count = 0;
+                std::vector<std::string> unknown_cells;
+                std::optional<Error> error;
+            };
+
+            /**
+             * Parse all 'set_property BEL' and 'set_property LOC' constraints within a piece of an .xdc file consisting of complete lines.
+             */
+            void parse_cell_chunk(const char* begin, const char* end, u32 first_line_number, const std::unordered_map<std::string_view, Gate*>& name_to_gate, CellChunk& chunk)
+            {
+                u32 line_number = first_line_number;
+                for (const char* line_begin = begin; line_begin < end; line_number++)
+                {
+                    const char* line_end = std::find(line_begin, end, '\n');
+                    std::string_view line(line_begin, line_end - line_begin);
+                    line_begin = line_end + 1;
 
-                    if (const auto res = parse_single_cell(ts); res.is_ok())
+                    if (next_xdc_token(line) != "set_property")
                     {
-                        cell_data[res.get()].bel_type = bel_type;
+                        continue;
                     }
-                    else
+
+                    const std::string_view property = next_xdc_token(line);
+                    if (property != "BEL" && property != "LOC")
                     {
-                        return ERR_APPEND(res.get_error(), "cannot parse xdc token stream: failed to extract cell name");
+                        continue;
                     }
-                }
-                else if (ts.peek().string == "LOC")
-                {
-                    ts.consume("LOC");
 
-                    LOC new_loc;
-                    if (const auto res = parse_LOC(ts); res.is_ok())
+                    const std::string_view value = next_xdc_token(line);
+
+                    std::string_view cell_name;
+                    if (const auto res = parse_single_cell(line, line_number); res.is_ok())
                     {
-                        new_loc = res.get();
+                        cell_name = res.get();
                     }
                     else
                     {
-                        return ERR_APPEND(res.get_error(), "cannot parse xdc token stream: failed to extract LOC");
+                        chunk.error = Error(__FILE__, __LINE__, res.get_error(), "cannot parse xdc file: failed to extract cell name");
+                        return;
+                    }
+
+                    const auto gate_it = name_to_gate.find(cell_name);
+                    if (gate_it == name_to_gate.end())
+                    {
+                        chunk.unknown_cells.emplace_back(cell_name);
                     }
 
-                    if (const auto res = parse_single_cell(ts); res.is_ok())
+                    if (property == "BEL")
                     {
-                        cell_data[res.get()].loc = new_loc;
+                        if (!is_valid_enum<BELType>(std::string(value)))
+                        {
+                            chunk.error = Error(__FILE__, __LINE__, "cannot parse xdc file: encountered unknown BEL type '" + std::string(value) + "' at line " + std::to_string(line_number));
+                            return;
+                        }
+                        chunk.bel_count++;
                     }
                     else
                     {
-                        return ERR_APPEND(res.get_error(), "cannot parse xdc token stream: failed to extract cell name");
+                        if (const auto res = parse_LOC(value, line_number); res.is_ok())
+                        {
+                            if (gate_it != name_to_gate.end())
+                            {
+                                chunk.locs.emplace_back(gate_it->second, res.get());
+                            }
+                        }
+                        else
+                        {
+                            chunk.error = Error(__FILE__, __LINE__, res.get_error(), "cannot parse xdc file: failed to extract LOC");
+                            return;
+                        }
                     }
                 }
-                else
-                {
-                    ts.consume_current_line();
-                }
             }
+        }    // namespace
 
-            return OK(cell_data);
-        }
-   
         // This might depend on the exact xilinx device (family) we are dealing with
         // Result<std::pair<u32, u32>> reconstruct_coordinates(const CellData& cell_data)
         // {
@@ -262,76 +254,72 @@ namespace hal
 
     Result<std::monostate> XilinxToolboxPlugin::parse_xdc_file(Netlist* nl, const std::filesystem::path& xdc_file)
     {
-        std::stringstream ss;
-        std::ifstream ifs;
-        ifs.open(xdc_file.string(), std::ifstream::in);
-        if (!ifs.is_open())
+        MappedTextFile file;
+        if (!file.open(xdc_file))
         {
             return ERR("could not parse xdc file '" + xdc_file.string() + "' : unable to open file");
         }
-        ss << ifs.rdbuf();
-        ifs.close();
 
-        auto ts = xilinx_toolbox::tokenize(ss);
+        const std::string_view text = file.get_text();
+        const char* const text_end  = text.data() + text.size();
 
-        std::unordered_map<std::string, xilinx_toolbox::CellData> cell_data;
-        // parse tokens
-        try
-        {
-            if (auto res = xilinx_toolbox::parse_tokens(ts); res.is_error())
-            {
-                return ERR_APPEND(res.get_error(), "could not parse xdc '" + xdc_file.string() + "': unable to parse tokens");
-            }
-            else
-            {
-                cell_data = res.get();
-            }
-        }
-        catch (TokenStream<std::string>::TokenStreamException& e)
+        // split the file into chunks of complete lines
+        std::vector<const char*> chunk_bounds = {text.data()};
+        std::vector<u32> chunk_line_numbers   = {1};
+        while (text_end - chunk_bounds.back() > (std::ptrdiff_t)xilinx_toolbox::xdc_chunk_size)
         {
-            if (e.line_number != (u32)-1)
-            {
-                return ERR("could not parse xdc '" + xdc_file.string() + "': " + e.message + " (line " + std::to_string(e.line_number) + ")");
-            }
-            else
+            const char* split = std::find(chunk_bounds.back() + xilinx_toolbox::xdc_chunk_size, text_end, '\n');
+            if (split == text_end)
             {
-                return ERR("could not parse xdc '" + xdc_file.string() + "': " + e.message);
+                break;
             }
+            chunk_line_numbers.push_back(chunk_line_numbers.back() + std::count(chunk_bounds.back(), split + 1, '\n'));
+            chunk_bounds.push_back(split + 1);
         }
+        chunk_bounds.push_back(text_end);
 
-        std::unordered_map<std::string, Gate*> gate_name_to_gate;
-        for (const auto g : nl->get_gates())
+        std::unordered_map<std::string_view, Gate*> gate_name_to_gate;
+        gate_name_to_gate.reserve(nl->get_gates().size());
+        for (Gate* g : nl->get_gates())
         {
             gate_name_to_gate[g->get_name()] = g;
         }
 
-        for (const auto& [gate_name, cd] : cell_data)
+        std::vector<xilinx_toolbox::CellChunk> chunks(chunk_line_numbers.size());
+        utils::parallel_for(chunks.size(), [&chunk_bounds, &chunk_line_numbers, &gate_name_to_gate, &chunks](u32 idx) {
+            xilinx_toolbox::parse_cell_chunk(chunk_bounds.at(idx), chunk_bounds.at(idx + 1), chunk_line_numbers.at(idx), gate_name_to_gate, chunks.at(idx));
+        });
+
+        u32 loc_count = 0;
+        u32 bel_count = 0;
+        for (const auto& chunk : chunks)
         {
-            if (const auto it = gate_name_to_gate.find(gate_name); it == gate_name_to_gate.end())
-            {   
-                log_error("xilinx_toolbox", "Found gate name {} in xdc file but not in netlist!", gate_name);
-                continue;
+            if (chunk.error.has_value())
+            {
+                return ERR_APPEND(chunk.error.value(), "could not parse xdc '" + xdc_file.string() + "': unable to parse constraints");
             }
-            else
+
+            for (const auto& gate_name : chunk.unknown_cells)
             {
-                /*
-                if (cd.loc.has_value())
-                {
-                    it->second->set_data("placement_information", "LOC", "string", "{type: " + enum_to_string<xilinx_toolbox::LOCType>(cd.loc.value().loc_type) + ", X: " + std::to_string(cd.loc.value().loc_x) + ", Y: " + std::to_string(cd.loc.value().loc_y) + "}");
-                }
+                log_error("xilinx_toolbox", "Found gate name {} in xdc file but not in netlist!", gate_name);
+            }
 
-                if (cd.bel_type.has_value())
+            // translate the site of each LOC constraint into integer coordinates, package pins do not have any
+            for (const auto& [gate, loc] : chunk.locs)
+            {
+                if (loc.loc_type != xilinx_toolbox::LOCType::PIN)
                 {
-
+                    gate->set_location(std::make_pair((i32)loc.loc_x, (i32)loc.loc_y));
+                    loc_count++;
                 }
-                */
             }
 
-            std::cout << gate_name << ": " << (cd.bel_type.has_value() ? enum_to_string(cd.bel_type.value()) : "NONE") << " - "
-                      << (cd.loc.has_value() ? (enum_to_string(cd.loc.value().loc_type) + std::to_string(cd.loc.value().loc_x) + std::to_string(cd.loc.value().loc_y)) : "NONE") << std::endl;
+            bel_count += chunk.bel_count;
         }
 
+        log_info("xilinx_toolbox", "reconstructed coordinates for {} gates from LOC constraints, found {} BEL constraints", loc_count, bel_count);
+
         return OK({});
     }
 
-}    // namespace hal
\ No newline at end of file
+}    // namespace hal
@@ -0,0 +1,297 @@
+#include "hal_core/netlist/decorators/sequential_netlist_decorator.h"
+
+#include "hal_core/netlist/endpoint.h"
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/net.h"
+#include "hal_core/utilities/utils.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+
+namespace hal
+{
+    namespace
+    {
+        bool is_flip_flop(const Gate* gate)
+        {
+            return gate->get_type()->has_property(GateTypeProperty::ff);
+        }
+
+        bool compare_ids(const Gate* a, const Gate* b)
+        {
+            return a->get_id() < b->get_id();
+        }
+
+        /**
+         * Traverses the combinational logic behind flip-flops.
+         * Visited gates are marked with the number of the current search so that the marks never have to be cleared between searches.
+         */
+        class SuccessorSearch
+        {
+        public:
+            SuccessorSearch(u32 num_gates) : m_visited(num_gates + 1, 0)
+            {
+            }
+
+            std::vector<Gate*> find_successors(const Gate* flip_flop)
+            {
+                m_search++;
+
+                std::vector<Gate*> successors;
+                m_stack.assign(flip_flop->get_fan_out_nets().begin(), flip_flop->get_fan_out_nets().end());
+                while (!m_stack.empty())
+                {
+                    const Net* net = m_stack.back();
+                    m_stack.pop_back();
+
+                    for (const Endpoint* ep : net->get_destinations())
+                    {
+                        Gate* gate = ep->get_gate();
+                        if (is_flip_flop(gate))
+                        {
+                            successors.push_back(gate);
+                            continue;
+                        }
+
+                        const u32 id = gate->get_id();
+                        if (id >= m_visited.size())
+                        {
+                            m_visited.resize(id + 1, 0);
+                        }
+                        if (m_visited[id] == m_search)
+                        {
+                            continue;
+                        }
+                        m_visited[id] = m_search;
+
+                        m_stack.insert(m_stack.end(), gate->get_fan_out_nets().begin(), gate->get_fan_out_nets().end());
+                    }
+                }
+
+                std::sort(successors.begin(), successors.end(), compare_ids);
+                successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+                return successors;
+            }
+
+        private:
+            std::vector<u32> m_visited;
+            u32 m_search = 0;
+            std::vector<const Net*> m_stack;
+        };
+    }    // namespace
+
+    SequentialNetlistDecorator::SequentialNetlistDecorator(const Netlist& netlist)
+        : m_netlist(netlist), m_callback_name("sequential_netlist_decorator_" + std::to_string(reinterpret_cast<uintptr_t>(this)))
+    {
+        rebuild();
+
+        m_netlist.get_event_handler()->register_callback(
+            m_callback_name, std::function<void(GateEvent::event, Gate*, u32)>([this](GateEvent::event e, Gate* gate, u32) { handle_gate_event(e, gate); }));
+        m_netlist.get_event_handler()->register_callback(
+            m_callback_name, std::function<void(NetEvent::event, Net*, u32)>([this](NetEvent::event e, Net* net, u32 associated_data) { handle_net_event(e, net, associated_data); }));
+    }
+
+    SequentialNetlistDecorator::~SequentialNetlistDecorator()
+    {
+        m_netlist.get_event_handler()->unregister_callback(m_callback_name);
+    }
+
+    void SequentialNetlistDecorator::rebuild()
+    {
+        m_flip_flops = m_netlist.get_gates(is_flip_flop);
+        std::sort(m_flip_flops.begin(), m_flip_flops.end(), compare_ids);
+
+        m_flip_flop_indices.clear();
+        m_flip_flop_indices.reserve(m_flip_flops.size());
+        for (u32 i = 0; i < m_flip_flops.size(); i++)
+        {
+            m_flip_flop_indices[m_flip_flops.at(i)] = i;
+        }
+
+        std::vector<u32> all_indices(m_flip_flops.size());
+        std::iota(all_indices.begin(), all_indices.end(), 0);
+        m_successors = compute_successors(all_indices);
+
+        // flip-flops are processed by ID, so every list of predecessors is ordered by ID as well
+        m_predecessors.assign(m_flip_flops.size(), {});
+        for (u32 i = 0; i < m_flip_flops.size(); i++)
+        {
+            for (const Gate* successor : m_successors.at(i))
+            {
+                m_predecessors.at(m_flip_flop_indices.at(successor)).push_back(m_flip_flops.at(i));
+            }
+        }
+
+        m_rebuild_required = false;
+        m_changed_nets.clear();
+        m_changed_gates.clear();
+    }
+
+    void SequentialNetlistDecorator::update()
+    {
+        if (m_rebuild_required)
+        {
+            rebuild();
+            return;
+        }
+
+        if (m_changed_nets.empty() && m_changed_gates.empty())
+        {
+            return;
+        }
+
+        const std::vector<u32> affected = find_affected_flip_flops();
+        m_changed_nets.clear();
+        m_changed_gates.clear();
+
+        // updating most of the flip-flops one by one is slower than starting over
+        if (affected.size() > m_flip_flops.size() / 2)
+        {
+            rebuild();
+            return;
+        }
+
+        std::vector<std::vector<Gate*>> new_successors = compute_successors(affected);
+        for (u32 i = 0; i < affected.size(); i++)
+        {
+            Gate* flip_flop                   = m_flip_flops.at(affected.at(i));
+            std::vector<Gate*>& successors    = m_successors.at(affected.at(i));
+            const std::vector<Gate*>& updated = new_successors.at(i);
+
+            std::vector<Gate*> removed;
+            std::set_difference(successors.begin(), successors.end(), updated.begin(), updated.end(), std::back_inserter(removed), compare_ids);
+            for (const Gate* successor : removed)
+            {
+                std::vector<Gate*>& predecessors = m_predecessors.at(m_flip_flop_indices.at(successor));
+                predecessors.erase(std::lower_bound(predecessors.begin(), predecessors.end(), flip_flop, compare_ids));
+            }
+
+            std::vector<Gate*> added;
+            std::set_difference(updated.begin(), updated.end(), successors.begin(), successors.end(), std::back_inserter(added), compare_ids);
+            for (const Gate* successor : added)
+            {
+                std::vector<Gate*>& predecessors = m_predecessors.at(m_flip_flop_indices.at(successor));
+                predecessors.insert(std::lower_bound(predecessors.begin(), predecessors.end(), flip_flop, compare_ids), flip_flop);
+            }
+
+            successors = std::move(new_successors.at(i));
+        }
+    }
+
+    Result<std::vector<Gate*>> SequentialNetlistDecorator::get_next_sequential_gates(const Gate* gate, bool get_successors)
+    {
+        if (gate == nullptr)
+        {
+            return ERR("could not get next sequential gates: gate is a 'nullptr'");
+        }
+
+        update();
+
+        const auto it = m_flip_flop_indices.find(gate);
+        if (it == m_flip_flop_indices.end())
+        {
+            return ERR("could not get next sequential gates of gate '" + gate->get_name() + "' with ID " + std::to_string(gate->get_id()) + ": gate is not a flip-flop of netlist with ID "
+                       + std::to_string(m_netlist.get_id()));
+        }
+
+        return OK(get_successors ? m_successors.at(it->second) : m_predecessors.at(it->second));
+    }
+
+    void SequentialNetlistDecorator::handle_gate_event(GateEvent::event e, Gate* gate)
+    {
+        // flip-flops are numbered consecutively, so adding or removing one requires starting over
+        if ((e == GateEvent::event::created || e == GateEvent::event::removed) && is_flip_flop(gate))
+        {
+            m_rebuild_required = true;
+        }
+    }
+
+    void SequentialNetlistDecorator::handle_net_event(NetEvent::event e, Net* net, u32 associated_data)
+    {
+        if (e == NetEvent::event::src_added || e == NetEvent::event::src_removed)
+        {
+            // the flip-flops in front of the source gate now reach different gates
+            m_changed_gates.insert(associated_data);
+        }
+        else if (e == NetEvent::event::dst_added || e == NetEvent::event::dst_removed)
+        {
+            // the flip-flops in front of the net now reach different gates
+            m_changed_nets.insert(net->get_id());
+        }
+    }
+
+    std::vector<u32> SequentialNetlistDecorator::find_affected_flip_flops() const
+    {
+        std::vector<u32> affected;
+        std::unordered_set<const Gate*> visited;
+        std::vector<const Net*> stack;
+
+        auto visit_gate = [this, &affected, &visited, &stack](const Gate* gate) {
+            if (!visited.insert(gate).second)
+            {
+                return;
+            }
+
+            if (const auto it = m_flip_flop_indices.find(gate); it != m_flip_flop_indices.end())
+            {
+                affected.push_back(it->second);
+            }
+            else
+            {
+                stack.insert(stack.end(), gate->get_fan_in_nets().begin(), gate->get_fan_in_nets().end());
+            }
+        };
+
+        // deleted gates and nets are skipped, their former neighbors have been recorded as well
+        for (u32 gate_id : m_changed_gates)
+        {
+            if (const Gate* gate = m_netlist.get_gate_by_id(gate_id); gate != nullptr)
+            {
+                visit_gate(gate);
+            }
+        }
+
+        for (u32 net_id : m_changed_nets)
+        {
+            if (const Net* net = m_netlist.get_net_by_id(net_id); net != nullptr)
+            {
+                stack.push_back(net);
+            }
+        }
+
+        while (!stack.empty())
+        {
+            const Net* net = stack.back();
+            stack.pop_back();
+
+            for (const Endpoint* ep : net->get_sources())
+            {
+                visit_gate(ep->get_gate());
+            }
+        }
+
+        std::sort(affected.begin(), affected.end());
+        return affected;
+    }
+
+    std::vector<std::vector<Gate*>> SequentialNetlistDecorator::compute_successors(const std::vector<u32>& flip_flop_indices) const
+    {
+        std::vector<std::vector<Gate*>> successors(flip_flop_indices.size());
+
+        // every thread keeps its own search to avoid reallocating the visited marks for every flip-flop
+        const u32 num_threads = utils::get_num_parallel_threads(flip_flop_indices.size());
+        const u32 num_gates   = m_netlist.get_gates().size();
+        std::vector<std::unique_ptr<SuccessorSearch>> searches(num_threads);
+        utils::parallel_for_with_thread_index(flip_flop_indices.size(), num_threads, [this, &flip_flop_indices, &successors, &searches, num_gates](u32 t, u32 i) {
+            if (searches.at(t) == nullptr)
+            {
+                searches.at(t) = std::make_unique<SuccessorSearch>(num_gates);
+            }
+            successors.at(i) = searches.at(t)->find_successors(m_flip_flops.at(flip_flop_indices.at(i)));
+        });
+
+        return successors;
+    }
+}    // namespace hal
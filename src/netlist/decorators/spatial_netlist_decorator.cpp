@@ -0,0 +1,340 @@
+#include "hal_core/netlist/decorators/spatial_netlist_decorator.h"
+
+#include "hal_core/netlist/gate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+namespace hal
+{
+    namespace
+    {
+        // average number of gates per grid cell if the cell size is chosen automatically
+        const double gates_per_cell = 4.0;
+
+        u64 get_cell_key(i64 cell_x, i64 cell_y)
+        {
+            return ((u64)cell_x << 32) | (u64)cell_y;
+        }
+    }    // namespace
+
+    SpatialNetlistDecorator::SpatialNetlistDecorator(const Netlist& netlist, u32 cell_size)
+        : m_netlist(netlist), m_callback_name("spatial_netlist_decorator_" + std::to_string(reinterpret_cast<uintptr_t>(this)))
+    {
+        rebuild(cell_size);
+
+        m_netlist.get_event_handler()->register_callback(
+            m_callback_name, std::function<void(GateEvent::event, Gate*, u32)>([this](GateEvent::event e, Gate* gate, u32) { handle_gate_event(e, gate); }));
+    }
+
+    SpatialNetlistDecorator::~SpatialNetlistDecorator()
+    {
+        m_netlist.get_event_handler()->unregister_callback(m_callback_name);
+    }
+
+    void SpatialNetlistDecorator::rebuild(u32 cell_size)
+    {
+        const std::vector<Gate*>& gates = m_netlist.get_gates();
+
+        if (cell_size == 0)
+        {
+            // choose the cell size from the bounding box of all placed gates
+            i64 min_x      = std::numeric_limits<i32>::max();
+            i64 min_y      = std::numeric_limits<i32>::max();
+            i64 max_x      = 0;
+            i64 max_y      = 0;
+            u64 num_placed = 0;
+            for (const Gate* gate : gates)
+            {
+                if (gate->has_location())
+                {
+                    min_x = std::min(min_x, (i64)gate->get_location_x());
+                    min_y = std::min(min_y, (i64)gate->get_location_y());
+                    max_x = std::max(max_x, (i64)gate->get_location_x());
+                    max_y = std::max(max_y, (i64)gate->get_location_y());
+                    num_placed++;
+                }
+            }
+
+            cell_size = 1;
+            if (num_placed > 0)
+            {
+                const double area = (double)(max_x - min_x + 1) * (double)(max_y - min_y + 1);
+                cell_size         = (u32)std::max(1.0, std::ceil(std::sqrt(area * gates_per_cell / num_placed)));
+            }
+        }
+
+        m_cell_size = cell_size;
+        m_cells.clear();
+        m_locations.clear();
+        m_locations.reserve(gates.size());
+        m_min_cell_x = 0;
+        m_min_cell_y = 0;
+        m_max_cell_x = -1;
+        m_max_cell_y = -1;
+
+        for (Gate* gate : gates)
+        {
+            insert_gate(gate);
+        }
+    }
+
+    u32 SpatialNetlistDecorator::get_cell_size() const
+    {
+        return m_cell_size;
+    }
+
+    u32 SpatialNetlistDecorator::get_num_placed_gates() const
+    {
+        return m_locations.size();
+    }
+
+    std::vector<Gate*> SpatialNetlistDecorator::get_gates_in_area(i32 min_x, i32 min_y, i32 max_x, i32 max_y) const
+    {
+        std::vector<Gate*> res;
+        if (m_cells.empty() || max_x < 0 || max_y < 0 || min_x > max_x || min_y > max_y)
+        {
+            return res;
+        }
+
+        min_x = std::max(min_x, 0);
+        min_y = std::max(min_y, 0);
+
+        const i64 min_cell_x = std::max((i64)(min_x / m_cell_size), m_min_cell_x);
+        const i64 min_cell_y = std::max((i64)(min_y / m_cell_size), m_min_cell_y);
+        const i64 max_cell_x = std::min((i64)(max_x / m_cell_size), m_max_cell_x);
+        const i64 max_cell_y = std::min((i64)(max_y / m_cell_size), m_max_cell_y);
+        if (min_cell_x > max_cell_x || min_cell_y > max_cell_y)
+        {
+            return res;
+        }
+
+        auto collect = [&res, min_x, min_y, max_x, max_y](const std::vector<IndexedGate>& entries) {
+            for (const IndexedGate& entry : entries)
+            {
+                if (entry.x >= min_x && entry.x <= max_x && entry.y >= min_y && entry.y <= max_y)
+                {
+                    res.push_back(entry.gate);
+                }
+            }
+        };
+
+        if ((u64)(max_cell_x - min_cell_x + 1) * (u64)(max_cell_y - min_cell_y + 1) <= m_cells.size())
+        {
+            for (i64 cell_x = min_cell_x; cell_x <= max_cell_x; cell_x++)
+            {
+                for (i64 cell_y = min_cell_y; cell_y <= max_cell_y; cell_y++)
+                {
+                    if (const auto it = m_cells.find(get_cell_key(cell_x, cell_y)); it != m_cells.end())
+                    {
+                        collect(it->second);
+                    }
+                }
+            }
+        }
+        else
+        {
+            // the area covers more cells than are occupied, so only look at the occupied ones
+            for (const auto& [key, entries] : m_cells)
+            {
+                const i64 cell_x = (i64)(key >> 32);
+                const i64 cell_y = (i64)(key & 0xFFFFFFFF);
+                if (cell_x >= min_cell_x && cell_x <= max_cell_x && cell_y >= min_cell_y && cell_y <= max_cell_y)
+                {
+                    collect(entries);
+                }
+            }
+        }
+
+        return res;
+    }
+
+    std::vector<Gate*> SpatialNetlistDecorator::get_nearest_gates(i32 x, i32 y, u32 k) const
+    {
+        return find_nearest_gates(x, y, k, nullptr);
+    }
+
+    Result<std::vector<Gate*>> SpatialNetlistDecorator::get_nearest_gates(const Gate* gate, u32 k) const
+    {
+        if (gate == nullptr)
+        {
+            return ERR("could not get nearest gates: gate is a 'nullptr'");
+        }
+
+        if (!gate->has_location())
+        {
+            return ERR("could not get nearest gates of gate '" + gate->get_name() + "' with ID " + std::to_string(gate->get_id()) + ": gate has no location assigned");
+        }
+
+        return OK(find_nearest_gates(gate->get_location_x(), gate->get_location_y(), k, gate));
+    }
+
+    void SpatialNetlistDecorator::insert_gate(Gate* gate)
+    {
+        if (!gate->has_location())
+        {
+            return;
+        }
+
+        const i32 x      = gate->get_location_x();
+        const i32 y      = gate->get_location_y();
+        const i64 cell_x = x / m_cell_size;
+        const i64 cell_y = y / m_cell_size;
+
+        m_cells[get_cell_key(cell_x, cell_y)].push_back({gate, x, y});
+        m_locations[gate] = std::make_pair(x, y);
+
+        if (m_max_cell_x < m_min_cell_x)
+        {
+            m_min_cell_x = m_max_cell_x = cell_x;
+            m_min_cell_y = m_max_cell_y = cell_y;
+        }
+        else
+        {
+            m_min_cell_x = std::min(m_min_cell_x, cell_x);
+            m_min_cell_y = std::min(m_min_cell_y, cell_y);
+            m_max_cell_x = std::max(m_max_cell_x, cell_x);
+            m_max_cell_y = std::max(m_max_cell_y, cell_y);
+        }
+    }
+
+    void SpatialNetlistDecorator::erase_gate(const Gate* gate)
+    {
+        // the gate may already have been moved, so its indexed location is used to find the cell
+        const auto location_it = m_locations.find(gate);
+        if (location_it == m_locations.end())
+        {
+            return;
+        }
+
+        const auto cell_it = m_cells.find(get_cell_key(location_it->second.first / m_cell_size, location_it->second.second / m_cell_size));
+        m_locations.erase(location_it);
+        if (cell_it == m_cells.end())
+        {
+            return;
+        }
+
+        std::vector<IndexedGate>& entries = cell_it->second;
+        if (const auto entry_it = std::find_if(entries.begin(), entries.end(), [gate](const IndexedGate& entry) { return entry.gate == gate; }); entry_it != entries.end())
+        {
+            *entry_it = entries.back();
+            entries.pop_back();
+        }
+
+        if (entries.empty())
+        {
+            m_cells.erase(cell_it);
+        }
+    }
+
+    void SpatialNetlistDecorator::handle_gate_event(GateEvent::event e, Gate* gate)
+    {
+        if (e == GateEvent::event::created)
+        {
+            insert_gate(gate);
+        }
+        else if (e == GateEvent::event::removed)
+        {
+            erase_gate(gate);
+        }
+        else if (e == GateEvent::event::location_changed)
+        {
+            erase_gate(gate);
+            insert_gate(gate);
+        }
+    }
+
+    std::vector<Gate*> SpatialNetlistDecorator::find_nearest_gates(i32 x, i32 y, u32 k, const Gate* excluded_gate) const
+    {
+        std::vector<Gate*> res;
+        if (k == 0 || m_cells.empty())
+        {
+            return res;
+        }
+
+        const i64 center_x = std::max(x, 0) / m_cell_size;
+        const i64 center_y = std::max(y, 0) / m_cell_size;
+
+        // max-heap of the k best candidates found so far, ordered by squared distance and ID
+        std::vector<std::tuple<u64, u32, Gate*>> candidates;
+        candidates.reserve(k);
+
+        auto visit_cell = [this, &candidates, x, y, k, excluded_gate](i64 cell_x, i64 cell_y) {
+            if (cell_x < m_min_cell_x || cell_x > m_max_cell_x || cell_y < m_min_cell_y || cell_y > m_max_cell_y)
+            {
+                return;
+            }
+
+            const auto it = m_cells.find(get_cell_key(cell_x, cell_y));
+            if (it == m_cells.end())
+            {
+                return;
+            }
+
+            for (const IndexedGate& entry : it->second)
+            {
+                if (entry.gate == excluded_gate)
+                {
+                    continue;
+                }
+
+                const i64 dx                                = (i64)entry.x - x;
+                const i64 dy                                = (i64)entry.y - y;
+                const std::tuple<u64, u32, Gate*> candidate = {(u64)(dx * dx) + (u64)(dy * dy), entry.gate->get_id(), entry.gate};
+                if (candidates.size() < k)
+                {
+                    candidates.push_back(candidate);
+                    std::push_heap(candidates.begin(), candidates.end());
+                }
+                else if (candidate < candidates.front())
+                {
+                    std::pop_heap(candidates.begin(), candidates.end());
+                    candidates.back() = candidate;
+                    std::push_heap(candidates.begin(), candidates.end());
+                }
+            }
+        };
+
+        // visit rings of cells around the center cell, starting at the first ring that overlaps the occupied cells
+        const i64 first_ring = std::max({(i64)0, m_min_cell_x - center_x, center_x - m_max_cell_x, m_min_cell_y - center_y, center_y - m_max_cell_y});
+        const i64 last_ring  = std::max({center_x - m_min_cell_x, m_max_cell_x - center_x, center_y - m_min_cell_y, m_max_cell_y - center_y});
+        for (i64 r = first_ring; r <= last_ring; r++)
+        {
+            if (r == 0)
+            {
+                visit_cell(center_x, center_y);
+            }
+            else
+            {
+                for (i64 i = -r; i <= r; i++)
+                {
+                    visit_cell(center_x + i, center_y - r);
+                    visit_cell(center_x + i, center_y + r);
+                }
+                for (i64 i = -r + 1; i <= r - 1; i++)
+                {
+                    visit_cell(center_x - r, center_y + i);
+                    visit_cell(center_x + r, center_y + i);
+                }
+            }
+
+            // all gates in the remaining rings are at least r * cell_size + 1 away from the location
+            const u64 min_remaining_distance = (u64)r * m_cell_size + 1;
+            if (candidates.size() == k && std::get<0>(candidates.front()) < min_remaining_distance * min_remaining_distance)
+            {
+                break;
+            }
+        }
+
+        std::sort_heap(candidates.begin(), candidates.end());
+
+        res.reserve(candidates.size());
+        for (const auto& candidate : candidates)
+        {
+            res.push_back(std::get<2>(candidate));
+        }
+        return res;
+    }
+}    // namespace hal
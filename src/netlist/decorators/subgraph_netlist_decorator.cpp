@@ -7,6 +7,9 @@
 #include "hal_core/netlist/netlist_factory.h"
 #include "hal_core/utilities/utils.h"
 
+#include <optional>
+#include <unordered_set>
+
 namespace hal
 {
     SubgraphNetlistDecorator::SubgraphNetlistDecorator(const Netlist& netlist) : m_netlist(netlist)
@@ -178,6 +181,27 @@ namespace hal
 
     namespace
     {
+        /**
+         * A net within the cones of the subgraph outputs that is driven by a subgraph gate.
+         */
+        struct ConeNet
+        {
+            struct Input
+            {
+                std::string variable;
+                // index of the input net within the cone or the variable of a subgraph input net
+                std::optional<u32> cone_index;
+                BooleanFunction function;
+            };
+
+            const Net* net;
+            const Endpoint* source;
+            BooleanFunction gate_function;
+            std::vector<Input> inputs;
+            BooleanFunction function;
+            std::optional<Error> error;
+        };
+
         Result<BooleanFunction> subgraph_function_recursive(const Net* n,
                                                             const std::vector<const Gate*>& subgraph_gates,
                                                             std::map<std::pair<u32, const GatePin*>, BooleanFunction>& gate_cache,
@@ -467,6 +491,294 @@ namespace hal
         }
     }
 
+    Result<std::vector<BooleanFunction>> SubgraphNetlistDecorator::get_subgraph_functions(const std::vector<const Gate*>& subgraph_gates,
+                                                                                        const std::vector<const Net*>& subgraph_outputs) const
+    {
+        // check validity of subgraph_gates
+        if (subgraph_gates.empty())
+        {
+            return ERR("could not get subgraph functions: subgraph contains no gates");
+        }
+        else if (std::any_of(subgraph_gates.begin(), subgraph_gates.end(), [](const Gate* g) { return g == nullptr; }))
+        {
+            return ERR("could not get subgraph functions: subgraph contains a gate that is a 'nullptr'");
+        }
+
+        const std::unordered_set<const Gate*> subgraph_gate_set(subgraph_gates.begin(), subgraph_gates.end());
+
+        std::vector<ConeNet> cone;
+        std::unordered_map<const Net*, u32> cone_indices;
+        std::vector<u32> frontier;
+
+        // returns the index of the net within the cone or std::nullopt if the net is a subgraph input
+        auto add_to_cone = [&subgraph_gate_set, &cone, &cone_indices, &frontier](const Net* n) -> Result<std::optional<u32>> {
+            if (const auto it = cone_indices.find(n); it != cone_indices.end())
+            {
+                return OK(it->second);
+            }
+
+            const std::vector<Endpoint*> sources = n->get_sources();
+            if (sources.size() > 1)
+            {
+                return ERR("could not get subgraph function of net '" + n->get_name() + "' with ID " + std::to_string(n->get_id()) + ": cannot handle multi driven nets! Encountered at net "
+                           + std::to_string(n->get_id()) + ".");
+            }
+
+            if (sources.empty())
+            {
+                return OK(std::nullopt);
+            }
+
+            if (sources.front()->get_gate() == nullptr)
+            {
+                return ERR("could not get subgraph function of net '" + n->get_name() + "' with ID " + std::to_string(n->get_id()) + ": gate at source for net " + std::to_string(n->get_id())
+                           + " is null.");
+            }
+
+            if (subgraph_gate_set.find(sources.front()->get_gate()) == subgraph_gate_set.end())
+            {
+                return OK(std::nullopt);
+            }
+
+            const u32 index = cone.size();
+            cone_indices[n] = index;
+            cone.push_back({n, sources.front(), BooleanFunction(), {}, BooleanFunction(), std::nullopt});
+            frontier.push_back(index);
+            return OK(index);
+        };
+
+        // the results are either a variable right away or taken from the cone once it has been evaluated
+        std::vector<BooleanFunction> results(subgraph_outputs.size());
+        std::vector<std::optional<u32>> result_cone_indices(subgraph_outputs.size());
+        for (u32 i = 0; i < subgraph_outputs.size(); i++)
+        {
+            const Net* subgraph_output = subgraph_outputs.at(i);
+            if (subgraph_output == nullptr)
+            {
+                return ERR("could not get subgraph functions: net is a 'nullptr'");
+            }
+            else if (subgraph_output->get_num_of_sources() > 1)
+            {
+                return ERR("could not get subgraph function of net '" + subgraph_output->get_name() + "' with ID " + std::to_string(subgraph_output->get_id()) + ": net has more than one source");
+            }
+            else if (subgraph_output->is_global_input_net())
+            {
+                results.at(i) = BooleanFunctionNetDecorator(*subgraph_output).get_boolean_variable();
+                continue;
+            }
+            else if (subgraph_output->get_num_of_sources() == 0)
+            {
+                return ERR("could not get subgraph function of net '" + subgraph_output->get_name() + "' with ID " + std::to_string(subgraph_output->get_id()) + ": net has no sources");
+            }
+
+            if (auto res = add_to_cone(subgraph_output); res.is_error())
+            {
+                return ERR(res.get_error());
+            }
+            else if (!res.get().has_value())
+            {
+                results.at(i) = BooleanFunctionNetDecorator(*subgraph_output).get_boolean_variable();
+            }
+            else
+            {
+                result_cone_indices.at(i) = res.get();
+            }
+        }
+
+        // collect the union of all cones, the gate functions of each new layer of nets are built concurrently
+        while (!frontier.empty())
+        {
+            const std::vector<u32> current = std::move(frontier);
+            frontier.clear();
+
+            utils::parallel_for(current.size(), [&cone, &current](u32 i) {
+                ConeNet& cone_net = cone.at(current.at(i));
+                if (auto res = cone_net.source->get_gate()->get_resolved_boolean_function(cone_net.source->get_pin()); res.is_error())
+                {
+                    cone_net.error = Error(__FILE__,
+                                           __LINE__,
+                                           res.get_error(),
+                                           "could not get subgraph function of net " + cone_net.net->get_name() + " with ID " + std::to_string(cone_net.net->get_id())
+                                               + ": failed to get function of gate.");
+                }
+                else
+                {
+                    cone_net.gate_function = res.get().simplify_local();
+                }
+            });
+
+            for (u32 index : current)
+            {
+                if (cone.at(index).error.has_value())
+                {
+                    return ERR(cone.at(index).error.value());
+                }
+
+                for (const std::string& variable : cone.at(index).gate_function.get_variable_names())
+                {
+                    const Net* n = cone.at(index).net;
+                    Net* in_net  = nullptr;
+                    if (auto res = BooleanFunctionNetDecorator::get_net_from(&m_netlist, variable); res.is_error())
+                    {
+                        return ERR_APPEND(res.get_error(),
+                                          "could not get subgraph function of net '" + n->get_name() + "' with ID " + std::to_string(n->get_id()) + ": cannot find in_net " + variable + " at gate "
+                                              + std::to_string(cone.at(index).source->get_gate()->get_id()) + "!");
+                    }
+                    else
+                    {
+                        in_net = res.get();
+                    }
+
+                    // adding to the cone may move the cone nets
+                    if (auto res = add_to_cone(in_net); res.is_error())
+                    {
+                        return ERR(res.get_error());
+                    }
+                    else if (res.get().has_value())
+                    {
+                        cone.at(index).inputs.push_back({variable, res.get(), BooleanFunction()});
+                    }
+                    else
+                    {
+                        cone.at(index).inputs.push_back({variable, std::nullopt, BooleanFunctionNetDecorator(*in_net).get_boolean_variable()});
+                    }
+                }
+            }
+        }
+
+        // assign every cone net to a level after all of its inputs, which also detects cycles
+        std::vector<u32> levels(cone.size(), 0);
+        {
+            enum class State
+            {
+                unvisited,
+                on_stack,
+                done
+            };
+            std::vector<State> states(cone.size(), State::unvisited);
+            std::vector<std::pair<u32, u32>> stack;
+
+            for (u32 root = 0; root < cone.size(); root++)
+            {
+                if (states.at(root) != State::unvisited)
+                {
+                    continue;
+                }
+
+                states.at(root) = State::on_stack;
+                stack.emplace_back(root, 0);
+                while (!stack.empty())
+                {
+                    auto& [index, next_input] = stack.back();
+                    const ConeNet& cone_net   = cone.at(index);
+                    if (next_input == cone_net.inputs.size())
+                    {
+                        for (const auto& input : cone_net.inputs)
+                        {
+                            if (input.cone_index.has_value())
+                            {
+                                levels.at(index) = std::max(levels.at(index), levels.at(input.cone_index.value()) + 1);
+                            }
+                        }
+                        states.at(index) = State::done;
+                        stack.pop_back();
+                        continue;
+                    }
+
+                    const std::optional<u32> input_index = cone_net.inputs.at(next_input++).cone_index;
+                    if (!input_index.has_value() || states.at(input_index.value()) == State::done)
+                    {
+                        continue;
+                    }
+                    else if (states.at(input_index.value()) == State::on_stack)
+                    {
+                        const Net* n = cone.at(input_index.value()).net;
+                        return ERR("could not get subgraph function of net '" + n->get_name() + "' with ID " + std::to_string(n->get_id()) + ": subgraph contains a cycle!");
+                    }
+
+                    states.at(input_index.value()) = State::on_stack;
+                    stack.emplace_back(input_index.value(), 0);
+                }
+            }
+        }
+
+        std::vector<std::vector<u32>> cone_levels(cone.empty() ? 0 : *std::max_element(levels.begin(), levels.end()) + 1);
+        for (u32 index = 0; index < cone.size(); index++)
+        {
+            cone_levels.at(levels.at(index)).push_back(index);
+        }
+
+        // substitute the inputs of all gate functions level by level, the nets of a level only depend on nets of earlier levels
+        for (const std::vector<u32>& level : cone_levels)
+        {
+            utils::parallel_for(level.size(), [&cone, &level](u32 i) {
+                ConeNet& cone_net = cone.at(level.at(i));
+
+                std::map<std::string, BooleanFunction> input_to_bf;
+                for (const auto& input : cone_net.inputs)
+                {
+                    input_to_bf.insert({input.variable, input.cone_index.has_value() ? cone.at(input.cone_index.value()).function : input.function});
+                }
+
+                if (auto res = cone_net.gate_function.substitute(input_to_bf); res.is_error())
+                {
+                    cone_net.error = Error(__FILE__,
+                                           __LINE__,
+                                           res.get_error(),
+                                           "could not get subgraph function of net '" + cone_net.net->get_name() + "' with ID " + std::to_string(cone_net.net->get_id())
+                                               + ": failed to substitute inputs for gate function " + cone_net.gate_function.to_string() + ".");
+                }
+                else
+                {
+                    cone_net.function = res.get();
+                }
+            });
+
+            for (u32 index : level)
+            {
+                if (cone.at(index).error.has_value())
+                {
+                    return ERR(cone.at(index).error.value());
+                }
+            }
+        }
+
+        for (u32 i = 0; i < subgraph_outputs.size(); i++)
+        {
+            if (result_cone_indices.at(i).has_value())
+            {
+                results.at(i) = cone.at(result_cone_indices.at(i).value()).function;
+            }
+        }
+
+        return OK(results);
+    }
+
+    Result<std::vector<BooleanFunction>> SubgraphNetlistDecorator::get_subgraph_functions(const std::vector<Gate*>& subgraph_gates, const std::vector<const Net*>& subgraph_outputs) const
+    {
+        const auto subgraph_gates_const = std::vector<const Gate*>(subgraph_gates.begin(), subgraph_gates.end());
+        if (auto res = get_subgraph_functions(subgraph_gates_const, subgraph_outputs); res.is_error())
+        {
+            return ERR(res.get_error());
+        }
+        else
+        {
+            return res;
+        }
+    }
+
+    Result<std::vector<BooleanFunction>> SubgraphNetlistDecorator::get_subgraph_functions(const Module* subgraph_module, const std::vector<const Net*>& subgraph_outputs) const
+    {
+        if (auto res = get_subgraph_functions(subgraph_module->get_gates(), subgraph_outputs); res.is_error())
+        {
+            return ERR(res.get_error());
+        }
+        else
+        {
+            return res;
+        }
+    }
+
     Result<std::set<const Net*>> SubgraphNetlistDecorator::get_subgraph_function_inputs(const std::vector<const Gate*>& subgraph_gates, const Net* subgraph_output) const
     {
         // check validity of subgraph_gates
@@ -0,0 +1,769 @@
+#include "hal_core/netlist/gate_library/gate_library_cache.h"
+
+#include "hal_core/netlist/boolean_function.h"
+#include "hal_core/netlist/gate_library/gate_library.h"
+#include "hal_core/netlist/gate_library/gate_type_component/ff_component.h"
+#include "hal_core/netlist/gate_library/gate_type_component/init_component.h"
+#include "hal_core/netlist/gate_library/gate_type_component/latch_component.h"
+#include "hal_core/netlist/gate_library/gate_type_component/lut_component.h"
+#include "hal_core/netlist/gate_library/gate_type_component/ram_component.h"
+#include "hal_core/netlist/gate_library/gate_type_component/ram_port_component.h"
+#include "hal_core/netlist/gate_library/gate_type_component/state_component.h"
+#include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
+#include "hal_version.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace hal
+{
+    namespace gate_library_cache
+    {
+        namespace
+        {
+            const char CACHE_MAGIC[8] = {'H', 'A', 'L', 'G', 'L', 'C', 0, 0};
+
+            // hash of the library file content, the cache is discarded whenever the file changes
+            Result<u64> compute_content_hash(const std::filesystem::path& file_path)
+            {
+                std::ifstream ifs(file_path, std::ios::binary);
+                if (!ifs.good())
+                {
+                    return ERR("could not compute content hash: unable to open '" + file_path.string() + "'");
+                }
+
+                u64 hash = utils::FNV1A_OFFSET_BASIS;
+                char buf[65536];
+                while (ifs.good())
+                {
+                    ifs.read(buf, sizeof(buf));
+                    hash = utils::fnv1a_hash(hash, buf, ifs.gcount());
+                }
+                return OK(hash);
+            }
+
+            std::vector<std::filesystem::path> get_cache_paths(const std::filesystem::path& file_path)
+            {
+                std::string cache_name = file_path.filename().string() + CACHE_FILE_EXTENSION;
+                return {file_path.parent_path() / cache_name, utils::get_user_share_directory() / "gate_library_cache" / cache_name};
+            }
+
+            class CacheWriter
+            {
+            public:
+                void write_u8(u8 value)
+                {
+                    m_data.push_back((char)value);
+                }
+
+                void write_u32(u32 value)
+                {
+                    m_data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+                }
+
+                void write_u64(u64 value)
+                {
+                    m_data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+                }
+
+                void write_string(const std::string& value)
+                {
+                    write_u32(value.size());
+                    m_data.append(value);
+                }
+
+                void write_boolean_function(const BooleanFunction& bf)
+                {
+                    const std::vector<BooleanFunction::Node>& nodes = bf.get_nodes();
+                    write_u32(nodes.size());
+                    for (const auto& node : nodes)
+                    {
+                        write_u32(node.type);
+                        write_u32(node.size);
+                        write_u32(node.index);
+                        write_string(node.variable);
+                        write_u32(node.constant.size());
+                        for (BooleanFunction::Value value : node.constant)
+                        {
+                            write_u8((u8)value);
+                        }
+                    }
+                }
+
+                const std::string& get_data() const
+                {
+                    return m_data;
+                }
+
+            private:
+                std::string m_data;
+            };
+
+            class CacheReader
+            {
+            public:
+                CacheReader(std::string&& data) : m_data(std::move(data))
+                {
+                }
+
+                u8 read_u8()
+                {
+                    if (!check(1))
+                    {
+                        return 0;
+                    }
+                    return (u8)m_data[m_pos++];
+                }
+
+                u32 read_u32()
+                {
+                    u32 value = 0;
+                    if (check(sizeof(value)))
+                    {
+                        std::copy_n(m_data.data() + m_pos, sizeof(value), reinterpret_cast<char*>(&value));
+                        m_pos += sizeof(value);
+                    }
+                    return value;
+                }
+
+                std::string read_string()
+                {
+                    u32 size = read_u32();
+                    if (!check(size))
+                    {
+                        return "";
+                    }
+                    std::string value = m_data.substr(m_pos, size);
+                    m_pos += size;
+                    return value;
+                }
+
+                Result<BooleanFunction> read_boolean_function()
+                {
+                    u32 num_nodes = read_u32();
+                    if (num_nodes == 0)
+                    {
+                        return OK(BooleanFunction());
+                    }
+                    if (!check(num_nodes))
+                    {
+                        return ERR("could not read Boolean function: unexpected end of cache data");
+                    }
+
+                    std::vector<BooleanFunction::Node> nodes;
+                    nodes.reserve(num_nodes);
+                    for (u32 i = 0; i < num_nodes; i++)
+                    {
+                        u16 type                   = read_u32();
+                        u16 size                   = read_u32();
+                        BooleanFunction::Node node = BooleanFunction::Node::Operation(type, size);
+                        node.index                 = read_u32();
+                        node.variable              = read_string();
+                        u32 num_values             = read_u32();
+                        if (!check(num_values))
+                        {
+                            return ERR("could not read Boolean function: unexpected end of cache data");
+                        }
+                        node.constant.reserve(num_values);
+                        for (u32 j = 0; j < num_values; j++)
+                        {
+                            node.constant.push_back((BooleanFunction::Value)read_u8());
+                        }
+                        nodes.push_back(std::move(node));
+                    }
+                    return BooleanFunction::build(std::move(nodes));
+                }
+
+                bool good() const
+                {
+                    return m_good;
+                }
+
+                bool at_end() const
+                {
+                    return m_pos == m_data.size();
+                }
+
+            private:
+                std::string m_data;
+                size_t m_pos = 0;
+                bool m_good  = true;
+
+                bool check(size_t num_bytes)
+                {
+                    if (m_pos + num_bytes > m_data.size())
+                    {
+                        m_good = false;
+                    }
+                    return m_good;
+                }
+            };
+
+            // components form a chain in which every component holds at most one child, the direct child is reported last
+            GateTypeComponent* get_child_component(const GateTypeComponent* component)
+            {
+                std::vector<GateTypeComponent*> components = component->get_components();
+                return components.empty() ? nullptr : components.back();
+            }
+
+            void write_component(CacheWriter& writer, const GateTypeComponent* component)
+            {
+                if (component == nullptr)
+                {
+                    writer.write_u8(0);
+                    return;
+                }
+
+                writer.write_u8(1);
+                writer.write_u8((u8)component->get_type());
+                switch (component->get_type())
+                {
+                    case GateTypeComponent::ComponentType::lut: {
+                        const LUTComponent* lut_component = component->convert_to<LUTComponent>();
+                        writer.write_u8(lut_component->is_init_ascending());
+                        break;
+                    }
+                    case GateTypeComponent::ComponentType::ff: {
+                        const FFComponent* ff_component = component->convert_to<FFComponent>();
+                        writer.write_boolean_function(ff_component->get_next_state_function());
+                        writer.write_boolean_function(ff_component->get_clock_function());
+                        writer.write_boolean_function(ff_component->get_async_reset_function());
+                        writer.write_boolean_function(ff_component->get_async_set_function());
+                        writer.write_u8((u8)ff_component->get_async_set_reset_behavior().first);
+                        writer.write_u8((u8)ff_component->get_async_set_reset_behavior().second);
+                        break;
+                    }
+                    case GateTypeComponent::ComponentType::latch: {
+                        const LatchComponent* latch_component = component->convert_to<LatchComponent>();
+                        writer.write_boolean_function(latch_component->get_data_in_function());
+                        writer.write_boolean_function(latch_component->get_enable_function());
+                        writer.write_boolean_function(latch_component->get_async_reset_function());
+                        writer.write_boolean_function(latch_component->get_async_set_function());
+                        writer.write_u8((u8)latch_component->get_async_set_reset_behavior().first);
+                        writer.write_u8((u8)latch_component->get_async_set_reset_behavior().second);
+                        break;
+                    }
+                    case GateTypeComponent::ComponentType::ram: {
+                        const RAMComponent* ram_component = component->convert_to<RAMComponent>();
+                        writer.write_u32(ram_component->get_bit_size());
+                        break;
+                    }
+                    case GateTypeComponent::ComponentType::mac:
+                        break;
+                    case GateTypeComponent::ComponentType::init: {
+                        const InitComponent* init_component = component->convert_to<InitComponent>();
+                        writer.write_string(init_component->get_init_category());
+                        writer.write_u32(init_component->get_init_identifiers().size());
+                        for (const std::string& identifier : init_component->get_init_identifiers())
+                        {
+                            writer.write_string(identifier);
+                        }
+                        break;
+                    }
+                    case GateTypeComponent::ComponentType::state: {
+                        const StateComponent* state_component = component->convert_to<StateComponent>();
+                        writer.write_string(state_component->get_state_identifier());
+                        writer.write_string(state_component->get_neg_state_identifier());
+                        break;
+                    }
+                    case GateTypeComponent::ComponentType::ram_port: {
+                        const RAMPortComponent* port_component = component->convert_to<RAMPortComponent>();
+                        writer.write_string(port_component->get_data_group());
+                        writer.write_string(port_component->get_address_group());
+                        writer.write_boolean_function(port_component->get_clock_function());
+                        writer.write_boolean_function(port_component->get_enable_function());
+                        writer.write_u8(port_component->is_write_port());
+                        break;
+                    }
+                }
+
+                write_component(writer, get_child_component(component));
+            }
+
+            Result<std::unique_ptr<GateTypeComponent>> read_component(CacheReader& reader)
+            {
+                if (reader.read_u8() == 0)
+                {
+                    return OK(nullptr);
+                }
+
+                auto type = (GateTypeComponent::ComponentType)reader.read_u8();
+
+                // read all Boolean functions of the component before the child component
+                std::vector<BooleanFunction> functions;
+                auto read_functions = [&reader, &functions](u32 count) -> Result<std::monostate> {
+                    for (u32 i = 0; i < count; i++)
+                    {
+                        if (auto res = reader.read_boolean_function(); res.is_error())
+                        {
+                            return ERR(res.get_error());
+                        }
+                        else
+                        {
+                            functions.push_back(res.get());
+                        }
+                    }
+                    return OK({});
+                };
+
+                std::unique_ptr<GateTypeComponent> component;
+                switch (type)
+                {
+                    case GateTypeComponent::ComponentType::lut: {
+                        bool init_ascending = reader.read_u8();
+                        auto child          = read_component(reader);
+                        if (child.is_error())
+                        {
+                            return ERR(child.get_error());
+                        }
+                        return OK(GateTypeComponent::create_lut_component(child.get(), init_ascending));
+                    }
+                    case GateTypeComponent::ComponentType::ff:
+                    case GateTypeComponent::ComponentType::latch: {
+                        if (auto res = read_functions(4); res.is_error())
+                        {
+                            return ERR(res.get_error());
+                        }
+                        auto behav_state     = (AsyncSetResetBehavior)reader.read_u8();
+                        auto behav_neg_state = (AsyncSetResetBehavior)reader.read_u8();
+                        auto child           = read_component(reader);
+                        if (child.is_error())
+                        {
+                            return ERR(child.get_error());
+                        }
+
+                        if (type == GateTypeComponent::ComponentType::ff)
+                        {
+                            component                 = GateTypeComponent::create_ff_component(child.get(), functions.at(0), functions.at(1));
+                            FFComponent* ff_component = component->convert_to<FFComponent>();
+                            ff_component->set_async_reset_function(functions.at(2));
+                            ff_component->set_async_set_function(functions.at(3));
+                            ff_component->set_async_set_reset_behavior(behav_state, behav_neg_state);
+                        }
+                        else
+                        {
+                            component                       = GateTypeComponent::create_latch_component(child.get());
+                            LatchComponent* latch_component = component->convert_to<LatchComponent>();
+                            latch_component->set_data_in_function(functions.at(0));
+                            latch_component->set_enable_function(functions.at(1));
+                            latch_component->set_async_reset_function(functions.at(2));
+                            latch_component->set_async_set_function(functions.at(3));
+                            latch_component->set_async_set_reset_behavior(behav_state, behav_neg_state);
+                        }
+                        return OK(std::move(component));
+                    }
+                    case GateTypeComponent::ComponentType::ram: {
+                        u32 bit_size = reader.read_u32();
+                        auto child   = read_component(reader);
+                        if (child.is_error())
+                        {
+                            return ERR(child.get_error());
+                        }
+                        return OK(GateTypeComponent::create_ram_component(child.get(), bit_size));
+                    }
+                    case GateTypeComponent::ComponentType::mac: {
+                        if (auto child = read_component(reader); child.is_error() || child.get() != nullptr)
+                        {
+                            return ERR("could not read component: MAC component must not have a child component");
+                        }
+                        return OK(GateTypeComponent::create_mac_component());
+                    }
+                    case GateTypeComponent::ComponentType::init: {
+                        std::string category = reader.read_string();
+                        std::vector<std::string> identifiers(reader.read_u32());
+                        for (auto& identifier : identifiers)
+                        {
+                            identifier = reader.read_string();
+                            if (!reader.good())
+                            {
+                                return ERR("could not read component: unexpected end of cache data");
+                            }
+                        }
+                        if (auto child = read_component(reader); child.is_error() || child.get() != nullptr)
+                        {
+                            return ERR("could not read component: init component must not have a child component");
+                        }
+                        return OK(GateTypeComponent::create_init_component(category, identifiers));
+                    }
+                    case GateTypeComponent::ComponentType::state: {
+                        std::string state_identifier     = reader.read_string();
+                        std::string neg_state_identifier = reader.read_string();
+                        auto child                       = read_component(reader);
+                        if (child.is_error())
+                        {
+                            return ERR(child.get_error());
+                        }
+                        return OK(GateTypeComponent::create_state_component(child.get(), state_identifier, neg_state_identifier));
+                    }
+                    case GateTypeComponent::ComponentType::ram_port: {
+                        std::string data_group = reader.read_string();
+                        std::string addr_group = reader.read_string();
+                        if (auto res = read_functions(2); res.is_error())
+                        {
+                            return ERR(res.get_error());
+                        }
+                        bool is_write = reader.read_u8();
+                        auto child    = read_component(reader);
+                        if (child.is_error())
+                        {
+                            return ERR(child.get_error());
+                        }
+                        return OK(GateTypeComponent::create_ram_port_component(child.get(), data_group, addr_group, functions.at(0), functions.at(1), is_write));
+                    }
+                }
+
+                return ERR("could not read component: unknown component type " + std::to_string((u32)type));
+            }
+
+            void write_gate_type(CacheWriter& writer, const GateType* gt)
+            {
+                writer.write_string(gt->get_name());
+
+                std::set<GateTypeProperty> properties = gt->get_properties();
+                writer.write_u32(properties.size());
+                for (GateTypeProperty property : properties)
+                {
+                    writer.write_u32((u32)property);
+                }
+
+                // the top level component is reported last
+                std::vector<GateTypeComponent*> components = gt->get_components();
+                write_component(writer, components.empty() ? nullptr : components.back());
+
+                // pins are stored grouped, pin IDs and the order within each group are retained
+                std::vector<PinGroup<GatePin>*> pin_groups = gt->get_pin_groups();
+                writer.write_u32(pin_groups.size());
+                for (const PinGroup<GatePin>* group : pin_groups)
+                {
+                    writer.write_u32(group->get_id());
+                    writer.write_string(group->get_name());
+                    writer.write_u32((u32)group->get_direction());
+                    writer.write_u32((u32)group->get_type());
+                    writer.write_u8(group->is_ascending());
+                    writer.write_u32((u32)group->get_start_index());
+
+                    std::vector<GatePin*> pins = group->get_pins();
+                    writer.write_u32(pins.size());
+                    for (const GatePin* pin : pins)
+                    {
+                        writer.write_u32(pin->get_id());
+                        writer.write_string(pin->get_name());
+                        writer.write_u32((u32)pin->get_direction());
+                        writer.write_u32((u32)pin->get_type());
+                    }
+                }
+
+                // sort functions by name to obtain identical cache files for identical libraries
+                const std::unordered_map<std::string, BooleanFunction>& function_map = gt->get_boolean_functions();
+                std::vector<std::pair<std::string, const BooleanFunction*>> functions;
+                for (const auto& [name, bf] : function_map)
+                {
+                    functions.push_back(std::make_pair(name, &bf));
+                }
+                std::sort(functions.begin(), functions.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+                writer.write_u32(functions.size());
+                for (const auto& [name, bf] : functions)
+                {
+                    writer.write_string(name);
+                    writer.write_boolean_function(*bf);
+                }
+            }
+
+            Result<std::monostate> read_gate_type(CacheReader& reader, GateLibrary* gate_lib)
+            {
+                std::string name = reader.read_string();
+
+                std::set<GateTypeProperty> properties;
+                for (u32 i = 0, num_properties = reader.read_u32(); i < num_properties && reader.good(); i++)
+                {
+                    properties.insert((GateTypeProperty)reader.read_u32());
+                }
+
+                std::unique_ptr<GateTypeComponent> component;
+                if (auto res = read_component(reader); res.is_error())
+                {
+                    return ERR_APPEND(res.get_error(), "could not read gate type '" + name + "': failed to read component");
+                }
+                else
+                {
+                    component = res.get();
+                }
+
+                if (!reader.good())
+                {
+                    return ERR("could not read gate type '" + name + "': unexpected end of cache data");
+                }
+
+                GateType* gt = gate_lib->create_gate_type(name, properties, std::move(component));
+                if (gt == nullptr)
+                {
+                    return ERR("could not read gate type '" + name + "': failed to create gate type");
+                }
+
+                for (u32 i = 0, num_groups = reader.read_u32(); i < num_groups && reader.good(); i++)
+                {
+                    u32 group_id         = reader.read_u32();
+                    std::string pg_name  = reader.read_string();
+                    auto group_direction = (PinDirection)reader.read_u32();
+                    auto group_type      = (PinType)reader.read_u32();
+                    bool ascending       = reader.read_u8();
+                    auto start_index     = (i32)reader.read_u32();
+
+                    std::vector<GatePin*> pins;
+                    for (u32 j = 0, num_pins = reader.read_u32(); j < num_pins && reader.good(); j++)
+                    {
+                        u32 pin_id           = reader.read_u32();
+                        std::string pin_name = reader.read_string();
+                        auto pin_direction   = (PinDirection)reader.read_u32();
+                        auto pin_type        = (PinType)reader.read_u32();
+                        if (auto res = gt->create_pin(pin_id, pin_name, pin_direction, pin_type, false); res.is_error())
+                        {
+                            return ERR_APPEND(res.get_error(), "could not read gate type '" + name + "': failed to create pin '" + pin_name + "'");
+                        }
+                        else
+                        {
+                            pins.push_back(res.get());
+                        }
+                    }
+
+                    if (auto res = gt->create_pin_group(group_id, pg_name, pins, group_direction, group_type, ascending, start_index); res.is_error())
+                    {
+                        return ERR_APPEND(res.get_error(), "could not read gate type '" + name + "': failed to create pin group '" + pg_name + "'");
+                    }
+                }
+
+                for (u32 i = 0, num_functions = reader.read_u32(); i < num_functions && reader.good(); i++)
+                {
+                    std::string function_name = reader.read_string();
+                    if (auto res = reader.read_boolean_function(); res.is_error())
+                    {
+                        return ERR_APPEND(res.get_error(), "could not read gate type '" + name + "': failed to read Boolean function '" + function_name + "'");
+                    }
+                    else
+                    {
+                        gt->add_boolean_function(function_name, res.get());
+                    }
+                }
+
+                if (!reader.good())
+                {
+                    return ERR("could not read gate type '" + name + "': unexpected end of cache data");
+                }
+
+                return OK({});
+            }
+
+            void write_header(CacheWriter& writer, u64 content_hash)
+            {
+                for (char c : CACHE_MAGIC)
+                {
+                    writer.write_u8((u8)c);
+                }
+                writer.write_u32(CACHE_FORMAT_VERSION);
+
+                // the parsers ship with HAL, so a cache created by another build may have been parsed differently
+                writer.write_string(hal_version::version);
+                writer.write_string(hal_version::git_hash);
+                writer.write_string(hal_version::is_dirty ? hal_version::build_timestamp : "");
+
+                writer.write_u64(content_hash);
+            }
+
+            Result<std::unique_ptr<GateLibrary>> load_from(const std::filesystem::path& cache_path, const std::filesystem::path& file_path, u64 content_hash)
+            {
+                std::string data;
+                {
+                    std::ifstream ifs(cache_path, std::ios::binary);
+                    if (!ifs.good())
+                    {
+                        return ERR("could not load gate library cache '" + cache_path.string() + "': unable to open file");
+                    }
+                    std::stringstream buffer;
+                    buffer << ifs.rdbuf();
+                    data = buffer.str();
+                }
+
+                CacheWriter expected_header;
+                write_header(expected_header, content_hash);
+                if (data.compare(0, expected_header.get_data().size(), expected_header.get_data()) != 0)
+                {
+                    return ERR("could not load gate library cache '" + cache_path.string() + "': cache is outdated or was created by a different format or HAL version");
+                }
+
+                CacheReader reader(data.substr(expected_header.get_data().size()));
+
+                std::string lib_name = reader.read_string();
+                auto gate_lib        = std::make_unique<GateLibrary>(file_path, lib_name);
+
+                gate_lib->set_gate_location_data_category(reader.read_string());
+                std::string x_identifier = reader.read_string();
+                std::string y_identifier = reader.read_string();
+                gate_lib->set_gate_location_data_identifiers(x_identifier, y_identifier);
+
+                for (u32 i = 0, num_includes = reader.read_u32(); i < num_includes && reader.good(); i++)
+                {
+                    gate_lib->add_include(reader.read_string());
+                }
+
+                for (u32 i = 0, num_gate_types = reader.read_u32(); i < num_gate_types && reader.good(); i++)
+                {
+                    if (auto res = read_gate_type(reader, gate_lib.get()); res.is_error())
+                    {
+                        return ERR_APPEND(res.get_error(), "could not load gate library cache '" + cache_path.string() + "'");
+                    }
+                }
+
+                for (u32 i = 0, num_vcc_gnd = reader.read_u32(); i < num_vcc_gnd && reader.good(); i++)
+                {
+                    bool is_vcc  = reader.read_u8();
+                    GateType* gt = gate_lib->get_gate_type_by_name(reader.read_string());
+                    if (gt == nullptr || (is_vcc && !gate_lib->mark_vcc_gate_type(gt)) || (!is_vcc && !gate_lib->mark_gnd_gate_type(gt)))
+                    {
+                        return ERR("could not load gate library cache '" + cache_path.string() + "': failed to mark VCC or GND gate type");
+                    }
+                }
+
+                if (!reader.good() || !reader.at_end())
+                {
+                    return ERR("could not load gate library cache '" + cache_path.string() + "': cache data is corrupted");
+                }
+
+                return OK(std::move(gate_lib));
+            }
+        }    // namespace
+
+        bool is_cache_file(const std::filesystem::path& file_path)
+        {
+            return file_path.extension() == CACHE_FILE_EXTENSION;
+        }
+
+        Result<std::unique_ptr<GateLibrary>> load(const std::filesystem::path& file_path)
+        {
+            u64 content_hash;
+            if (auto res = compute_content_hash(file_path); res.is_error())
+            {
+                return ERR_APPEND(res.get_error(), "could not load gate library cache for '" + file_path.string() + "'");
+            }
+            else
+            {
+                content_hash = res.get();
+            }
+
+            for (const auto& cache_path : get_cache_paths(file_path))
+            {
+                if (!std::filesystem::exists(cache_path))
+                {
+                    continue;
+                }
+
+                if (auto res = load_from(cache_path, file_path, content_hash); res.is_ok())
+                {
+                    return res;
+                }
+                else
+                {
+                    log_debug("gate_library_cache", "{}", res.get_error().get());
+                }
+            }
+
+            return ERR("could not load gate library cache for '" + file_path.string() + "': no valid cache found");
+        }
+
+        Result<std::monostate> save(const GateLibrary* gate_lib, const std::filesystem::path& file_path)
+        {
+            if (gate_lib == nullptr)
+            {
+                return ERR("could not save gate library cache for '" + file_path.string() + "': gate library is a 'nullptr'");
+            }
+
+            u64 content_hash;
+            if (auto res = compute_content_hash(file_path); res.is_error())
+            {
+                return ERR_APPEND(res.get_error(), "could not save gate library cache for '" + file_path.string() + "'");
+            }
+            else
+            {
+                content_hash = res.get();
+            }
+
+            CacheWriter writer;
+            write_header(writer, content_hash);
+
+            writer.write_string(gate_lib->get_name());
+            writer.write_string(gate_lib->get_gate_location_data_category());
+            writer.write_string(gate_lib->get_gate_location_data_identifiers().first);
+            writer.write_string(gate_lib->get_gate_location_data_identifiers().second);
+
+            std::vector<std::string> includes = gate_lib->get_includes();
+            writer.write_u32(includes.size());
+            for (const std::string& inc : includes)
+            {
+                writer.write_string(inc);
+            }
+
+            // gate types are restored in order of their IDs, so that the IDs remain unchanged
+            std::vector<GateType*> gate_types;
+            for (const auto& [gt_name, gt] : gate_lib->get_gate_types())
+            {
+                gate_types.push_back(gt);
+            }
+            std::sort(gate_types.begin(), gate_types.end(), [](const GateType* l, const GateType* r) { return l->get_id() < r->get_id(); });
+            writer.write_u32(gate_types.size());
+            for (const GateType* gt : gate_types)
+            {
+                write_gate_type(writer, gt);
+            }
+
+            std::vector<std::pair<bool, std::string>> vcc_gnd_types;
+            for (const auto& [gt_name, gt] : gate_lib->get_vcc_gate_types())
+            {
+                vcc_gnd_types.push_back(std::make_pair(true, gt_name));
+            }
+            for (const auto& [gt_name, gt] : gate_lib->get_gnd_gate_types())
+            {
+                vcc_gnd_types.push_back(std::make_pair(false, gt_name));
+            }
+            std::sort(vcc_gnd_types.begin(), vcc_gnd_types.end());
+            writer.write_u32(vcc_gnd_types.size());
+            for (const auto& [is_vcc, gt_name] : vcc_gnd_types)
+            {
+                writer.write_u8(is_vcc);
+                writer.write_string(gt_name);
+            }
+
+            // write to a temporary file of this writer first so that neither concurrent readers nor concurrent writers observe partial cache files
+            for (const auto& cache_path : get_cache_paths(file_path))
+            {
+                std::error_code ec;
+                std::filesystem::create_directories(cache_path.parent_path(), ec);
+
+                const std::filesystem::path tmp_path = utils::get_unique_temp_path(cache_path);
+                {
+                    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+                    if (!ofs.good())
+                    {
+                        continue;
+                    }
+                    ofs.write(writer.get_data().data(), writer.get_data().size());
+                    if (!ofs.good())
+                    {
+                        ofs.close();
+                        std::filesystem::remove(tmp_path, ec);
+                        continue;
+                    }
+                }
+
+                std::filesystem::rename(tmp_path, cache_path, ec);
+                if (!ec)
+                {
+                    return OK({});
+                }
+                std::filesystem::remove(tmp_path, ec);
+            }
+
+            return ERR("could not save gate library cache for '" + file_path.string() + "': no writable cache location");
+        }
+    }    // namespace gate_library_cache
+}    // namespace hal
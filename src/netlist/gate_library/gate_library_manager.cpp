@@ -1,12 +1,15 @@
 #include "hal_core/netlist/gate_library/gate_library_manager.h"
 
 #include "hal_core/netlist/gate_library/gate_library.h"
+#include "hal_core/netlist/gate_library/gate_library_cache.h"
 #include "hal_core/netlist/gate_library/gate_library_parser/gate_library_parser_manager.h"
 #include "hal_core/netlist/gate_library/gate_library_writer/gate_library_writer_manager.h"
 #include "hal_core/utilities/log.h"
 #include "hal_core/utilities/utils.h"
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
 
 namespace hal
 {
@@ -16,6 +19,32 @@ namespace hal
         {
             std::map<std::filesystem::path, std::unique_ptr<GateLibrary>> m_gate_libraries;
 
+            // lower case gate type name to all gate libraries containing a gate type of that name
+            std::unordered_map<std::string, std::vector<GateLibrary*>> m_gate_type_index;
+
+            void add_to_index(GateLibrary* lib)
+            {
+                for (const auto& [gt_name, gt] : lib->get_gate_types())
+                {
+                    m_gate_type_index[utils::to_lower(gt_name)].push_back(lib);
+                }
+            }
+
+            void remove_from_index(GateLibrary* lib)
+            {
+                for (const auto& [gt_name, gt] : lib->get_gate_types())
+                {
+                    if (auto it = m_gate_type_index.find(utils::to_lower(gt_name)); it != m_gate_type_index.end())
+                    {
+                        it->second.erase(std::remove(it->second.begin(), it->second.end(), lib), it->second.end());
+                        if (it->second.empty())
+                        {
+                            m_gate_type_index.erase(it);
+                        }
+                    }
+                }
+            }
+
             Result<std::monostate> prepare_library(const std::unique_ptr<GateLibrary>& lib)
             {
                 auto gate_types = lib->get_gate_types();
@@ -94,10 +123,24 @@ namespace hal
                 }
             }
 
-            std::unique_ptr<GateLibrary> gate_lib = gate_library_parser_manager::parse(file_path);
-            if (gate_lib == nullptr)
+            std::unique_ptr<GateLibrary> gate_lib;
+            if (auto cache_res = gate_library_cache::load(file_path); cache_res.is_ok())
             {
-                return nullptr;
+                gate_lib = cache_res.get();
+                log_info("gate_library_manager", "restored gate library '{}' from cache.", gate_lib->get_name());
+            }
+            else
+            {
+                gate_lib = gate_library_parser_manager::parse(file_path);
+                if (gate_lib == nullptr)
+                {
+                    return nullptr;
+                }
+
+                if (auto res = gate_library_cache::save(gate_lib.get(), file_path); res.is_error())
+                {
+                    log_debug("gate_library_manager", "could not cache gate library '{}':\n{}", gate_lib->get_name(), res.get_error().get());
+                }
             }
 
             if (auto res = prepare_library(gate_lib); res.is_error())
@@ -106,8 +149,14 @@ namespace hal
                 return nullptr;
             }
 
+            if (auto it = m_gate_libraries.find(file_path); it != m_gate_libraries.end())
+            {
+                remove_from_index(it->second.get());
+            }
+
             GateLibrary* res                     = gate_lib.get();
             m_gate_libraries[file_path.string()] = std::move(gate_lib);
+            add_to_index(res);
             return res;
         }
 
@@ -126,6 +175,10 @@ namespace hal
 
                 for (const auto& lib_path : utils::RecursiveDirectoryRange(lib_dir))
                 {
+                    if (gate_library_cache::is_cache_file(lib_path.path()))
+                    {
+                        continue;
+                    }
                     load(lib_path.path(), reload);
                 }
             }
@@ -138,7 +191,10 @@ namespace hal
             {
                 if (!std::filesystem::exists(lib_dir)) continue;
                 for (const auto& lib_path : utils::RecursiveDirectoryRange(lib_dir))
+                {
+                    if (gate_library_cache::is_cache_file(lib_path.path())) continue;
                     retval.push_back(lib_path.path());
+                }
             }
             return retval;
         }
@@ -168,7 +224,11 @@ namespace hal
 
         void remove(std::filesystem::path file_path)
         {
-            m_gate_libraries.erase(file_path);
+            if (auto it = m_gate_libraries.find(file_path); it != m_gate_libraries.end())
+            {
+                remove_from_index(it->second.get());
+                m_gate_libraries.erase(it);
+            }
         }
 
         GateLibrary* get_gate_library(const std::string& file_path)
@@ -227,5 +287,32 @@ namespace hal
             }
             return res;
         }
+
+        std::vector<std::pair<GateLibrary*, u32>> get_gate_libraries_by_gate_types(const std::set<std::string>& gate_types)
+        {
+            std::unordered_map<GateLibrary*, u32> match_counts;
+            for (const auto& gt_name : gate_types)
+            {
+                if (auto it = m_gate_type_index.find(utils::to_lower(gt_name)); it != m_gate_type_index.end())
+                {
+                    for (GateLibrary* lib : it->second)
+                    {
+                        match_counts[lib]++;
+                    }
+                }
+            }
+
+            // iterate libraries ordered by path to break ties deterministically
+            std::vector<std::pair<GateLibrary*, u32>> res;
+            for (const auto& it : m_gate_libraries)
+            {
+                if (auto count_it = match_counts.find(it.second.get()); count_it != match_counts.end())
+                {
+                    res.push_back(*count_it);
+                }
+            }
+            std::stable_sort(res.begin(), res.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+            return res;
+        }
     }    // namespace gate_library_manager
 }    // namespace hal
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "hal_core/netlist/netlist_parser/netlist_parser.h"
+
+#include "hal_core/netlist/module.h"
+
+#include <map>
+
+namespace hal
+{
+    Result<std::pair<std::unique_ptr<Netlist>, NetlistUpdateReport>> NetlistParser::update(std::unique_ptr<Netlist> netlist)
+    {
+        if (netlist == nullptr)
+        {
+            return ERR("could not update netlist: netlist is a 'nullptr'");
+        }
+
+        std::map<std::string, u32> previous_modules;
+        for (const Module* module : netlist->get_modules())
+        {
+            previous_modules[module->get_name()]++;
+        }
+
+        auto res = instantiate(netlist->get_gate_library());
+        if (res.is_error())
+        {
+            return ERR_APPEND(res.get_error(), "could not update netlist: failed to instantiate netlist");
+        }
+        std::unique_ptr<Netlist> result = res.get();
+
+        NetlistUpdateReport report;
+        report.full_rebuild = true;
+        for (const Module* module : result->get_modules())
+        {
+            if (const auto it = previous_modules.find(module->get_name()); it != previous_modules.end() && it->second > 0)
+            {
+                it->second--;
+                report.changed_modules.push_back(module->get_name());
+            }
+            else
+            {
+                report.added_modules.push_back(module->get_name());
+            }
+        }
+        for (const auto& [name, count] : previous_modules)
+        {
+            report.removed_modules.insert(report.removed_modules.end(), count, name);
+        }
+
+        return OK(std::make_pair(std::move(result), std::move(report)));
+    }
+}    // namespace hal
@@ -6,8 +6,10 @@
 #include "hal_core/netlist/netlist_parser/netlist_parser.h"
 #include "hal_core/utilities/log.h"
 #include "hal_core/plugin_system/plugin_manager.h"
+#include "hal_core/utilities/utils.h"
 
 #include <fstream>
+#include <set>
 
 namespace hal
 {
@@ -53,29 +55,37 @@ namespace hal
                          "finished parsing in {:2.2f} seconds.",
                          (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - begin_time).count() / 1000);
 
-                std::vector<std::unique_ptr<Netlist>> netlists;
+                // instantiates the parsed netlist with a single gate library, failures are only logged since other libraries may still fit
+                auto instantiate = [&file_name, &parser](const GateLibrary* lib) -> std::unique_ptr<Netlist> {
+                    const auto lib_begin_time = std::chrono::high_resolution_clock::now();
 
-                if (gate_library != nullptr)
-                {
-                    begin_time = std::chrono::high_resolution_clock::now();
+                    log_info("netlist_parser", "instantiating '{}' with gate library '{}'...", file_name.string(), lib->get_name());
 
-                    log_info("netlist_parser", "instantiating '{}' with gate library '{}'...", file_name.string(), gate_library->get_name());
-
-                    if (auto res = parser->instantiate(gate_library); res.is_error())
+                    auto res = parser->instantiate(lib);
+                    if (res.is_error())
                     {
-                        log_info("netlist_parser", "failed to instantiate '{}' with gate library '{}':\n{}", file_name.string(), gate_library->get_name(), res.get_error().get());
-                        return {};
+                        log_info("netlist_parser", "failed to instantiate '{}' with gate library '{}':\n{}", file_name.string(), lib->get_name(), res.get_error().get());
+                        return nullptr;
                     }
-                    else
-                    {
-                        auto netlist = res.get();
-                        netlist->set_input_filename(file_name.string());
 
-                        log_info("netlist_parser",
-                                 "instantiated '{}' in {:2.2f} seconds.",
-                                 file_name.string(),
-                                 (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - begin_time).count() / 1000);
+                    auto netlist = res.get();
+                    netlist->set_input_filename(file_name.string());
+
+                    log_info("netlist_parser",
+                             "instantiated '{}' with gate library '{}' in {:2.2f} seconds.",
+                             file_name.string(),
+                             lib->get_name(),
+                             (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - lib_begin_time).count() / 1000);
+
+                    return netlist;
+                };
+
+                std::vector<std::unique_ptr<Netlist>> netlists;
 
+                if (gate_library != nullptr)
+                {
+                    if (auto netlist = instantiate(gate_library); netlist != nullptr)
+                    {
                         netlists.push_back(std::move(netlist));
                     }
                 }
@@ -84,36 +94,54 @@ namespace hal
                     log_warning("netlist_parser", "no (valid) gate library specified, trying to auto-detect gate library...");
                     gate_library_manager::load_all();
 
-                    for (GateLibrary* lib_it : gate_library_manager::get_gate_libraries())
+                    // rank libraries by the number of required gate types they provide, only try all libraries if the parser cannot tell
+                    std::vector<GateLibrary*> candidates;
+                    if (std::set<std::string> gate_types = parser->get_required_gate_types(); !gate_types.empty())
                     {
-                        begin_time = std::chrono::high_resolution_clock::now();
-
-                        log_info("netlist_parser", "instantiating '{}' with gate library '{}'...", file_name.string(), lib_it->get_name());
-
-                        if (auto res = parser->instantiate(lib_it); res.is_error())
+                        for (const auto& [lib, num_matches] : gate_library_manager::get_gate_libraries_by_gate_types(gate_types))
                         {
-                            log_info("netlist_parser", "failed to instantiate '{}' with gate library '{}':\n{}", file_name.string(), lib_it->get_name(), res.get_error().get());
-                            // log_debug("netlist_parser", "error encountered during netlist instantiation:\n{}", res.get_error().get());
-                            continue;
+                            log_info("netlist_parser", "gate library '{}' provides {} of {} required gate types.", lib->get_name(), num_matches, gate_types.size());
+                            candidates.push_back(lib);
                         }
-                        else
-                        {
-                            auto netlist = res.get();
-
-                            netlist->set_input_filename(file_name.string());
+                    }
+                    else
+                    {
+                        candidates = gate_library_manager::get_gate_libraries();
+                    }
 
-                            log_info("netlist_parser",
-                                     "instantiated '{}' in {:2.2f} seconds.",
-                                     file_name.string(),
-                                     (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - begin_time).count() / 1000);
+                    if (break_on_match)
+                    {
+                        for (GateLibrary* lib_it : candidates)
+                        {
+                            if (auto netlist = instantiate(lib_it); netlist != nullptr)
+                            {
+                                netlists.push_back(std::move(netlist));
+                                break;
+                            }
+                        }
+                    }
+                    else
+                    {
+                        // instantiation only reads the parsed netlist, so all candidates are instantiated concurrently while keeping their order in the result
+                        begin_time = std::chrono::high_resolution_clock::now();
 
-                            netlists.push_back(std::move(netlist));
+                        std::vector<std::unique_ptr<Netlist>> instantiated(candidates.size());
+                        utils::parallel_for(candidates.size(), [&instantiate, &candidates, &instantiated](u32 idx) { instantiated.at(idx) = instantiate(candidates.at(idx)); });
 
-                            if (break_on_match)
+                        for (auto& netlist : instantiated)
+                        {
+                            if (netlist != nullptr)
                             {
-                                break;
+                                netlists.push_back(std::move(netlist));
                             }
                         }
+
+                        log_info("netlist_parser",
+                                 "instantiated '{}' with {} of {} gate libraries in {:2.2f} seconds.",
+                                 file_name.string(),
+                                 netlists.size(),
+                                 candidates.size(),
+                                 (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - begin_time).count() / 1000);
                     }
 
                     if (netlists.empty())
@@ -235,6 +263,58 @@ namespace hal
             return dispatch_parse(file_name, factory(), nullptr, false);
         }
 
+        Result<std::pair<std::unique_ptr<Netlist>, NetlistUpdateReport>> update(std::unique_ptr<Netlist> netlist, const std::filesystem::path& file_name)
+        {
+            if (netlist == nullptr)
+            {
+                return ERR("could not update netlist with '" + file_name.string() + "': netlist is a 'nullptr'");
+            }
+
+            ParserFactory factory = get_parser_factory_for_file(file_name);
+            if (!factory)
+            {
+                return ERR("could not update netlist with '" + file_name.string() + "': no netlist parser registered for file type");
+            }
+
+            auto begin_time                       = std::chrono::high_resolution_clock::now();
+            std::unique_ptr<NetlistParser> parser = factory();
+
+            log_info("netlist_parser", "parsing '{}'...", file_name.string());
+
+            if (auto res = parser->parse(file_name); res.is_error())
+            {
+                return ERR_APPEND(res.get_error(), "could not update netlist with '" + file_name.string() + "': failed to parse file");
+            }
+
+            log_info("netlist_parser",
+                     "finished parsing in {:2.2f} seconds.",
+                     (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - begin_time).count() / 1000);
+
+            begin_time = std::chrono::high_resolution_clock::now();
+
+            log_info("netlist_parser", "updating netlist with '{}'...", file_name.string());
+
+            auto res = parser->update(std::move(netlist));
+            if (res.is_error())
+            {
+                return ERR_APPEND(res.get_error(), "could not update netlist with '" + file_name.string() + "': failed to update netlist");
+            }
+
+            auto update = res.get();
+            update.first->set_input_filename(file_name.string());
+
+            log_info("netlist_parser",
+                     "updated netlist in {:2.2f} seconds ({} modules unchanged, {} changed, {} added, {} removed{}).",
+                     (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - begin_time).count() / 1000,
+                     update.second.unchanged_modules.size(),
+                     update.second.changed_modules.size(),
+                     update.second.added_modules.size(),
+                     update.second.removed_modules.size(),
+                     update.second.full_rebuild ? ", full rebuild" : "");
+
+            return OK(std::move(update));
+        }
+
         std::unordered_map<std::string, std::vector<std::string>> get_parser_to_extensions()
         {
             return m_parser_to_extensions;
@@ -75,5 +75,25 @@ namespace hal
             :returns: A list of gate libraries.
             :rtype:  list[hal_py.GateLibrary]
         )");
+
+        py_gate_library_manager.def(
+            "get_gate_libraries_by_gate_types",
+            [](const std::set<std::string>& gate_types) {
+                std::vector<std::pair<RawPtrWrapper<GateLibrary>, u32>> result;
+                for (const auto& [lib, num_matches] : gate_library_manager::get_gate_libraries_by_gate_types(gate_types))
+                {
+                    result.emplace_back(lib, num_matches);
+                }
+                return result;
+            },
+            py::arg("gate_types"),
+            R"(
+            Get all loaded gate libraries that contain at least one of the given gate types, ordered by the number of contained gate types in descending order.
+            Gate type names are compared case-insensitively using an index that is maintained while loading gate libraries.
+
+            :param set[str] gate_types: The names of the gate types.
+            :returns: A list of pairs of gate libraries and the number of given gate types they contain.
+            :rtype: list[tuple(hal_py.GateLibrary,int)]
+        )");
     }
 }    // namespace hal
@@ -0,0 +1,52 @@
+#include "hal_core/python_bindings/python_bindings.h"
+
+namespace hal
+{
+    void sequential_netlist_decorator_init(py::module& m)
+    {
+        py::class_<SequentialNetlistDecorator> py_sequential_netlist_decorator(m, "SequentialNetlistDecorator", R"()");
+
+        py_sequential_netlist_decorator.def(py::init<const Netlist&>(), py::arg("netlist"), py::keep_alive<1, 2>(), R"(
+            Construct new SequentialNetlistDecorator object and compute for every flip-flop of the netlist its sequential successors and predecessors, i.e., the flip-flops that are reached through combinational logic only.
+            The index is invalidated through gate and net events of the netlist and only the affected flip-flops are updated on the next query, i.e., changes made while events are disabled are not tracked until rebuild is called.
+
+            :param hal_py.Netlist netlist: The netlist to operate on.
+        )");
+
+        py_sequential_netlist_decorator.def("rebuild", &SequentialNetlistDecorator::rebuild, R"(
+            Discard the index and compute the sequential successors and predecessors of all flip-flops again.
+        )");
+
+        py_sequential_netlist_decorator.def("update", &SequentialNetlistDecorator::update, R"(
+            Update the sequential successors and predecessors of all flip-flops affected by netlist changes since the last update.
+            This is done implicitly by every query.
+        )");
+
+        py_sequential_netlist_decorator.def(
+            "get_next_sequential_gates",
+            [](SequentialNetlistDecorator& self, const Gate* gate, bool get_successors) -> std::optional<std::vector<Gate*>> {
+                auto res = self.get_next_sequential_gates(gate, get_successors);
+                if (res.is_ok())
+                {
+                    return res.get();
+                }
+                else
+                {
+                    log_error("python_context", "error encountered while getting next sequential gates:\n{}", res.get_error().get());
+                    return std::nullopt;
+                }
+            },
+            py::arg("gate"),
+            py::arg("get_successors"),
+            R"(
+            Get all sequential successors or predecessors of a flip-flop, i.e., the flip-flops that are reached by traversing combinational logic starting at its output or input nets.
+            The result may include the provided flip-flop itself and is ordered by gate ID.
+            Matches hal_py.NetlistUtils.get_next_sequential_gates without the need to traverse the netlist.
+
+            :param hal_py.Gate gate: The flip-flop.
+            :param bool get_successors: If True, sequential successors are returned, otherwise sequential predecessors are returned.
+            :returns: All sequential successors or predecessors of the flip-flop on success, None otherwise.
+            :rtype: list[hal_py.Gate] or None
+        )");
+    }
+}    // namespace hal
@@ -0,0 +1,103 @@
+#include "hal_core/python_bindings/python_bindings.h"
+
+namespace hal
+{
+    void spatial_netlist_decorator_init(py::module& m)
+    {
+        py::class_<SpatialNetlistDecorator> py_spatial_netlist_decorator(m, "SpatialNetlistDecorator", R"()");
+
+        py_spatial_netlist_decorator.def(py::init<const Netlist&, u32>(), py::arg("netlist"), py::arg("cell_size") = 0, py::keep_alive<1, 2>(), R"(
+            Construct new SpatialNetlistDecorator object and index the locations of all placed gates of the netlist in a uniform grid.
+            The index is kept up to date by listening to gate events of the netlist, i.e., gates that are created, removed, or moved while gate events are disabled are not tracked until rebuild is called.
+
+            :param hal_py.Netlist netlist: The netlist to operate on.
+            :param int cell_size: The side length of a grid cell. If set to 0, the size is chosen such that a cell holds only a few gates on average.
+        )");
+
+        py_spatial_netlist_decorator.def("rebuild", &SpatialNetlistDecorator::rebuild, py::arg("cell_size") = 0, R"(
+            Discard the index and index the locations of all placed gates of the netlist again.
+
+            :param int cell_size: The side length of a grid cell. If set to 0, the size is chosen such that a cell holds only a few gates on average.
+        )");
+
+        py_spatial_netlist_decorator.def_property_readonly("cell_size", &SpatialNetlistDecorator::get_cell_size, R"(
+            The side length of a grid cell of the index.
+
+            :type: int
+        )");
+
+        py_spatial_netlist_decorator.def("get_cell_size", &SpatialNetlistDecorator::get_cell_size, R"(
+            Get the side length of a grid cell of the index.
+
+            :returns: The side length of a grid cell.
+            :rtype: int
+        )");
+
+        py_spatial_netlist_decorator.def_property_readonly("num_placed_gates", &SpatialNetlistDecorator::get_num_placed_gates, R"(
+            The number of indexed gates, i.e., of gates that have a location assigned.
+
+            :type: int
+        )");
+
+        py_spatial_netlist_decorator.def("get_num_placed_gates", &SpatialNetlistDecorator::get_num_placed_gates, R"(
+            Get the number of indexed gates, i.e., of gates that have a location assigned.
+
+            :returns: The number of indexed gates.
+            :rtype: int
+        )");
+
+        py_spatial_netlist_decorator.def("get_gates_in_area", &SpatialNetlistDecorator::get_gates_in_area, py::arg("min_x"), py::arg("min_y"), py::arg("max_x"), py::arg("max_y"), R"(
+            Get all placed gates within the given rectangle, bounds included.
+            The gates are returned in no particular order.
+
+            :param int min_x: The minimum x-coordinate of the rectangle.
+            :param int min_y: The minimum y-coordinate of the rectangle.
+            :param int max_x: The maximum x-coordinate of the rectangle.
+            :param int max_y: The maximum y-coordinate of the rectangle.
+            :returns: The gates within the rectangle.
+            :rtype: list[hal_py.Gate]
+        )");
+
+        py_spatial_netlist_decorator.def("get_nearest_gates",
+                                         py::overload_cast<i32, i32, u32>(&SpatialNetlistDecorator::get_nearest_gates, py::const_),
+                                         py::arg("x"),
+                                         py::arg("y"),
+                                         py::arg("k"),
+                                         R"(
+            Get the k placed gates closest to the given location in terms of Euclidean distance.
+            The gates are ordered by increasing distance, gates with equal distance are ordered by ID.
+
+            :param int x: The x-coordinate of the location.
+            :param int y: The y-coordinate of the location.
+            :param int k: The maximum number of gates to return.
+            :returns: The k closest gates.
+            :rtype: list[hal_py.Gate]
+        )");
+
+        py_spatial_netlist_decorator.def(
+            "get_nearest_gates",
+            [](const SpatialNetlistDecorator& self, const Gate* gate, u32 k) -> std::optional<std::vector<Gate*>> {
+                auto res = self.get_nearest_gates(gate, k);
+                if (res.is_ok())
+                {
+                    return res.get();
+                }
+                else
+                {
+                    log_error("python_context", "error encountered while getting nearest gates:\n{}", res.get_error().get());
+                    return std::nullopt;
+                }
+            },
+            py::arg("gate"),
+            py::arg("k"),
+            R"(
+            Get the k placed gates closest to the given gate in terms of Euclidean distance, excluding the gate itself.
+            The gates are ordered by increasing distance, gates with equal distance are ordered by ID.
+
+            :param hal_py.Gate gate: The gate.
+            :param int k: The maximum number of gates to return.
+            :returns: The k closest gates on success, None otherwise.
+            :rtype: list[hal_py.Gate] or None
+        )");
+    }
+}    // namespace hal
@@ -172,6 +172,60 @@ namespace hal
             :rtype: hal_py.BooleanFunction or None
         )");
 
+        py_subgraph_netlist_decorator.def(
+            "get_subgraph_functions",
+            [](SubgraphNetlistDecorator& self, const std::vector<const Gate*>& subgraph_gates, const std::vector<const Net*>& subgraph_outputs) -> std::optional<std::vector<BooleanFunction>> {
+                auto res = self.get_subgraph_functions(subgraph_gates, subgraph_outputs);
+                if (res.is_ok())
+                {
+                    return res.get();
+                }
+                else
+                {
+                    log_error("python_context", "error encountered while generating subgraph functions:\n{}", res.get_error().get());
+                    return std::nullopt;
+                }
+            },
+            py::arg("subgraph_gates"),
+            py::arg("subgraph_outputs"),
+            R"(
+            Get the combined Boolean functions of a subgraph of combinational gates for several subgraph output nets at once.
+            The function of every gate within the cones of the outputs is only built once and independent parts of the cones are evaluated concurrently.
+            The variables of the resulting Boolean functions are created from the subgraph input nets using 'BooleanFunctionNetDecorator.get_boolean_variable'.
+
+            :param list[hal_py.Gate] subgraph_gates: The gates making up the subgraph to consider.
+            :param list[hal_py.Net] subgraph_outputs: The subgraph output nets for which to generate the Boolean functions.
+            :returns: The combined Boolean functions of the subgraph in the order of the output nets on success, None otherwise.
+            :rtype: list[hal_py.BooleanFunction] or None
+        )");
+
+        py_subgraph_netlist_decorator.def(
+            "get_subgraph_functions",
+            [](SubgraphNetlistDecorator& self, const Module* subgraph_module, const std::vector<const Net*>& subgraph_outputs) -> std::optional<std::vector<BooleanFunction>> {
+                auto res = self.get_subgraph_functions(subgraph_module, subgraph_outputs);
+                if (res.is_ok())
+                {
+                    return res.get();
+                }
+                else
+                {
+                    log_error("python_context", "error encountered while generating subgraph functions:\n{}", res.get_error().get());
+                    return std::nullopt;
+                }
+            },
+            py::arg("subgraph_module"),
+            py::arg("subgraph_outputs"),
+            R"(
+            Get the combined Boolean functions of a subgraph of combinational gates for several subgraph output nets at once.
+            The function of every gate within the cones of the outputs is only built once and independent parts of the cones are evaluated concurrently.
+            The variables of the resulting Boolean functions are created from the subgraph input nets using 'BooleanFunctionNetDecorator.get_boolean_variable'.
+
+            :param hal_py.Module subgraph_module: The module making up the subgraph to consider.
+            :param list[hal_py.Net] subgraph_outputs: The subgraph output nets for which to generate the Boolean functions.
+            :returns: The combined Boolean functions of the subgraph in the order of the output nets on success, None otherwise.
+            :rtype: list[hal_py.BooleanFunction] or None
+        )");
+
         py_subgraph_netlist_decorator.def(
             "get_subgraph_function_inputs",
             [](SubgraphNetlistDecorator& self, const std::vector<Gate*>& subgraph_gates, const Net* subgraph_output) -> std::optional<std::set<const Net*>> {
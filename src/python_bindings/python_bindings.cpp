@@ -75,6 +75,10 @@ namespace hal
 
         netlist_modification_decorator_init(m);
 
+        spatial_netlist_decorator_init(m);
+
+        sequential_netlist_decorator_init(m);
+
         log_init(m);
 
 #ifndef PYBIND11_MODULE
@@ -0,0 +1,145 @@
+#include "hal_core/utilities/text_scanner.h"
+
+#include <fstream>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hal
+{
+    MappedTextFile::~MappedTextFile()
+    {
+        close();
+    }
+
+    bool MappedTextFile::open(const std::filesystem::path& path)
+    {
+        close();
+
+#ifndef _WIN32
+        int fd = ::open(path.string().c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                madvise(addr, st.st_size, MADV_SEQUENTIAL);
+                m_data   = static_cast<const char*>(addr);
+                m_size   = st.st_size;
+                m_mapped = true;
+                ::close(fd);
+                return true;
+            }
+        }
+        ::close(fd);
+#endif
+
+        // fall back to reading the file, e.g., for empty files or pipes
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs.is_open())
+        {
+            return false;
+        }
+        m_buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+        return true;
+    }
+
+    void MappedTextFile::close()
+    {
+#ifndef _WIN32
+        if (m_mapped)
+        {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+#endif
+        m_buffer.clear();
+        m_buffer.shrink_to_fit();
+        m_data   = nullptr;
+        m_size   = 0;
+        m_mapped = false;
+    }
+
+    std::string_view MappedTextFile::get_text() const
+    {
+        return std::string_view(m_data, m_size);
+    }
+
+    CharacterSet::CharacterSet(const std::string& characters, bool include_whitespace)
+    {
+        m_table.fill(false);
+
+        std::string all = characters;
+        if (include_whitespace)
+        {
+            all += " \t\n\v\f\r";
+        }
+
+        for (char c : all)
+        {
+            if (!m_table[static_cast<u8>(c)])
+            {
+                m_table[static_cast<u8>(c)] = true;
+                m_characters.push_back(c);
+            }
+        }
+    }
+
+    const char* CharacterSet::find_first(const char* begin, const char* end) const
+    {
+        const char* p = begin;
+
+#if defined(__SSE2__)
+        // compare 16 characters at once against every character of the set
+        while (end - p >= 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i hits  = _mm_setzero_si128();
+            for (char c : m_characters)
+            {
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8(c)));
+            }
+            if (int mask = _mm_movemask_epi8(hits); mask != 0)
+            {
+                return p + __builtin_ctz(mask);
+            }
+            p += 16;
+        }
+#endif
+
+        for (; p < end; ++p)
+        {
+            if (m_table[static_cast<u8>(*p)])
+            {
+                return p;
+            }
+        }
+        return end;
+    }
+
+    std::string_view StringArena::store(std::string&& s)
+    {
+        m_strings.push_back(std::move(s));
+        return m_strings.back();
+    }
+
+    void StringArena::clear()
+    {
+        m_strings.clear();
+    }
+}    // namespace hal
@@ -2,11 +2,14 @@
 
 #include "hal_core/utilities/log.h"
 
+#include <algorithm>
+#include <atomic>
 #include <dirent.h>
 #include <fstream>
 #include <sstream>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 
 #ifdef _WIN32
 #include <tchar.h>
@@ -58,6 +61,21 @@ namespace hal
 #endif
         }
 
+        std::filesystem::path get_unique_temp_path(const std::filesystem::path& path)
+        {
+            static std::atomic<u64> counter(0);
+#ifdef _WIN32
+            const u64 process_id = GetCurrentProcessId();
+#else
+            const u64 process_id = getpid();
+#endif
+            const u64 thread_id = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+            std::filesystem::path tmp_path = path;
+            tmp_path += ".tmp." + std::to_string(process_id) + "." + std::to_string(thread_id) + "." + std::to_string(counter++);
+            return tmp_path;
+        }
+
         std::filesystem::path get_binary_directory()
         {
             char buf[1024] = {0};
@@ -695,5 +713,14 @@ permanent authorization for you to choose that version for the Library.
             return ERR("encountered unknown error");
         }
 
+        u32 get_num_parallel_threads(u32 count, u32 num_threads)
+        {
+            if (num_threads == 0)
+            {
+                num_threads = std::thread::hardware_concurrency();
+            }
+            return std::max(1u, std::min(count, num_threads));
+        }
+
     }    // namespace core_utils
 }    // namespace hal
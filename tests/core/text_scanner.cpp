@@ -0,0 +1,200 @@
+#include "hal_core/utilities/text_scanner.h"
+#include "netlist_test_utils.h"
+
+#include "test_def.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace hal
+{
+    class TextScannerTest : public ::testing::Test
+    {
+    protected:
+        virtual void SetUp()
+        {
+            test_utils::init_log_channels();
+            test_utils::create_sandbox_directory();
+        }
+
+        virtual void TearDown()
+        {
+            test_utils::remove_sandbox_directory();
+        }
+    };
+
+    /**
+     * Testing the access to the content of files of different shapes.
+     *
+     * Functions: MappedTextFile::open, MappedTextFile::close, MappedTextFile::get_text
+     */
+    TEST_F(TextScannerTest, check_mapped_text_file)
+    {
+        TEST_START
+        {
+            // regular file
+            std::filesystem::path path = test_utils::create_sandbox_file("regular.txt", "line 1\nline 2\n");
+            MappedTextFile file;
+            ASSERT_TRUE(file.open(path));
+            EXPECT_EQ(file.get_text(), "line 1\nline 2\n");
+
+            file.close();
+            EXPECT_TRUE(file.get_text().empty());
+        }
+        {
+            // file without a trailing newline, the last character must not be cut off
+            std::filesystem::path path = test_utils::create_sandbox_file("no_newline.txt", "line 1\nline 2");
+            MappedTextFile file;
+            ASSERT_TRUE(file.open(path));
+            EXPECT_EQ(file.get_text(), "line 1\nline 2");
+            EXPECT_EQ(file.get_text().back(), '2');
+        }
+        {
+            // empty file
+            std::filesystem::path path = test_utils::create_sandbox_file("empty.txt", "");
+            MappedTextFile file;
+            ASSERT_TRUE(file.open(path));
+            EXPECT_TRUE(file.get_text().empty());
+        }
+        {
+            // opening another file replaces the previous content
+            std::filesystem::path first  = test_utils::create_sandbox_file("first.txt", "first");
+            std::filesystem::path second = test_utils::create_sandbox_file("second.txt", "second");
+            MappedTextFile file;
+            ASSERT_TRUE(file.open(first));
+            EXPECT_EQ(file.get_text(), "first");
+            ASSERT_TRUE(file.open(second));
+            EXPECT_EQ(file.get_text(), "second");
+        }
+        {
+            // non-existing file
+            MappedTextFile file;
+            EXPECT_FALSE(file.open(test_utils::create_sandbox_path("does_not_exist.txt")));
+            EXPECT_TRUE(file.get_text().empty());
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing the search for characters of a set, covering matches within the 16-character blocks processed at once as well as within the remaining tail.
+     *
+     * Functions: CharacterSet::contains, CharacterSet::find_first
+     */
+    TEST_F(TextScannerTest, check_character_set)
+    {
+        TEST_START
+        {
+            CharacterSet set(";,", true);
+            EXPECT_TRUE(set.contains(';'));
+            EXPECT_TRUE(set.contains(','));
+            EXPECT_TRUE(set.contains(' '));
+            EXPECT_TRUE(set.contains('\n'));
+            EXPECT_FALSE(set.contains('a'));
+            EXPECT_FALSE(set.contains('\0'));
+
+            CharacterSet no_whitespace(";,");
+            EXPECT_FALSE(no_whitespace.contains(' '));
+        }
+        {
+            // a single match at every position of a 40 character text, i.e., in the first block, the second block, and the tail
+            CharacterSet set(";");
+            for (u32 pos = 0; pos < 40; pos++)
+            {
+                std::string text(40, 'a');
+                text[pos]         = ';';
+                const char* begin = text.data();
+                const char* end   = text.data() + text.size();
+                EXPECT_EQ(set.find_first(begin, end) - begin, pos);
+
+                // unaligned start within the text
+                if (pos >= 3)
+                {
+                    EXPECT_EQ(set.find_first(begin + 3, end) - begin, pos);
+                }
+                else
+                {
+                    EXPECT_EQ(set.find_first(begin + 3, end), end);
+                }
+            }
+        }
+        {
+            // several matches, the first one is returned
+            CharacterSet set(";,", true);
+            std::string text  = "abcdefghijklmnopqr;stuvwxyz,abc def;";
+            const char* begin = text.data();
+            const char* end   = text.data() + text.size();
+            EXPECT_EQ(set.find_first(begin, end) - begin, 18);
+            EXPECT_EQ(set.find_first(begin + 19, end) - begin, 27);
+            EXPECT_EQ(set.find_first(begin + 28, end) - begin, 31);
+            EXPECT_EQ(set.find_first(begin + 32, end) - begin, 35);
+
+            // the match right before the 16-character boundary wins over a match right after it
+            std::string boundary = "aaaaaaaaaaaaaaa;;aaaaaaaaaaaaaaa";
+            EXPECT_EQ(set.find_first(boundary.data(), boundary.data() + boundary.size()) - boundary.data(), 15);
+        }
+        {
+            // no match
+            CharacterSet set(";");
+            std::string text(100, 'a');
+            const char* begin = text.data();
+            const char* end   = text.data() + text.size();
+            EXPECT_EQ(set.find_first(begin, end), end);
+
+            // the search must not look beyond the end of the range
+            text[50] = ';';
+            EXPECT_EQ(set.find_first(begin, begin + 50), begin + 50);
+            EXPECT_EQ(set.find_first(begin + 20, begin + 40), begin + 40);
+
+            // empty range
+            EXPECT_EQ(set.find_first(begin, begin), begin);
+        }
+        {
+            // characters beyond ASCII
+            CharacterSet set("\xff");
+            std::string text(20, '\x7f');
+            text[17]          = '\xff';
+            const char* begin = text.data();
+            EXPECT_EQ(set.find_first(begin, begin + text.size()) - begin, 17);
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing that views on stored strings remain valid while the arena grows.
+     *
+     * Functions: StringArena::store, StringArena::clear
+     */
+    TEST_F(TextScannerTest, check_string_arena)
+    {
+        TEST_START
+        {
+            StringArena arena;
+            std::vector<std::string_view> views;
+            for (u32 i = 0; i < 10000; i++)
+            {
+                // long enough to not fit into the small string buffer
+                views.push_back(arena.store("string_arena_entry_" + std::to_string(i)));
+            }
+
+            for (u32 i = 0; i < 10000; i++)
+            {
+                EXPECT_EQ(views.at(i), "string_arena_entry_" + std::to_string(i));
+            }
+
+            // short strings live inside the stored string object itself
+            std::string_view short_view = arena.store("a");
+            for (u32 i = 0; i < 10000; i++)
+            {
+                arena.store("b");
+            }
+            EXPECT_EQ(short_view, "a");
+            EXPECT_EQ(views.front(), "string_arena_entry_0");
+
+            arena.clear();
+            EXPECT_EQ(arena.store("after clear"), "after clear");
+        }
+        TEST_END
+    }
+}    // namespace hal
@@ -7,8 +7,13 @@
 #include "hal_core/netlist/decorators/boolean_function_net_decorator.h"
 #include "hal_core/netlist/decorators/boolean_function_decorator.h"
 #include "hal_core/netlist/decorators/netlist_modification_decorator.h"
+#include "hal_core/netlist/decorators/sequential_netlist_decorator.h"
+#include "hal_core/netlist/decorators/spatial_netlist_decorator.h"
+#include "hal_core/netlist/decorators/subgraph_netlist_decorator.h"
 #include "netlist_test_utils.h"
 
+#include <set>
+
 
 #include "gtest/gtest.h"
 
@@ -506,4 +511,222 @@ namespace hal {
         }
         TEST_END
     }
+
+    /**
+     * Test SpatialNetlistDecorator.
+     */
+    TEST_F(DecoratorTest, check_spatial_netlist_decorator)
+    {
+        TEST_START
+        {
+            auto nl = test_utils::create_empty_netlist();
+            ASSERT_NE(nl, nullptr);
+
+            auto gl = nl->get_gate_library();
+            ASSERT_NE(gl, nullptr);
+
+            // gates on a 10x10 grid with a spacing of 3, one unplaced gate
+            std::vector<Gate*> gates;
+            for (i32 i = 0; i < 100; i++)
+            {
+                Gate* gate = nl->create_gate(gl->get_gate_type_by_name("AND2"), "G" + std::to_string(i), 3 * (i % 10), 3 * (i / 10));
+                ASSERT_NE(gate, nullptr);
+                gates.push_back(gate);
+            }
+            Gate* unplaced = nl->create_gate(gl->get_gate_type_by_name("AND2"), "unplaced");
+            ASSERT_NE(unplaced, nullptr);
+
+            auto as_set = [](const std::vector<Gate*>& vec) { return std::set<Gate*>(vec.begin(), vec.end()); };
+
+            for (u32 cell_size : {0u, 1u, 4u, 100u})
+            {
+                SpatialNetlistDecorator nl_dec(*nl, cell_size);
+                EXPECT_EQ(nl_dec.get_num_placed_gates(), 100);
+
+                // test SpatialNetlistDecorator::get_gates_in_area
+                EXPECT_EQ(as_set(nl_dec.get_gates_in_area(3, 3, 6, 6)), std::set<Gate*>({gates.at(11), gates.at(12), gates.at(21), gates.at(22)}));
+                EXPECT_EQ(as_set(nl_dec.get_gates_in_area(-5, -5, 1, 1)), std::set<Gate*>({gates.at(0)}));
+                EXPECT_EQ(nl_dec.get_gates_in_area(1, 1, 2, 2).size(), 0);
+                EXPECT_EQ(nl_dec.get_gates_in_area(6, 6, 3, 3).size(), 0);
+                EXPECT_EQ(nl_dec.get_gates_in_area(0, 0, 1000, 1000).size(), 100);
+
+                // test SpatialNetlistDecorator::get_nearest_gates
+                EXPECT_EQ(nl_dec.get_nearest_gates(0, 0, 3), std::vector<Gate*>({gates.at(0), gates.at(1), gates.at(10)}));
+                EXPECT_EQ(nl_dec.get_nearest_gates(100, 100, 1), std::vector<Gate*>({gates.at(99)}));
+                EXPECT_EQ(nl_dec.get_nearest_gates(0, 0, 0).size(), 0);
+                EXPECT_EQ(nl_dec.get_nearest_gates(0, 0, 1000).size(), 100);
+
+                const auto nearest_res = nl_dec.get_nearest_gates(gates.at(55), 4);
+                ASSERT_TRUE(nearest_res.is_ok());
+                EXPECT_EQ(nearest_res.get(), std::vector<Gate*>({gates.at(45), gates.at(54), gates.at(56), gates.at(65)}));
+                EXPECT_TRUE(nl_dec.get_nearest_gates(unplaced, 4).is_error());
+                EXPECT_TRUE(nl_dec.get_nearest_gates(nullptr, 4).is_error());
+            }
+
+            {
+                // test maintenance of the index on netlist changes
+                SpatialNetlistDecorator nl_dec(*nl);
+
+                gates.at(0)->set_location(std::make_pair(4, 4));
+                unplaced->set_location(std::make_pair(5, 5));
+                gates.at(22)->set_location(std::make_pair(-1, -1));
+                ASSERT_TRUE(nl->delete_gate(gates.at(11)));
+                Gate* created = nl->create_gate(gl->get_gate_type_by_name("AND2"), "created", 6, 3);
+                ASSERT_NE(created, nullptr);
+
+                EXPECT_EQ(nl_dec.get_num_placed_gates(), 100);
+                EXPECT_EQ(as_set(nl_dec.get_gates_in_area(3, 3, 6, 6)), std::set<Gate*>({gates.at(0), unplaced, gates.at(12), gates.at(21), created}));
+                EXPECT_EQ(nl_dec.get_nearest_gates(0, 0, 2), std::vector<Gate*>({gates.at(1), gates.at(10)}));
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Test SequentialNetlistDecorator.
+     */
+    TEST_F(DecoratorTest, check_sequential_netlist_decorator)
+    {
+        TEST_START
+        {
+            auto nl = test_utils::create_empty_netlist();
+            ASSERT_NE(nl, nullptr);
+
+            auto gl = nl->get_gate_library();
+            ASSERT_NE(gl, nullptr);
+
+            // ff0 and ff1 feed ff2 through an AND gate, ff2 feeds ff0 directly
+            Gate* ff0  = nl->create_gate(gl->get_gate_type_by_name("DFF"), "FF0");
+            Gate* ff1  = nl->create_gate(gl->get_gate_type_by_name("DFF"), "FF1");
+            Gate* ff2  = nl->create_gate(gl->get_gate_type_by_name("DFF"), "FF2");
+            Gate* and0 = nl->create_gate(gl->get_gate_type_by_name("AND2"), "AND0");
+            ASSERT_NE(ff0, nullptr);
+            ASSERT_NE(ff1, nullptr);
+            ASSERT_NE(ff2, nullptr);
+            ASSERT_NE(and0, nullptr);
+
+            Net* net_ff0 = test_utils::connect(nl.get(), ff0, "Q", and0, "I0");
+            Net* net_ff1 = test_utils::connect(nl.get(), ff1, "Q", and0, "I1");
+            Net* net_and = test_utils::connect(nl.get(), and0, "O", ff2, "D");
+            Net* net_ff2 = test_utils::connect(nl.get(), ff2, "Q", ff0, "D");
+            ASSERT_NE(net_ff0, nullptr);
+            ASSERT_NE(net_ff1, nullptr);
+            ASSERT_NE(net_and, nullptr);
+            ASSERT_NE(net_ff2, nullptr);
+
+            SequentialNetlistDecorator nl_dec(*nl);
+
+            auto get_successors   = [&nl_dec](const Gate* gate) { return nl_dec.get_next_sequential_gates(gate, true).get(); };
+            auto get_predecessors = [&nl_dec](const Gate* gate) { return nl_dec.get_next_sequential_gates(gate, false).get(); };
+
+            // test SequentialNetlistDecorator::get_next_sequential_gates
+            EXPECT_EQ(get_successors(ff0), std::vector<Gate*>({ff2}));
+            EXPECT_EQ(get_successors(ff1), std::vector<Gate*>({ff2}));
+            EXPECT_EQ(get_successors(ff2), std::vector<Gate*>({ff0}));
+            EXPECT_EQ(get_predecessors(ff0), std::vector<Gate*>({ff2}));
+            EXPECT_EQ(get_predecessors(ff1), std::vector<Gate*>());
+            EXPECT_EQ(get_predecessors(ff2), std::vector<Gate*>({ff0, ff1}));
+            EXPECT_TRUE(nl_dec.get_next_sequential_gates(and0, true).is_error());
+            EXPECT_TRUE(nl_dec.get_next_sequential_gates(nullptr, true).is_error());
+
+            // test updates on netlist changes
+            ASSERT_TRUE(net_ff1->remove_destination(and0, "I1"));
+            ASSERT_NE(net_ff2->add_destination(ff1, "D"), nullptr);
+            EXPECT_EQ(get_successors(ff1), std::vector<Gate*>());
+            EXPECT_EQ(get_successors(ff2), std::vector<Gate*>({ff0, ff1}));
+            EXPECT_EQ(get_predecessors(ff1), std::vector<Gate*>({ff2}));
+            EXPECT_EQ(get_predecessors(ff2), std::vector<Gate*>({ff0}));
+
+            Gate* ff3 = nl->create_gate(gl->get_gate_type_by_name("DFF"), "FF3");
+            ASSERT_NE(ff3, nullptr);
+            ASSERT_NE(net_and->add_destination(ff3, "D"), nullptr);
+            EXPECT_EQ(get_successors(ff0), std::vector<Gate*>({ff2, ff3}));
+            EXPECT_EQ(get_predecessors(ff3), std::vector<Gate*>({ff0}));
+
+            ASSERT_TRUE(nl->delete_gate(and0));
+            EXPECT_EQ(get_successors(ff0), std::vector<Gate*>());
+            EXPECT_EQ(get_predecessors(ff2), std::vector<Gate*>());
+            EXPECT_EQ(get_predecessors(ff3), std::vector<Gate*>());
+            EXPECT_EQ(get_successors(ff2), std::vector<Gate*>({ff0, ff1}));
+        }
+        TEST_END
+    }
+    /**
+     * Test SubgraphNetlistDecorator.
+     */
+    TEST_F(DecoratorTest, check_subgraph_netlist_decorator)
+    {
+        TEST_START
+        {
+            auto nl = test_utils::create_empty_netlist();
+            ASSERT_NE(nl, nullptr);
+
+            auto gl = nl->get_gate_library();
+            ASSERT_NE(gl, nullptr);
+
+            // and0 feeds both and1 and and2, and1 feeds and2
+            Gate* and0 = nl->create_gate(gl->get_gate_type_by_name("AND2"), "AND0");
+            Gate* and1 = nl->create_gate(gl->get_gate_type_by_name("AND2"), "AND1");
+            Gate* and2 = nl->create_gate(gl->get_gate_type_by_name("AND2"), "AND2");
+            ASSERT_NE(and0, nullptr);
+            ASSERT_NE(and1, nullptr);
+            ASSERT_NE(and2, nullptr);
+
+            Net* net_a = nl->create_net("A");
+            Net* net_b = nl->create_net("B");
+            Net* net_c = nl->create_net("C");
+            ASSERT_NE(net_a, nullptr);
+            ASSERT_NE(net_b, nullptr);
+            ASSERT_NE(net_c, nullptr);
+            ASSERT_TRUE(nl->mark_global_input_net(net_a));
+            ASSERT_TRUE(nl->mark_global_input_net(net_b));
+            ASSERT_TRUE(nl->mark_global_input_net(net_c));
+            ASSERT_NE(net_a->add_destination(and0, "I0"), nullptr);
+            ASSERT_NE(net_b->add_destination(and0, "I1"), nullptr);
+            ASSERT_NE(net_c->add_destination(and1, "I1"), nullptr);
+
+            Net* net_0 = test_utils::connect(nl.get(), and0, "O", and1, "I0");
+            Net* net_1 = test_utils::connect(nl.get(), and1, "O", and2, "I1");
+            ASSERT_NE(net_0, nullptr);
+            ASSERT_NE(net_1, nullptr);
+            ASSERT_NE(net_0->add_destination(and2, "I0"), nullptr);
+            Net* net_2 = nl->create_net("N2");
+            ASSERT_NE(net_2, nullptr);
+            ASSERT_NE(net_2->add_source(and2, "O"), nullptr);
+
+            const SubgraphNetlistDecorator nl_dec(*nl);
+            const std::vector<const Gate*> subgraph_gates = {and0, and1, and2};
+
+            // test SubgraphNetlistDecorator::get_subgraph_functions
+            {
+                const std::vector<const Net*> subgraph_outputs = {net_2, net_1, net_a, net_0};
+                const auto res                                 = nl_dec.get_subgraph_functions(subgraph_gates, subgraph_outputs);
+                ASSERT_TRUE(res.is_ok());
+                ASSERT_EQ(res.get().size(), subgraph_outputs.size());
+                for (u32 i = 0; i < subgraph_outputs.size(); i++)
+                {
+                    const auto single_res = nl_dec.get_subgraph_function(subgraph_gates, subgraph_outputs.at(i));
+                    ASSERT_TRUE(single_res.is_ok());
+                    EXPECT_EQ(res.get().at(i), single_res.get());
+                }
+            }
+            {
+                // gates outside of the subgraph turn their output nets into inputs
+                const std::vector<const Gate*> partial_gates = {and2};
+                const auto res                               = nl_dec.get_subgraph_functions(partial_gates, {net_2});
+                ASSERT_TRUE(res.is_ok());
+                EXPECT_EQ(res.get(), std::vector<BooleanFunction>({nl_dec.get_subgraph_function(partial_gates, net_2).get()}));
+            }
+            EXPECT_TRUE(nl_dec.get_subgraph_functions(subgraph_gates, {}).get().empty());
+            EXPECT_TRUE(nl_dec.get_subgraph_functions(std::vector<const Gate*>(), {net_2}).is_error());
+            EXPECT_TRUE(nl_dec.get_subgraph_functions(subgraph_gates, {net_2, nullptr}).is_error());
+
+            // test cycle detection
+            ASSERT_TRUE(net_c->remove_destination(and1, "I1"));
+            ASSERT_NE(net_2->add_destination(and1, "I1"), nullptr);
+            EXPECT_TRUE(nl_dec.get_subgraph_function(subgraph_gates, net_2).is_error());
+            EXPECT_TRUE(nl_dec.get_subgraph_functions(subgraph_gates, {net_2}).is_error());
+        }
+        TEST_END
+    }
 }
\ No newline at end of file
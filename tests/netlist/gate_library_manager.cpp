@@ -1,4 +1,5 @@
 #include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/gate_library/gate_library_cache.h"
 #include "hal_core/netlist/gate_library/gate_library_manager.h"
 #include "hal_core/netlist/net.h"
 #include "hal_core/netlist/netlist.h"
@@ -9,8 +10,12 @@
 #include "netlist_test_utils.h"
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <thread>
 
 namespace hal
 {
@@ -31,6 +36,7 @@ namespace hal
         virtual void TearDown()
         {
             std::filesystem::remove(m_test_lib_path);
+            std::filesystem::remove(m_test_lib_path.string() + gate_library_cache::CACHE_FILE_EXTENSION);
             plugin_manager::unload_all_plugins();
         }
 
@@ -190,6 +196,144 @@ namespace hal
         TEST_END
     }
 
+    /**
+     * Testing that loaded gate libraries are cached and restored from the cache on reload.
+     *
+     * Functions: load
+     */
+    TEST_F(GateLibraryManagerTest, check_gate_library_cache)
+    {
+        TEST_START
+        NO_COUT_TEST_BLOCK;
+        create_test_lib();
+        std::filesystem::path cache_path = m_test_lib_path.string() + gate_library_cache::CACHE_FILE_EXTENSION;
+        std::filesystem::remove(cache_path);
+
+        GateLibrary* parsed_lib = gate_library_manager::load(m_test_lib_path, true);
+        ASSERT_NE(parsed_lib, nullptr);
+        EXPECT_TRUE(std::filesystem::exists(cache_path));
+        std::unordered_map<std::string, GateType*> parsed_types = parsed_lib->get_gate_types();
+
+        auto cached_lib = gate_library_cache::load(m_test_lib_path);
+        ASSERT_TRUE(cached_lib.is_ok());
+        std::unique_ptr<GateLibrary> restored_lib = cached_lib.get();
+        EXPECT_EQ(restored_lib->get_name(), parsed_lib->get_name());
+
+        // the cache is created before auto-generated gate types are added
+        for (const auto& [gt_name, gt] : restored_lib->get_gate_types())
+        {
+            ASSERT_TRUE(parsed_types.find(gt_name) != parsed_types.end());
+            const GateType* parsed_gt = parsed_types.at(gt_name);
+            EXPECT_EQ(gt->get_id(), parsed_gt->get_id());
+            EXPECT_EQ(gt->get_properties(), parsed_gt->get_properties());
+            EXPECT_EQ(gt->get_pin_names(), parsed_gt->get_pin_names());
+            EXPECT_EQ(gt->get_boolean_functions(), parsed_gt->get_boolean_functions());
+        }
+
+        // reloading uses the cache and yields an equivalent library
+        GateLibrary* reloaded_lib = gate_library_manager::load(m_test_lib_path, true);
+        ASSERT_NE(reloaded_lib, nullptr);
+        EXPECT_EQ(reloaded_lib->get_gate_types().size(), parsed_types.size());
+        EXPECT_EQ(reloaded_lib->get_gnd_gate_types().size(), 1);
+        EXPECT_EQ(reloaded_lib->get_vcc_gate_types().size(), 1);
+
+        // changing the library file invalidates the cache
+        {
+            std::ofstream test_lib(m_test_lib_path.string(), std::ios::app);
+            test_lib << "\n";
+        }
+        EXPECT_TRUE(gate_library_cache::load(m_test_lib_path).is_error());
+        TEST_END
+    }
+
+    /**
+     * Testing that concurrent writers of the same cache file neither corrupt it nor leave temporary files behind.
+     *
+     * Functions: save, load
+     */
+    TEST_F(GateLibraryManagerTest, check_gate_library_cache_concurrent_save)
+    {
+        TEST_START
+        NO_COUT_TEST_BLOCK;
+        create_test_lib();
+        std::filesystem::path cache_path = m_test_lib_path.string() + gate_library_cache::CACHE_FILE_EXTENSION;
+        std::filesystem::remove(cache_path);
+
+        GateLibrary* parsed_lib = gate_library_manager::load(m_test_lib_path, false);
+        ASSERT_NE(parsed_lib, nullptr);
+
+        const u32 num_writers = 8;
+        std::vector<std::thread> writers;
+        std::atomic<u32> num_ok(0);
+        for (u32 i = 0; i < num_writers; i++)
+        {
+            writers.emplace_back([&]() {
+                for (u32 j = 0; j < 10; j++)
+                {
+                    if (gate_library_cache::save(parsed_lib, m_test_lib_path).is_ok())
+                    {
+                        num_ok++;
+                    }
+                }
+            });
+        }
+        for (auto& t : writers)
+        {
+            t.join();
+        }
+        EXPECT_EQ(num_ok, num_writers * 10);
+
+        auto cached_lib = gate_library_cache::load(m_test_lib_path);
+        ASSERT_TRUE(cached_lib.is_ok());
+        EXPECT_EQ(cached_lib.get()->get_name(), parsed_lib->get_name());
+
+        for (const auto& entry : std::filesystem::directory_iterator(m_test_lib_path.parent_path()))
+        {
+            EXPECT_EQ(entry.path().filename().string().find(m_test_lib_path.filename().string() + ".tmp"), std::string::npos);
+        }
+        TEST_END
+    }
+
+    /**
+     * Testing the lookup of gate libraries by the gate types they contain.
+     *
+     * Functions: get_gate_libraries_by_gate_types
+     */
+    TEST_F(GateLibraryManagerTest, check_get_gate_libraries_by_gate_types)
+    {
+        TEST_START
+        NO_COUT_TEST_BLOCK;
+        create_test_lib();
+        GateLibrary* test_lib = gate_library_manager::get_gate_library(m_test_lib_path);
+        ASSERT_NE(test_lib, nullptr);
+
+        auto find_test_lib = [test_lib](const std::vector<std::pair<GateLibrary*, u32>>& libs) -> std::optional<u32> {
+            for (const auto& [lib, num_matches] : libs)
+            {
+                if (lib == test_lib)
+                {
+                    return num_matches;
+                }
+            }
+            return std::nullopt;
+        };
+
+        // gate type names are matched case-insensitively
+        EXPECT_EQ(find_test_lib(gate_library_manager::get_gate_libraries_by_gate_types({"GND", "vcc", "NON_EXISTING_GATE_TYPE"})), std::optional<u32>(2));
+        EXPECT_EQ(find_test_lib(gate_library_manager::get_gate_libraries_by_gate_types({"GND"})), std::optional<u32>(1));
+        EXPECT_EQ(find_test_lib(gate_library_manager::get_gate_libraries_by_gate_types({"NON_EXISTING_GATE_TYPE"})), std::nullopt);
+        EXPECT_TRUE(gate_library_manager::get_gate_libraries_by_gate_types({}).empty());
+
+        // results are ordered by the number of matches
+        auto libs = gate_library_manager::get_gate_libraries_by_gate_types({"GND", "VCC"});
+        EXPECT_TRUE(std::is_sorted(libs.begin(), libs.end(), [](const auto& a, const auto& b) { return a.second > b.second; }));
+
+        // removed libraries are no longer found
+        gate_library_manager::remove(std::filesystem::absolute(m_test_lib_path));
+        EXPECT_EQ(find_test_lib(gate_library_manager::get_gate_libraries_by_gate_types({"GND", "VCC"})), std::nullopt);
+        TEST_END
+    }
+
     /**
     * Testing the handling of various invalid inputs.
     *